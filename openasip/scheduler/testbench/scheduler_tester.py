@@ -66,7 +66,8 @@ Options:
   -i <comma separated list of stats>. Print more statistics for each run.
      Stats available:
      c=cycle count, rr=register reads, rw=register writes, oc=operation count,
-     opc=ops/cycle, and 'all' which includes all stats. Example: 'rr,rw'
+     opc=ops/cycle, st=compilation and scheduling time in seconds,
+     and 'all' which includes all stats. Example: 'rr,rw'
      prints register read and write stats.
   -l Output as LaTeX table.
   -L Loosen the topresults. Set the worsened result as the new topresult to
@@ -252,7 +253,7 @@ def ParseCommandLine():
             compiledSimulation = True
         elif o == '-i':
             if a == 'all':
-                moreStats = 'c,rr,rw,oc,opc'.split(',')
+                moreStats = 'c,rr,rw,oc,opc,st'.split(',')
             else:
                 moreStats = a.split(',')
         elif o == '-b':
@@ -411,6 +412,7 @@ class SimulationStats:
         self.registerReads = 0
         self.registerWrites = 0
         self.operationExecutions = 0
+        self.schedulingTime = 0.0
 
     def decodeStatString(self, stat):
         """
@@ -435,6 +437,8 @@ class SimulationStats:
             except:
                 pass
             return ('operation per cycle', 'opc', '%.2f' % value)
+        elif stat == 'st':
+            return ('scheduling time', 'sched s', '%.2f' % self.schedulingTime)
         else:
             print('unknown statistics type:', stat)
             return (None, None, None)
@@ -480,6 +484,8 @@ class TestCase:
 
         self.testExtraCompileFlags = extraCompileFlags
         self.description = ""
+        self.schedulingTime = 0.0
+        self.lastSchedulingTime = 0.0
         self.architectures = []
         self.directory = directory
         if directory.startswith('./'):
@@ -641,7 +647,10 @@ class TestCase:
                              " " + seqProgFileName
 
 
+        startTime = time.time()
         exitOk, stdoutContents, stderrContents = runWithTimeout(schedulingCommand, schedulingTimeoutSec)
+        self.lastSchedulingTime = time.time() - startTime
+        self.schedulingTime += self.lastSchedulingTime
 
         if not exitOk:
             self.testFailed("scheduling timeout")
@@ -771,6 +780,7 @@ close $cycle_file
         self.lastStats.operationExecutions = getStat('operations_executed')
         self.lastStats.registerReads = getStat('registers_read')
         self.lastStats.registerWrites = getStat('registers_written')
+        self.lastStats.schedulingTime = self.lastSchedulingTime
 
         self.stats[archFilename] = self.lastStats
         return True
@@ -1172,6 +1182,11 @@ class Tester:
                 "Broken schedule for %d/%d case(s). Top results not updated.\n"
                 % (broken, totalCombinations))
 
+        if moreStats is not None and 'st' in moreStats:
+            schedulingTime = sum([t.schedulingTime for t in self.testCases])
+            sys.stdout.write(
+                "Total scheduling time %.1f s.\n" % schedulingTime)
+
     def updateStatisticsFiles(self):
         for testCase in self.testCases:
             testCase.updateStatisticsFiles()
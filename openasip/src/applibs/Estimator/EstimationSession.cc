@@ -0,0 +1,694 @@
+/*
+    Copyright (c) 2002-2026 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file EstimationSession.cc
+ *
+ * Implementation of EstimationSession class.
+ *
+ * @note rating: red
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include "EstimationSession.hh"
+#include "Machine.hh"
+#include "FunctionUnit.hh"
+#include "RegisterFile.hh"
+#include "FUPort.hh"
+#include "RFPort.hh"
+#include "Socket.hh"
+#include "Segment.hh"
+#include "Bus.hh"
+#include "UnitImplementationLocation.hh"
+#include "NullUnitImplementationLocation.hh"
+#include "MachineImplementation.hh"
+#include "ObjectState.hh"
+#include "Conversion.hh"
+#include "Exception.hh"
+
+namespace CostEstimator {
+
+namespace {
+
+/**
+ * Appends the given object state tree to a signature string.
+ *
+ * The name of the component and its connections to sockets are left out,
+ * because they do not affect the estimates of the component.
+ *
+ * @param state The state to append.
+ * @param root True if the state is the state of the component itself.
+ * @param signature The signature to append to.
+ */
+void
+appendState(const ObjectState& state, bool root, std::string& signature) {
+    signature += state.name();
+    signature += "{";
+    for (int i = 0; i < state.attributeCount(); ++i) {
+        const ObjectState::Attribute& attribute = *state.attribute(i);
+        if ((root && attribute.name == TTAMachine::Component::OSKEY_NAME) ||
+            attribute.name == TTAMachine::FunctionUnit::OSKEY_ORDER_NUMBER ||
+            attribute.name == TTAMachine::Port::OSKEY_FIRST_SOCKET ||
+            attribute.name == TTAMachine::Port::OSKEY_SECOND_SOCKET) {
+            continue;
+        }
+        signature += attribute.name + "=" + attribute.value + ";";
+    }
+    signature += state.stringValue();
+    for (int i = 0; i < state.childCount(); ++i) {
+        appendState(*state.child(i), false, signature);
+    }
+    signature += "}";
+}
+
+/**
+ * Appends the given object state tree to a key string as it is.
+ *
+ * @param state The state to append.
+ * @param key The key to append to.
+ */
+void
+appendCompleteState(const ObjectState& state, std::string& key) {
+    key += state.name();
+    key += "{";
+    for (int i = 0; i < state.attributeCount(); ++i) {
+        const ObjectState::Attribute& attribute = *state.attribute(i);
+        key += attribute.name + "=" + attribute.value + ";";
+    }
+    key += state.stringValue();
+    for (int i = 0; i < state.childCount(); ++i) {
+        appendCompleteState(*state.child(i), key);
+    }
+    key += "}";
+}
+
+/**
+ * Joins the given numbers to a string in ascending order.
+ */
+std::string
+sortedList(std::vector<int> numbers) {
+    std::sort(numbers.begin(), numbers.end());
+    std::string list;
+    for (std::size_t i = 0; i < numbers.size(); ++i) {
+        list += Conversion::toString(numbers[i]) + ",";
+    }
+    return list;
+}
+
+}
+
+const std::size_t EstimationSession::DEFAULT_CAPACITY = 100000;
+const std::size_t EstimationSession::IC_CAPACITY = 32;
+
+/**
+ * Constructor.
+ *
+ * @param capacity Maximum number of memoized component and path estimates.
+ */
+EstimationSession::EstimationSession(std::size_t capacity) :
+    Estimator(), estimates_(capacity), icEstimates_(IC_CAPACITY),
+    signaturesValid_(false), hits_(0), misses_(0) {
+}
+
+/**
+ * Destructor.
+ */
+EstimationSession::~EstimationSession() {
+}
+
+/**
+ * Estimates the area of the interconnection network.
+ *
+ * The IC&decoder plugins estimate the interconnection network as a whole,
+ * so the estimate is reused only for identical machines with identical
+ * IC&decoder implementations.
+ *
+ * @see Estimator::icArea()
+ */
+AreaInGates
+EstimationSession::icArea(
+    const TTAMachine::Machine& machine,
+    const IDF::MachineImplementation& machineImplementation) {
+    if (!machineImplementation.hasICDecoderPluginName() ||
+        !machineImplementation.hasICDecoderPluginFile() ||
+        !machineImplementation.hasICDecoderHDB()) {
+        return Estimator::icArea(machine, machineImplementation);
+    }
+    std::string key = icKey(machine, machineImplementation);
+    double area = 0.0;
+    if (lookup(icEstimates_, key, area)) {
+        return area;
+    }
+    return store(
+        icEstimates_, key, Estimator::icArea(machine, machineImplementation));
+}
+
+/**
+ * Estimates the area of the given function unit.
+ *
+ * @see Estimator::functionUnitArea()
+ */
+AreaInGates
+EstimationSession::functionUnitArea(
+    const TTAMachine::FunctionUnit& architecture,
+    const IDF::FUImplementationLocation& implementationEntry) {
+    std::string key =
+        "fu_area|" + implementationKey(implementationEntry) + "|" +
+        unitSignature(architecture);
+    double area = 0.0;
+    if (lookup(estimates_, key, area)) {
+        return area;
+    }
+    return store(
+        estimates_, key,
+        Estimator::functionUnitArea(architecture, implementationEntry));
+}
+
+/**
+ * Estimates the area of the given register file.
+ *
+ * @see Estimator::registerFileArea()
+ */
+AreaInGates
+EstimationSession::registerFileArea(
+    const TTAMachine::BaseRegisterFile& architecture,
+    const IDF::RFImplementationLocation& implementationEntry) {
+    std::string key =
+        "rf_area|" + implementationKey(implementationEntry) + "|" +
+        unitSignature(architecture);
+    double area = 0.0;
+    if (lookup(estimates_, key, area)) {
+        return area;
+    }
+    return store(
+        estimates_, key,
+        Estimator::registerFileArea(architecture, implementationEntry));
+}
+
+/**
+ * Estimates the delay of the longest path in the given machine.
+ *
+ * The architecture signatures of the components are computed once for
+ * the whole call instead of once for each transport path.
+ *
+ * @see Estimator::longestPath()
+ */
+DelayInNanoSeconds
+EstimationSession::longestPath(
+    const TTAMachine::Machine& machine,
+    const IDF::MachineImplementation& machineImplementation) {
+    signatures_.clear();
+    signaturesValid_ = true;
+    DelayInNanoSeconds delay = 0.0;
+    try {
+        delay = Estimator::longestPath(machine, machineImplementation);
+    } catch (const Exception&) {
+        signaturesValid_ = false;
+        signatures_.clear();
+        throw;
+    }
+    signaturesValid_ = false;
+    signatures_.clear();
+    return delay;
+}
+
+/**
+ * Estimates the input delay of the given function unit port.
+ *
+ * @see Estimator::functionUnitPortWriteDelay()
+ */
+DelayInNanoSeconds
+EstimationSession::functionUnitPortWriteDelay(
+    const TTAMachine::FUPort& port,
+    const IDF::FUImplementationLocation& implementationEntry) {
+    std::string key =
+        "fu_write|" + implementationKey(implementationEntry) + "|" +
+        unitSignature(*port.parentUnit()) + "|" + port.name();
+    double delay = 0.0;
+    if (lookup(estimates_, key, delay)) {
+        return delay;
+    }
+    return store(
+        estimates_, key,
+        Estimator::functionUnitPortWriteDelay(port, implementationEntry));
+}
+
+/**
+ * Estimates the output delay of the given function unit port.
+ *
+ * @see Estimator::functionUnitPortReadDelay()
+ */
+DelayInNanoSeconds
+EstimationSession::functionUnitPortReadDelay(
+    const TTAMachine::FUPort& port,
+    const IDF::FUImplementationLocation& implementationEntry) {
+    std::string key =
+        "fu_read|" + implementationKey(implementationEntry) + "|" +
+        unitSignature(*port.parentUnit()) + "|" + port.name();
+    double delay = 0.0;
+    if (lookup(estimates_, key, delay)) {
+        return delay;
+    }
+    return store(
+        estimates_, key,
+        Estimator::functionUnitPortReadDelay(port, implementationEntry));
+}
+
+/**
+ * Estimates the maximum computation delay of the given function unit.
+ *
+ * @see Estimator::functionUnitMaximumComputationDelay()
+ */
+DelayInNanoSeconds
+EstimationSession::functionUnitMaximumComputationDelay(
+    const TTAMachine::FunctionUnit& architecture,
+    const IDF::FUImplementationLocation& implementation) {
+    std::string key =
+        "fu_computation|" + implementationKey(implementation) + "|" +
+        unitSignature(architecture);
+    double delay = 0.0;
+    if (lookup(estimates_, key, delay)) {
+        return delay;
+    }
+    return store(
+        estimates_, key, Estimator::functionUnitMaximumComputationDelay(
+            architecture, implementation));
+}
+
+/**
+ * Estimates the maximum computation delay of the given register file.
+ *
+ * @see Estimator::registerFileMaximumComputationDelay()
+ */
+DelayInNanoSeconds
+EstimationSession::registerFileMaximumComputationDelay(
+    const TTAMachine::BaseRegisterFile& architecture,
+    const IDF::RFImplementationLocation& implementationEntry) {
+    std::string key =
+        "rf_computation|" + implementationKey(implementationEntry) + "|" +
+        unitSignature(architecture);
+    double delay = 0.0;
+    if (lookup(estimates_, key, delay)) {
+        return delay;
+    }
+    return store(
+        estimates_, key, Estimator::registerFileMaximumComputationDelay(
+            architecture, implementationEntry));
+}
+
+/**
+ * Estimates the input delay of the given register file port.
+ *
+ * @see Estimator::registerFilePortWriteDelay()
+ */
+DelayInNanoSeconds
+EstimationSession::registerFilePortWriteDelay(
+    const TTAMachine::RFPort& port,
+    const IDF::RFImplementationLocation& implementationEntry) {
+    std::string key =
+        "rf_write|" + implementationKey(implementationEntry) + "|" +
+        unitSignature(*port.parentUnit()) + "|" + port.name();
+    double delay = 0.0;
+    if (lookup(estimates_, key, delay)) {
+        return delay;
+    }
+    return store(
+        estimates_, key,
+        Estimator::registerFilePortWriteDelay(port, implementationEntry));
+}
+
+/**
+ * Estimates the output delay of the given register file port.
+ *
+ * @see Estimator::registerFilePortReadDelay()
+ */
+DelayInNanoSeconds
+EstimationSession::registerFilePortReadDelay(
+    const TTAMachine::RFPort& port,
+    const IDF::RFImplementationLocation& implementationEntry) {
+    std::string key =
+        "rf_read|" + implementationKey(implementationEntry) + "|" +
+        unitSignature(*port.parentUnit()) + "|" + port.name();
+    double delay = 0.0;
+    if (lookup(estimates_, key, delay)) {
+        return delay;
+    }
+    return store(
+        estimates_, key,
+        Estimator::registerFilePortReadDelay(port, implementationEntry));
+}
+
+/**
+ * Estimates the socket-bus-socket delay of the given transport path.
+ *
+ * The key of a path consists of the widths and directions of the sockets
+ * and the bus on the path and of the sockets connected to the bus, which
+ * is the data the IC&decoder plugins estimate the path delay from.
+ *
+ * @see Estimator::estimateSocketToSocketDelayOfPath()
+ */
+DelayInNanoSeconds
+EstimationSession::estimateSocketToSocketDelayOfPath(
+    const std::string pluginPath, const std::string pluginName,
+    const TransportPath& path,
+    const IDF::MachineImplementation& machineImplementation,
+    const IDF::SocketImplementationLocation& sourceSocketImplementation,
+    const IDF::BusImplementationLocation& busImplementation,
+    const IDF::SocketImplementationLocation&
+        destinationSocketImplementation) {
+    std::string key =
+        "path|" + pluginPath + "|" + pluginName + "|" +
+        machineImplementation.icDecoderHDB() + "|" +
+        implementationKey(sourceSocketImplementation) + "|" +
+        implementationKey(busImplementation) + "|" +
+        implementationKey(destinationSocketImplementation) + "|" +
+        socketSignature(path.sourceSocket()) + "|" +
+        busSignature(path.bus()) + "|" +
+        socketSignature(path.destinationSocket());
+    double delay = 0.0;
+    if (lookup(estimates_, key, delay)) {
+        return delay;
+    }
+    return store(
+        estimates_, key, Estimator::estimateSocketToSocketDelayOfPath(
+            pluginPath, pluginName, path, machineImplementation,
+            sourceSocketImplementation, busImplementation,
+            destinationSocketImplementation));
+}
+
+/**
+ * Forgets all the memoized estimates.
+ *
+ * Should be called in case the contents of the HDBs have changed.
+ */
+void
+EstimationSession::clear() {
+    estimates_.clear();
+    icEstimates_.clear();
+    signatures_.clear();
+    hits_ = 0;
+    misses_ = 0;
+}
+
+/**
+ * Returns the number of estimates that were found in the cache.
+ */
+int
+EstimationSession::cacheHits() const {
+    return hits_;
+}
+
+/**
+ * Returns the number of estimates that were passed to the plugins.
+ */
+int
+EstimationSession::cacheMisses() const {
+    return misses_;
+}
+
+/**
+ * Looks up a memoized estimate.
+ *
+ * @param cache The cache to look the estimate up from.
+ * @param key The key of the estimate.
+ * @param estimate Set to the memoized estimate, if one was found.
+ * @return True if the estimate was found.
+ */
+bool
+EstimationSession::lookup(
+    EstimateCache& cache, const std::string& key, double& estimate) {
+    if (!cache.find(key, estimate)) {
+        ++misses_;
+        return false;
+    }
+    ++hits_;
+    return true;
+}
+
+/**
+ * Memoizes an estimate.
+ *
+ * @param cache The cache to store the estimate to.
+ * @param key The key of the estimate.
+ * @param estimate The estimate.
+ * @return The estimate.
+ */
+double
+EstimationSession::store(
+    EstimateCache& cache, const std::string& key, double estimate) {
+    cache.insert(key, estimate);
+    return estimate;
+}
+
+/**
+ * Returns the key of the given implementation location.
+ *
+ * The HDB file is resolved to its absolute path so that equally named
+ * HDBs in different directories do not share estimates.
+ */
+std::string
+EstimationSession::implementationKey(
+    const IDF::UnitImplementationLocation& implementation) const {
+    if (&implementation == &IDF::NullUnitImplementationLocation::instance()) {
+        return "-";
+    }
+    std::string hdbFile;
+    try {
+        hdbFile = implementation.hdbFile();
+    } catch (const FileNotFound&) {
+        // the estimator reports the missing HDB
+        hdbFile = implementation.hdbFileOriginal();
+    }
+    return hdbFile + ":" + Conversion::toString(implementation.id());
+}
+
+/**
+ * Returns the architecture signature of the given unit.
+ *
+ * The signature contains everything in the unit except its name and
+ * its connections to sockets.
+ */
+std::string
+EstimationSession::unitSignature(const TTAMachine::Component& unit) {
+    if (signaturesValid_) {
+        SignatureCache::const_iterator i = signatures_.find(&unit);
+        if (i != signatures_.end()) {
+            return i->second;
+        }
+    }
+    const TTAMachine::RegisterFile* rf =
+        dynamic_cast<const TTAMachine::RegisterFile*>(&unit);
+    if (rf != NULL) {
+        // make sure the lazily computed port limits are up to date
+        rf->maxReads();
+        rf->maxWrites();
+    }
+    ObjectState* state = unit.saveState();
+    std::string signature;
+    appendState(*state, true, signature);
+    delete state;
+    if (signaturesValid_) {
+        signatures_[&unit] = signature;
+    }
+    return signature;
+}
+
+/**
+ * Returns the signature of the given socket.
+ *
+ * The signature consists of the direction of the socket and the widths of
+ * the buses and ports connected to it.
+ */
+std::string
+EstimationSession::socketSignature(const TTAMachine::Socket& socket) {
+    if (signaturesValid_) {
+        SignatureCache::const_iterator i = signatures_.find(&socket);
+        if (i != signatures_.end()) {
+            return i->second;
+        }
+    }
+    std::vector<int> busWidths;
+    for (int i = 0; i < socket.segmentCount(); ++i) {
+        busWidths.push_back(socket.segment(i)->parentBus()->width());
+    }
+    std::vector<int> portWidths;
+    for (int i = 0; i < socket.portCount(); ++i) {
+        portWidths.push_back(socket.port(i)->width());
+    }
+    std::string signature =
+        Conversion::toString(static_cast<int>(socket.direction())) + ":" +
+        sortedList(busWidths) + ":" + sortedList(portWidths);
+    if (signaturesValid_) {
+        signatures_[&socket] = signature;
+    }
+    return signature;
+}
+
+/**
+ * Returns the signature of the given bus.
+ *
+ * The signature consists of the width of the bus and the directions and
+ * the widest ports of the sockets connected to it.
+ */
+std::string
+EstimationSession::busSignature(const TTAMachine::Bus& bus) {
+    if (signaturesValid_) {
+        SignatureCache::const_iterator i = signatures_.find(&bus);
+        if (i != signatures_.end()) {
+            return i->second;
+        }
+    }
+    std::vector<int> inputWidths;
+    std::vector<int> outputWidths;
+    TTAMachine::Machine::SocketNavigator socketNav =
+        bus.machine()->socketNavigator();
+    for (int i = 0; i < socketNav.count(); ++i) {
+        const TTAMachine::Socket& socket = *socketNav.item(i);
+        if (!bus.isConnectedTo(socket)) {
+            continue;
+        }
+        int width = 0;
+        for (int port = 0; port < socket.portCount(); ++port) {
+            width = std::max(width, socket.port(port)->width());
+        }
+        if (socket.direction() == TTAMachine::Socket::OUTPUT) {
+            inputWidths.push_back(width);
+        } else {
+            outputWidths.push_back(width);
+        }
+    }
+    std::string signature =
+        Conversion::toString(bus.width()) + ":" + sortedList(inputWidths) +
+        ":" + sortedList(outputWidths);
+    if (signaturesValid_) {
+        signatures_[&bus] = signature;
+    }
+    return signature;
+}
+
+/**
+ * Returns the key of the interconnection network of the machine.
+ *
+ * The key consists of the complete state of the machine and of the
+ * IC&decoder plugin, its parameters, and the socket and bus
+ * implementations given in the machine implementation.
+ */
+std::string
+EstimationSession::icKey(
+    const TTAMachine::Machine& machine,
+    const IDF::MachineImplementation& machineImplementation) const {
+    std::string key =
+        "ic_area|" + machineImplementation.icDecoderPluginFile() + "|" +
+        machineImplementation.icDecoderPluginName() + "|" +
+        machineImplementation.icDecoderHDB() + "|";
+    for (unsigned i = 0;
+         i < machineImplementation.icDecoderParameterCount(); ++i) {
+        key += machineImplementation.icDecoderParameterName(i) + "=" +
+            machineImplementation.icDecoderParameterValue(i) + ";";
+    }
+    key += "|";
+    for (int i = 0; i < machineImplementation.socketImplementationCount();
+         ++i) {
+        const IDF::SocketImplementationLocation& socket =
+            machineImplementation.socketImplementation(i);
+        key += socket.unitName() + "=" + implementationKey(socket) + ";";
+    }
+    key += "|";
+    for (int i = 0; i < machineImplementation.busImplementationCount();
+         ++i) {
+        const IDF::BusImplementationLocation& bus =
+            machineImplementation.busImplementation(i);
+        key += bus.unitName() + "=" + implementationKey(bus) + ";";
+    }
+    key += "|";
+    ObjectState* state = machine.saveState();
+    appendCompleteState(*state, key);
+    delete state;
+    return key;
+}
+
+/**
+ * Constructor.
+ *
+ * @param capacity Maximum number of estimates.
+ */
+EstimationSession::EstimateCache::EstimateCache(std::size_t capacity) :
+    capacity_(std::max<std::size_t>(capacity, 1)) {
+}
+
+/**
+ * Looks up an estimate and marks it the most recently used one.
+ *
+ * @param key The key of the estimate.
+ * @param estimate Set to the estimate, if one was found.
+ * @return True if the estimate was found.
+ */
+bool
+EstimationSession::EstimateCache::find(
+    const std::string& key, double& estimate) {
+    std::map<std::string, EntryList::iterator>::iterator i =
+        index_.find(key);
+    if (i == index_.end()) {
+        return false;
+    }
+    entries_.splice(entries_.begin(), entries_, i->second);
+    estimate = i->second->second;
+    return true;
+}
+
+/**
+ * Adds an estimate, dropping the least recently used one if full.
+ *
+ * @param key The key of the estimate.
+ * @param estimate The estimate.
+ */
+void
+EstimationSession::EstimateCache::insert(
+    const std::string& key, double estimate) {
+    std::map<std::string, EntryList::iterator>::iterator i =
+        index_.find(key);
+    if (i != index_.end()) {
+        i->second->second = estimate;
+        entries_.splice(entries_.begin(), entries_, i->second);
+        return;
+    }
+    if (index_.size() >= capacity_) {
+        index_.erase(entries_.back().first);
+        entries_.pop_back();
+    }
+    entries_.push_front(std::make_pair(key, estimate));
+    index_[key] = entries_.begin();
+}
+
+/**
+ * Removes all the estimates.
+ */
+void
+EstimationSession::EstimateCache::clear() {
+    entries_.clear();
+    index_.clear();
+}
+
+}
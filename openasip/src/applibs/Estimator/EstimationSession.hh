@@ -0,0 +1,196 @@
+/*
+    Copyright (c) 2002-2026 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file EstimationSession.hh
+ *
+ * Declaration of EstimationSession class.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_ESTIMATION_SESSION_HH
+#define TTA_ESTIMATION_SESSION_HH
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "Estimator.hh"
+
+namespace TTAMachine {
+    class Component;
+    class Socket;
+    class Bus;
+}
+
+namespace IDF {
+    class UnitImplementationLocation;
+}
+
+namespace CostEstimator {
+
+/**
+ * Estimator that memoizes the component and path estimates over a series
+ * of estimated machines.
+ *
+ * Explorers estimate long sequences of machines which differ from each
+ * other by only a few units or buses. The session stores the area, the
+ * computation delay and the port delays of each unit, and the delay of
+ * each socket-bus-socket path, under a key built from the implementation
+ * of the component and the architecture data its estimate depends on.
+ * Component names are not part of the keys, thus the cached estimates
+ * survive reloading and renaming of the machine and only the components
+ * and paths touched by a change are passed to the estimation plugins.
+ *
+ * The interconnection network area is estimated by the IC&decoder plugin
+ * as a whole, so it is keyed on the complete machine and the complete
+ * IC&decoder part of the implementation and kept in a smaller cache of
+ * its own. Both caches drop the least recently used estimates when full.
+ *
+ * Energy estimates depend on the execution trace and are not memoized.
+ */
+class EstimationSession : public Estimator {
+public:
+    EstimationSession(std::size_t capacity = DEFAULT_CAPACITY);
+    virtual ~EstimationSession();
+
+    virtual AreaInGates icArea(
+        const TTAMachine::Machine& machine,
+        const IDF::MachineImplementation& machineImplementation);
+
+    virtual AreaInGates functionUnitArea(
+        const TTAMachine::FunctionUnit& architecture,
+        const IDF::FUImplementationLocation& implementationEntry);
+
+    virtual AreaInGates registerFileArea(
+        const TTAMachine::BaseRegisterFile& architecture,
+        const IDF::RFImplementationLocation& implementationEntry);
+
+    virtual DelayInNanoSeconds longestPath(
+        const TTAMachine::Machine& machine,
+        const IDF::MachineImplementation& machineImplementation);
+
+    virtual DelayInNanoSeconds functionUnitPortWriteDelay(
+        const TTAMachine::FUPort& port,
+        const IDF::FUImplementationLocation& implementationEntry);
+
+    virtual DelayInNanoSeconds functionUnitPortReadDelay(
+        const TTAMachine::FUPort& port,
+        const IDF::FUImplementationLocation& implementationEntry);
+
+    virtual DelayInNanoSeconds functionUnitMaximumComputationDelay(
+        const TTAMachine::FunctionUnit& architecture,
+        const IDF::FUImplementationLocation& implementation);
+
+    virtual DelayInNanoSeconds registerFileMaximumComputationDelay(
+        const TTAMachine::BaseRegisterFile& architecture,
+        const IDF::RFImplementationLocation& implementationEntry);
+
+    virtual DelayInNanoSeconds registerFilePortWriteDelay(
+        const TTAMachine::RFPort& port,
+        const IDF::RFImplementationLocation& implementationEntry);
+
+    virtual DelayInNanoSeconds registerFilePortReadDelay(
+        const TTAMachine::RFPort& port,
+        const IDF::RFImplementationLocation& implementationEntry);
+
+    void clear();
+
+    int cacheHits() const;
+    int cacheMisses() const;
+
+    /// Default maximum number of memoized component and path estimates.
+    static const std::size_t DEFAULT_CAPACITY;
+    /// Maximum number of memoized interconnection network estimates.
+    static const std::size_t IC_CAPACITY;
+
+protected:
+    virtual DelayInNanoSeconds estimateSocketToSocketDelayOfPath(
+        const std::string pluginPath, const std::string pluginName,
+        const TransportPath& path,
+        const IDF::MachineImplementation& machineImplementation,
+        const IDF::SocketImplementationLocation& sourceSocketImplementation,
+        const IDF::BusImplementationLocation& busImplementation,
+        const IDF::SocketImplementationLocation&
+            destinationSocketImplementation);
+
+private:
+    /// Memoized estimates indexed by their keys, in least recently used
+    /// order.
+    class EstimateCache {
+    public:
+        explicit EstimateCache(std::size_t capacity);
+
+        bool find(const std::string& key, double& estimate);
+        void insert(const std::string& key, double estimate);
+        void clear();
+
+    private:
+        /// The estimates, the most recently used first.
+        typedef std::list<std::pair<std::string, double> > EntryList;
+
+        /// Maximum number of estimates.
+        std::size_t capacity_;
+        /// The estimates.
+        EntryList entries_;
+        /// The estimates indexed by their keys.
+        std::map<std::string, EntryList::iterator> index_;
+    };
+    /// Architecture signatures of the components of the current machine.
+    typedef std::map<const void*, std::string> SignatureCache;
+
+    bool lookup(
+        EstimateCache& cache, const std::string& key, double& estimate);
+    double store(
+        EstimateCache& cache, const std::string& key, double estimate);
+
+    std::string implementationKey(
+        const IDF::UnitImplementationLocation& implementation) const;
+    std::string unitSignature(const TTAMachine::Component& unit);
+    std::string socketSignature(const TTAMachine::Socket& socket);
+    std::string busSignature(const TTAMachine::Bus& bus);
+    std::string icKey(
+        const TTAMachine::Machine& machine,
+        const IDF::MachineImplementation& machineImplementation) const;
+
+    /// The memoized estimates.
+    EstimateCache estimates_;
+    /// The memoized interconnection network estimates.
+    EstimateCache icEstimates_;
+    /// Signatures of the components of the machine estimated by the
+    /// ongoing longestPath() call, indexed by the component.
+    SignatureCache signatures_;
+    /// True while the component signatures can be reused.
+    bool signaturesValid_;
+    /// Number of estimates found in the cache.
+    int hits_;
+    /// Number of estimates computed by the plugins.
+    int misses_;
+};
+
+}
+
+#endif
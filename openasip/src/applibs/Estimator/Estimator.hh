@@ -89,27 +89,27 @@ public:
 
     /// area estimation functions
 
-    AreaInGates totalArea(
+    virtual AreaInGates totalArea(
         const TTAMachine::Machine& machine,
         const IDF::MachineImplementation& machineImplementation);
 
-    AreaInGates totalAreaOfFunctionUnits(
+    virtual AreaInGates totalAreaOfFunctionUnits(
         const TTAMachine::Machine& machine,
         const IDF::MachineImplementation& machineImplementation);
 
-    AreaInGates totalAreaOfRegisterFiles(
+    virtual AreaInGates totalAreaOfRegisterFiles(
         const TTAMachine::Machine& machine,
         const IDF::MachineImplementation& machineImplementation);
 
-    AreaInGates icArea(
+    virtual AreaInGates icArea(
         const TTAMachine::Machine& machine,
         const IDF::MachineImplementation& machineImplementation);
 
-    AreaInGates functionUnitArea(
+    virtual AreaInGates functionUnitArea(
         const TTAMachine::FunctionUnit& architecture,
         const IDF::FUImplementationLocation& implementationEntry);
 
-    AreaInGates registerFileArea(
+    virtual AreaInGates registerFileArea(
         const TTAMachine::BaseRegisterFile& architecture,
         const IDF::RFImplementationLocation& implementationEntry);
 
@@ -147,7 +147,7 @@ public:
 
     /// delay estimation functions
 
-    DelayInNanoSeconds longestPath(
+    virtual DelayInNanoSeconds longestPath(
         const TTAMachine::Machine& machine,
         const IDF::MachineImplementation& machineImplementation);
 
@@ -155,35 +155,35 @@ public:
         const TTAMachine::Machine& machine,
         const IDF::MachineImplementation& machineImplementation);
 
-    DelayInNanoSeconds functionUnitPortWriteDelay(
+    virtual DelayInNanoSeconds functionUnitPortWriteDelay(
         const TTAMachine::FUPort& port,
         const IDF::FUImplementationLocation& implementationEntry);
 
-    DelayInNanoSeconds functionUnitPortReadDelay(
+    virtual DelayInNanoSeconds functionUnitPortReadDelay(
         const TTAMachine::FUPort& port,
         const IDF::FUImplementationLocation& implementationEntry);
 
-    DelayInNanoSeconds functionUnitMaximumComputationDelay(
+    virtual DelayInNanoSeconds functionUnitMaximumComputationDelay(
         const TTAMachine::FunctionUnit& architecture,
         const IDF::FUImplementationLocation& implementation);
 
-    DelayInNanoSeconds registerFileMaximumComputationDelay(
+    virtual DelayInNanoSeconds registerFileMaximumComputationDelay(
         const TTAMachine::BaseRegisterFile& architecture,
         const IDF::RFImplementationLocation& implementationEntry);
 
-    DelayInNanoSeconds registerFilePortWriteDelay(
+    virtual DelayInNanoSeconds registerFilePortWriteDelay(
         const TTAMachine::RFPort& port,
         const IDF::RFImplementationLocation& implementationEntry);
 
-    DelayInNanoSeconds registerFilePortReadDelay(
+    virtual DelayInNanoSeconds registerFilePortReadDelay(
         const TTAMachine::RFPort& port,
         const IDF::RFImplementationLocation& implementationEntry);
 
-private:
+protected:
     static TransportPathList* findAllICPaths(
         const TTAMachine::Machine& machine);
 
-    DelayInNanoSeconds estimateSocketToSocketDelayOfPath(
+    virtual DelayInNanoSeconds estimateSocketToSocketDelayOfPath(
         const std::string pluginPath, const std::string pluginName,
         const TransportPath& path,
         const IDF::MachineImplementation& machineImplementation,
@@ -192,6 +192,7 @@ private:
         const IDF::SocketImplementationLocation&
             destinationSocketImplementation);
 
+private:
     FUCostEstimationPlugin& fuCostFunctionPluginOfImplementation(
         const IDF::FUImplementationLocation& implementation);
 
@@ -40,7 +40,7 @@
 #include "Exception.hh"
 #include "SimulatorConstants.hh"
 #include "PluginTools.hh"
-#include "Estimator.hh"
+#include "EstimationSession.hh"
 #include "DSDBManager.hh"
 #include "TestApplication.hh"
 #include "BaseLineReader.hh"
@@ -131,8 +131,9 @@ private:
     DSDBManager* dsdb_;
     /// The plugin tool.
     static PluginTools pluginTool_;
-    /// The estimator frontend.
-    CostEstimator::Estimator estimator_;
+    /// The estimator frontend. Memoizes the estimates of the components
+    /// over the evaluated configurations.
+    CostEstimator::EstimationSession estimator_;
     /// Output stream.
     std::ostringstream* oStream_;
     /// Used for the default evaluate() argument.
@@ -30,8 +30,19 @@
  * @note rating: red
  */
 
+#include <map>
+#include <mutex>
+#include <fstream>
+#include <sstream>
+#include <functional>
+#include <cstdio>
+#include <unistd.h>
+
 #include "FUFiniteStateAutomaton.hh"
 #include "Application.hh"
+#include "Environment.hh"
+#include "FileSystem.hh"
+#include "Conversion.hh"
 #include "ResourceVectorSet.hh"
 #include "CollisionMatrix.hh"
 #include "StringTools.hh"
@@ -41,6 +52,17 @@
 #include "HWOperation.hh"
 #include "FunctionUnit.hh"
 
+namespace {
+    /// Identifies the format of the cached automata.
+    const std::string CACHE_FILE_HEADER = "OpenASIP FU FSA 1";
+    /// Marks a cached complete automaton.
+    const char CACHED_COMPLETE = 'C';
+    /// Marks a pipeline with too many states to be built completely.
+    const char CACHED_TOO_LARGE = 'L';
+}
+
+const int FUFiniteStateAutomaton::MAX_SHARED_STATES;
+
 /**
  * Initializes the FSA from the given FU.
  *
@@ -171,15 +193,27 @@ FUFiniteStateAutomaton::addCollisionMatrixForState(
  *
  * This might take very long time if there are lots of states to build. That
  * is, if the FU pipeline resource usage patterns are long and complicated.
+ *
+ * @param maxStates Stop building after the automaton has more states than
+ * this. The states built so far are kept and the rest are built lazily.
+ * @return True if all states were built.
  */
-void
-FUFiniteStateAutomaton::buildStateMachine() {
+bool
+FUFiniteStateAutomaton::buildStateMachine(int maxStates) {
 
+    if (isComplete()) {
+        // nothing to build, possibly read from a cache without the
+        // collision matrices needed for building
+        return true;
+    }
     hash_set<FSAStateIndex> handledStates;
     hash_set<FSAStateIndex> unfinishedStatesList;
     unfinishedStatesList.insert(0); // start from the start state
 
     while (!unfinishedStatesList.empty()) {
+        if (stateCount() > maxStates) {
+            return false;
+        }
         const FSAStateIndex state = *unfinishedStatesList.begin();
         unfinishedStatesList.erase(state);
         // go through all operations (transitions), the NOP is included
@@ -193,6 +227,169 @@ FUFiniteStateAutomaton::buildStateMachine() {
         }
         handledStates.insert(state);
     }
+    return true;
+}
+
+/**
+ * Returns true if all the states and state transitions have been built.
+ */
+bool
+FUFiniteStateAutomaton::isComplete() const {
+    for (std::size_t i = 0; i < transitions_.size(); ++i) {
+        const TransitionVector& vec = transitions_[i];
+        for (std::size_t t = 0; t < vec.size(); ++t) {
+            if (vec[t] == UNKNOWN_STATE) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Returns a description of the modeled pipeline.
+ *
+ * The description contains the transition names and the collision
+ * matrices of the operations, which together define the automaton. FUs
+ * with equal descriptions thus have identical automata regardless of
+ * their names and other properties.
+ *
+ * @return The description.
+ */
+std::string
+FUFiniteStateAutomaton::pipelineDescription() const {
+    std::ostringstream description;
+    for (int i = 0; i < operationCollisionMatrices_.size(); ++i) {
+        description
+            << transitionName(i) << std::endl
+            << operationCollisionMatrices_.at(i).toString();
+    }
+    return description.str();
+}
+
+/**
+ * Returns a completely built automaton for the given FU.
+ *
+ * The automata are shared between all clients of the process which model
+ * FUs with identical pipelines, and must thus not be modified. The
+ * automata are also cached on disk in Environment::fsaCachePath() so
+ * that the states need to be built only once per pipeline.
+ *
+ * In case the automaton of the FU has more than MAX_SHARED_STATES states,
+ * a new automaton that builds its states lazily is returned instead. It
+ * is not shared with other clients.
+ *
+ * @param fu The function unit to build the automaton for.
+ * @return The automaton.
+ */
+FUFiniteStateAutomaton::Handle
+FUFiniteStateAutomaton::sharedAutomaton(const TTAMachine::FunctionUnit& fu) {
+
+    Handle automaton(new FUFiniteStateAutomaton(fu, true));
+    const std::string description = automaton->pipelineDescription();
+
+    static std::mutex registryLock;
+    // a null handle marks a pipeline whose automaton is too large to share
+    static std::map<std::string, Handle> registry;
+
+    std::lock_guard<std::mutex> lock(registryLock);
+    std::map<std::string, Handle>::const_iterator shared =
+        registry.find(description);
+    if (shared != registry.end()) {
+        return shared->second != NULL ? shared->second : automaton;
+    }
+
+    std::ostringstream fileName;
+    fileName
+        << Environment::fsaCachePath() << FileSystem::DIRECTORY_SEPARATOR
+        << std::hex << std::hash<std::string>()(description) << ".fsa";
+
+    bool complete = false;
+    if (!automaton->readCacheFile(fileName.str(), description, complete)) {
+        complete = automaton->buildStateMachine(MAX_SHARED_STATES);
+        automaton->writeCacheFile(fileName.str(), description);
+    }
+    if (!complete) {
+        registry[description] = Handle();
+        return automaton;
+    }
+    registry[description] = automaton;
+    return automaton;
+}
+
+/**
+ * Reads the states and state transitions from a cache file.
+ *
+ * @param fileName The cache file.
+ * @param description Description of the pipeline of this automaton.
+ * @param complete Set to true if the automaton was read, false if the
+ * file tells the automaton is too large to be built completely.
+ * @return True if the file was written for the same pipeline, false if
+ * there is no such file.
+ */
+bool
+FUFiniteStateAutomaton::readCacheFile(
+    const std::string& fileName, const std::string& description,
+    bool& complete) {
+
+    std::ifstream file(fileName.c_str(), std::ios::binary);
+    std::string header;
+    std::size_t descriptionSize = 0;
+    if (!std::getline(file, header) || header != CACHE_FILE_HEADER ||
+        !(file >> descriptionSize) || file.get() != '\n' ||
+        descriptionSize != description.size()) {
+        return false;
+    }
+    std::string fileDescription(descriptionSize, '\0');
+    if (!file.read(&fileDescription[0], descriptionSize) ||
+        fileDescription != description) {
+        return false;
+    }
+    const int status = file.get();
+    if (status == CACHED_TOO_LARGE) {
+        complete = false;
+        return true;
+    }
+    complete = status == CACHED_COMPLETE && readTransitions(file);
+    return complete;
+}
+
+/**
+ * Writes the states and state transitions to a cache file.
+ *
+ * An automaton that is not complete is not written, only the fact that
+ * it could not be built completely. The file is first written under a temporary name and then renamed, so
+ * that other processes never see a partially written file. Failures to
+ * write the cache are ignored.
+ *
+ * @param fileName The cache file.
+ * @param description Description of the pipeline of this automaton.
+ */
+void
+FUFiniteStateAutomaton::writeCacheFile(
+    const std::string& fileName, const std::string& description) const {
+
+    const std::string directory = FileSystem::directoryOfPath(fileName);
+    if (!FileSystem::fileIsDirectory(directory) &&
+        !FileSystem::createDirectory(directory)) {
+        return;
+    }
+    const std::string tempName =
+        fileName + "." + Conversion::toString(getpid()) + ".tmp";
+    std::ofstream file(tempName.c_str(), std::ios::binary);
+    file << CACHE_FILE_HEADER << std::endl
+         << description.size() << std::endl
+         << description;
+    if (isComplete()) {
+        file.put(CACHED_COMPLETE);
+        writeTransitions(file);
+    } else {
+        file.put(CACHED_TOO_LARGE);
+    }
+    file.close();
+    if (!file || std::rename(tempName.c_str(), fileName.c_str()) != 0) {
+        std::remove(tempName.c_str());
+    }
 }
 
 /**
@@ -275,9 +472,14 @@ FUFiniteStateAutomaton::stateName(FSAStateIndex state) const {
     StateCollisionMatrixIndex::const_iterator i = 
         stateCollisionMatrices_.find(state);
 
-    if (i == stateCollisionMatrices_.end())
+    if (i == stateCollisionMatrices_.end()) {
+        if (state >= 0 && state < stateCount()) {
+            // read from a cache file without the collision matrices
+            return FiniteStateAutomaton::stateName(state);
+        }
         throw OutOfRange(
             __FILE__, __LINE__, __func__, "No such state.");
+    }
 
     return (*i).second->toDotString();
 }
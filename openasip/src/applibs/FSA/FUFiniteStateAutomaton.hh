@@ -34,6 +34,8 @@
 #define TTA_FU_FINITE_STATE_AUTOMATON_HH
 
 #include <string>
+#include <memory>
+#include <climits>
 #include "FiniteStateAutomaton.hh"
 #include "Exception.hh"
 #include "FUCollisionMatrixIndex.hh"
@@ -51,6 +53,9 @@ class ReservationTable;
  * resources.
  *
  * Includes support for lazily initializing the states when needed.
+ *
+ * Completely built automata of identical FU pipelines are shared between
+ * the clients of a process and cached on disk, see sharedAutomaton().
  */
 class FUFiniteStateAutomaton : public FiniteStateAutomaton {
 public:
@@ -60,6 +65,12 @@ public:
 
     typedef FSAStateTransitionIndex OperationID;
 
+    /// Handle to an automaton that may be shared with other clients.
+    typedef std::shared_ptr<FUFiniteStateAutomaton> Handle;
+
+    /// Maximum number of states in a completely built shared automaton.
+    static const int MAX_SHARED_STATES = 1 << 16;
+
     FUFiniteStateAutomaton(
         const TTAMachine::FunctionUnit& fu, 
         bool lazyBuilding = true);
@@ -85,9 +96,20 @@ public:
     void issueOperation(OperationID operation);
     void advanceCycle();
 
-    void buildStateMachine();
+    bool buildStateMachine(int maxStates = INT_MAX);
+    bool isComplete() const;
+
+    std::string pipelineDescription() const;
+
+    static Handle sharedAutomaton(const TTAMachine::FunctionUnit& fu);
 
 private:
+    bool readCacheFile(
+        const std::string& fileName, const std::string& description,
+        bool& complete);
+    void writeCacheFile(
+        const std::string& fileName, const std::string& description) const;
+
     void addCollisionMatrixForState(
         FSAStateIndex state, CollisionMatrix* matrix);
 
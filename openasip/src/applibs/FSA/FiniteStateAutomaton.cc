@@ -31,6 +31,9 @@
  */
 
 #include <sstream>
+#include <istream>
+#include <ostream>
+#include <cstdint>
 #include "Application.hh"
 #include "FiniteStateAutomaton.hh"
 #include "Conversion.hh"
@@ -283,3 +286,80 @@ FiniteStateAutomaton::startState() const {
     return 0;
 }
 
+/**
+ * Returns the number of states in the automaton.
+ *
+ * @return The state count.
+ */
+int
+FiniteStateAutomaton::stateCount() const {
+    return stateCount_;
+}
+
+/**
+ * Writes the states and the state transitions to a stream.
+ *
+ * The transitions are written as a compact binary table which can be
+ * read back with readTransitions(). The transition names are not written.
+ *
+ * @param stream The stream to write to.
+ */
+void
+FiniteStateAutomaton::writeTransitions(std::ostream& stream) const {
+
+    std::vector<int32_t> table;
+    table.reserve(2 + stateCount_ * transitionTypeCount_);
+    table.push_back(stateCount_);
+    table.push_back(transitionTypeCount_);
+    for (int i = 0; i < stateCount_; ++i) {
+        const TransitionVector& vec = transitions_[i];
+        table.insert(table.end(), vec.begin(), vec.end());
+    }
+    stream.write(
+        reinterpret_cast<const char*>(&table[0]),
+        table.size() * sizeof(int32_t));
+}
+
+/**
+ * Replaces the states and the state transitions with the ones read from
+ * a stream written by writeTransitions().
+ *
+ * The automaton must have the same transition types as the one that was
+ * written. Only automata with all transitions resolved can be read, as
+ * the information needed for resolving the missing ones is not stored.
+ *
+ * @param stream The stream to read from.
+ * @return True if the transitions were read, false if the stream did not
+ * contain a valid table for this automaton, in which case the automaton
+ * is left unchanged.
+ */
+bool
+FiniteStateAutomaton::readTransitions(std::istream& stream) {
+
+    int32_t counts[2];
+    if (!stream.read(reinterpret_cast<char*>(counts), sizeof(counts)) ||
+        counts[0] < 1 || counts[1] != transitionTypeCount_) {
+        return false;
+    }
+    const int stateCount = counts[0];
+    std::vector<int32_t> row(transitionTypeCount_);
+    TransitionMap transitions;
+    transitions.reserve(stateCount);
+    for (int i = 0; i < stateCount; ++i) {
+        if (transitionTypeCount_ > 0 &&
+            !stream.read(
+                reinterpret_cast<char*>(&row[0]),
+                row.size() * sizeof(int32_t))) {
+            return false;
+        }
+        for (int t = 0; t < transitionTypeCount_; ++t) {
+            if (row[t] < ILLEGAL_STATE || row[t] >= stateCount) {
+                return false;
+            }
+        }
+        transitions.push_back(TransitionVector(row.begin(), row.end()));
+    }
+    transitions_.swap(transitions);
+    stateCount_ = stateCount;
+    return true;
+}
@@ -34,6 +34,7 @@
 #define TTA_FINITE_STATE_AUTOMATON_HH
 
 #include <string>
+#include <iosfwd>
 #include <set>
 #include <map>
 #include <vector>
@@ -100,6 +101,10 @@ public:
 
     virtual FSAStateIndex startState() const;
 
+    int stateCount() const;
+
+    void writeTransitions(std::ostream& stream) const;
+    bool readTransitions(std::istream& stream);
 
 protected:
 
@@ -58,11 +58,6 @@ bool GhdlSimulator::compile(std::vector<std::string>& errors) {
         errors.push_back("Couldn't create work dir");
         return false;
     }
-    string baseDir = tbDirectory();
-    if (!FileSystem::changeWorkingDir(baseDir)) {
-        errors.push_back("Couldn't change directory to " + baseDir);
-        return false;
-    }
     for (int i = 0; i < hdlFileCount(); i++) {
         if (!importFile(file(i), errors)) {
             return false;
@@ -79,14 +74,10 @@ bool GhdlSimulator::compile(std::vector<std::string>& errors) {
 
 bool GhdlSimulator::simulate(std::vector<std::string>& errors) {
     errors.clear();
-    string baseDir = tbDirectory();
-    if (!FileSystem::changeWorkingDir(baseDir)) {
-        errors.push_back("Couldn't change directory to " + baseDir);
-        return false;
-    }
 
     string command;
-    if (FileSystem::fileExists("testbench")) {
+    if (FileSystem::fileExists(
+            tbDirectory() + FileSystem::DIRECTORY_SEPARATOR + "testbench")) {
         command = "./testbench 2>&1";
     } else {
         // In the latest GHDL no executable is produces, thus the simulation
@@ -94,8 +85,9 @@ bool GhdlSimulator::simulate(std::vector<std::string>& errors) {
         command = string("ghdl -r --std=08 --ieee=synopsys --workdir=") + workDir()
             + " testbench  2>&1";
     }
+    command = inTbDirectory(command);
     if (verbose()) {
-        std::cout << command << std::endl;
+        outputStream() << command << std::endl;
     }
     vector<string> messages;
     int rv = Application::runShellCommandAndGetOutput(command, messages);
@@ -107,22 +99,22 @@ bool GhdlSimulator::simulate(std::vector<std::string>& errors) {
 bool 
 GhdlSimulator::importFile(
     std::string file, std::vector<std::string>& errors) {
-    string command = "ghdl  -i --std=08 --ieee=synopsys --workdir=" 
-        + workDir() + " " + file + " 2>&1";
+    string command = inTbDirectory(
+        "ghdl  -i --std=08 --ieee=synopsys --workdir=" 
+        + workDir() + " " + file + " 2>&1");
     if (verbose()) {
-        // TODO: get output stream
-        std::cout << command << std::endl;
+        outputStream() << command << std::endl;
     }
     int rv = Application::runShellCommandAndGetOutput(command, errors);
     return rv == 0;
 }
 
 bool GhdlSimulator::compileDesign(std::vector<std::string>& errors) {
-    string command = "ghdl  -m -Wno-hide --std=08 --ieee=synopsys --workdir=" 
-        + workDir() + " testbench 2>&1";
+    string command = inTbDirectory(
+        "ghdl  -m -Wno-hide --std=08 --ieee=synopsys --workdir=" 
+        + workDir() + " testbench 2>&1");
     if (verbose()) {
-        // TODO: get output stream
-        std::cout << command << std::endl;
+        outputStream() << command << std::endl;
     }
     int rv = Application::runShellCommandAndGetOutput(command, errors);
     return rv == 0;
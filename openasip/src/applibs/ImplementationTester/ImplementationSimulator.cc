@@ -45,11 +45,10 @@ ImplementationSimulator::ImplementationSimulator(
     bool verbose,
     bool leaveDirty): 
     tbFile_(tbFile),
-    hdlFiles_(hdlFiles), baseDir_(""), workDir_(""), oldCwd_(""),
-    verbose_(verbose), leaveDirty_(leaveDirty) {
+    hdlFiles_(hdlFiles), baseDir_(""), workDir_(""),
+    verbose_(verbose), outputStream_(&std::cout), leaveDirty_(leaveDirty) {
 
     baseDir_ = FileSystem::directoryOfPath(tbFile);
-    oldCwd_ = FileSystem::currentWorkingDir();
 }
 
 ImplementationSimulator::~ImplementationSimulator() {
@@ -58,9 +57,6 @@ ImplementationSimulator::~ImplementationSimulator() {
             FileSystem::removeFileOrDirectory(workDir_);
         }
     }
-    if (!oldCwd_.empty()) {
-        FileSystem::changeWorkingDir(oldCwd_);
-    }
 }
 
 std::string ImplementationSimulator::createWorkDir() {
@@ -88,6 +84,21 @@ std::string ImplementationSimulator::tbFile() const {
     return tbFile_;
 }
 
+/**
+ * Returns the given shell command prefixed to run in the testbench
+ * directory.
+ *
+ * The process working directory is not changed, so simulators of
+ * different testbenches can run concurrently.
+ *
+ * @param command The shell command.
+ * @return The command run in the testbench directory.
+ */
+std::string
+ImplementationSimulator::inTbDirectory(const std::string& command) const {
+    return "cd \"" + baseDir_ + "\" && " + command;
+}
+
 int ImplementationSimulator::hdlFileCount() const {
     return hdlFiles_.size();
 }
@@ -100,6 +111,22 @@ bool ImplementationSimulator::verbose() {
     return verbose_;
 }
 
+/**
+ * Sets the stream the verbose output is written to.
+ *
+ * The default is std::cout.
+ *
+ * @param stream The output stream.
+ */
+void
+ImplementationSimulator::setOutputStream(std::ostream& stream) {
+    outputStream_ = &stream;
+}
+
+std::ostream& ImplementationSimulator::outputStream() {
+    return *outputStream_;
+}
+
 void 
 ImplementationSimulator::parseErrorMessages(
     std::vector<std::string>& inputMsg, std::vector<std::string>& errors) {
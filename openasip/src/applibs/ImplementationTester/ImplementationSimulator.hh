@@ -33,6 +33,7 @@
 #ifndef TTA_IMPLEMENTATION_SIMULATOR_HH
 #define TTA_IMPLEMENTATION_SIMULATOR_HH
 
+#include <iostream>
 #include <string>
 #include <vector>
 
@@ -50,6 +51,8 @@ public:
     
     virtual bool simulate(std::vector<std::string>& errors) = 0;
 
+    void setOutputStream(std::ostream& stream);
+
 protected:
     virtual std::string createWorkDir();
 
@@ -61,12 +64,16 @@ protected:
 
     std::string tbFile() const;
 
+    std::string inTbDirectory(const std::string& command) const;
+
     int hdlFileCount() const;
 
     std::string file(int index) const;
 
     bool verbose();
 
+    std::ostream& outputStream();
+
     void 
     parseErrorMessages(
         std::vector<std::string>& inputMsg, std::vector<std::string>& errors);
@@ -82,10 +89,10 @@ private:
     std::string baseDir_;
     /// Working directory where testbench is compiled and simulated
     std::string workDir_;
-    /// Old current working directory (before changing to workDir_)
-    std::string oldCwd_;
     /// Enable verbose output
     bool verbose_;
+    /// Stream of the verbose output
+    std::ostream* outputStream_;
     /// Don't delete work dir
     bool leaveDirty_;
 };
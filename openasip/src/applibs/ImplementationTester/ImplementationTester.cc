@@ -39,6 +39,9 @@
 #include <fstream>
 #include <vector>
 #include <map>
+#include <thread>
+#include <atomic>
+#include <exception>
 #include <stdint.h>
 
 #include "ImplementationTester.hh"
@@ -263,6 +266,201 @@ bool
 ImplementationTester::validateFU(
     const int entryID, std::vector<std::string>& errors) {
 
+    string tbName;
+    vector<string> hdlFiles;
+    if (!prepareFU(entryID, tbName, hdlFiles, errors)) {
+        return false;
+    }
+    bool success = simulateTestbench(tbName, hdlFiles, errors, std::cout);
+    removeTestbench(tbName);
+    return success;
+}
+
+
+/**
+ * Validates that RF behaviour model and implementation are equal
+ *
+ * @param entryID Entry ID of the RF
+ * @param errors Error messages from the validation process
+ * @return True if there were no errors
+ */
+bool 
+ImplementationTester::validateRF(
+    const int entryID, std::vector<std::string>& errors) {
+
+    string tbName;
+    vector<string> hdlFiles;
+    if (!prepareRF(entryID, tbName, hdlFiles, errors)) {
+        return false;
+    }
+    bool success = simulateTestbench(tbName, hdlFiles, errors, std::cout);
+    removeTestbench(tbName);
+    return success;
+}
+
+
+/**
+ * Validates the given FU and RF entries running several simulations
+ * concurrently.
+ *
+ * The testbenches are generated one at a time as the HDB and the
+ * behavior models used by the generators are not safe to share between
+ * threads. Each testbench is generated into a directory of its own, in
+ * which its simulator compiles and runs it, so up to the given number of
+ * HDL simulators run at the same time.
+ *
+ * @param fuIDs Entry IDs of the FUs to validate.
+ * @param rfIDs Entry IDs of the RFs to validate.
+ * @param jobs Maximum number of concurrent simulations, 0 for one per
+ *             hardware thread.
+ * @param results Results of the entries, FUs first, in ID order.
+ * @return True if none of the tested entries failed.
+ */
+bool
+ImplementationTester::validateEntries(
+    const std::set<int>& fuIDs, const std::set<int>& rfIDs,
+    unsigned int jobs, std::vector<EntryResult>& results) {
+
+    results.clear();
+    for (std::set<int>::const_iterator i = fuIDs.begin(); 
+         i != fuIDs.end(); i++) {
+        EntryResult result = {true, *i, false, false, "", vector<string>()};
+        results.push_back(result);
+    }
+    for (std::set<int>::const_iterator i = rfIDs.begin(); 
+         i != rfIDs.end(); i++) {
+        EntryResult result = {false, *i, false, false, "", vector<string>()};
+        results.push_back(result);
+    }
+
+    // the results whose testbenches are simulated, and their inputs
+    vector<size_t> simulated;
+    vector<string> tbNames;
+    vector<vector<string> > hdlFileLists;
+    for (size_t i = 0; i < results.size(); i++) {
+        EntryResult& result = results.at(i);
+        bool canTest = result.isFU ?
+            canTestFU(result.entryID, result.reason) :
+            canTestRF(result.entryID, result.reason);
+        if (!canTest) {
+            continue;
+        }
+        result.tested = true;
+        string tbName;
+        vector<string> hdlFiles;
+        bool prepared = false;
+        try {
+            prepared = result.isFU ?
+                prepareFU(result.entryID, tbName, hdlFiles, result.errors) :
+                prepareRF(result.entryID, tbName, hdlFiles, result.errors);
+        } catch (const Exception& e) {
+            result.errors.push_back(
+                "Runtime error: " + e.errorMessage() + "\n");
+        }
+        if (prepared) {
+            simulated.push_back(i);
+            tbNames.push_back(tbName);
+            hdlFileLists.push_back(hdlFiles);
+        }
+    }
+
+    if (jobs == 0) {
+        jobs = std::thread::hardware_concurrency();
+    }
+    if (jobs > simulated.size()) {
+        jobs = simulated.size();
+    }
+    if (jobs == 0) {
+        jobs = 1;
+    }
+
+    // the verbose output of each simulation is printed after all of them
+    // are done so the outputs of different entries are not interleaved
+    vector<std::ostringstream> outputs(simulated.size());
+    std::atomic<size_t> nextJob(0);
+    auto simulateJobs = [&]() {
+        for (size_t job = nextJob++; job < simulated.size(); 
+             job = nextJob++) {
+            EntryResult& result = results.at(simulated.at(job));
+            try {
+                result.success = simulateTestbench(
+                    tbNames.at(job), hdlFileLists.at(job), result.errors,
+                    outputs.at(job));
+            } catch (const Exception& e) {
+                result.errors.push_back(
+                    "Runtime error: " + e.errorMessage() + "\n");
+            } catch (const std::exception& e) {
+                result.errors.push_back(
+                    string("Runtime error: ") + e.what() + "\n");
+            }
+        }
+    };
+    vector<std::thread> threads;
+    for (unsigned int i = 1; i < jobs; i++) {
+        threads.push_back(std::thread(simulateJobs));
+    }
+    simulateJobs();
+    for (size_t i = 0; i < threads.size(); i++) {
+        threads.at(i).join();
+    }
+    for (size_t i = 0; i < outputs.size(); i++) {
+        std::cout << outputs.at(i).str();
+    }
+    std::cout << std::flush;
+
+    for (size_t i = 0; i < tbNames.size(); i++) {
+        removeTestbench(tbNames.at(i));
+    }
+
+    bool noFailures = true;
+    for (size_t i = 0; i < results.size(); i++) {
+        EntryResult& result = results.at(i);
+        if (result.tested && !result.errors.empty()) {
+            result.success = false;
+        }
+        if (result.tested && !result.success) {
+            noFailures = false;
+        }
+    }
+    return noFailures;
+}
+
+
+/**
+ * Creates the simulator that compiles and simulates a testbench.
+ *
+ * @param testbench Name of the testbench file.
+ * @param hdlFiles The HDL files of the tested implementation.
+ * @return The simulator, owned by the caller.
+ */
+ImplementationSimulator*
+ImplementationTester::createSimulator(
+    const std::string& testbench,
+    const std::vector<std::string>& hdlFiles) const {
+
+    if (simulator_ == SIM_MODELSIM) {
+        return new ModelsimSimulator(
+            testbench, hdlFiles, verbose_, leaveDirty_);
+    }
+    return new GhdlSimulator(testbench, hdlFiles, verbose_, leaveDirty_);
+}
+
+
+/**
+ * Generates the testbench of an FU entry.
+ *
+ * @param entryID Entry ID of the FU
+ * @param tbName Name of the generated testbench file
+ * @param hdlFiles The HDL files of the FU implementation
+ * @param errors Error messages from the generation
+ * @return True if the testbench was generated
+ */
+bool
+ImplementationTester::prepareFU(
+    const int entryID, std::string& tbName,
+    std::vector<std::string>& hdlFiles,
+    std::vector<std::string>& errors) {
+
     if (tempDir_.empty()) {
         if (!createTempDir()) {
             IOException exp(__FILE__, __LINE__, "ImplementationTester",
@@ -292,34 +490,30 @@ ImplementationTester::validateFU(
     }
     
     FUTestbenchGenerator tbGen(fuEntry);
-    
-    ofstream fileStream;
-    string tbName = fuTbName(entryID);
+    tbName = fuTbName(entryID);
 
     createTestbench(&tbGen, tbName);
-
-    bool success = 
-        simulateTestbench(tbName, &fuEntry->implementation(), errors);
-    
-    if (!leaveDirty_) {
-        FileSystem::removeFileOrDirectory(tbName);
-    }
+    createListOfSimulationFiles(&fuEntry->implementation(), hdlFiles);
 
     delete fuEntry;
-    return success;
+    return true;
 }
 
 
 /**
- * Validates that RF behaviour model and implementation are equal
+ * Generates the testbench of an RF entry.
  *
  * @param entryID Entry ID of the RF
- * @param errors Error messages from the validation process
- * @return True if there were no errors
+ * @param tbName Name of the generated testbench file
+ * @param hdlFiles The HDL files of the RF implementation
+ * @param errors Error messages from the generation
+ * @return True if the testbench was generated
  */
-bool 
-ImplementationTester::validateRF(
-    const int entryID, std::vector<std::string>& errors) {
+bool
+ImplementationTester::prepareRF(
+    const int entryID, std::string& tbName,
+    std::vector<std::string>& hdlFiles,
+    std::vector<std::string>& errors) {
 
     if (tempDir_.empty()) {
         if (!createTempDir()) {
@@ -350,18 +544,28 @@ ImplementationTester::validateRF(
     }
 
     RFTestbenchGenerator tbGen(rfEntry);
-    string tbName = rfTbName(entryID);
+    tbName = rfTbName(entryID);
 
     createTestbench(&tbGen, tbName);
+    createListOfSimulationFiles(&rfEntry->implementation(), hdlFiles);
+
+    delete rfEntry;
+    return true;
+}
+
+
+/**
+ * Removes the directory of a testbench unless files are to be left.
+ *
+ * @param tbName Name of the testbench file
+ */
+void
+ImplementationTester::removeTestbench(const std::string& tbName) const {
 
-    bool success = 
-        simulateTestbench(tbName, &rfEntry->implementation(), errors);
-    
     if (!leaveDirty_) {
-        FileSystem::removeFileOrDirectory(tbName);
+        FileSystem::removeFileOrDirectory(
+            FileSystem::directoryOfPath(tbName));
     }
-    delete rfEntry;
-    return success;
 }
 
 
@@ -460,6 +664,8 @@ ImplementationTester::createTempDir() {
 /**
  * Creates name for the testbench file
  *
+ * Each testbench has a directory of its own for the simulator files.
+ *
  * @param id ID number of the FU
  * @return testbench name
  */
@@ -468,6 +674,7 @@ ImplementationTester::fuTbName(int id) const {
 
     std::ostringstream name;
     name << tempDir_ << FileSystem::DIRECTORY_SEPARATOR
+         << "fu_" << id << FileSystem::DIRECTORY_SEPARATOR
          << "tb_fu_" << id << ".vhdl";
     return name.str();
 }
@@ -475,6 +682,8 @@ ImplementationTester::fuTbName(int id) const {
 /**
  * Creates name for the testbench file
  *
+ * Each testbench has a directory of its own for the simulator files.
+ *
  * @param id ID number of the RF
  * @return testbench name
  */
@@ -483,6 +692,7 @@ ImplementationTester::rfTbName(int id) const {
 
     std::ostringstream name;
     name << tempDir_ << FileSystem::DIRECTORY_SEPARATOR
+         << "rf_" << id << FileSystem::DIRECTORY_SEPARATOR
          << "tb_rf_" << id << ".vhdl";
     return name.str();
 }
@@ -528,26 +738,20 @@ ImplementationTester::createListOfSimulationFiles(
  * Compiles and simulates the testbech
  *
  * @param testbench Name of the testbench file
- * @param implementation Implementation of the FU/RF
+ * @param hdlFiles The HDL files of the FU/RF implementation
  * @param errors Error messages from the compilation/simulation
+ * @param output Stream of the verbose output of the simulator
  * @return True if compilation and simulation were successfull
  */
 bool 
 ImplementationTester::simulateTestbench(
     std::string testbench,
-    const HDB::HWBlockImplementation* implementation,
-    std::vector<std::string>& errors) const {
+    const std::vector<std::string>& hdlFiles,
+    std::vector<std::string>& errors,
+    std::ostream& output) const {
 
-    vector<string> hdlFiles;
-    createListOfSimulationFiles(implementation, hdlFiles);
-
-    ImplementationSimulator* sim = NULL;
-    if (simulator_ == SIM_GHDL) {
-        sim = new GhdlSimulator(testbench, hdlFiles, verbose_, leaveDirty_);
-    } else if (simulator_ == SIM_MODELSIM) {
-        sim = new ModelsimSimulator(
-            testbench, hdlFiles, verbose_, leaveDirty_);
-    }
+    ImplementationSimulator* sim = createSimulator(testbench, hdlFiles);
+    sim->setOutputStream(output);
 
     if (!sim->compile(errors)) {
         delete sim;
@@ -566,6 +770,13 @@ void
 ImplementationTester::createTestbench(
     TestbenchGenerator* tbGen, std::string tbName) const {
     
+    string tbDir = FileSystem::directoryOfPath(tbName);
+    if (!FileSystem::fileExists(tbDir) && 
+        !FileSystem::createDirectory(tbDir)) {
+        throw IOException(
+            __FILE__, __LINE__, "ImplementationTester",
+            "Couldn't create directory " + tbDir);
+    }
     ofstream fileStream;
     openTbFile(fileStream, tbName);
     tbGen->generateTestbench(fileStream);
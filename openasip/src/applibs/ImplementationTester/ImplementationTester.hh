@@ -34,6 +34,7 @@
 #ifndef TTA_IMPLEMENTATION_TESTER_HH
 #define TTA_IMPLEMENTATION_TESTER_HH
 
+#include <iosfwd>
 #include <string>
 #include <vector>
 #include <set>
@@ -49,8 +50,26 @@ enum VhdlSim {
     SIM_MODELSIM
 };
 
+class ImplementationSimulator;
+
 class ImplementationTester {
 public:
+    /// Outcome of validating one HDB entry.
+    struct EntryResult {
+        /// True for an FU entry, false for an RF entry.
+        bool isFU;
+        /// Entry ID in the HDB.
+        int entryID;
+        /// False if the entry cannot be tested.
+        bool tested;
+        /// True if the entry was tested without errors.
+        bool success;
+        /// Reason why the entry cannot be tested.
+        std::string reason;
+        /// Error messages from the validation.
+        std::vector<std::string> errors;
+    };
+
     ImplementationTester();
 
     ImplementationTester(std::string hdbFile, VhdlSim simulator);
@@ -73,12 +92,34 @@ public:
 
     bool validateRF(const int entryID, std::vector<std::string>& errors);
 
+    bool validateEntries(
+        const std::set<int>& fuIDs, const std::set<int>& rfIDs,
+        unsigned int jobs, std::vector<EntryResult>& results);
+
     std::set<int> fuEntryIDs() const;
 
     std::set<int> rfEntryIDs() const;
 
+protected:
+
+    virtual ImplementationSimulator* createSimulator(
+        const std::string& testbench,
+        const std::vector<std::string>& hdlFiles) const;
+
 private:
 
+    bool prepareFU(
+        const int entryID, std::string& tbName,
+        std::vector<std::string>& hdlFiles,
+        std::vector<std::string>& errors);
+
+    bool prepareRF(
+        const int entryID, std::string& tbName,
+        std::vector<std::string>& hdlFiles,
+        std::vector<std::string>& errors);
+
+    void removeTestbench(const std::string& tbName) const;
+
     bool fuHasMemoryAccess(HDB::FUEntry* fuEntry) const;
 
     bool fuFullyPipelined(HDB::FUEntry* fuEntry) const;
@@ -110,8 +151,9 @@ private:
     bool 
     simulateTestbench(
         std::string testbench, 
-        const HDB::HWBlockImplementation* implementation,
-        std::vector<std::string>& errors) const;
+        const std::vector<std::string>& hdlFiles,
+        std::vector<std::string>& errors,
+        std::ostream& output) const;
 
     std::string hdbFile_;
     HDB::HDBManager* hdb_;
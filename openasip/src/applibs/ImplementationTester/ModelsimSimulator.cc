@@ -60,11 +60,6 @@ bool ModelsimSimulator::compile(vector<string>& errors) {
                          "executables in PATH?");
         return false;
     }
-    string baseDir = tbDirectory();
-    if (!FileSystem::changeWorkingDir(baseDir)) {
-        errors.push_back("Couldn't change directory to " + baseDir);
-        return false;
-    }
     for (int i = 0; i < hdlFileCount(); i++) {
         if (!compileOneFile(file(i), errors)) {
             return false;
@@ -84,9 +79,10 @@ bool ModelsimSimulator::simulate(vector<string>& errors) {
     // get correct simulation time from somewhere?
     // There's practically no difference between 30 ns and 300 ns simulation
     // time
-    string simulate = "vsim -c -do \"run 300ns;quit\" work.testbench 2>&1";
+    string simulate = inTbDirectory(
+        "vsim -c -do \"run 300ns;quit\" work.testbench 2>&1");
     if (verbose()) {
-        std::cout << simulate << std::endl;
+        outputStream() << simulate << std::endl;
     }
     vector<string> messages;
     int rv = Application::runShellCommandAndGetOutput(simulate, messages);
@@ -99,26 +95,28 @@ std::string ModelsimSimulator::createWorkDir() {
     string work = tbDirectory() + FileSystem::DIRECTORY_SEPARATOR + "work";
     string createLib = "vlib " + work + " 2>&1";
     if (verbose()) {
-        std::cout << createLib << std::endl;
+        outputStream() << createLib << std::endl;
     }
     vector<string> messages;
     int rv = Application::runShellCommandAndGetOutput(createLib, messages);
     if (rv != 0) {
         if (verbose()) {
             for (unsigned int i = 0; i < messages.size(); i++) {
-                std::cout << messages.at(i) << std::endl;
+                outputStream() << messages.at(i) << std::endl;
             }
         }
         string failed = "";
         return failed;
     }
-    string mapWorkDir = "vmap work " + work + " 2>&1";
+    // the library mapping is written to modelsim.ini of the testbench
+    // directory
+    string mapWorkDir = inTbDirectory("vmap work " + work + " 2>&1");
     messages.clear();
     int rv2 = Application::runShellCommandAndGetOutput(mapWorkDir, messages);
     if (rv2 != 0) {
         if (verbose()) {
             for (unsigned int i = 0; i < messages.size(); i++) {
-                std::cout << messages.at(i) << std::endl;
+                outputStream() << messages.at(i) << std::endl;
             }
         }
         string failed = "";
@@ -130,9 +128,9 @@ std::string ModelsimSimulator::createWorkDir() {
 
 bool
 ModelsimSimulator::compileOneFile(string file, vector<string>& errors) {
-    string command = "vcom " + file + " 2>&1";
+    string command = inTbDirectory("vcom " + file + " 2>&1");
     if (verbose()) {
-        std::cout << command << std::endl;
+        outputStream() << command << std::endl;
     }
     int rv = Application::runShellCommandAndGetOutput(command, errors);
     return rv == 0;
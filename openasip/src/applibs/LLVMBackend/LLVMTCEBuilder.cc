@@ -2776,8 +2776,8 @@ LLVMTCEBuilder::emitSPInitialization(TTAProgram::CodeSnippet& target) {
     if (target.instructionCount() > 0) {
         TTAProgram::Instruction& first = target.firstInstruction(); 
         target.insertBefore(first, spInit);
-        if (prog_->instructionReferenceManager().hasReference(first)) {
-            prog_->instructionReferenceManager().replace(
+        if (codeReferenceManager().hasReference(first)) {
+            codeReferenceManager().replace(
                 first, spInit->firstInstruction());
         }
     } else {
@@ -2785,6 +2785,15 @@ LLVMTCEBuilder::emitSPInitialization(TTAProgram::CodeSnippet& target) {
     }
 }
 
+/**
+ * Returns the manager of the instruction references into the code of the
+ * function being built.
+ */
+TTAProgram::InstructionReferenceManager&
+LLVMTCEBuilder::codeReferenceManager() {
+    return prog_->instructionReferenceManager();
+}
+
 /**
  * Handles INLINEASM nodes that hold real inline assembly code.
  *
@@ -3463,8 +3472,7 @@ LLVMTCEBuilder::emitSetjmp(
             TTAMachine::NullInstructionTemplate::instance());
 
     TTAProgram::InstructionReference returnReference =
-        prog_->instructionReferenceManager().createReference(
-            *returnInstruction);
+        codeReferenceManager().createReference(*returnInstruction);
 
     codeGenerator.pushInstructionReferenceToStack(*proc, sp, returnReference);
 
@@ -228,6 +228,9 @@ namespace llvm {
 
         void emitSPInitialization(TTAProgram::CodeSnippet& target);
 
+        virtual TTAProgram::InstructionReferenceManager&
+        codeReferenceManager();
+
         void clearFunctionBookkeeping() {
             labeledPOs_.clear();
             symbolicPORefs_.clear();            
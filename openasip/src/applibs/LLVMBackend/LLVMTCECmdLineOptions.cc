@@ -92,6 +92,9 @@ const std::string LLVMTCECmdLineOptions::SWL_DISABLE_HWLOOPS =
 
 const std::string LLVMTCECmdLineOptions::SWL_ASSUME_ADF_STACKALIGNMENT =
     "assume-adf-stackalignment";
+
+const std::string LLVMTCECmdLineOptions::SWL_SCHEDULER_THREADS =
+    "scheduler-threads";
 /**
  * Constructor.
  */
@@ -234,6 +237,12 @@ LLVMTCECmdLineOptions::LLVMTCECmdLineOptions() {
 	new BoolCmdLineOptionParser(
             SWL_ASSUME_ADF_STACKALIGNMENT,
             "Assume size of stackalignment based on biggest memory operations in the adf."));
+
+    addOption(
+        new IntegerCmdLineOptionParser(
+            SWL_SCHEDULER_THREADS,
+            "Number of threads used for scheduling the functions of the "
+            "program. 0 uses one thread per hardware thread. Default is 1."));
 }
 
 /**
@@ -511,3 +520,16 @@ bool
 LLVMTCECmdLineOptions::assumeADFStackAlignment() const {
     return findOption(SWL_ASSUME_ADF_STACKALIGNMENT)->isDefined();
 }
+
+/**
+ * Returns the number of threads to schedule the functions with.
+ *
+ * @return The number of threads, 0 for one per hardware thread.
+ */
+int
+LLVMTCECmdLineOptions::schedulerThreads() const {
+    if (!findOption(SWL_SCHEDULER_THREADS)->isDefined()) {
+        return 1;
+    }
+    return findOption(SWL_SCHEDULER_THREADS)->integer();
+}
@@ -106,6 +106,7 @@ public:
     bool disableAddressSpaceAA() const;
     bool disableHWLoops() const;
     bool assumeADFStackAlignment() const;
+    int schedulerThreads() const;
 
     virtual void printVersion() const {
         std::cout
@@ -150,6 +151,7 @@ private:
     static const std::string SWL_GEN_PLUGIN_ONLY;
     static const std::string SWL_DISABLE_HWLOOPS;
     static const std::string SWL_ASSUME_ADF_STACKALIGNMENT;
+    static const std::string SWL_SCHEDULER_THREADS;
 };
 
 #endif
@@ -73,6 +73,10 @@ IGNORE_COMPILER_WARNING("-Wunused-parameter")
 #include "AbsoluteToRelativeJumps.hh"
 
 #include <stdlib.h>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
 #include <llvm/ADT/SmallString.h>
 #include <llvm/MC/MCContext.h>
 #include <llvm/MC/MCSymbol.h>
@@ -107,7 +111,8 @@ LLVMTCEIRBuilder::LLVMTCEIRBuilder(
     LLVMTCEBuilder(tm, mach, ID, functionAtATime), ipData_(&ipd), 
     ddgBuilder_(ipd), AA_(AA), modifyMF_(modifyMF),
     scheduler_(NULL), dsf_(NULL),
-    bypasser_(NULL), loopFinder_(NULL) {
+    bypasser_(NULL), loopFinder_(NULL), schedulingThreads_(1),
+    functionIRM_(NULL) {
     RegisterCopyAdder::findTempRegisters(*mach, ipd);
 
     if (functionAtATime_) {
@@ -125,6 +130,13 @@ LLVMTCEIRBuilder::LLVMTCEIRBuilder(
 
     } 
     delaySlotFilling_ = !options_->disableDelaySlotFiller();
+
+    int threads = options_->schedulerThreads();
+    if (threads == 0) {
+        schedulingThreads_ = std::max(1u, std::thread::hardware_concurrency());
+    } else if (threads > 1) {
+        schedulingThreads_ = threads;
+    }
 }
 
 void
@@ -168,12 +180,15 @@ LLVMTCEIRBuilder::writeMachineFunction(MachineFunction& mf) {
         prog_->addProcedure(procedure);
     } 
     
+    // the functions scheduled later keep their references in a
+    // manager of their own until they are stitched into the program.
     TTAProgram::InstructionReferenceManager* irm = NULL;
-    if (functionAtATime_) {
+    if (functionAtATime_ || deferScheduling()) {
         irm = new TTAProgram::InstructionReferenceManager();
     } else {        
         irm = &prog_->instructionReferenceManager();
     }
+    functionIRM_ = irm;
 
     ControlFlowGraph* cfg = buildTCECFG(mf);
     cfg->setInstructionReferenceManager(*irm);
@@ -190,9 +205,12 @@ LLVMTCEIRBuilder::writeMachineFunction(MachineFunction& mf) {
         ctj.handleControlFlowGraph(*cfg, *mach_);
     }
 
+    PendingFunction pending = {procedure, cfg, NULL, irm};
     if (fastCompilation || !isHotFunction(mf)) {
         verboseLog(TCEString("###      compiling (fast): ") + fnName);
-        EXIT_IF_THROWS(compileFast(*cfg));
+        if (!deferScheduling()) {
+            EXIT_IF_THROWS(compileFast(*cfg));
+        }
     } else {
         verboseLog(TCEString("### compiling (optimized): ") + fnName);
         AliasAnalysis* AA = NULL;
@@ -210,40 +228,165 @@ LLVMTCEIRBuilder::writeMachineFunction(MachineFunction& mf) {
             // got them for us and passed through.        
             AA = AA_;
         }
-        EXIT_IF_THROWS(compileOptimized(*cfg, AA));
+        if (deferScheduling()) {
+            // the LLVM alias analysis is only available during the
+            // pass, so the DDG is built now.
+            EXIT_IF_THROWS(pending.ddg = prepareOptimized(*cfg, AA));
+        } else {
+            EXIT_IF_THROWS(compileOptimized(*cfg, AA));
+        }
     }
+    functionIRM_ = NULL;
 
-    if (!modifyMF_) {
-        cfg->convertBBRefsToInstRefs();
+    if (Application::verboseLevel() > 0 && spillMoveCount_ > 0) {
+        Application::logStream() 
+            << "spill moves in " << 
+            (std::string)(mf.getFunction().getName()) << ": "
+            << spillMoveCount_ << std::endl;
     }
-    cfg->copyToProcedure(*procedure, irm);
-#ifdef WRITE_CFG_DOTS
-    cfg->writeToDotFile(fnName + "_cfg4.dot");
-#endif
-    if (procedure->instructionCount() > 0) {
-        codeLabels_[fnName] = &procedure->firstInstruction();
+
+    if (deferScheduling()) {
+        pendingFunctions_.push_back(pending);
+        return false;
     }
 
     if (modifyMF_) {
+        cfg->copyToProcedure(*procedure, irm);
+        if (procedure->instructionCount() > 0) {
+            codeLabels_[fnName] = &procedure->firstInstruction();
+        }
         cfg->copyToLLVMMachineFunction(mf, irm); 
         fixJumpTableDestinations(mf, *cfg);               
         delete cfg;
         return true;
     }
 
+    finishProcedure(*procedure, *cfg, *irm);
+    delete cfg;
+    if (functionAtATime_) delete irm;
+    return false;
+}
+
+/**
+ * Tells whether the functions are scheduled only after the whole module
+ * has been built, on multiple threads.
+ *
+ * The function at a time modes schedule each function as they come.
+ */
+bool
+LLVMTCEIRBuilder::deferScheduling() const {
+    return schedulingThreads_ > 1 && !functionAtATime_ && !modifyMF_;
+}
+
+/**
+ * Copies a scheduled function into its procedure in the program.
+ *
+ * @param procedure The procedure of the function in the program.
+ * @param cfg The scheduled function.
+ * @param irm The manager of the references into the function.
+ */
+void
+LLVMTCEIRBuilder::finishProcedure(
+    TTAProgram::Procedure& procedure, ControlFlowGraph& cfg,
+    TTAProgram::InstructionReferenceManager& irm) {
+
+    cfg.convertBBRefsToInstRefs();
+    cfg.copyToProcedure(procedure, &irm);
+#ifdef WRITE_CFG_DOTS
+    cfg.writeToDotFile(procedure.name() + "_cfg4.dot");
+#endif
+    if (deferScheduling()) {
+        irm.moveReferencesTo(prog_->instructionReferenceManager());
+    }
+    if (procedure.instructionCount() > 0) {
+        codeLabels_[procedure.name()] = &procedure.firstInstruction();
+    }
+
     AbsoluteToRelativeJumps jumpConv(*ipData_);
-    jumpConv.handleProcedure(*procedure, *mach_);
+    jumpConv.handleProcedure(procedure, *mach_);
+}
 
-    if (Application::verboseLevel() > 0 && spillMoveCount_ > 0) {
-        Application::logStream() 
-            << "spill moves in " << 
-            (std::string)(mf.getFunction().getName()) << ": "
-            << spillMoveCount_ << std::endl;
+/**
+ * Schedules the functions whose scheduling was postponed.
+ *
+ * The functions are scheduled on a number of threads, each of which has
+ * its own scheduler and delay slot filler. The scheduled functions are
+ * then copied into their procedures in the order of the module, so the
+ * resulting program does not depend on the order the threads finish in.
+ *
+ * An exception thrown while scheduling a function is passed from the
+ * worker thread to the calling thread. The pending functions are then
+ * discarded and the exception of the first failed function in module
+ * order is rethrown.
+ */
+void
+LLVMTCEIRBuilder::schedulePendingFunctions() {
+
+    if (pendingFunctions_.empty()) {
+        return;
     }
 
-    delete cfg;
-    if (functionAtATime_) delete irm;
-    return false;
+    // exceptions thrown by the workers, rethrown by the calling thread
+    std::vector<std::exception_ptr> errors(pendingFunctions_.size());
+    std::atomic<bool> failed(false);
+    std::atomic<size_t> nextFunction(0);
+    auto schedule = [this, &nextFunction, &errors, &failed]() {
+        CycleLookBackSoftwareBypasser bypasser;
+        CopyingDelaySlotFiller delaySlotFiller;
+        CopyingDelaySlotFiller* dsf =
+            delaySlotFilling_ ? &delaySlotFiller : NULL;
+        BBSchedulerController scheduler(*mach_, *ipData_, &bypasser, dsf);
+
+        for (size_t i = nextFunction++;
+             i < pendingFunctions_.size() && !failed; i = nextFunction++) {
+            PendingFunction& function = pendingFunctions_[i];
+            try {
+                if (function.ddg == NULL) {
+                    compileFast(*function.cfg);
+                } else {
+                    scheduleOptimized(
+                        *function.cfg, *function.ddg, scheduler, dsf);
+                    delete function.ddg;
+                    function.ddg = NULL;
+                }
+            } catch (...) {
+                errors[i] = std::current_exception();
+                failed = true;
+            }
+        }
+    };
+
+    unsigned threadCount = std::min(
+        (size_t)schedulingThreads_, pendingFunctions_.size());
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < threadCount; ++i) {
+        threads.push_back(std::thread(schedule));
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    if (failed) {
+        for (PendingFunction& function : pendingFunctions_) {
+            delete function.ddg;
+            delete function.cfg;
+            delete function.irm;
+        }
+        pendingFunctions_.clear();
+        // report the error of the first failed function in module order
+        for (std::exception_ptr& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+
+    for (PendingFunction& function : pendingFunctions_) {
+        finishProcedure(*function.procedure, *function.cfg, *function.irm);
+        delete function.cfg;
+        delete function.irm;
+    }
+    pendingFunctions_.clear();
 }
 
 /**
@@ -276,7 +419,10 @@ LLVMTCEIRBuilder::buildTCECFG(llvm::MachineFunction& mf) {
     mang_->getNameWithPrefix(Buffer, &mf.getFunction(), false);
     TCEString fnName(Buffer.c_str());
 
-    ControlFlowGraph* cfg = new ControlFlowGraph(fnName, prog_);
+    // the CFGs scheduled later use the reference manager of the function
+    // instead of the one of the program.
+    ControlFlowGraph* cfg =
+        new ControlFlowGraph(fnName, deferScheduling() ? NULL : prog_);
 
     bbMapping_.clear();
     skippedBBs_.clear();
@@ -519,12 +665,7 @@ LLVMTCEIRBuilder::buildTCECFG(llvm::MachineFunction& mf) {
         }
     }
 
-    TTAProgram::InstructionReferenceManager* irm = NULL;
-    if (functionAtATime_) {
-        irm = new TTAProgram::InstructionReferenceManager();
-    } else {
-        irm = &prog_->instructionReferenceManager();
-    }
+    TTAProgram::InstructionReferenceManager* irm = &codeReferenceManager();
 
     // 2nd loop: create all instructions inside BB's.
     // this can only come after the first loop so that BB's have
@@ -921,6 +1062,25 @@ LLVMTCEIRBuilder::compileOptimized(
     ControlFlowGraph& cfg, 
     llvm::AliasAnalysis* llvmAA) {
 
+    DataDependenceGraph* ddg = prepareOptimized(cfg, llvmAA);
+    CopyingDelaySlotFiller* dsf = NULL;
+    if (delaySlotFilling_) {
+        dsf = &delaySlotFiller();
+    }
+    scheduleOptimized(cfg, *ddg, scheduler(), dsf);
+    delete ddg;
+}
+
+/**
+ * Runs the optimizations preceding the scheduling of a function.
+ *
+ * @return The DDG of the function for the scheduler, owned by the caller.
+ */
+DataDependenceGraph*
+LLVMTCEIRBuilder::prepareOptimized(
+    ControlFlowGraph& cfg,
+    llvm::AliasAnalysis* llvmAA) {
+
     SimpleIfConverter ifConverter(*ipData_, *mach_);
     ifConverter.handleControlFlowGraph(cfg, *mach_);
     Peel2BBLoops peel2bbLoops(*ipData_, *mach_);
@@ -959,25 +1119,42 @@ LLVMTCEIRBuilder::compileOptimized(
         // need the BB refs to rebuild the LLVM CFG 
         cfg.convertBBRefsToInstRefs();
     }
+    return ddg;
+}
 
-    if (delaySlotFilling_)
-        delaySlotFiller().initialize(cfg, *ddg, *mach_);
-    scheduler().handleCFGDDG(cfg, ddg, *mach_ );
+/**
+ * Schedules a function and runs the postpass optimizations on it.
+ *
+ * @param cfg The function to schedule.
+ * @param ddg The DDG of the function.
+ * @param scheduler The scheduler to use.
+ * @param dsf The delay slot filler of the scheduler, NULL if disabled.
+ */
+void
+LLVMTCEIRBuilder::scheduleOptimized(
+    ControlFlowGraph& cfg,
+    DataDependenceGraph& ddg,
+    BBSchedulerController& scheduler,
+    CopyingDelaySlotFiller* dsf) {
+
+    if (dsf != NULL)
+        dsf->initialize(cfg, ddg, *mach_);
+    scheduler.handleCFGDDG(cfg, &ddg, *mach_ );
 
 #ifdef WRITE_CFG_DOTS
-    fnName = cfg.name();
+    TCEString fnName = cfg.name();
     cfg.writeToDotFile(fnName + "_cfg2.dot");
 #endif
 #ifdef WRITE_DDG_DOTS
-    ddg->writeToDotFile(fnName + "_ddg3.dot");
+    ddg.writeToDotFile(fnName + "_ddg3.dot");
 #endif
 
     if (!functionAtATime_) {
         // TODO: make DS filler work with FAAT
         // sched yield emitter does not work with the delay slot filler
 
-        if (delaySlotFilling_) {
-            delaySlotFiller().fillDelaySlots(cfg, *ddg, *mach_);
+        if (dsf != NULL) {
+            dsf->fillDelaySlots(cfg, ddg, *mach_);
         } 
     }
 
@@ -989,13 +1166,12 @@ LLVMTCEIRBuilder::compileOptimized(
     ppos.handleControlFlowGraph(cfg, *mach_);
 
 #ifdef WRITE_DDG_DOTS
-    ddg->writeToDotFile(fnName + "_ddg4.dot");
+    ddg.writeToDotFile(fnName + "_ddg4.dot");
 #endif
 
 #ifdef WRITE_CFG_DOTS
     cfg.writeToDotFile(fnName + "_cfg4.dot");
 #endif
-    delete ddg;    
 }
 
 
@@ -1132,6 +1308,8 @@ LLVMTCEIRBuilder::doInitialization(Module& m) {
 bool
 LLVMTCEIRBuilder::doFinalization(Module& m) { 
 
+    EXIT_IF_THROWS(schedulePendingFunctions());
+
     // Catch the exception here as throwing exceptions
     // through library boundaries is flaky. It crashes 
     // on x86-32 Linux at least. See:
@@ -1152,6 +1330,17 @@ LLVMTCEIRBuilder::doFinalization(Module& m) {
     return false; 
 }
 
+/**
+ * Returns the manager of the references into the function being built.
+ */
+TTAProgram::InstructionReferenceManager&
+LLVMTCEIRBuilder::codeReferenceManager() {
+    if (functionIRM_ != NULL) {
+        return *functionIRM_;
+    }
+    return LLVMTCEBuilder::codeReferenceManager();
+}
+
 TCEString 
 LLVMTCEIRBuilder::operationName(const MachineInstr& mi) const {
     if (dynamic_cast<const TCETargetMachine*>(&targetMachine()) 
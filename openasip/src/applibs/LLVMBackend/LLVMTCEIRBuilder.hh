@@ -128,8 +128,22 @@ namespace llvm {
             std::shared_ptr<TTAProgram::Move> m,
             bool isDestination) override;
 
+        virtual TTAProgram::InstructionReferenceManager&
+        codeReferenceManager() override;
+
     private:
 
+        /// A function whose TTA scheduling is postponed until all the
+        /// functions of the module have been built.
+        struct PendingFunction {
+            TTAProgram::Procedure* procedure;
+            ControlFlowGraph* cfg;
+            /// NULL if the function is compiled without optimizations.
+            DataDependenceGraph* ddg;
+            /// The references into the code of the function.
+            TTAProgram::InstructionReferenceManager* irm;
+        };
+
         bool isHotFunction(llvm::MachineFunction& mf) const;
         bool isRealInstruction(const MachineInstr& instr) const;
         bool hasRealInstructions(
@@ -144,6 +158,21 @@ namespace llvm {
         void compileOptimized(
             ControlFlowGraph& cfg, 
             llvm::AliasAnalysis* llvmAA);
+        DataDependenceGraph* prepareOptimized(
+            ControlFlowGraph& cfg,
+            llvm::AliasAnalysis* llvmAA);
+        void scheduleOptimized(
+            ControlFlowGraph& cfg,
+            DataDependenceGraph& ddg,
+            BBSchedulerController& scheduler,
+            CopyingDelaySlotFiller* dsf);
+
+        bool deferScheduling() const;
+        void schedulePendingFunctions();
+        void finishProcedure(
+            TTAProgram::Procedure& procedure,
+            ControlFlowGraph& cfg,
+            TTAProgram::InstructionReferenceManager& irm);
 
         bool isExplicitReturn(const llvm::MachineInstr& mi) const;
 
@@ -183,6 +212,13 @@ namespace llvm {
         CycleLookBackSoftwareBypasser* bypasser_;
 
         InnerLoopFinder* loopFinder_;
+
+        /// Number of threads the functions are scheduled with.
+        unsigned schedulingThreads_;
+        /// Functions waiting to be scheduled, in the order of the module.
+        std::vector<PendingFunction> pendingFunctions_;
+        /// The reference manager of the function being built.
+        TTAProgram::InstructionReferenceManager* functionIRM_;
     };
 }
 
@@ -105,11 +105,7 @@ BitVector::pushBack(long long unsigned int integer, int size) {
  */
 void
 BitVector::pushBack(const BitVector& bits) {
-    reserve(size() + bits.size());
-    for (std::vector<bool>::const_iterator iter = bits.begin();
-         iter != bits.end(); iter++) {
-        push_back(*iter);
-    }
+    insert(end(), bits.begin(), bits.end());
 }
 /**
  * Pushes back the given bit.
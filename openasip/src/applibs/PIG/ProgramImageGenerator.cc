@@ -37,7 +37,9 @@
 #include "ProgramImageGenerator.hh"
 
 #include <cmath>
+#include <exception>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "ArrayProgramImageWriter.hh"
@@ -188,13 +190,44 @@ ProgramImageGenerator::generateProgramImage(
     OutputFormat format,
     int mausPerLine) {
 
+    ImageStreamList images;
+    images.push_back(ImageStream(format, &stream));
+    generateProgramImages(programName, images, mausPerLine);
+}
+
+
+/**
+ * Generates the program image in several formats from one encoding of the
+ * program.
+ *
+ * The program is compressed only once and the resulting instruction bits
+ * are written to each of the given streams in the format paired with it.
+ * The images can be written by several threads as the writers only read
+ * the encoded program.
+ *
+ * @param programName Name of the program.
+ * @param images The output streams and the formats of their images.
+ * @param mausPerLine If the output is ASCII format, defines the number of
+ *                    MAUs printed per line.
+ * @param threadCount Maximum number of threads writing the images, 0 for
+ *                    one per hardware thread.
+ * @exception InvalidData If machine or BEM is not loaded or if they are
+ *                        erroneous or if the given program is not in the
+ *                        program set.
+ * @exception OutOfRange If mausPerLine is negative.
+ */
+void
+ProgramImageGenerator::generateProgramImages(
+    const std::string& programName,
+    const ImageStreamList& images,
+    int mausPerLine,
+    unsigned int threadCount) {
+
     if (mausPerLine < 0) {
         string errorMsg = "Negative number of MAUs printed per line.";
         throw OutOfRange(__FILE__, __LINE__, __func__, errorMsg);
     }
     InstructionBitVector* programBits = compressor_->compress(programName);
-    int mau = compressor_->machine().controlUnit()->addressSpace()->width();
-    BitImageWriter* writer = NULL;
 
     if (Application::verboseLevel() > 0) {
         size_t instructionCount = 
@@ -344,41 +377,92 @@ ProgramImageGenerator::generateProgramImage(
     }
 
 
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    if (threadCount == 0 || images.size() < 2) {
+        threadCount = 1;
+    }
+
+    // each thread writes every threadCount'th image
+    std::vector<std::exception_ptr> errors(threadCount);
+    auto writeImages = [&](unsigned int first) {
+        try {
+            for (size_t i = first; i < images.size(); i += threadCount) {
+                BitImageWriter* writer = createProgramImageWriter(
+                    *programBits, images[i].first, mausPerLine);
+                writer->writeImage(*images[i].second);
+                delete writer;
+            }
+        } catch (...) {
+            errors[first] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned int t = 1; t < threadCount; t++) {
+        threads.push_back(std::thread(writeImages, t));
+    }
+    writeImages(0);
+    for (size_t t = 0; t < threads.size(); t++) {
+        threads[t].join();
+    }
+    delete programBits;
+
+    for (size_t t = 0; t < errors.size(); t++) {
+        if (errors[t]) {
+            std::rethrow_exception(errors[t]);
+        }
+    }
+}
+
+
+/**
+ * Creates the image writer of the given program image format.
+ *
+ * @param programBits The encoded program.
+ * @param format The output format.
+ * @param mausPerLine If the output is ASCII format, defines the number of
+ *                    MAUs printed per line.
+ * @return The writer, owned by the caller.
+ */
+BitImageWriter*
+ProgramImageGenerator::createProgramImageWriter(
+    const InstructionBitVector& programBits, OutputFormat format,
+    int mausPerLine) const {
+
+    int mau = compressor_->machine().controlUnit()->addressSpace()->width();
+    BitImageWriter* writer = NULL;
     if (format == BINARY) {
-        writer = new RawImageWriter(*programBits);
+        writer = new RawImageWriter(programBits);
     } else if (format == ASCII) {
         // change this to "mausPerLine > 0" when mau == instructionwidth
         // does not apply anymore
         if (mausPerLine > 1) {
-            writer = new AsciiImageWriter(*programBits, mau * mausPerLine);
+            writer = new AsciiImageWriter(programBits, mau * mausPerLine);
         } else {
-           writer = new AsciiProgramImageWriter(*programBits);
+           writer = new AsciiProgramImageWriter(programBits);
        }
     } else if (format == ARRAY) {
         if (mausPerLine > 1) {
-            writer = new ArrayImageWriter(*programBits, mau * mausPerLine);
+            writer = new ArrayImageWriter(programBits, mau * mausPerLine);
         } else {
-            writer = new ArrayProgramImageWriter(*programBits);
+            writer = new ArrayProgramImageWriter(programBits);
         }
     } else if (format == MIF) {
-        writer = new MifImageWriter(*programBits, mau);
+        writer = new MifImageWriter(programBits, mau);
     } else if (format == VHDL) {
-        writer = new VhdlProgramImageWriter(*programBits, entityName_);
+        writer = new VhdlProgramImageWriter(programBits, entityName_);
     } else if (format == COE) {
-        writer = new CoeImageWriter(*programBits, mau);
+        writer = new CoeImageWriter(programBits, mau);
     } else if (format == HEX) {
-        writer = new HexImageWriter(*programBits, mau);
+        writer = new HexImageWriter(programBits, mau);
     } else if (format == BIN2N) {
-        writer = new Bin2nProgramImageWriter(*programBits);
+        writer = new Bin2nProgramImageWriter(programBits);
     } else {
         assert(false);
     }
-    
-
-    writer->writeImage(stream);
-
-    delete writer;
-    delete programBits;
+    return writer;
 }
 
 
@@ -37,6 +37,8 @@
 #include <iostream>
 #include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "CodeCompressorPlugin.hh"
 #include "BaseType.hh"
@@ -56,7 +58,9 @@ namespace TTAMachine {
 }
 
 class BinaryEncoding;
+class BitImageWriter;
 class CodeCompressorPlugin;
+class InstructionBitVector;
 class CmdLineOptionParser;
 
 /**
@@ -80,6 +84,10 @@ public:
 	BIN2N /// Binary format padded to 2**n
     };
     typedef std::map<std::string, TPEF::Binary*> TPEFMap;
+    /// An output stream and the format of the image written to it.
+    typedef std::pair<OutputFormat, std::ostream*> ImageStream;
+    /// Images generated from the same encoded program.
+    typedef std::vector<ImageStream> ImageStreamList;
 
     ProgramImageGenerator();
     virtual ~ProgramImageGenerator();
@@ -97,6 +105,11 @@ public:
         std::ostream& stream,
         OutputFormat format,
         int mausPerLine = 0);
+    void generateProgramImages(
+        const std::string& programName,
+        const ImageStreamList& images,
+        int mausPerLine = 0,
+        unsigned int threadCount = 1);
     void generateDataImage(
         const std::string& programName, TPEF::Binary& program,
         const std::string& addressSpace, std::ostream& stream,
@@ -126,6 +139,9 @@ private:
 
     static CodeCompressorPlugin* createCompressor(
         const std::string& fileName, PluginTools& pluginTool);
+    BitImageWriter* createProgramImageWriter(
+        const InstructionBitVector& programBits, OutputFormat format,
+        int mausPerLine) const;
     TPEF::InstructionElement* relocTarget(
         const TPEF::Binary& program,
         const TPEF::DataSection& dataSection,
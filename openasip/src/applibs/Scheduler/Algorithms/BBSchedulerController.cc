@@ -34,6 +34,7 @@
 #include <set>
 #include <string>
 #include <cstdlib>
+#include <atomic>
 
 #include "BBSchedulerController.hh"
 #include "ControlFlowGraph.hh"
@@ -101,9 +102,21 @@ BBSchedulerController::BBSchedulerController(
       softwareBypasser_(bypasser),
       delaySlotFiller_(delaySlotFiller),
       basicBlocksScheduled_(0),
-      totalBasicBlocks_(0) {
+      totalBasicBlocks_(0),
+      budgetExceededBlocks_(0),
+      budgetReported_(false) {
     CmdLineOptions *cmdLineOptions = Application::cmdLineOptions();
     options_ = dynamic_cast<LLVMTCECmdLineOptions*>(cmdLineOptions);
+
+    SchedulerCmdLineOptions* schedulerOptions =
+        dynamic_cast<SchedulerCmdLineOptions*>(cmdLineOptions);
+    if (schedulerOptions != NULL) {
+        bbBudget_ = SchedulingBudget(
+            schedulerOptions->basicBlockTimeBudget(),
+            schedulerOptions->basicBlockStepBudget());
+        procedureBudget_ = SchedulingBudget(
+            schedulerOptions->procedureTimeBudget());
+    }
 }
 
 BBSchedulerController::~BBSchedulerController() {
@@ -133,6 +146,12 @@ BBSchedulerController::handleBasicBlock(
 
     bool bbScheduled = false;
 
+    budgetReported_ = false;
+    // the procedure has used its budget, use the cheap scheduler for the
+    // rest of its basic blocks.
+    bool procedureOverBudget =
+        procedureBudget_.isLimited() && !procedureBudget_.consume();
+
     RegisterRenamer* rr = NULL;
 
     SchedulerCmdLineOptions* options =
@@ -151,7 +170,12 @@ BBSchedulerController::handleBasicBlock(
 
     std::vector<DDGPass*> bbSchedulers;
 
-    if (options_ != NULL && options_->useBubbleFish2Scheduler()) {
+    if (procedureOverBudget) {
+        reportBudgetExceeded(
+            bb, bbn, procedureBudget_, "procedure", "list scheduler");
+        bbSchedulers.push_back(new BasicBlockScheduler(
+            BasicBlockPass::interPassData(), softwareBypasser_, NULL));
+    } else if (options_ != NULL && options_->useBubbleFish2Scheduler()) {
         bbSchedulers.push_back(new BF2Scheduler(
                                    BasicBlockPass::interPassData(), rr));
     } else if (options_ != NULL && options_->useBUScheduler()) {
@@ -165,7 +189,12 @@ BBSchedulerController::handleBasicBlock(
                                    BasicBlockPass::interPassData(), rr));
     }
 
-    if (options_->isLoopOptDefined() &&
+    BF2Scheduler* bf2 = dynamic_cast<BF2Scheduler*>(bbSchedulers[0]);
+    if (bf2 != NULL && bbBudget_.isLimited()) {
+        bf2->setBudget(&bbBudget_);
+    }
+
+    if (!procedureOverBudget && options_->isLoopOptDefined() &&
         cfg_->isSingleBBLoop(*bbn) && 
         bb.lastInstruction().hasJump() &&
         bigDDG_ != NULL) {
@@ -213,10 +242,15 @@ BBSchedulerController::handleBasicBlock(
                     << std::endl;
             }
             
+            bbBudget_.start();
             if (executeLoopPass(
                     bb, targetMachine, irm, bbSchedulers, bbn) ) {
                 bbScheduled = true;
             } else {
+                if (bbBudget_.isExceeded()) {
+                    reportBudgetExceeded(
+                        bb, bbn, bbBudget_, "loop", "basic block scheduler");
+                }
                 if (Application::verboseLevel() > 1) {
                     Application::logStream()
                         << "loop scheduler failed, using basic block "
@@ -460,7 +494,7 @@ BBSchedulerController::executeDDGPass(
     DataDependenceGraph* ddg = NULL;
     SimpleResourceManager* rm = NULL;
     // Used for live info dumping.
-    static int bbNumber = 0;
+    static std::atomic<int> bbNumber(0);
     int min = INT_MAX;
     int fastest = 0;
     if (ddgPasses.size() > 1) {
@@ -471,9 +505,12 @@ BBSchedulerController::executeDDGPass(
             rm->setCFG(cfg_);
             rm->setBBN(bbn);
 
+            // every pass gets the whole budget of the basic block
+            bbBudget_.start();
             int size =
                 ddgPasses[i]->handleDDG(*ddg, *rm, targetMachine, minCycle, true);
-            if (size < min) {
+            // -1 means the pass gave up due the compile time budget
+            if (size >= 0 && size < min) {
                 min = size;
                 fastest = i;
             }
@@ -507,7 +544,24 @@ BBSchedulerController::executeDDGPass(
 #endif
 
     try {
+        bbBudget_.start();
         ddgPasses[fastest]->handleDDG(*ddg, *rm, targetMachine, minCycle);
+        if (bbBudget_.isExceeded()) {
+            // the scheduler has undone its partial schedule. schedule
+            // the BB again with the cheaper list scheduler.
+            reportBudgetExceeded(
+                bb, bbn, bbBudget_, "basic block", "list scheduler");
+            SimpleResourceManager::disposeRM(rm);
+            delete ddg;
+            ddg = createDDGFromBB(bb, targetMachine);
+            rm = SimpleResourceManager::createRM(targetMachine);
+            rm->setDDG(static_cast<DataDependenceGraph*>(ddg->rootGraph()));
+            rm->setCFG(cfg_);
+            rm->setBBN(bbn);
+            BasicBlockScheduler fallbackScheduler(
+                BasicBlockPass::interPassData(), softwareBypasser_, NULL);
+            fallbackScheduler.handleDDG(*ddg, *rm, targetMachine, minCycle);
+        }
         if (bbn->isHWLoop()) {
             bbn->predecessor()->updateHWloopLength(
                 ddg->largestCycle() + 1 - ddg->smallestCycle());
@@ -554,6 +608,39 @@ BBSchedulerController::executeDDGPass(
     delete ddg;
 }
 
+/**
+ * Logs a basic block which exceeded a compile time budget.
+ *
+ * @param bb The basic block.
+ * @param bbn Node of the basic block in the CFG, or NULL.
+ * @param budget The exceeded budget.
+ * @param scope Name of the scope of the budget, for the message.
+ * @param fallback Name of the scheduler used instead, for the message.
+ */
+void
+BBSchedulerController::reportBudgetExceeded(
+    const TTAProgram::BasicBlock& bb, const BasicBlockNode* bbn,
+    const SchedulingBudget& budget, const std::string& scope,
+    const std::string& fallback) {
+
+    // a block can exceed the budget of the loop and the flat schedule
+    if (!budgetReported_) {
+        ++budgetExceededBlocks_;
+        budgetReported_ = true;
+    }
+    TCEString procName = cfg_ != NULL ? cfg_->procedureName() : "";
+    Application::logStream()
+        << "Scheduling budget of the " << scope << " exceeded in "
+        << procName;
+    if (bbn != NULL) {
+        Application::logStream() << " BB " << bbn->nodeID();
+    }
+    Application::logStream()
+        << " (" << bb.instructionCount() << " instructions, "
+        << budget.elapsedTime() << " ms, " << budget.steps()
+        << " steps), using the " << fallback << "." << std::endl;
+}
+
 /* Returns true if node count changed */
 bool BBSchedulerController::handleBBNode(
     ControlFlowGraph& cfg, BasicBlockNode& bb,
@@ -589,6 +676,7 @@ BBSchedulerController::handleCFGDDG(
     const TTAMachine::Machine& targetMachine) {
     cfg_ = &cfg;
     bigDDG_ = ddg;
+    procedureBudget_.start();
 
     ScheduleEstimator est(ProcedurePass::interPassData());
     est.handleControlFlowGraph(cfg, targetMachine);
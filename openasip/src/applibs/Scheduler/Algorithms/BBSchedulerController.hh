@@ -38,6 +38,7 @@
 #include "ProcedurePass.hh"
 #include "ProgramPass.hh"
 #include "Program.hh"
+#include "SchedulingBudget.hh"
 
 class BasicBlockNode;
 class SoftwareBypasser;
@@ -103,12 +104,20 @@ public:
     virtual std::string shortDescription() const override;
     virtual std::string longDescription() const override;
 
+    /// Number of basic blocks which exceeded the scheduling budget.
+    int budgetExceededBlockCount() const { return budgetExceededBlocks_; }
+
 protected:
     virtual DataDependenceGraph* createDDGFromBB(
         TTAProgram::BasicBlock& bb, const TTAMachine::Machine& mach);
 
 private:
 
+    void reportBudgetExceeded(
+        const TTAProgram::BasicBlock& bb, const BasicBlockNode* bbn,
+        const SchedulingBudget& budget, const std::string& scope,
+        const std::string& fallback);
+
     const TTAMachine::Machine& targetMachine_;
 
     /// The currently scheduled procedure.
@@ -130,6 +139,16 @@ private:
     int totalBasicBlocks_;
 
     LLVMTCECmdLineOptions* options_;
+
+    /// Compile time budget of the basic block being scheduled.
+    SchedulingBudget bbBudget_;
+    /// Compile time budget of the procedure being scheduled.
+    SchedulingBudget procedureBudget_;
+    /// Number of basic blocks which exceeded either of the budgets.
+    int budgetExceededBlocks_;
+    /// True if the basic block being scheduled is already counted in
+    /// budgetExceededBlocks_.
+    bool budgetReported_;
 };
 
 #endif
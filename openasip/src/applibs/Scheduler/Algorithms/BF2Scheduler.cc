@@ -63,6 +63,7 @@
 #include "BasicBlockScheduler.hh"
 #include "UnboundedRegisterFile.hh"
 #include "RegisterRenamer.hh"
+#include "SchedulingBudget.hh"
 #include "MapTools.hh"
 #include "BFScheduleBU.hh"
 #include "ProgramAnnotation.hh"
@@ -97,7 +98,8 @@ BF2Scheduler::BF2Scheduler(
     killDeadResults_(true),
     jumpNode_(NULL),
     llResult_(NULL),
-    duplicator_(NULL) {
+    duplicator_(NULL),
+    budget_(NULL) {
     options_ =
         dynamic_cast<LLVMTCECmdLineOptions*>(Application::cmdLineOptions());
     if (options_ != NULL) {
@@ -114,7 +116,8 @@ BF2Scheduler::BF2Scheduler(
     killDeadResults_(killDeadResults),
     jumpNode_(NULL),
     llResult_(NULL),
-    duplicator_(NULL) {
+    duplicator_(NULL),
+    budget_(NULL) {
     options_ =
         dynamic_cast<LLVMTCECmdLineOptions*>(Application::cmdLineOptions());
 }
@@ -140,7 +143,13 @@ TTAMachine::Unit* BF2Scheduler::getDstUnit(MoveNode& mn) {
     return NULL;
 }
 
-void BF2Scheduler::scheduleDDG(
+/**
+ * Schedules the given DDG.
+ *
+ * @return False if the compile time budget was exceeded. In that case all
+ * scheduling done has been undone.
+ */
+bool BF2Scheduler::scheduleDDG(
     DataDependenceGraph& ddg,
     SimpleResourceManager& rm,
     const TTAMachine::Machine& targetMachine) {
@@ -200,6 +209,11 @@ void BF2Scheduler::scheduleDDG(
             continue;
         }
 
+        if (budget_ != NULL && !budget_->consume()) {
+            unschedule();
+            return false;
+        }
+
         if (!scheduleFrontFromMove(*mn)) {
 #ifdef DEBUG_BUBBLEFISH_SCHEDULER
             std::cerr << "Scheduling of front failed! Inducing move: "
@@ -238,6 +252,7 @@ void BF2Scheduler::scheduleDDG(
             (boost::format("bb_%s_after_scheduler_ddg.dot") %
              ddg_->name()).str());
     }
+    return true;
 }
 
 int
@@ -246,7 +261,12 @@ BF2Scheduler::handleDDG(
     const TTAMachine::Machine& targetMachine, int, bool testOnly) {
     loopBufOps_.clear();
 
-    scheduleDDG(ddg, rm, targetMachine);
+    if (!scheduleDDG(ddg, rm, targetMachine)) {
+        if (duplicator_ != NULL) {
+            delete duplicator_; duplicator_ = NULL;
+        }
+        return -1;
+    }
 
     int len = rm_->largestCycle() - rm_->smallestCycle()+1;
 
@@ -308,6 +328,11 @@ int BF2Scheduler::handleLoopDDG(
             continue;
         }
 
+        if (budget_ != NULL && !budget_->consume()) {
+            undoLoopSchedule();
+            return -1;
+        }
+
         if (!scheduleFrontFromMove(*mn)) {
 #ifndef DEBUG_BUBBLEFISH_SCHEDULER
             if (options_ != NULL && options_->dumpDDGsDot()) {
@@ -339,15 +364,7 @@ int BF2Scheduler::handleLoopDDG(
                       << "Unscheduling all due scheduling failed at around: "
                       << mn->toString() << std::endl << std::endl;
 #endif
-            unschedule();
-            if (prologRM_ != NULL) {
-                preSharedOperandPorts_.clear();
-                preLoopSharedOperands_.clear();
-                unreservePreallocatedFUs();
-            }
-            if (duplicator_ != NULL) {
-                delete duplicator_; duplicator_ = NULL;
-            }
+            undoLoopSchedule();
             return -1;
         }
 #ifdef DEBUG_BUBBLEFISH_SCHEDULER
@@ -488,6 +505,10 @@ BF2Scheduler::handleLoopDDG(
     }
 
     int overlapCount = handleLoopDDG(selector, true);
+    if (overlapCount == -1 && budget_ != NULL && budget_->isExceeded()) {
+        // no time left to retry without the pre-loop operand sharing
+        return -1;
+    }
     if (overlapCount == -1) {
         if (Application::verboseLevel() > 1) {
             std::cerr << "Loop Sched. fail with pre-loop opshare on with II: "
@@ -671,6 +692,8 @@ void BF2Scheduler::finalizeSchedule() {
         scheduledStack_.pop_back();
         delete bfo;
     }
+    // the block is committed, free the undo records in bulk
+    Reversible::releaseMemory();
 }
 
 
@@ -794,6 +817,21 @@ void BF2Scheduler::unschedule() {
 
 
 
+/**
+ * Undoes a failed or abandoned loop schedule, including the function
+ * units reserved for the operands shared with the prolog.
+ */
+void BF2Scheduler::undoLoopSchedule() {
+    unschedule();
+    if (prologRM_ != NULL) {
+        preSharedOperandPorts_.clear();
+        preLoopSharedOperands_.clear();
+        unreservePreallocatedFUs();
+    }
+    if (duplicator_ != NULL) {
+        delete duplicator_; duplicator_ = NULL;
+    }
+}
 
 bool BF2Scheduler::isDeadResult(MoveNode& mn) const {
     return dreRemovedMoves_.find(&mn) != dreRemovedMoves_.end() ||
@@ -1159,7 +1197,7 @@ void BF2Scheduler::countLoopInvariantValueUsages() {
     invariants_.clear();
     invariantsOfCount_.clear();
 
-    static int iaCounter= 0;
+    static thread_local int iaCounter= 0;
     for (int i = 0; i < ddg().programOperationCount(); i++) {
         ProgramOperation& po = ddg().programOperation(i);
         const Operation& op = po.operation();
@@ -56,6 +56,7 @@ class BFOptimization;
 class MoveNodeDuplicator;
 class BF2ScheduleFront;
 class BFScheduleLoopBufferInit;
+class SchedulingBudget;
 
 namespace TTAMachine {
     class Unit;
@@ -85,7 +86,7 @@ public:
         const TTAMachine::Machine& targetMachine, int minCycle = 0,
         bool testOnly = false);
 
-    void scheduleDDG(
+    bool scheduleDDG(
         DataDependenceGraph& ddg,
         SimpleResourceManager& rm,
         const TTAMachine::Machine& targetMachine);
@@ -219,6 +220,9 @@ public:
     MoveNodeMap bypassNodes();
 
     RegisterRenamer* renamer() { return renamer_; }
+
+    /// Sets the compile time budget polled while scheduling, or NULL.
+    void setBudget(SchedulingBudget* budget) { budget_ = budget; }
 protected:
 
     int handleLoopDDG(BUMoveNodeSelector& selector, bool allowPreLoopOpshare);
@@ -291,6 +295,7 @@ private:
         bool onlySharedWithAnother);
 
     void unreservePreallocatedFUs();
+    void undoLoopSchedule();
 
     void releasePortForOp(const Operation& op);
 
@@ -313,6 +318,8 @@ private:
     LoopAnalyzer::LoopAnalysisResult* llResult_;
 
     MoveNodeDuplicator* duplicator_;
+    /// Compile time budget of the scheduled BB, NULL if unlimited.
+    SchedulingBudget* budget_;
 
     std::multimap<TCEString, MoveNode*> invariants_;
     std::multimap<int, TCEString> invariantsOfCount_;
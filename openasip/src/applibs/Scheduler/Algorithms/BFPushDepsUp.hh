@@ -42,7 +42,7 @@ class MoveNode;
 
 class BFPushDepsUp : public BFOptimization {
 public:
-    static int recurseCounter_;
+    static thread_local int recurseCounter_;
     BFPushDepsUp(
 	BF2Scheduler& sched, MoveNode &mn, int prefCycle) :
 	BFOptimization(sched),
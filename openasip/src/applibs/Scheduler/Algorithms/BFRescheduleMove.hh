@@ -52,7 +52,7 @@ public:
         BFUnscheduleMove(sched, mn) {}
     void undoOnlyMe();
 protected:
-    std::stack<Reversible*> midChildren_;
+    UndoStack midChildren_;
 };
 
 #endif
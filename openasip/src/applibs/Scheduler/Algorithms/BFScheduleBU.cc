@@ -175,6 +175,7 @@ BFScheduleBU::operator()() {
                         if (forbiddenRF) {
                             renSrc->undo();
                             preChildren_.pop();
+                            delete renSrc;
                             forbiddenRF =
                                 RFReadPortCountPreventsScheduling(mn_);
                             regCopy = regCopyBefore =
@@ -262,6 +263,7 @@ BFScheduleBU::operator()() {
 #endif
                     preChildren_.pop();
                     renameSrc->undo();
+                    delete renameSrc;
                 } else {
                     ddglc = renamedDDGLC;
                     rmlc = renamedRMLC;
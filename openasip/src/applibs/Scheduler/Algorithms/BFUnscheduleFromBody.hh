@@ -66,7 +66,7 @@ protected:
     const TTAMachine::FunctionUnit *srcFU_;
     const TTAMachine::ImmediateUnit* immu_;
     int immRegIndex_;
-    static int recurseCounter_;
+    static thread_local int recurseCounter_;
 };
 
 #endif
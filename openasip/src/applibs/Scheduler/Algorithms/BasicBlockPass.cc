@@ -30,6 +30,8 @@
  * @note rating: red
  */
 
+#include <atomic>
+
 #include "BasicBlockPass.hh"
 #include "Application.hh"
 #include "BasicBlock.hh"
@@ -107,7 +109,7 @@ BasicBlockPass::executeDDGPass(
     DataDependenceGraph* ddg = createDDGFromBB(bb, targetMachine);
 
     // Used for live info dumping.
-    static int bbNumber = 0;
+    static std::atomic<int> bbNumber(0);
 
 #ifdef DDG_SNAPSHOTS
     std::string name = "scheduling";
@@ -127,7 +127,7 @@ CopyingDelaySlotFiller::fillDelaySlots(
     ControlFlowGraph::EdgeSet outEdges = cfg_->outEdges(jumpingBB);
 
     InstructionReferenceManager& irm =
-        cfg_->program()->instructionReferenceManager();
+        cfg_->instructionReferenceManager();
 
     TTAProgram::BasicBlock& thisBB = jumpingBB.basicBlock();
     std::pair<int, TTAProgram::Move*> jumpData = findJump(thisBB);
@@ -335,7 +335,7 @@ bool CopyingDelaySlotFiller::updateFTBBAndCfg(
     ControlFlowEdge& edge, int slotsFilled) {
 
     InstructionReferenceManager& irm =
-        cfg_->program()->instructionReferenceManager();
+        cfg_->instructionReferenceManager();
 
     for (int i = 0; i < slotsFilled; i++) {
         assert(!irm.hasReference(
@@ -1807,8 +1807,8 @@ CopyingDelaySlotFiller::updateJumpsAndCfg(
             &jumpAddressImmediate->value());
 
     BasicBlock& nextBB = fillingBBN.basicBlock();
-    InstructionReferenceManager& irm = cfg_->program()->
-        instructionReferenceManager();
+    InstructionReferenceManager& irm =
+        cfg_->instructionReferenceManager();
     // TODO: only the correct jump one, nto both
     assert(slotsFilled <= nextBB.instructionCount());
 
@@ -35,6 +35,7 @@
 
 #include <map>
 #include <set>
+#include <atomic>
 
 #include "SoftwareBypasser.hh"
 #include "DataDependenceGraph.hh"
@@ -122,9 +123,9 @@ private:
 
     MoveNodeSelector* selector_;
 
-    static int bypassCount_;
-    static int deadResultCount_;
-    static int triggerAbortCount_;
+    static std::atomic<int> bypassCount_;
+    static std::atomic<int> deadResultCount_;
+    static std::atomic<int> triggerAbortCount_;
 };
 
 #endif
@@ -35,6 +35,8 @@
  * @note rating: red
  */
 
+#include <atomic>
+
 #include "BasicBlockPass.hh"
 #include "ControlFlowGraphPass.hh"
 
@@ -73,9 +75,9 @@ public:
     }
 private:
     TTAProgram::InstructionReferenceManager* irm_;
-    static unsigned int moveCount_;
-    static unsigned int operandCount_;
-    static unsigned int removedOperands_;
-    static unsigned int registerReads_;
-    static unsigned int triggerCannotRemove_;
+    static std::atomic<unsigned int> moveCount_;
+    static std::atomic<unsigned int> operandCount_;
+    static std::atomic<unsigned int> removedOperands_;
+    static std::atomic<unsigned int> registerReads_;
+    static std::atomic<unsigned int> triggerCannotRemove_;
 };
@@ -512,10 +512,9 @@ PreOptimizer::handleCFGDDG(
     ControlFlowGraph& cfg,
     DataDependenceGraph& ddg) {
 
-    TTAProgram::Program* program = cfg.program();
     TTAProgram::InstructionReferenceManager* irm =
-        program == NULL ? NULL :
-        &program->instructionReferenceManager();
+        cfg.hasInstructionReferenceManager() ?
+        &cfg.instructionReferenceManager() : NULL;
 
     // Loop over all programoperations. find XOR's by 1.
     for (int i = ddg.programOperationCount() - 1; i >= 0; i--) {
@@ -97,15 +97,36 @@ RegisterRenamer::initialize() {
         tempRegFiles_ = trCacheIter->second;
     }
 
+    // number all the registers of the machine densely
+    int regCount = 0;
+    for (int i = 0; i < regNav.count(); i++) {
+        const TTAMachine::RegisterFile* rf = regNav.item(i);
+        firstRegisters_[rf] = regCount;
+        for (int j = 0; j < rf->size(); j++) {
+            TCEString regName = DisassemblyRegister::registerName(*rf, j);
+            registerNames_.push_back(regName);
+            registerNumbers_[regName] = regCount + j;
+        }
+        regCount += rf->size();
+    }
+
+    allNormalGPRs_.resize(regCount);
+    freeGPRs_.resize(regCount);
+    usedGPRs_.resize(regCount);
+    onlyBeginPartiallyUsedRegs_.resize(regCount);
+    onlyEndPartiallyUsedRegs_.resize(regCount);
+    onlyMidPartiallyUsedRegs_.resize(regCount);
+
     for (int i = 0; i < regNav.count(); i++) {
         bool isTempRf = false;
         TTAMachine::RegisterFile* rf = regNav.item(i);
         if (AssocTools::containsKey(tempRegFiles_, rf)) {
             isTempRf = true;
         }
-        unsigned int regCount = isTempRf ? rf->size()-1 : rf->size();
-        for (unsigned int j = 0; j < regCount; j++ ) {
-            allNormalGPRs_.insert(DisassemblyRegister::registerName(*rf, j));
+        unsigned int normalCount = isTempRf ? rf->size()-1 : rf->size();
+        int first = firstRegisters_[rf];
+        for (unsigned int j = 0; j < normalCount; j++ ) {
+            allNormalGPRs_.set(first + j);
         }
     }
 }
@@ -115,11 +136,9 @@ RegisterRenamer::initializeFreeRegisters() {
     
     assert(ddg_ != NULL);
     freeGPRs_ = allNormalGPRs_;
-    onlyBeginPartiallyUsedRegs_.clear();
-    onlyEndPartiallyUsedRegs_.clear();
-    onlyMidPartiallyUsedRegs_.clear();
-
-    std::map<TCEString,int> lastUses;
+    onlyBeginPartiallyUsedRegs_.reset();
+    onlyEndPartiallyUsedRegs_.reset();
+    onlyMidPartiallyUsedRegs_.reset();
 
     // find regs inside this BB.
     for (int i = 0; i < ddg_->nodeCount(); i++) {
@@ -128,37 +147,40 @@ RegisterRenamer::initializeFreeRegisters() {
         // any write to a reg means it's not alive.
         TTAProgram::Terminal& dest = node.move().destination();
         if (dest.isGPR()) {
-            TCEString regName = DisassemblyRegister::registerName(
-                dest.registerFile(), dest.index());
-            onlyMidPartiallyUsedRegs_.insert(regName);
+            auto first = firstRegisters_.find(&dest.registerFile());
+            if (first != firstRegisters_.end()) {
+                onlyMidPartiallyUsedRegs_.set(first->second + dest.index());
+            }
         }
         TTAProgram::Terminal& src = node.move().source();
         if (src.isGPR()) {
-            TCEString regName = DisassemblyRegister::registerName(
-                src.registerFile(), src.index());
-            onlyMidPartiallyUsedRegs_.insert(regName);
+            auto first = firstRegisters_.find(&src.registerFile());
+            if (first != firstRegisters_.end()) {
+                onlyMidPartiallyUsedRegs_.set(first->second + src.index());
+            }
         }
     }
 
     // then loop for deps outside or inside this bb.
-    for (std::set<TCEString>::iterator allIter = freeGPRs_.begin(); 
-         allIter != freeGPRs_.end();) {
+    for (RegisterSet::size_type reg = allNormalGPRs_.find_first();
+         reg != RegisterSet::npos; reg = allNormalGPRs_.find_next(reg)) {
+        const TCEString& regName = registerNames_[reg];
         bool aliveOver = false;
         bool aliveAtBeginning = false;
         bool aliveAtEnd = false;
         bool aliveAtMid = false;
         // defined before and used here or after?
-        if (bb_.liveRangeData_->regDefReaches_.find(*allIter) != 
+        if (bb_.liveRangeData_->regDefReaches_.find(regName) != 
             bb_.liveRangeData_->regDefReaches_.end()) {
-            if (bb_.liveRangeData_->registersUsedAfter_.find(*allIter) 
+            if (bb_.liveRangeData_->registersUsedAfter_.find(regName) 
                 != bb_.liveRangeData_->registersUsedAfter_.end()) {
                 aliveOver = true;
             }
-            if (bb_.liveRangeData_->regFirstUses_.find(*allIter) != 
+            if (bb_.liveRangeData_->regFirstUses_.find(regName) != 
                 bb_.liveRangeData_->regFirstUses_.end()) {
                 aliveAtBeginning = true;
                 LiveRangeData::MoveNodeUseMapSet::iterator i =
-                    bb_.liveRangeData_->regLastUses_.find(*allIter);
+                    bb_.liveRangeData_->regLastUses_.find(regName);
                 if (i != bb_.liveRangeData_->regLastUses_.end()) {
                     LiveRangeData::MoveNodeUseSet& lastUses = i->second;
                     for (LiveRangeData::MoveNodeUseSet::iterator j = 
@@ -172,10 +194,10 @@ RegisterRenamer::initializeFreeRegisters() {
             aliveAtBeginning = true;
         }
         // used after this?
-        if (bb_.liveRangeData_->registersUsedAfter_.find(*allIter) != 
+        if (bb_.liveRangeData_->registersUsedAfter_.find(regName) != 
             bb_.liveRangeData_->registersUsedAfter_.end()) {
             // defined here?
-            if (bb_.liveRangeData_->regDefines_.find(*allIter) != 
+            if (bb_.liveRangeData_->regDefines_.find(regName) != 
                 bb_.liveRangeData_->regDefines_.end()) {
                 aliveAtEnd = true;
             }            
@@ -186,32 +208,29 @@ RegisterRenamer::initializeFreeRegisters() {
         }
 
         // TODO: why was this here?
-        if (onlyMidPartiallyUsedRegs_.find(*allIter) != 
-            onlyMidPartiallyUsedRegs_.end()) {
+        if (onlyMidPartiallyUsedRegs_.test(reg)) {
             aliveAtMid = true;
         }
 
         if (aliveOver) {
             // can not be used for renaming.
-            onlyMidPartiallyUsedRegs_.erase(*allIter);
-            freeGPRs_.erase(allIter++);
+            onlyMidPartiallyUsedRegs_.reset(reg);
+            freeGPRs_.reset(reg);
         } else {
             if (aliveAtBeginning) {
-                onlyBeginPartiallyUsedRegs_.insert(*allIter);
+                onlyBeginPartiallyUsedRegs_.set(reg);
 
-                onlyMidPartiallyUsedRegs_.erase(*allIter);
-                freeGPRs_.erase(allIter++);
+                onlyMidPartiallyUsedRegs_.reset(reg);
+                freeGPRs_.reset(reg);
             } else {
                 if (aliveAtEnd) {
-                    onlyEndPartiallyUsedRegs_.insert(*allIter);
+                    onlyEndPartiallyUsedRegs_.set(reg);
 
-                    onlyMidPartiallyUsedRegs_.erase(*allIter);
-                    freeGPRs_.erase(allIter++);
+                    onlyMidPartiallyUsedRegs_.reset(reg);
+                    freeGPRs_.reset(reg);
                 } else { // only mid if has reads of writes?
                     if (aliveAtMid) {
-                        freeGPRs_.erase(allIter++);
-                    } else {
-                        allIter++;
+                        freeGPRs_.reset(reg);
                     }
                 }
             }
@@ -223,17 +242,19 @@ std::set<TCEString>
 RegisterRenamer::findFreeRegistersInRF(
     const RegisterRenamer::RegisterFileSet& rfs) const {
 
-    std::set<TCEString> allowedGprs = registersOfRFs(rfs);
-    std::set<TCEString> regs;
-    SetTools::intersection(allowedGprs, freeGPRs_, regs);
-    return regs;
+    return registerNames(registersOfRFs(rfs) & freeGPRs_);
 }
 
-std::set<TCEString> 
+/**
+ * Returns the registers of the given RFs which may be used for renaming.
+ *
+ * Leaves out the zero register and the last register of temp RFs.
+ */
+RegisterRenamer::RegisterSet
 RegisterRenamer::registersOfRFs(
     const RegisterFileSet& rfs) const {
 
-    std::set<TCEString> gprs;
+    RegisterSet gprs(registerNames_.size());
     for (std::set<const TTAMachine::RegisterFile*,
              TTAMachine::MachinePart::Comparator>::iterator i = rfs.begin();
          i != rfs.end(); i++) {
@@ -242,17 +263,118 @@ RegisterRenamer::registersOfRFs(
         if (AssocTools::containsKey(tempRegFiles_, rf)) {
             isTempRF = true;
         }
+        auto first = firstRegisters_.find(rf);
+        if (first == firstRegisters_.end()) {
+            continue;
+        }
         int lowestFreeIndex = 0;
         if (rf->zeroRegister()) {
             lowestFreeIndex = 1;
         }
         for (int j = lowestFreeIndex;
              j < (isTempRF ? rf->size() - 1 : rf->size()); j++) {
-            gprs.insert(DisassemblyRegister::registerName(*rf, j));
+            gprs.set(first->second + j);
         }
     }
     return gprs;
 }
+
+/**
+ * Returns all registers of the RFs of the given width.
+ */
+RegisterRenamer::RegisterSet
+RegisterRenamer::registersOfWidth(int bitWidth) const {
+
+    RegisterSet gprs(registerNames_.size());
+    for (auto i = firstRegisters_.begin(); i != firstRegisters_.end(); i++) {
+        const TTAMachine::BaseRegisterFile& rf = *i->first;
+        if (rf.width() != bitWidth) {
+            continue;
+        }
+        for (int j = 0; j < rf.size(); j++) {
+            gprs.set(i->second + j);
+        }
+    }
+    return gprs;
+}
+
+/**
+ * Returns the names of the registers in the given set.
+ */
+std::set<TCEString>
+RegisterRenamer::registerNames(const RegisterSet& regs) const {
+
+    std::set<TCEString> names;
+    for (RegisterSet::size_type i = regs.find_first();
+         i != RegisterSet::npos; i = regs.find_next(i)) {
+        names.insert(registerNames_[i]);
+    }
+    return names;
+}
+
+/**
+ * Returns the dense number of the register with the given name.
+ *
+ * @return The number, or -1 if the machine has no such register.
+ */
+int
+RegisterRenamer::registerNumber(const TCEString& regName) const {
+
+    std::map<TCEString, int>::const_iterator i =
+        registerNumbers_.find(regName);
+    return i == registerNumbers_.end() ? -1 : i->second;
+}
+
+/**
+ * Returns the registers of the given set whose last access in the DDG
+ * is before the given cycle.
+ *
+ * The access cycles of all registers are computed in one pass over the DDG.
+ */
+RegisterRenamer::RegisterSet
+RegisterRenamer::registersUsedBeforeCycle(
+    const RegisterSet& regs, int earliestCycle) const {
+
+    RegisterSet result(regs.size());
+    if (regs.none()) {
+        return result;
+    }
+    std::vector<int> lastCycles(regs.size());
+    ddg_->lastRegisterCycles(firstRegisters_, lastCycles);
+    for (RegisterSet::size_type i = regs.find_first();
+         i != RegisterSet::npos; i = regs.find_next(i)) {
+        if (lastCycles[i] < earliestCycle) {
+            result.set(i);
+        }
+    }
+    return result;
+}
+
+/**
+ * Returns the registers of the given set whose first access in the DDG
+ * is after the given cycle.
+ *
+ * The access cycles of all registers are computed in one pass over the DDG.
+ */
+RegisterRenamer::RegisterSet
+RegisterRenamer::registersUsedAfterCycle(
+    const RegisterSet& regs, int latestCycle) const {
+
+    RegisterSet result(regs.size());
+    if (regs.none()) {
+        return result;
+    }
+    std::vector<int> firstCycles(regs.size());
+    ddg_->firstRegisterCycles(firstRegisters_, firstCycles);
+    for (RegisterSet::size_type i = regs.find_first();
+         i != RegisterSet::npos; i = regs.find_next(i)) {
+        if (firstCycles[i] > latestCycle) {
+            result.set(i);
+        }
+    }
+    return result;
+}
+
 /** 
  * Finds registers which are used but only before given earliestCycle.
  */ 
@@ -268,27 +390,14 @@ RegisterRenamer::findPartiallyUsedRegistersInRFBeforeCycle(
         return availableRegs;
     }
 
-    std::set<TCEString> allowedGprs = registersOfRFs(rfs);
-    std::set<TCEString> regs = usedGPRs_;
-    AssocTools::append(onlyBeginPartiallyUsedRegs_, regs);
-    AssocTools::append(onlyMidPartiallyUsedRegs_, regs);
-    std::set<TCEString> regs2;
-    SetTools::intersection(allowedGprs, regs, regs2);
+    RegisterSet regs = usedGPRs_ | onlyBeginPartiallyUsedRegs_ |
+        onlyMidPartiallyUsedRegs_;
+    regs &= registersOfRFs(rfs);
 
-    
     // find from used gprs.
     // todo: this is too conservative? leaves one cycle netween war?
-    for (std::set<TCEString>::iterator i = regs2.begin(); 
-         i != regs2.end(); i++) {
-        TCEString rfName = i->substr(0, i->find('.'));
-        TTAMachine::RegisterFile* rf = 
-            machine_.registerFileNavigator().item(rfName);
-
-        unsigned int regIndex = atoi(i->substr(i->find('.')+1).c_str());
-        if (ddg_->lastRegisterCycle(*rf, regIndex) < earliestCycle) {
-            availableRegs.insert(*i);
-        }
-    }
+    availableRegs = registerNames(
+        registersUsedBeforeCycle(regs, earliestCycle));
     
     // if need to have guards?
     if (guardMoves.empty()) {
@@ -310,31 +419,13 @@ std::set<TCEString>
 RegisterRenamer::findPartiallyUsedRegistersInRFAfterCycle(
     const RegisterRenamer::RegisterFileSet& rfs, int latestCycle) const {
 
-    std::set<TCEString> availableRegs;
-    // nothing can be scheduled earlier than cycle 0.
-    // in that case we have empty set, no need to check.
-
-    std::set<TCEString> allowedGprs = registersOfRFs(rfs);
-    std::set<TCEString> regs = usedGPRs_;
-    AssocTools::append(onlyEndPartiallyUsedRegs_, regs);
-    AssocTools::append(onlyMidPartiallyUsedRegs_, regs);
-    std::set<TCEString> regs2;
-    SetTools::intersection(allowedGprs, regs, regs2);
+    RegisterSet regs = usedGPRs_ | onlyEndPartiallyUsedRegs_ |
+        onlyMidPartiallyUsedRegs_;
+    regs &= registersOfRFs(rfs);
     
     // find from used gprs.
     // todo: this is too conservative? leaves one cycle netween war?
-    for (std::set<TCEString>::iterator i = regs2.begin(); 
-         i != regs2.end(); i++) {
-        TCEString rfName = i->substr(0, i->find('.'));
-        TTAMachine::RegisterFile* rf = 
-            machine_.registerFileNavigator().item(rfName);
-
-        unsigned int regIndex = atoi(i->substr(i->find('.')+1).c_str());
-        if (ddg_->firstRegisterCycle(*rf, regIndex) > latestCycle) {
-            availableRegs.insert(*i);
-        }
-    }
-    return availableRegs;
+    return registerNames(registersUsedAfterCycle(regs, latestCycle));
 }
 
 std::set<TCEString> 
@@ -348,22 +439,13 @@ RegisterRenamer::findPartiallyUsedRegistersBeforeCycle(
         return availableRegs;
     }
 
-    std::set<TCEString> regs = onlyMidPartiallyUsedRegs_;
-    AssocTools::append(onlyBeginPartiallyUsedRegs_, regs);
-    AssocTools::append(usedGPRs_, regs);
+    RegisterSet regs = onlyMidPartiallyUsedRegs_ |
+        onlyBeginPartiallyUsedRegs_ | usedGPRs_;
+    regs &= registersOfWidth(bitWidth);
 
-    for (std::set<TCEString>::iterator i = regs.begin(); 
-         i != regs.end(); i++) {
+    availableRegs = registerNames(
+        registersUsedBeforeCycle(regs, earliestCycle));
 
-        TCEString rfName = i->substr(0, i->find('.'));
-        TTAMachine::RegisterFile* rf = 
-            machine_.registerFileNavigator().item(rfName);
-        unsigned int regIndex = atoi(i->substr(i->find('.')+1).c_str());
-        if (ddg_->lastRegisterCycle(*rf, regIndex) < earliestCycle && 
-            rf->width() == bitWidth) {
-            availableRegs.insert(*i);
-        }
-    }
     // if need to have guards?
     if (guardMoves.empty()) {
         return availableRegs;        
@@ -372,8 +454,8 @@ RegisterRenamer::findPartiallyUsedRegistersBeforeCycle(
         if (!liveRange->guards.empty()) {
             std::cerr << "\t\t\t\tpartiallyusedregs: ";
             for (std::set<TCEString>::iterator i = 
-                     regs.begin();
-                 i != regs.end(); i++) {
+                     availableRegs.begin();
+                 i != availableRegs.end(); i++) {
                 std::cerr << *i << " ";
             }
             std::cerr << std::endl;
@@ -393,44 +475,19 @@ RegisterRenamer::findPartiallyUsedRegistersBeforeCycle(
 std::set<TCEString> 
 RegisterRenamer::findPartiallyUsedRegistersAfterCycle(
     int bitWidth, int latestCycle) const {
-    std::set<TCEString> availableRegs;
 
-    std::set<TCEString> regs = onlyMidPartiallyUsedRegs_;
-    AssocTools::append(onlyEndPartiallyUsedRegs_, regs);
-    AssocTools::append(usedGPRs_, regs);
+    RegisterSet regs = onlyMidPartiallyUsedRegs_ |
+        onlyEndPartiallyUsedRegs_ | usedGPRs_;
+    regs &= registersOfWidth(bitWidth);
 
-    for (std::set<TCEString>::iterator i = regs.begin(); 
-         i != regs.end(); i++) {
-
-        TCEString rfName = i->substr(0, i->find('.'));
-        TTAMachine::RegisterFile* rf = 
-            machine_.registerFileNavigator().item(rfName);
-        unsigned int regIndex = atoi(i->substr(i->find('.')+1).c_str());
-        if (ddg_->firstRegisterCycle(*rf, regIndex) > latestCycle && 
-            rf->width() == bitWidth) {
-            availableRegs.insert(*i);
-        }
-    }
-    return availableRegs;
+    return registerNames(registersUsedAfterCycle(regs, latestCycle));
 }
 
 std::set<TCEString> 
 RegisterRenamer::findFreeRegisters(
     int bitWidth) const {
 
-    std::set<TCEString> availableRegs;
-
-    for (std::set<TCEString>::iterator i = freeGPRs_.begin(); 
-         i != freeGPRs_.end(); i++) {
-
-        TCEString rfName = i->substr(0, i->find('.'));
-        TTAMachine::RegisterFile* rf = 
-            machine_.registerFileNavigator().item(rfName);
-        if (rf->width() == bitWidth) {
-            availableRegs.insert(*i);
-        }
-    }
-    return availableRegs;
+    return registerNames(freeGPRs_ & registersOfWidth(bitWidth));
 }
 
 std::set<TCEString>
@@ -1093,13 +1150,17 @@ RegisterRenamer::renameLiveRange(
 
 void RegisterRenamer::renamedToRegister(const TCEString& newReg) {
 
-    freeGPRs_.erase(newReg);
+    int reg = registerNumber(newReg);
+    if (reg == -1) {
+        return;
+    }
+    freeGPRs_.reset(reg);
 
-    onlyBeginPartiallyUsedRegs_.erase(newReg);
-    onlyEndPartiallyUsedRegs_.erase(newReg);
-    onlyMidPartiallyUsedRegs_.erase(newReg);
+    onlyBeginPartiallyUsedRegs_.reset(reg);
+    onlyEndPartiallyUsedRegs_.reset(reg);
+    onlyMidPartiallyUsedRegs_.reset(reg);
 
-    usedGPRs_.insert(newReg);
+    usedGPRs_.set(reg);
 
 }
 
@@ -1108,7 +1169,10 @@ void RegisterRenamer::revertedRenameToRegister(const TCEString& reg) {
         bb_.liveRangeData_->regLastUses_[reg].empty() &&
         bb_.liveRangeData_->regDefines_[reg].empty() &&
         bb_.liveRangeData_->regFirstDefines_[reg].empty()) {
-        freeGPRs_.insert(reg);
+        int regNumber = registerNumber(reg);
+        if (regNumber != -1) {
+            freeGPRs_.set(regNumber);
+        }
     }
 }
 
@@ -1346,7 +1410,7 @@ RegisterRenamer::findGuardRegisters(
 
 
 /// To avoid reanalysing machine every time hen new rr created.
-std::map<const TTAMachine::Machine*,
+thread_local std::map<const TTAMachine::Machine*,
          std::set <const TTAMachine::RegisterFile*,
                    TTAMachine::MachinePart::Comparator> >
 RegisterRenamer::tempRegFileCache_;
@@ -37,6 +37,9 @@
 
 #include "TCEString.hh"
 #include <set>
+#include <map>
+#include <vector>
+#include <boost/dynamic_bitset.hpp>
 #include "MachinePart.hh"
 #include "DataDependenceGraph.hh"
 
@@ -63,7 +66,7 @@ public:
 
     RegisterRenamer(
         const TTAMachine::Machine& machine, TTAProgram::BasicBlock& bb);
-    unsigned int freeGPRCount() const { return freeGPRs_.size(); }
+    unsigned int freeGPRCount() const { return freeGPRs_.count(); }
 
     void initialize(DataDependenceGraph& ddg);
 
@@ -104,9 +107,17 @@ public:
     void renamedToRegister(const TCEString& newReg);
     void revertedRenameToRegister(const TCEString& reg);
 private:
-
-
-    std::set<TCEString> registersOfRFs(const RegisterFileSet& rfs) const;
+    /// Set of registers, indexed by the dense register numbers.
+    typedef boost::dynamic_bitset<> RegisterSet;
+
+    RegisterSet registersOfRFs(const RegisterFileSet& rfs) const;
+    RegisterSet registersOfWidth(int bitWidth) const;
+    std::set<TCEString> registerNames(const RegisterSet& regs) const;
+    int registerNumber(const TCEString& regName) const;
+    RegisterSet registersUsedBeforeCycle(
+        const RegisterSet& regs, int earliestCycle) const;
+    RegisterSet registersUsedAfterCycle(
+        const RegisterSet& regs, int latestCycle) const;
 
     void initializeFreeRegisters();
 
@@ -137,21 +148,30 @@ private:
         int loopDepth) const;
 
     void initialize();
-    std::set<TCEString> allNormalGPRs_;
-    std::set<TCEString> freeGPRs_;
+
+    /// First dense register number of each register file. The registers
+    /// of all the RFs of the machine are numbered in navigator order.
+    std::map<const TTAMachine::BaseRegisterFile*, int> firstRegisters_;
+    /// "RF.index" name of each register number.
+    std::vector<TCEString> registerNames_;
+    /// Register numbers by the register names.
+    std::map<TCEString, int> registerNumbers_;
+
+    RegisterSet allNormalGPRs_;
+    RegisterSet freeGPRs_;
 
     // already usd by the reg renamer, but can be reused of liveranges
     // cannot overlap?
-    std::set<TCEString> usedGPRs_;
+    RegisterSet usedGPRs_;
 
     // used partially by original code; 
     // used at beginning of bb, free at end.
-    std::set<TCEString> onlyBeginPartiallyUsedRegs_;
+    RegisterSet onlyBeginPartiallyUsedRegs_;
     // used at end of bb, free at begin.
-    std::set<TCEString> onlyEndPartiallyUsedRegs_;
-    std::set<TCEString> onlyMidPartiallyUsedRegs_;
+    RegisterSet onlyEndPartiallyUsedRegs_;
+    RegisterSet onlyMidPartiallyUsedRegs_;
 
-    static std::map<const TTAMachine::Machine*, 
+    static thread_local std::map<const TTAMachine::Machine*, 
                     std::set <const TTAMachine::RegisterFile*,
                               TTAMachine::MachinePart::Comparator> >
     tempRegFileCache_;
@@ -0,0 +1,96 @@
+/*
+    Copyright (c) 2002-2026 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file SchedulingBudget.cc
+ *
+ * Implementation of SchedulingBudget class.
+ *
+ * @note rating: red
+ */
+
+#include "SchedulingBudget.hh"
+
+/**
+ * Constructor.
+ *
+ * @param timeLimit Wall time limit in milliseconds, negative if unlimited.
+ * @param stepLimit Maximum number of steps, negative if unlimited.
+ */
+SchedulingBudget::SchedulingBudget(int timeLimit, int stepLimit) :
+    timeLimit_(timeLimit), stepLimit_(stepLimit), steps_(0),
+    exceeded_(false), startTime_(std::chrono::steady_clock::now()) {
+}
+
+/**
+ * Destructor.
+ */
+SchedulingBudget::~SchedulingBudget() {
+}
+
+/**
+ * Starts a new budget period: resets the step count and the clock.
+ */
+void
+SchedulingBudget::start() {
+    steps_ = 0;
+    exceeded_ = false;
+    startTime_ = std::chrono::steady_clock::now();
+}
+
+/**
+ * Accounts one scheduling step.
+ *
+ * @return False if the budget has been exceeded, true otherwise.
+ */
+bool
+SchedulingBudget::consume() {
+    if (exceeded_) {
+        return false;
+    }
+    ++steps_;
+    if (stepLimit_ >= 0 && steps_ > stepLimit_) {
+        exceeded_ = true;
+    } else if (timeLimit_ >= 0 && elapsedTime() > timeLimit_) {
+        exceeded_ = true;
+    }
+    return !exceeded_;
+}
+
+/**
+ * Returns true if either of the limits is set.
+ */
+bool
+SchedulingBudget::isLimited() const {
+    return timeLimit_ >= 0 || stepLimit_ >= 0;
+}
+
+/**
+ * Returns the wall time since start() in milliseconds.
+ */
+int
+SchedulingBudget::elapsedTime() const {
+    return static_cast<int>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - startTime_).count());
+}
@@ -0,0 +1,75 @@
+/*
+    Copyright (c) 2002-2026 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file SchedulingBudget.hh
+ *
+ * Declaration of SchedulingBudget class.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_SCHEDULING_BUDGET_HH
+#define TTA_SCHEDULING_BUDGET_HH
+
+#include <chrono>
+
+/**
+ * Compile time budget of a scheduling task.
+ *
+ * The budget is given as a wall time limit, a limit for the count of
+ * scheduling steps, or both. A scheduler calls consume() for every step it
+ * takes and gives up when it returns false. A negative limit means no
+ * limit.
+ */
+class SchedulingBudget {
+public:
+    SchedulingBudget(int timeLimit = -1, int stepLimit = -1);
+    virtual ~SchedulingBudget();
+
+    void start();
+    bool consume();
+
+    bool isLimited() const;
+    bool isExceeded() const { return exceeded_; }
+
+    int steps() const { return steps_; }
+    int elapsedTime() const;
+
+    int timeLimit() const { return timeLimit_; }
+    int stepLimit() const { return stepLimit_; }
+
+private:
+    /// Wall time limit in milliseconds, negative if unlimited.
+    int timeLimit_;
+    /// Maximum number of steps, negative if unlimited.
+    int stepLimit_;
+    /// Number of steps taken since start().
+    int steps_;
+    /// True after the budget has been exceeded.
+    bool exceeded_;
+    /// The time start() was called.
+    std::chrono::steady_clock::time_point startTime_;
+};
+
+#endif
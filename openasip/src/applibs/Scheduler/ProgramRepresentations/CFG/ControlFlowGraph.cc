@@ -149,7 +149,7 @@ ControlFlowGraph::ControlFlowGraph(
     program_(program),
     startAddress_(TTAProgram::NullAddress::instance()),
     endAddress_(TTAProgram::NullAddress::instance()),
-    passData_(NULL) {
+    passData_(NULL), irm_(NULL) {
     procedureName_ = name;
 }
 
@@ -167,7 +167,7 @@ ControlFlowGraph::ControlFlowGraph(
     procedure_(&procedure),
     startAddress_(TTAProgram::NullAddress::instance()),
     endAddress_(TTAProgram::NullAddress::instance()),
-    passData_(NULL) {
+    passData_(NULL), irm_(NULL) {
     buildFrom(procedure);
 }
 
@@ -189,7 +189,7 @@ ControlFlowGraph::ControlFlowGraph(
     procedure_(&procedure),
     startAddress_(TTAProgram::NullAddress::instance()),
     endAddress_(TTAProgram::NullAddress::instance()),
-    passData_(&passData) {
+    passData_(&passData), irm_(NULL) {
     buildFrom(procedure);
 }
 
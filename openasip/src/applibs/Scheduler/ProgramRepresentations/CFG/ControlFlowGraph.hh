@@ -143,6 +143,9 @@ public:
         TTAProgram::InstructionReferenceManager& irm) {
         irm_ = &irm;
     }
+    bool hasInstructionReferenceManager() const {
+        return program_ != NULL || irm_ != NULL;
+    }
 
     BasicBlockNode* jumpSuccessor(BasicBlockNode& bbn);
     BasicBlockNode* fallThruSuccessor(const BasicBlockNode& bbn) const;
@@ -46,7 +46,7 @@
 #include "TerminalRegister.hh"
 #include "Move.hh"
 
-int DataDependenceEdge::regAntidepCount_ = 0;
+std::atomic<int> DataDependenceEdge::regAntidepCount_(0);
 
 /**
  * Constructor.
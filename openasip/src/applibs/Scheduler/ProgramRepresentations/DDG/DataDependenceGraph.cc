@@ -33,6 +33,8 @@
  * @note rating: red
  */
 
+#include <algorithm>
+
 #include "StringTools.hh"
 #include "AssocTools.hh"
 #include "DataDependenceGraph.hh"
@@ -184,8 +186,7 @@ DataDependenceGraph::addNode(MoveNode& moveNode, MoveNode& relatedNode) {
  */
 const BasicBlockNode&
 DataDependenceGraph::getBasicBlockNode(const MoveNode& mn) const {
-    std::map<const MoveNode*, BasicBlockNode*>::const_iterator iter = 
-        moveNodeBlocks_.find(&mn);
+    auto iter = moveNodeBlocks_.find(&mn);
     if (iter == moveNodeBlocks_.end()) {
         TCEString msg = "MoveNode not in DDG!: ";
         msg += mn.toString();
@@ -202,8 +203,7 @@ DataDependenceGraph::getBasicBlockNode(const MoveNode& mn) const {
  */
 BasicBlockNode&
 DataDependenceGraph::getBasicBlockNode(MoveNode& mn)  {
-    std::map<const MoveNode*, BasicBlockNode*>::iterator iter = 
-        moveNodeBlocks_.find(&mn);
+    auto iter = moveNodeBlocks_.find(&mn);
     if (iter == moveNodeBlocks_.end()) {
         TCEString msg = "MoveNode not in DDG!: ";
         msg += mn.toString();
@@ -1068,6 +1068,258 @@ DataDependenceGraph::firstRegisterCycle(
 }
 
 
+/**
+ * Computes lastRegisterCycle() of many registers in a single pass over
+ * the graph.
+ *
+ * The registers are numbered densely: register i of a register file is
+ * number firstRegisters[rf] + i. Accesses to register files missing from
+ * the map are ignored.
+ *
+ * @param firstRegisters Number of the first register of each register file.
+ * @param cycles Result vector, sized to the count of numbered registers.
+ * Element i is set to what lastRegisterCycle() returns for register i.
+ */
+void
+DataDependenceGraph::lastRegisterCycles(
+    const std::map<const TTAMachine::BaseRegisterFile*, int>& firstRegisters,
+    std::vector<int>& cycles) const {
+
+    std::fill(cycles.begin(), cycles.end(), -1);
+    // registers whose result is already known
+    std::vector<bool> finished(cycles.size(), false);
+    std::vector<int> paramRegs = paramRegisterNumbers(firstRegisters);
+
+    for (int i = 0; i < nodeCount(); ++i) {
+        MoveNode& n = node(i);
+        TTAProgram::Move& move = n.move();
+
+        // check source
+        TTAProgram::Terminal& source = move.source();
+        if (source.isImmediateRegister() || source.isGPR()) {
+            const TTAMachine::BaseRegisterFile* rf =
+                source.isImmediateRegister() ?
+                static_cast<const TTAMachine::BaseRegisterFile*>(
+                    &source.immediateUnit()) :
+                &source.registerFile();
+            auto first = firstRegisters.find(rf);
+            if (first != firstRegisters.end()) {
+                int reg = first->second + source.index();
+                if (!finished[reg]) {
+                    if (!n.isPlaced()) {
+                        cycles[reg] = INT_MAX;
+                        finished[reg] = true;
+                    } else if (n.cycle() > cycles[reg]) {
+                        cycles[reg] = n.cycle();
+                    }
+                }
+            }
+        }
+
+        // check destination
+        TTAProgram::Terminal& destination = move.destination();
+        if (destination.isGPR()) {
+            auto first = firstRegisters.find(&destination.registerFile());
+            if (first != firstRegisters.end()) {
+                int reg = first->second + destination.index();
+                if (!finished[reg]) {
+                    if (!n.isPlaced()) {
+                        cycles[reg] = INT_MAX;
+                        finished[reg] = true;
+                    } else {
+                        if (n.cycle() > cycles[reg]) {
+                            cycles[reg] = n.cycle();
+                        }
+                        if (move.isUnconditional() && outDegree(n) == 0) {
+                            assert(cycles[reg] == n.cycle());
+                            finished[reg] = true;
+                        }
+                    }
+                }
+            }
+        }
+
+        // check guard.
+        if (!move.isUnconditional()) {
+            const TTAMachine::RegisterGuard* rg =
+                dynamic_cast<const TTAMachine::RegisterGuard*>(
+                    &move.guard().guard());
+            if (rg != NULL) {
+                auto first = firstRegisters.find(rg->registerFile());
+                if (first != firstRegisters.end()) {
+                    int reg = first->second + rg->registerIndex();
+                    if (!finished[reg]) {
+                        if (!n.isPlaced()) {
+                            cycles[reg] = INT_MAX;
+                            finished[reg] = true;
+                        } else if (n.cycle() > cycles[reg]) {
+                            cycles[reg] = n.cycle();
+                        }
+                    }
+                }
+            }
+        }
+        if (move.isFunctionCall()) {
+            for (unsigned int j = 0; j < paramRegs.size(); j++) {
+                int reg = paramRegs[j];
+                if (finished[reg]) {
+                    continue;
+                }
+                if (!n.isPlaced()) {
+                    cycles[reg] = INT_MAX;
+                    finished[reg] = true;
+                } else if (n.cycle() + delaySlots_ > cycles[reg]) {
+                    cycles[reg] = n.cycle() + delaySlots_;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Computes firstRegisterCycle() of many registers in a single pass over
+ * the graph.
+ *
+ * The registers are numbered as in lastRegisterCycles().
+ *
+ * @param firstRegisters Number of the first register of each register file.
+ * @param cycles Result vector, sized to the count of numbered registers.
+ * Element i is set to what firstRegisterCycle() returns for register i.
+ */
+void
+DataDependenceGraph::firstRegisterCycles(
+    const std::map<const TTAMachine::BaseRegisterFile*, int>& firstRegisters,
+    std::vector<int>& cycles) const {
+
+    std::fill(cycles.begin(), cycles.end(), INT_MAX);
+    // registers whose result is already known
+    std::vector<bool> finished(cycles.size(), false);
+    std::vector<int> paramRegs = paramRegisterNumbers(firstRegisters);
+
+    for (int i = nodeCount()-1; i >= 0; --i) {
+        MoveNode& n = node(i);
+        TTAProgram::Move& move = n.move();
+
+        // check source
+        TTAProgram::Terminal& source = move.source();
+        if (source.isImmediateRegister() || source.isGPR()) {
+            const TTAMachine::BaseRegisterFile* rf =
+                source.isImmediateRegister() ?
+                static_cast<const TTAMachine::BaseRegisterFile*>(
+                    &source.immediateUnit()) :
+                &source.registerFile();
+            auto first = firstRegisters.find(rf);
+            if (first != firstRegisters.end()) {
+                int reg = first->second + source.index();
+                if (!finished[reg]) {
+                    if (!n.isPlaced()) {
+                        cycles[reg] = -1;
+                        finished[reg] = true;
+                    } else if (n.cycle() < cycles[reg]) {
+                        cycles[reg] = n.cycle();
+                    }
+                }
+            }
+        }
+
+        // check destination
+        TTAProgram::Terminal& destination = move.destination();
+        if (destination.isGPR()) {
+            auto first = firstRegisters.find(&destination.registerFile());
+            if (first != firstRegisters.end()) {
+                int reg = first->second + destination.index();
+                if (!finished[reg]) {
+                    if (!n.isPlaced()) {
+                        cycles[reg] = -1;
+                        finished[reg] = true;
+                    } else {
+                        if (n.cycle() < cycles[reg]) {
+                            cycles[reg] = n.cycle();
+                        }
+                        // write of (constant) into reg, and no antideps in?
+                        if (move.isUnconditional() && inDegree(n) == 0) {
+                            assert(cycles[reg] == n.cycle());
+                            finished[reg] = true;
+                        }
+                    }
+                }
+            }
+        }
+
+        // check guard.
+        if (!move.isUnconditional()) {
+            const TTAMachine::RegisterGuard* rg =
+                dynamic_cast<const TTAMachine::RegisterGuard*>(
+                    &move.guard().guard());
+            if (rg != NULL) {
+                auto first = firstRegisters.find(rg->registerFile());
+                if (first != firstRegisters.end()) {
+                    int reg = first->second + rg->registerIndex();
+                    if (!finished[reg]) {
+                        if (!n.isPlaced()) {
+                            cycles[reg] = -1;
+                            finished[reg] = true;
+                        } else if (n.cycle() < cycles[reg]) {
+                            cycles[reg] = n.cycle();
+                        }
+                    }
+                }
+            }
+        }
+        if (move.isFunctionCall()) {
+            for (unsigned int j = 0; j < paramRegs.size(); j++) {
+                int reg = paramRegs[j];
+                if (finished[reg]) {
+                    continue;
+                }
+                if (!n.isPlaced()) {
+                    cycles[reg] = -1;
+                    finished[reg] = true;
+                } else if (n.cycle() + delaySlots_ < cycles[reg]) {
+                    cycles[reg] = n.cycle() + delaySlots_;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Returns the dense numbers of the function call parameter registers.
+ *
+ * @param firstRegisters Number of the first register of each register file.
+ * @return Numbers of the parameter registers found in the numbered RFs.
+ */
+std::vector<int>
+DataDependenceGraph::paramRegisterNumbers(
+    const std::map<const TTAMachine::BaseRegisterFile*, int>&
+    firstRegisters) const {
+
+    std::vector<int> numbers;
+    if (allParamRegs_.empty()) {
+        return numbers;
+    }
+    std::map<TCEString, int> firstByName;
+    for (auto i = firstRegisters.begin(); i != firstRegisters.end(); i++) {
+        if (dynamic_cast<const TTAMachine::RegisterFile*>(i->first) != NULL) {
+            firstByName[i->first->name()] = i->second;
+        }
+    }
+    for (std::set<TCEString>::const_iterator i = allParamRegs_.begin();
+         i != allParamRegs_.end(); i++) {
+        size_t dot = i->find('.');
+        if (dot == TCEString::npos) {
+            continue;
+        }
+        auto first = firstByName.find(i->substr(0, dot));
+        if (first != firstByName.end()) {
+            numbers.push_back(
+                first->second + atoi(i->substr(dot + 1).c_str()));
+        }
+    }
+    return numbers;
+}
+
+
 /**
  * Returns the set of MoveNodes which reads given register after
  * last unconditional scheduled write to the register.
@@ -3394,8 +3646,9 @@ DataDependenceGraph::createSubgraph(
     // also find POs to copy.
     for (int i = 0, nc = subGraph->nodeCount(); i < nc; i++) {
         MoveNode& mn = subGraph->node(i);
-        BasicBlockNode* bbn = moveNodeBlocks_[&mn];
-        subGraph->moveNodeBlocks_[&mn] = bbn;
+        auto bbn = moveNodeBlocks_.find(&mn);
+        subGraph->moveNodeBlocks_[&mn] =
+            bbn != moveNodeBlocks_.end() ? bbn->second : NULL;
         if (mn.isSourceOperation()) {
             subgraphPOs.insert(mn.sourceOperationPtr());
         }
@@ -3532,21 +3785,7 @@ DataDependenceGraph*
 DataDependenceGraph::createSubgraph(
     TTAProgram::CodeSnippet& cs, bool includeLoops)  {
     NodeSet moveNodes;
-    int nc = nodeCount();
-    for (int i = 0; i < nc; i++) {
-        MoveNode& mn = node(i,false);
-        if (mn.isMove()) {
-            TTAProgram::Move& move = mn.move();
-            if (move.isInInstruction()) {
-                TTAProgram::Instruction& parentIns = move.parent();
-                if (parentIns.isInProcedure()) { // is in code snippet
-                    if (&parentIns.parent() == &cs) {
-                        moveNodes.insert(&mn);
-                    }
-                }
-            } 
-        }
-    }
+    addNodesOfSnippet(cs, moveNodes);
     return createSubgraph(moveNodes, includeLoops);
 }
 
@@ -3563,26 +3802,36 @@ DataDependenceGraph*
 DataDependenceGraph::createSubgraph(
     std::list<TTAProgram::CodeSnippet*>& codeSnippets, bool includeLoops) {
     NodeSet moveNodes;
+    for (std::list<TTAProgram::CodeSnippet*>::iterator iter =
+             codeSnippets.begin();
+         iter != codeSnippets.end(); iter++) {
+        addNodesOfSnippet(**iter, moveNodes);
+    }
+    return createSubgraph(moveNodes, includeLoops);
+}
 
-    int nc = nodeCount();
-    for (int i = 0; i < nc; i++) {
-        MoveNode& mn = node(i,false);
-        if (mn.isMove()) {
-            TTAProgram::Move& move = mn.move();
-            TTAProgram::Instruction& parentIns = move.parent();
-            if (parentIns.isInProcedure()) { // is in code snippet
-                for (std::list<TTAProgram::CodeSnippet*>::iterator iter = 
-                         codeSnippets.begin(); 
-                     iter != codeSnippets.end(); iter++) {
-                    TTAProgram::CodeSnippet& cs = **iter;
-                    if (&move.parent().parent() == &cs) {
-                        moveNodes.insert(&mn);
-                    }
-                }
-            } 
+/**
+ * Adds the nodes of the moves of a code snippet to a node set.
+ *
+ * The nodes are looked up from the move to node map, so this costs
+ * O(moves in the snippet) instead of a scan over the whole graph.
+ *
+ * @param cs The code snippet.
+ * @param nodes The set to which the nodes in this graph are added.
+ */
+void
+DataDependenceGraph::addNodesOfSnippet(
+    TTAProgram::CodeSnippet& cs, NodeSet& nodes) {
+    for (int i = 0; i < cs.instructionCount(); i++) {
+        TTAProgram::Instruction& ins = cs.instructionAtIndex(i);
+        for (int j = 0; j < ins.moveCount(); j++) {
+            auto mn = nodesOfMoves_.find(&ins.move(j));
+            // the map may have stale entries of dropped nodes
+            if (mn != nodesOfMoves_.end() && hasNode(*mn->second)) {
+                nodes.insert(mn->second);
+            }
         }
     }
-    return createSubgraph(moveNodes, includeLoops);
 }
 
 /**
@@ -36,6 +36,7 @@
 #include <map>
 #include <set>
 #include <list>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include <utility>
@@ -216,6 +217,14 @@ public:
     int firstRegisterCycle(
         const TTAMachine::BaseRegisterFile& rf, int registerIndex) const;
 
+    void lastRegisterCycles(
+        const std::map<const TTAMachine::BaseRegisterFile*, int>&
+        firstRegisters, std::vector<int>& cycles) const;
+
+    void firstRegisterCycles(
+        const std::map<const TTAMachine::BaseRegisterFile*, int>&
+        firstRegisters, std::vector<int>& cycles) const;
+
     void sanityCheck() const;
 
     /// Dot printing related methods
@@ -427,15 +436,21 @@ private:
     
     int getOperationLatency(const TCEString& name) const;
 
+    void addNodesOfSnippet(TTAProgram::CodeSnippet& cs, NodeSet& nodes);
+
+    std::vector<int> paramRegisterNumbers(
+        const std::map<const TTAMachine::BaseRegisterFile*, int>&
+        firstRegisters) const;
+
     std::set<TCEString> allParamRegs_;
 
     // cache to make things faster
     // may not be used with iterator.
-    std::map<const TTAProgram::Move*, MoveNode*> nodesOfMoves_;
+    std::unordered_map<const TTAProgram::Move*, MoveNode*> nodesOfMoves_;
 
     // own all the programoperations
     POList programOperations_;
-    std::map<const MoveNode*, BasicBlockNode*> moveNodeBlocks_;
+    std::unordered_map<const MoveNode*, BasicBlockNode*> moveNodeBlocks_;
 
     /// Dot printing related variables.
     /// Group the printed MoveNodes according to their cycles.
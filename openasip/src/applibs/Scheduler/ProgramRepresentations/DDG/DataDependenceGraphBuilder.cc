@@ -2186,11 +2186,60 @@ DataDependenceGraphBuilder::build(
 /**
  * Initializes states of all BB's to unreached
  *
+ * Also numbers the BB's in the order they are taken from the queues.
+ * BB's reachable from the entry are numbered in reverse post-order, so
+ * that a BB is processed after its forward predecessors and loop headers
+ * before the loop bodies. Unreachable BB's follow in the CFG order.
+ *
+ * @param backwards whether the pass propagates data from a BB to its
+ *        predecessors, in which case the numbering is reversed.
  */
 void
-DataDependenceGraphBuilder::initializeBBStates() {
+DataDependenceGraphBuilder::initializeBBStates(bool backwards) {
+
+    // depth-first search from the entry to get the post-order.
+    std::vector<BasicBlockNode*> postOrder;
+    std::set<BasicBlockNode*> visited;
+    std::vector<std::pair<BasicBlockNode*, std::vector<BasicBlockNode*> > >
+        stack;
+    BasicBlockNode& entry = cfg_->entryNode();
+    visited.insert(&entry);
+    BasicBlockNodeSet entrySuccs = cfg_->successors(entry);
+    stack.push_back(std::make_pair(&entry, std::vector<BasicBlockNode*>(
+        entrySuccs.rbegin(), entrySuccs.rend())));
+    while (!stack.empty()) {
+        std::vector<BasicBlockNode*>& succs = stack.back().second;
+        if (succs.empty()) {
+            postOrder.push_back(stack.back().first);
+            stack.pop_back();
+            continue;
+        }
+        BasicBlockNode* succ = succs.back();
+        succs.pop_back();
+        if (visited.insert(succ).second) {
+            // visit the successors in the order of the successor set.
+            BasicBlockNodeSet succSuccs = cfg_->successors(*succ);
+            stack.push_back(std::make_pair(succ, std::vector<BasicBlockNode*>(
+                succSuccs.rbegin(), succSuccs.rend())));
+        }
+    }
+
+    std::map<BasicBlockNode*, int> order;
+    int nextOrder = 0;
+    for (int i = static_cast<int>(postOrder.size()) - 1; i >= 0; i--) {
+        order[postOrder[i]] = nextOrder++;
+    }
+    for (int bbi = 0; bbi < cfg_->nodeCount(); bbi++) {
+        BasicBlockNode& bbn = cfg_->node(bbi);
+        if (visited.find(&bbn) == visited.end()) {
+            order[&bbn] = nextOrder++;
+        }
+    }
 
     // initialize state lists
+    for (int i = 0; i < BB_STATES; i++) {
+        blocksByState_[i].clear();
+    }
     for (int bbi = 0; bbi < cfg_->nodeCount(); bbi++) {
         BasicBlockNode& bbn = cfg_->node(bbi);
         BasicBlock& bb = bbn.basicBlock();
@@ -2198,34 +2247,33 @@ DataDependenceGraphBuilder::initializeBBStates() {
             bb.liveRangeData_ = new LiveRangeData;
         }
         BBData* bbd = new BBData(bbn);
+        bbd->order_ = backwards ? nextOrder - 1 - order[&bbn] : order[&bbn];
         bbData_[&bbn] = bbd;
         // in the beginning all are unreached
         if (bbn.isNormalBB()) {
-            blocksByState_[BB_UNREACHED].push_back(bbd);
+            blocksByState_[BB_UNREACHED][bbd->order_] = bbd;
         }
     }
 }
 
 /**
  * Changes state of a basic block in processing.
- * Move BBData into a diffefent list and changes the state data in BBData.
+ * Move BBData into a diffefent queue and changes the state data in BBData.
+ *
+ * The queues are ordered by the processing order of the BBs, so a BB
+ * queued again for an update is taken before the BBs after it.
  *
  * @param bbd BBData of basic block whose state is being changed
  * @param newState the new state of the basic block.
 */
 void
-DataDependenceGraphBuilder::changeState(
-    BBData& bbd, BBState newState, bool priorize) {
+DataDependenceGraphBuilder::changeState(BBData& bbd, BBState newState) {
 
     BBState oldState = bbd.state_;
     if (newState != oldState) {
-        ContainerTools::removeValueIfExists(blocksByState_[oldState], &bbd);
+        blocksByState_[oldState].erase(bbd.order_);
         bbd.state_ = newState;
-        if (priorize) {
-            blocksByState_[newState].push_front(&bbd);
-        } else {
-            blocksByState_[newState].push_back(&bbd);
-        }
+        blocksByState_[newState][bbd.order_] = &bbd;
     }
 }
 
@@ -2296,7 +2344,7 @@ DataDependenceGraphBuilder::createRegisterDeps() {
                 std::endl;
 //            cfg.writeToDotFile("unreachable_bb.dot");
         }
-        changeState(**blocksByState_[BB_UNREACHED].begin(), BB_QUEUED);
+        changeState(*blocksByState_[BB_UNREACHED].begin()->second, BB_QUEUED);
         iterateBBs(REGISTERS_AND_PROGRAM_OPERATIONS);
     }
     // free bb data
@@ -2323,7 +2371,7 @@ DataDependenceGraphBuilder::createMemAndFUstateDeps() {
     // all should be constructed, but if there are unreachable BB's
     // we might want to handle those also
     while (!blocksByState_[BB_UNREACHED].empty()) {
-        changeState(**blocksByState_[BB_UNREACHED].begin(), BB_QUEUED);
+        changeState(*blocksByState_[BB_UNREACHED].begin()->second, BB_QUEUED);
         iterateBBs(MEMORY_AND_SIDE_EFFECTS);
     }
     // free bb data
@@ -2346,9 +2394,7 @@ DataDependenceGraphBuilder::iterateBBs(
     ConstructionPhase phase) {
 
     while (!blocksByState_[BB_QUEUED].empty()) {
-        std::list<BBData*>::iterator bbIter =
-            blocksByState_[BB_QUEUED].begin();
-        BBData& bbd = **bbIter;
+        BBData& bbd = *blocksByState_[BB_QUEUED].begin()->second;
 
         // construct or update BB
         if (bbd.constructed_) {
@@ -2499,7 +2545,7 @@ DataDependenceGraphBuilder::setSucceedingPredepsForBB(
 
     // need to queue successor for update?
     if (changed || queueAll) {
-        changeState(succData, BB_QUEUED, loop);
+        changeState(succData, BB_QUEUED);
     }
 }
 
@@ -2881,8 +2927,8 @@ void DataDependenceGraphBuilder::updateMemUse(
 void
 DataDependenceGraphBuilder::searchRegisterDeaths() {
 
-    // initializes states of all BB's to unreached.
-    initializeBBStates();
+    // initializes states of all BB's to unreached, successors first.
+    initializeBBStates(true);
 
     // start from end of cfg. (sink nodes), queue them
     ControlFlowGraph::NodeSet lastBBs = cfg_->sinkNodes();
@@ -2906,7 +2952,7 @@ DataDependenceGraphBuilder::searchRegisterDeaths() {
                 std::endl;
 //            cfg.writeToDotFile("4everloop_bb.dot");
         }
-        changeState(**blocksByState_[BB_UNREACHED].begin(), BB_QUEUED);
+        changeState(*blocksByState_[BB_UNREACHED].begin()->second, BB_QUEUED);
 
         iterateRegisterDeaths();
     }
@@ -2925,9 +2971,7 @@ DataDependenceGraphBuilder::iterateRegisterDeaths() {
 
     // loop as long as we have unprocessed/changed BB's
     while (!blocksByState_[BB_QUEUED].empty()) {
-        std::list<BBData*>::iterator bbIter =
-            blocksByState_[BB_QUEUED].begin();
-        BBData& bbd = **bbIter;
+        BBData& bbd = *blocksByState_[BB_QUEUED].begin()->second;
 
         // mark as ready
         changeState(bbd, BB_READY);
@@ -3033,7 +3077,7 @@ const TCEString DataDependenceGraphBuilder::RA_NAME = "RA";
  */
 DataDependenceGraphBuilder::BBData::BBData(BasicBlockNode& bb) :
     poReadsHandled_(0),
-    state_(BB_UNREACHED),  constructed_(false), bblock_(&bb) {
+    state_(BB_UNREACHED), order_(0), constructed_(false), bblock_(&bb) {
 }
 
 /**
@@ -135,13 +135,16 @@ protected:
         int poReadsHandled_;
         /// State of the BB.
         BBState state_;
+        /// Position of the BB in the processing order of the current pass.
+        int order_;
         /// Whether the BB has been constructed or not.
         bool constructed_;
         BasicBlockNode* bblock_;
     };
 
     typedef std::map <BasicBlockNode*, BBData*> BBDataMap;
-    typedef std::list<BBData*> BBDataList;
+    /// BBs of one state keyed by their position in the processing order.
+    typedef std::map<int, BBData*> BBDataQueue;
 
     void updatePreceedingRegistersUsedAfter(
         BBData& bbd, 
@@ -154,7 +157,7 @@ protected:
     bool updateMemAndFuAliveAfter(BBData& bbd);
     void createMemAndFUstateDeps();
     void createRegisterDeps();
-    void initializeBBStates();
+    void initializeBBStates(bool backwards = false);
     BasicBlockNode* queueFirstBB();
     
     void clearUnneededBookkeeping();
@@ -274,10 +277,7 @@ protected:
 
     // functions related to iterating over basic blocks 
 
-    void changeState(
-        BBData& bbd,
-        BBState newState,
-        bool priorize = false);
+    void changeState(BBData& bbd, BBState newState);
 
     bool isAlwaysDifferentFU(const MoveNode* srcMN, const MoveNode* dstMN);
 
@@ -306,7 +306,7 @@ protected:
         LiveRangeData::MoveNodeUseSet& dst,
         bool setLoopProperty);
 
-    BBDataList blocksByState_[BB_STATES];
+    BBDataQueue blocksByState_[BB_STATES];
 
     BBDataMap bbData_;
     BasicBlockNode* currentBB_;
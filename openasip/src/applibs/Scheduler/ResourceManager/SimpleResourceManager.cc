@@ -73,7 +73,7 @@ SimpleResourceManager*
 SimpleResourceManager::createRM(
     const TTAMachine::Machine& machine, unsigned int ii) {
     std::map<int, std::list< SimpleResourceManager*> >& pool =
-        rmPool_[&machine];
+        rmPool_.rms[&machine];
     std::list<SimpleResourceManager*>& iipool = pool[ii];
     if (iipool.empty()) {
         return new SimpleResourceManager(machine,ii);
@@ -94,7 +94,7 @@ void SimpleResourceManager::disposeRM(
     if (rm == NULL) return;
     if (allowReuse) {
         std::map<int, std::list< SimpleResourceManager*> >& pool =
-            rmPool_[&rm->machine()];
+            rmPool_.rms[&rm->machine()];
         pool[rm->initiationInterval()].push_back(rm);
         rm->clear();
     } else {
@@ -640,9 +640,20 @@ SimpleResourceManager::setBBN(const BasicBlockNode* bbn) {
     director_->setBBN(bbn);
 }
 
-std::map<const TTAMachine::Machine*, 
-         std::map<int, std::list< SimpleResourceManager*> > >
-SimpleResourceManager::rmPool_;
+/**
+ * Deletes the RMs left in the pool of a thread.
+ */
+SimpleResourceManager::RMPool::~RMPool() {
+    for (auto& machinePool : rms) {
+        for (auto& iiPool : machinePool.second) {
+            for (SimpleResourceManager* rm : iiPool.second) {
+                delete rm;
+            }
+        }
+    }
+}
+
+thread_local SimpleResourceManager::RMPool SimpleResourceManager::rmPool_;
 
 void SimpleResourceManager::setMaxCycle(unsigned int maxCycle) {
     director_->setMaxCycle(maxCycle);
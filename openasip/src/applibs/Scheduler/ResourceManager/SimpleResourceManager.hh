@@ -164,9 +164,16 @@ private:
 
     unsigned int resources;
     
-    static std::map<const TTAMachine::Machine*, 
-                    std::map<int, std::list< SimpleResourceManager*> > >
-    rmPool_;
+    /// Recyclable RMs of one scheduling thread, owns the RMs.
+    struct RMPool {
+        ~RMPool();
+        std::map<const TTAMachine::Machine*,
+                 std::map<int, std::list< SimpleResourceManager*> > > rms;
+    };
+
+    /// Recyclable RMs, separately for each scheduling thread. The RMs
+    /// are deleted when the thread exits.
+    static thread_local RMPool rmPool_;
 };
 
 #endif
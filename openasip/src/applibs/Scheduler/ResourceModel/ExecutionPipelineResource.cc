@@ -541,6 +541,7 @@ ExecutionPipelineResource::assignDestination(
                 }
             }
         }
+        updateTriggerCollisions(cycle, pIndex, 1);
         setResultWriten(pOp, cycle);
         setOperandsUsed(pOp, cycle);
     } else {
@@ -759,6 +760,7 @@ ExecutionPipelineResource::unassignDestination(
         msg += Conversion::toString(initiationInterval_);
         throw ModuleRunTimeError(__FILE__, __LINE__, __func__, msg);
     }
+    updateTriggerCollisions(cycle, resources->operationIndex(opName), -1);
     for (unsigned int i = 0; i < resources->maximalLatency(); i++) {
         int modic = instructionIndex(cycle+i);
         for (unsigned int j = 0 ; j < resources->numberOfResources(); j++) {
@@ -1278,20 +1280,20 @@ bool ExecutionPipelineResource::resourcesAllowTrigger(
     unsigned int rLat = resources->maximalLatency();
     unsigned int nRes = resources->numberOfResources();
 
-    if (maxCycle_ != INT_MAX) {
-        for (unsigned int i = 0; i < rLat && canAssign; i++) {
-            
-            for (unsigned int j = 0 ; j < nRes; j++) {
-                // is this resource needed by this operation?
-                if (resources->operationPipeline(pIndex,i,j)) {
-                // is the resource free?
-                    if (((unsigned int)(cycle + i)) > 
-                        (unsigned int)(maxCycle_)) {
-                        return false;
-                    }
-                }
-            }
-        }    
+    int lastResourceCycle = resources->lastResourceCycle(pIndex);
+    if (maxCycle_ != INT_MAX && lastResourceCycle != -1 &&
+        ((unsigned int)(cycle + lastResourceCycle)) >
+        (unsigned int)(maxCycle_)) {
+        return false;
+    }
+
+    // If no assigned trigger collides with this one, all the resources
+    // are free. Otherwise check the resources one by one as they may
+    // still be shared with moves of opposite guards. An operation longer
+    // than the initiation interval may collide with itself, so it is
+    // always checked one by one.
+    if (rLat <= ii && !triggerCollides(cycle, pIndex)) {
+        return true;
     }
 
     std::vector<std::vector<bool> >
@@ -1369,6 +1371,55 @@ bool ExecutionPipelineResource::resourcesAllowTrigger(
     return canAssign;
 }
 
+/**
+ * Updates the counts of assigned triggers colliding with triggers of
+ * other operations after a trigger is assigned or unassigned.
+ *
+ * @param cycle Cycle of the trigger.
+ * @param operationIndex Index of the operation of the trigger.
+ * @param change 1 if the trigger was assigned, -1 if unassigned.
+ */
+void
+ExecutionPipelineResource::updateTriggerCollisions(
+    int cycle, int operationIndex, int change) {
+
+    const ExecutionPipelineResourceTable::CollisionVector& collisions =
+        resources->collisions(operationIndex);
+    for (unsigned int i = 0; i < collisions.size(); i++) {
+        int collisionCycle = cycle + collisions[i].distance;
+        if (initiationInterval_ != 0) {
+            collisionCycle = ((collisionCycle % initiationInterval_) +
+                              initiationInterval_) % initiationInterval_;
+        } else if (collisionCycle < 0) {
+            continue;
+        }
+        std::vector<int>& counts = triggerCollisions_[collisionCycle];
+        if (counts.empty()) {
+            counts.resize(resources->pipelineSize(), 0);
+        }
+        counts[collisions[i].operation] += change;
+        assert(counts[collisions[i].operation] >= 0);
+    }
+}
+
+/**
+ * Tests whether an assigned trigger collides with a trigger of the given
+ * operation in the given cycle.
+ *
+ * @param cycle Cycle of the trigger.
+ * @param operationIndex Index of the operation of the trigger.
+ * @return True if some of the pipeline resources the trigger needs are
+ * already reserved.
+ */
+bool
+ExecutionPipelineResource::triggerCollides(
+    int cycle, int operationIndex) const {
+
+    TriggerCollisionTable::const_iterator i =
+        triggerCollisions_.find(instructionIndex(cycle));
+    return i != triggerCollisions_.end() && i->second[operationIndex] != 0;
+}
+
 /**
  * Always return true.
  *
@@ -1759,6 +1810,7 @@ void
 ExecutionPipelineResource::clear() {
     SchedulingResource::clear();
     fuExecutionPipeline_.clear();
+    triggerCollisions_.clear();
     resultWriten_.clear();
     operandsUsed_.clear();
     operandsWriten_.clear();
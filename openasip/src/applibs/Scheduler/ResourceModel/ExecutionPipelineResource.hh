@@ -59,6 +59,9 @@ namespace TTAMachine {
 /**
  * ExecutionPipelineResource keeps book of pipeline resource reservation
  * status. It uses rather simple resource reservation table approach.
+ * Collisions between triggers are precomputed per FU so that a trigger
+ * which collides with none of the assigned ones is accepted without
+ * walking through the reservation table.
  *
  */
 class ExecutionPipelineResource : public SchedulingResource {
@@ -173,6 +176,10 @@ private:
     /// Type for resource reservation table, resource vector x latency.
     /// Includes the ownerships of the reservation.
     typedef SparseVector<ResourceReservationVector> ResourceReservationTable;
+
+    /// Type for counting the assigned triggers colliding with a trigger
+    /// of each operation, one vector of counts per cycle.
+    typedef SparseVector<std::vector<int> > TriggerCollisionTable;
     
 
     //Copying forbidden
@@ -245,6 +252,10 @@ private:
 
     bool resourcesAllowTrigger(int cycle, const MoveNode& move) const;
 
+    void updateTriggerCollisions(int cycle, int operationIndex, int change);
+
+    bool triggerCollides(int cycle, int operationIndex) const;
+
     bool operandPossibleAtCycle(
         const TTAMachine::Port& port, const MoveNode& mn, int cycle) const;
 
@@ -296,6 +307,8 @@ private:
 
     /// Stores one resource vector per cycle of scope for whole FU
     mutable ResourceReservationTable fuExecutionPipeline_;
+    /// Assigned triggers colliding with a trigger in a cycle
+    TriggerCollisionTable triggerCollisions_;
 
     // Stores PO for each "result ready" a cycle in which it was produced,
 #if 0
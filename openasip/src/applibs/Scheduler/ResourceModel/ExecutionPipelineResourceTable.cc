@@ -88,6 +88,65 @@ ExecutionPipelineResourceTable::ExecutionPipelineResourceTable(
             setLatency(opName, index, latency);
         }
     }
+    computeCollisions();
+}
+
+/**
+ * Precomputes which triggers collide with each other.
+ *
+ * Two triggers collide when both operations would use the same resource
+ * on the same cycle. A trigger of an operation that uses a resource k
+ * cycles after its trigger collides with a trigger of an operation that
+ * uses the same resource i cycles after its trigger when the latter
+ * trigger is k-i cycles after the former one.
+ */
+void
+ExecutionPipelineResourceTable::computeCollisions() {
+
+    const int opCount = operationPipelines_.size();
+    // (cycle, resource) pairs each operation uses, by resource
+    std::vector<std::vector<std::vector<int> > > uses(
+        opCount, std::vector<std::vector<int> >(numberOfResources_));
+    lastResourceCycles_.assign(opCount, -1);
+    for (int op = 0; op < opCount; op++) {
+        const ResourceTable& table = operationPipelines_[op];
+        for (unsigned int cycle = 0; cycle < table.size(); cycle++) {
+            for (unsigned int res = 0; res < table[cycle].size(); res++) {
+                if (table[cycle][res]) {
+                    uses[op][res].push_back(cycle);
+                    lastResourceCycles_[op] = cycle;
+                }
+            }
+        }
+    }
+
+    // distances range from -(maximalLatency_ - 1) to maximalLatency_ - 1
+    const int distanceCount = 2 * maximalLatency_ + 1;
+    collisions_.assign(opCount, CollisionVector());
+    for (int op = 0; op < opCount; op++) {
+        for (int other = 0; other < opCount; other++) {
+            std::vector<bool> colliding(distanceCount, false);
+            for (int res = 0; res < numberOfResources_; res++) {
+                const std::vector<int>& opUses = uses[op][res];
+                const std::vector<int>& otherUses = uses[other][res];
+                for (unsigned int i = 0; i < opUses.size(); i++) {
+                    for (unsigned int j = 0; j < otherUses.size(); j++) {
+                        colliding[
+                            opUses[i] - otherUses[j] + maximalLatency_] =
+                            true;
+                    }
+                }
+            }
+            for (int d = 0; d < distanceCount; d++) {
+                if (colliding[d]) {
+                    Collision collision;
+                    collision.distance = d - (int)maximalLatency_;
+                    collision.operation = other;
+                    collisions_[op].push_back(collision);
+                }
+            }
+        }
+    }
 }
 
 /**
@@ -172,7 +231,7 @@ ExecutionPipelineResourceTable::resourceTable(
 
     ExecutionPipelineResourceTable* newTable = 
         new ExecutionPipelineResourceTable(fu);
-    allResourceTables_[&fu] = newTable;
+    allResourceTables_[&fu].reset(newTable);
     return *newTable;
 }
 
@@ -183,8 +242,8 @@ ExecutionPipelineResourceTable::resourceTable(
  */
 void
 ExecutionPipelineResourceTable::finalize() {
-    MapTools::deleteAllValues(allResourceTables_);
+    allResourceTables_.clear();
 }
 
-ExecutionPipelineResourceTable::ResourceTableMap 
+thread_local ExecutionPipelineResourceTable::ResourceTableMap 
 ExecutionPipelineResourceTable::allResourceTables_;
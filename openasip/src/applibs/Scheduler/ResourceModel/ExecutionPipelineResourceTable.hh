@@ -35,6 +35,7 @@
 
 #include <string>
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace TTAMachine {
@@ -43,6 +44,16 @@ namespace TTAMachine {
 
 class ExecutionPipelineResourceTable {
 public:
+    /// A trigger of an operation that collides with a trigger of another.
+    struct Collision {
+        /// Cycle of the colliding trigger relative to the other trigger.
+        int distance;
+        /// Index of the colliding operation.
+        int operation;
+    };
+    /// Collisions of one operation with all the operations of the FU.
+    typedef std::vector<Collision> CollisionVector;
+
     inline unsigned int numberOfResources() const;
     inline unsigned int pipelineSize() const;
     inline unsigned int maximalLatency() const;
@@ -57,6 +68,9 @@ public:
         unsigned int operationIndex) const;
 
 
+    inline const CollisionVector& collisions(int op) const;
+    inline int lastResourceCycle(int op) const;
+
     inline const std::string& name() const;
 
     static const ExecutionPipelineResourceTable& resourceTable(
@@ -74,6 +88,8 @@ private:
     void setResourceUse(
         const std::string& opName, const int cycle, const int resIndex);
 
+    void computeCollisions();
+
     std::string name_;
 
     /// Type for resource vector, represents one cycle of use
@@ -82,8 +98,9 @@ private:
     /// Type for resource reservation table, resource vector x latency
     typedef std::vector<ResourceVector> ResourceTable;
 
-    typedef std::map<const TTAMachine::FunctionUnit*, 
-                     ExecutionPipelineResourceTable*> ResourceTableMap;
+    typedef std::map<const TTAMachine::FunctionUnit*,
+                     std::unique_ptr<ExecutionPipelineResourceTable> >
+    ResourceTableMap;
 
     /// Resource and ports vector width, depends on particular FU
     int numberOfResources_;
@@ -95,9 +112,15 @@ private:
     std::vector<std::map<int,int> > operationLatencies_;
     /// Pipelines for operations
     std::vector<ResourceTable> operationPipelines_;
-
-    /// Contains these tables for all FU's
-    static ResourceTableMap allResourceTables_;
+    /// Triggers colliding with a trigger of each operation, the index
+    /// is the operation index.
+    std::vector<CollisionVector> collisions_;
+    /// Last cycle each operation uses any resource in, -1 if none.
+    std::vector<int> lastResourceCycles_;
+
+    /// Contains these tables for all FU's, separately for each thread.
+    /// The tables are deleted when the thread exits.
+    static thread_local ResourceTableMap allResourceTables_;
 };
 
 #include "ExecutionPipelineResourceTable.icc"
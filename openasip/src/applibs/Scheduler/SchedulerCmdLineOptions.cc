@@ -54,6 +54,12 @@ const std::string SchedulerCmdLineOptions::SWL_IF_CONVERSION_THRESHOLD =
     "if-conversion-threshold";
 const std::string SchedulerCmdLineOptions::SWL_LOWMEM_MODE_THRESHOLD = 
     "lowmem-mode-threshold";
+const std::string SchedulerCmdLineOptions::SWL_BB_TIME_BUDGET =
+    "bb-time-budget";
+const std::string SchedulerCmdLineOptions::SWL_BB_STEP_BUDGET =
+    "bb-step-budget";
+const std::string SchedulerCmdLineOptions::SWL_PROCEDURE_TIME_BUDGET =
+    "procedure-time-budget";
 const std::string SchedulerCmdLineOptions::SWL_RESTRICTED_AA = "restricted-aa";
 const std::string SchedulerCmdLineOptions::SWL_STACK_AA = "stack-aa";
 const std::string SchedulerCmdLineOptions::SWL_OFFSET_AA = "offset-aa";
@@ -122,6 +128,27 @@ SchedulerCmdLineOptions::SchedulerCmdLineOptions(): CmdLineOptions(USAGE) {
             "which saves memory from scheduler but "
             "disables some optimizations."));
 
+    addOption(
+        new IntegerCmdLineOptionParser(
+            SWL_BB_TIME_BUDGET,
+            "Wall time in milliseconds the scheduler may spend on one basic "
+            "block. Blocks exceeding it are scheduled again with the "
+            "cheaper list scheduler."));
+
+    addOption(
+        new IntegerCmdLineOptionParser(
+            SWL_BB_STEP_BUDGET,
+            "Maximum number of operation scheduling steps the scheduler may "
+            "take in one basic block before falling back to the cheaper "
+            "list scheduler."));
+
+    addOption(
+        new IntegerCmdLineOptionParser(
+            SWL_PROCEDURE_TIME_BUDGET,
+            "Wall time in milliseconds the scheduler may spend on one "
+            "procedure. The rest of the basic blocks of a procedure "
+            "exceeding it are scheduled with the cheaper list scheduler."));
+
     addOption(
         new BoolCmdLineOptionParser(
             SWL_OFFSET_AA, "Enable constant offset alias analyzer. On by default."));
@@ -316,6 +343,48 @@ SchedulerCmdLineOptions::lowMemModeThreshold() const {
 }
 
 
+/**
+ * Returns the wall time budget for scheduling one basic block.
+ *
+ * @return The budget in milliseconds, or -1 if not given.
+ */
+int
+SchedulerCmdLineOptions::basicBlockTimeBudget() const {
+    if (!findOption(SWL_BB_TIME_BUDGET)->isDefined()) {
+        return -1;
+    } else {
+        return findOption(SWL_BB_TIME_BUDGET)->integer();
+    }
+}
+
+/**
+ * Returns the maximum number of scheduling steps for one basic block.
+ *
+ * @return The step count, or -1 if not given.
+ */
+int
+SchedulerCmdLineOptions::basicBlockStepBudget() const {
+    if (!findOption(SWL_BB_STEP_BUDGET)->isDefined()) {
+        return -1;
+    } else {
+        return findOption(SWL_BB_STEP_BUDGET)->integer();
+    }
+}
+
+/**
+ * Returns the wall time budget for scheduling one procedure.
+ *
+ * @return The budget in milliseconds, or -1 if not given.
+ */
+int
+SchedulerCmdLineOptions::procedureTimeBudget() const {
+    if (!findOption(SWL_PROCEDURE_TIME_BUDGET)->isDefined()) {
+        return -1;
+    } else {
+        return findOption(SWL_PROCEDURE_TIME_BUDGET)->integer();
+    }
+}
+
 
 /**
  * Returns the bypass limit when dead result elimination can be used.
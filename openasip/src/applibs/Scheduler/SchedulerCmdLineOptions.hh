@@ -76,6 +76,10 @@ public:
 
     virtual int lowMemModeThreshold() const;
 
+    virtual int basicBlockTimeBudget() const;
+    virtual int basicBlockStepBudget() const;
+    virtual int procedureTimeBudget() const;
+
     virtual bool isLoopOptDefined() const;
     virtual int bypassDistance() const;
     virtual int noDreBypassDistance() const;
@@ -103,6 +107,9 @@ private:
     static const std::string SWL_RESTRICTED_AA;
     static const std::string SWL_IF_CONVERSION_THRESHOLD;
     static const std::string SWL_LOWMEM_MODE_THRESHOLD;
+    static const std::string SWL_BB_TIME_BUDGET;
+    static const std::string SWL_BB_STEP_BUDGET;
+    static const std::string SWL_PROCEDURE_TIME_BUDGET;
     static const std::string SWL_RESOURCE_CONSTRAINT_PRINTING;
     static const std::string SWL_KILL_DEAD_RESULTS;
     static const std::string SWL_NO_DRE_BYPASS_DISTANCE;
@@ -33,10 +33,7 @@
 #include "CompiledSimUtilizationStats.hh"
 #include "Program.hh"
 #include "CompiledSimulation.hh"
-#include "Instruction.hh"
-#include "NullInstruction.hh"
-#include "ExecutableInstruction.hh"
-#include "ExecutableMove.hh"
+#include "ProgramUtilizationIndex.hh"
 
 using namespace TTAProgram;
 using namespace TTAMachine;
@@ -57,27 +54,32 @@ void
 CompiledSimUtilizationStats::calculate(
     const TTAProgram::Program& program, 
     const CompiledSimulation& compiledSim) {
-        
-    // Loop all instructions of a program
-    const Instruction* instr = &program.firstInstruction();
-    
-    int moveNumber = 0;
-    
-    while (instr != &NullInstruction::instance()) {
-        
-        ExecutableInstruction executableInstr;
 
-        // Add moves and their execution counts
-        for (int i = 0; i < instr->moveCount(); ++i, moveNumber++) {
-            ClockCycleCount execCount = compiledSim.moveExecutionCount(
-                moveNumber, instr->address().location());
-            DummyExecutableMove* move = new DummyExecutableMove(execCount);
-            executableInstr.addExecutableMove(move);
-        }
+    ProgramUtilizationIndex index(program);
+    calculate(index, compiledSim);
+}
 
-        // Calculate execution counts so far
-        UtilizationStats::calculateForInstruction(*instr, executableInstr);
-                
-        instr = &program.nextInstruction(*instr);
+/**
+ * Calculates the utilization statistics of a compiled simulation run using
+ * the precomputed utilization index of the program.
+ *
+ * @param index The utilization index of the simulated program.
+ * @param compiledSim The compiled simulation.
+ */
+void
+CompiledSimUtilizationStats::calculate(
+    const ProgramUtilizationIndex& index,
+    const CompiledSimulation& compiledSim) {
+
+    std::vector<ClockCycleCount> moveCounts(index.moveCount(), 0);
+    for (std::size_t i = 0; i < index.instructionCount(); ++i) {
+        const std::size_t first = index.firstMove(i);
+        for (std::size_t m = 0; m < index.moveCount(i); ++m) {
+            moveCounts[first + m] = compiledSim.moveExecutionCount(
+                first + m, index.instructionAddress(i));
+        }
     }
+    // all instructions are counted, also the ones not executed
+    std::vector<char> countedMoves(index.moveCount(), 1);
+    UtilizationStats::calculate(index, moveCounts, countedMoves);
 }
@@ -40,6 +40,7 @@ namespace TTAProgram {
 }
 
 class CompiledSimulation;
+class ProgramUtilizationIndex;
 
 /**
  * Calculates processor utilization data for compiled simulations
@@ -52,6 +53,9 @@ public:
     virtual void calculate(
         const TTAProgram::Program& program, 
         const CompiledSimulation& compiledSim);
+    virtual void calculate(
+        const ProgramUtilizationIndex& index,
+        const CompiledSimulation& compiledSim);
 
 private:
 
@@ -42,9 +42,11 @@
 /**
  * Constructor.
  *
- * Initializes the FSA to a lazy mode in which the states are built when
- * they are needed the first time. In order to initialize all states, 
- * call initializeAllStates().
+ * Uses the completely built FSA shared by all detectors of FUs with an
+ * identical pipeline. In case the FSA of the FU is too large to be built
+ * completely, it is initialized to a lazy mode in which the states are
+ * built when they are needed the first time. In order to initialize all
+ * states in that case, call initializeAllStates().
  *
  * @param fu The function unit to detect conflicts for.
  * @exception InvalidData If the model could not be built from the given FU.
@@ -72,7 +74,7 @@ FSAFUResourceConflictDetector::~FSAFUResourceConflictDetector() {
  */
 void
 FSAFUResourceConflictDetector::initializeAllStates() {
-    pimpl_->fsa_.buildStateMachine();
+    pimpl_->fsa_->buildStateMachine();
 }
 
 /**
@@ -85,7 +87,7 @@ FSAFUResourceConflictDetector::writeToDotFile(
     const TCEString& fileName) const {
 
     std::ofstream dot(fileName.c_str());
-    dot << pimpl_->fsa_.toDotString() << std::endl;
+    dot << pimpl_->fsa_->toDotString() << std::endl;
     dot.close();
 }
 
@@ -108,7 +110,7 @@ FSAFUResourceConflictDetector::issueOperation(OperationID id) {
  */
 const char*
 FSAFUResourceConflictDetector::operationName(OperationID id) const {
-    return pimpl_->fsa_.transitionName(id).c_str();
+    return pimpl_->fsa_->transitionName(id).c_str();
 }
 
 /**
@@ -134,7 +136,7 @@ FSAFUResourceConflictDetector::OperationID
 FSAFUResourceConflictDetector::operationID(
     const TCEString& operationName) const {
 
-    return pimpl_->fsa_.transitionIndex(
+    return pimpl_->fsa_->transitionIndex(
         StringTools::stringToUpper(operationName));
 }
 
@@ -145,7 +147,7 @@ FSAFUResourceConflictDetector::operationID(
  */
 void
 FSAFUResourceConflictDetector::reset() {
-    pimpl_->currentState_ = pimpl_->fsa_.startState();
+    pimpl_->currentState_ = pimpl_->fsa_->startState();
     issueOperation(pimpl_->NOP);
 }
 
@@ -155,7 +157,7 @@ FSAFUResourceConflictDetector::reset() {
  */
 bool
 FSAFUResourceConflictDetector::isIdle() {
-    return pimpl_->currentState_ == pimpl_->fsa_.startState() 
+    return pimpl_->currentState_ == pimpl_->fsa_->startState() 
         && pimpl_->currentState_ == pimpl_->nextState_;
 }
 
@@ -183,7 +185,7 @@ FSAFUResourceConflictDetector::isIdle() {
 bool
 FSAFUResourceConflictDetector::issueOperationInline(OperationID id) {
 
-    pimpl_->nextState_ = pimpl_->fsa_.transitions_[pimpl_->currentState_][id];
+    pimpl_->nextState_ = pimpl_->fsa_->transitions_[pimpl_->currentState_][id];
     if (pimpl_->nextState_ == FiniteStateAutomaton::ILLEGAL_STATE) {
         pimpl_->nextState_ = 0;
         return false;
@@ -204,9 +206,9 @@ FSAFUResourceConflictDetector::issueOperationInline(OperationID id) {
 bool
 FSAFUResourceConflictDetector::issueOperationLazyInline(OperationID id) {
 
-    pimpl_->nextState_ = pimpl_->fsa_.transitions_[pimpl_->currentState_][id];
+    pimpl_->nextState_ = pimpl_->fsa_->transitions_[pimpl_->currentState_][id];
     if (pimpl_->nextState_ == FiniteStateAutomaton::UNKNOWN_STATE) {
-        pimpl_->nextState_ = pimpl_->fsa_.resolveState(pimpl_->currentState_, id);
+        pimpl_->nextState_ = pimpl_->fsa_->resolveState(pimpl_->currentState_, id);
     }    
     if (pimpl_->nextState_ == FiniteStateAutomaton::ILLEGAL_STATE) {
         pimpl_->nextState_ = 0;
@@ -234,7 +236,7 @@ FSAFUResourceConflictDetector::advanceCycleInline() {
     // issue NOP transition at the next cycle in case there are no other
     // operation issues
     pimpl_->nextState_ = pimpl_->
-        fsa_.transitions_[pimpl_->currentState_][pimpl_->NOP];
+        fsa_->transitions_[pimpl_->currentState_][pimpl_->NOP];
     return true;
 }
 
@@ -256,9 +258,9 @@ FSAFUResourceConflictDetector::advanceCycleLazyInline() {
     pimpl_->currentState_ = pimpl_->nextState_;
     // issue NOP transition at the next cycle in case there are no other
     // operation issues
-    pimpl_->nextState_ = pimpl_->fsa_.transitions_[pimpl_->currentState_][pimpl_->NOP];
+    pimpl_->nextState_ = pimpl_->fsa_->transitions_[pimpl_->currentState_][pimpl_->NOP];
     if (pimpl_->nextState_ == FiniteStateAutomaton::UNKNOWN_STATE) {
-        pimpl_->nextState_ = pimpl_->fsa_.resolveState(
+        pimpl_->nextState_ = pimpl_->fsa_->resolveState(
             pimpl_->currentState_, pimpl_->NOP);
     }    
     return true;
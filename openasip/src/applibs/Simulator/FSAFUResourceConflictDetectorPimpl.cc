@@ -36,9 +36,9 @@
 
 FSAFUResourceConflictDetectorPimpl::FSAFUResourceConflictDetectorPimpl(
     const TTAMachine::FunctionUnit& fu) :
-    fsa_(fu, true),
-    currentState_(fsa_.startState()),  
-    operationIssued_(false), NOP(fsa_.transitionIndex("[NOP]")), 
+    fsa_(FUFiniteStateAutomaton::sharedAutomaton(fu)),
+    currentState_(fsa_->startState()),  
+    operationIssued_(false), NOP(fsa_->transitionIndex("[NOP]")), 
     fuName_(fu.name()) {
 }
 
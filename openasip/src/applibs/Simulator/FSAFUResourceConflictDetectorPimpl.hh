@@ -58,8 +58,8 @@ public:
 private:
     FSAFUResourceConflictDetectorPimpl(const TTAMachine::FunctionUnit& fu);
 
-    /// The FSA.
-    FUFiniteStateAutomaton fsa_;
+    /// The FSA, possibly shared with other detectors of identical FUs.
+    FUFiniteStateAutomaton::Handle fsa_;
     /// Current state of the FSA.
     FiniteStateAutomaton::FSAStateIndex currentState_;
     /// The next state of the FSA (move to currentState in cycle advance).
@@ -43,6 +43,7 @@
 #include "Conversion.hh"
 #include <iostream>
 #include <fstream>
+#include <vector>
 
 /**
  * Constructor.
@@ -194,6 +195,29 @@ MemDumpCommand::execute(const std::vector<DataObject>& arguments) {
     }
 
     MAUsToDisplay = newMAUCount;
+
+    if (dumpToFile) {
+        // 8 bit MAUs are read as one block and written out a byte each
+        std::vector<Memory::MAU> data(newDisplayedCount);
+        try {
+            memory->readBlock(newDisplayedAddress, data.data(), data.size());
+        } catch (const OutOfRange&) {
+            delete out;
+            interpreter()->setResult(
+                SimulatorToolbox::textGenerator().text(
+                    Texts::TXT_ADDRESS_OUT_OF_RANGE).str());
+            interpreter()->setError(true);
+            return false;        
+        }
+        std::vector<char> bytes(data.begin(), data.end());
+        out->write(bytes.data(), bytes.size());
+        out->close();
+        delete out;
+        out = NULL;
+        interpreter()->setResult(new DataObject(""));
+        return true;
+    }
+
     DataObject* result = new DataObject("");
     // read the wanted number (given with /n) of chunks of data to the result 
     while (newDisplayedCount > 0) {
@@ -213,25 +237,16 @@ MemDumpCommand::execute(const std::vector<DataObject>& arguments) {
         newDisplayedCount--;
         newDisplayedAddress += MAUsToDisplay;
 
-        if (!dumpToFile) {
-            const int HEX_DIGITS = MAUSize*newMAUCount/4;
-            result->setString(
-                result->stringValue() + 
-                Conversion::toHexString(data, HEX_DIGITS));
+        const int HEX_DIGITS = MAUSize*newMAUCount/4;
+        result->setString(
+            result->stringValue() + 
+            Conversion::toHexString(data, HEX_DIGITS));
 
-            if (newDisplayedCount > 0) {
-                result->setString(result->stringValue() + " ");
-            }
-        } else {
-            *out << (char)data;
+        if (newDisplayedCount > 0) {
+            result->setString(result->stringValue() + " ");
         }
     }
 
-    if (dumpToFile) {
-        out->close();
-        delete out;
-        out = NULL;
-    }
     interpreter()->setResult(result);
     return true;
 }
@@ -44,6 +44,8 @@
 #include "FileSystem.hh"
 #include <iostream>
 #include <fstream>
+#include <vector>
+#include <algorithm>
 
 
 MemWriteCommand::MemWriteCommand() : 
@@ -97,9 +99,11 @@ MemWriteCommand::execute(const std::vector<DataObject>& arguments) {
         return false;
     }
 
-    size_t readSize = FileSystem::sizeInBytes(fileName);
+    const size_t fileSize = FileSystem::sizeInBytes(fileName);
+    size_t readSize = fileSize;
     if (argumentCount == 3 || argumentCount == 5) {
-        readSize = arguments.at(nextArg + 2).integerValue();
+        readSize = std::min(
+            fileSize, (size_t)arguments.at(nextArg + 2).integerValue());
     }
 
     MemorySystem::MemoryPtr memory;
@@ -108,20 +112,21 @@ MemWriteCommand::execute(const std::vector<DataObject>& arguments) {
     }
 
     std::ifstream inputFile(fileName.c_str(), std::ios::binary);
-    char dataByte;
-
-    while (inputFile.get(dataByte) && readSize > 0) {
-        try {
-            memory->write(writeAddress, 1, (UIntWord)dataByte);
-        } catch (const OutOfRange&) {
-            interpreter()->setResult(
-                SimulatorToolbox::textGenerator().text(
-                    Texts::TXT_ADDRESS_OUT_OF_RANGE).str());
-            interpreter()->setError(true);
-            return false;        
-        }
-        writeAddress++;
-        readSize--;
+    std::vector<char> bytes(readSize);
+    inputFile.read(bytes.data(), readSize);
+    std::vector<Memory::MAU> data(inputFile.gcount());
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<unsigned char>(bytes[i]);
+    }
+
+    try {
+        memory->writeBlock(writeAddress, data.data(), data.size());
+    } catch (const OutOfRange&) {
+        interpreter()->setResult(
+            SimulatorToolbox::textGenerator().text(
+                Texts::TXT_ADDRESS_OUT_OF_RANGE).str());
+        interpreter()->setError(true);
+        return false;        
     }
     memory->advanceClock();
     inputFile.close();
@@ -69,6 +69,16 @@ public:
     virtual void read(ULongWord address, int size, ULongWord& data)
         { memory_->write(address, size, data); }
 
+    virtual void writeBlock(
+        ULongWord address, const MAU* data, std::size_t count) override
+        { memory_->writeBlock(address, data, count); }
+    virtual void readBlock(
+        ULongWord address, MAU* data, std::size_t count) override
+        { memory_->readBlock(address, data, count); }
+    virtual void fill(
+        ULongWord address, MAU value, std::size_t count) override
+        { memory_->fill(address, value, count); }
+
     virtual void fillWithZeros() { memory_->fillWithZeros(); }
 
     unsigned int readAccessCount() const;
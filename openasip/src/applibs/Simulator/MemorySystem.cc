@@ -38,6 +38,7 @@
 #include "Machine.hh"
 #include "AddressSpace.hh"
 #include "Memory.hh"
+#include "SharedMemory.hh"
 #include "MapTools.hh"
 #include "Application.hh"
 #include "SequenceTools.hh"
@@ -127,6 +128,10 @@ MemorySystem::hasMemory(const TCEString& aSpaceName) const {
  * The matching is done by the address space name. The shared address
  * space must have the 'shared' attribute set.
  *
+ * In case the memory of the other core is a SharedMemory, this core gets
+ * a port of its own to it that buffers the writes of this core until
+ * the other core advances the clock of its shared memories.
+ *
  * @fixme An untested method.
  */
 void
@@ -151,7 +156,15 @@ MemorySystem::shareMemoriesWith(MemorySystem& other) {
 
         replacedSharedMemories_.push_back(memories_[thisAS]);
 
-        memories_[thisAS] = other.memory(i);
+        SharedMemory* shared =
+            dynamic_cast<SharedMemory*>(other.memory(i).get());
+        if (shared != NULL) {
+            memories_[thisAS] = shared->addCore();
+            // reset with the rest of the memories of this core
+            memoryList_.push_back(memories_[thisAS]);
+        } else {
+            memories_[thisAS] = other.memory(i);
+        }
 
     }
 }
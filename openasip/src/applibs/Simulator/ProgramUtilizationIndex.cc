@@ -0,0 +1,426 @@
+/*
+    Copyright (c) 2002-2026 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file ProgramUtilizationIndex.cc
+ *
+ * Implementation of ProgramUtilizationIndex class.
+ *
+ * @note rating: red
+ */
+
+#include <algorithm>
+#include <set>
+#include <thread>
+
+#include "ProgramUtilizationIndex.hh"
+#include "Program.hh"
+#include "Instruction.hh"
+#include "NullInstruction.hh"
+#include "Address.hh"
+#include "Move.hh"
+#include "MoveGuard.hh"
+#include "Terminal.hh"
+#include "Operation.hh"
+#include "FunctionUnit.hh"
+#include "ImmediateUnit.hh"
+#include "RegisterFile.hh"
+#include "Bus.hh"
+#include "Socket.hh"
+#include "BaseFUPort.hh"
+#include "FUPort.hh"
+#include "Guard.hh"
+#include "StringTools.hh"
+#include "Conversion.hh"
+
+/// Number of counted moves below which the reduction is not parallelized.
+static const std::size_t PARALLEL_REDUCTION_THRESHOLD = 1 << 16;
+
+/**
+ * Constructor.
+ *
+ * Resolves the machine parts used by the moves of the given program.
+ *
+ * @param program The program.
+ */
+ProgramUtilizationIndex::ProgramUtilizationIndex(
+    const TTAProgram::Program& program) : startInstruction_(0) {
+
+    const InstructionAddress startAddress = 
+        program.startAddress().location();
+    firstMoves_.push_back(0);
+    const TTAProgram::Instruction* instruction = &program.firstInstruction();
+    while (instruction != &TTAProgram::NullInstruction::instance()) {
+        if (instruction->address().location() == startAddress &&
+            instruction->size() != 0) {
+            startInstruction_ = addresses_.size();
+        }
+        addInstruction(*instruction);
+        instruction = &program.nextInstruction(*instruction);
+    }
+
+    // sort the counted moves by the counters for the reduction
+    firstCounterMoves_.assign(counters_.size() + 1, 0);
+    for (std::size_t i = 0; i < contributions_.size(); ++i) {
+        ++firstCounterMoves_[contributions_[i].first + 1];
+    }
+    for (std::size_t i = 0; i < counters_.size(); ++i) {
+        firstCounterMoves_[i + 1] += firstCounterMoves_[i];
+    }
+    std::vector<std::size_t> next(
+        firstCounterMoves_.begin(), firstCounterMoves_.end() - 1);
+    counterMoves_.resize(contributions_.size());
+    for (std::size_t i = 0; i < contributions_.size(); ++i) {
+        counterMoves_[next[contributions_[i].first]++] =
+            contributions_[i].second;
+    }
+    contributions_.clear();
+    counterKeys_.clear();
+}
+
+/**
+ * Destructor.
+ */
+ProgramUtilizationIndex::~ProgramUtilizationIndex() {
+}
+
+/**
+ * Returns the number of instructions in the program.
+ */
+std::size_t
+ProgramUtilizationIndex::instructionCount() const {
+    return addresses_.size();
+}
+
+/**
+ * Returns the index of the instruction at the start address of the program.
+ */
+std::size_t
+ProgramUtilizationIndex::startInstruction() const {
+    return startInstruction_;
+}
+
+/**
+ * Returns the address of the given instruction.
+ *
+ * @param instruction Index of the instruction in the program order.
+ */
+InstructionAddress
+ProgramUtilizationIndex::instructionAddress(std::size_t instruction) const {
+    return addresses_[instruction];
+}
+
+/**
+ * Tells whether the given instruction is an implicit one, that is, is
+ * executed after the explicit instruction in the same address.
+ *
+ * @param instruction Index of the instruction in the program order.
+ */
+bool
+ProgramUtilizationIndex::isImplicit(std::size_t instruction) const {
+    return implicit_[instruction];
+}
+
+/**
+ * Returns the index of the first move of the given instruction.
+ *
+ * @param instruction Index of the instruction in the program order.
+ */
+std::size_t
+ProgramUtilizationIndex::firstMove(std::size_t instruction) const {
+    return firstMoves_[instruction];
+}
+
+/**
+ * Returns the number of moves in the given instruction.
+ *
+ * @param instruction Index of the instruction in the program order.
+ */
+std::size_t
+ProgramUtilizationIndex::moveCount(std::size_t instruction) const {
+    return firstMoves_[instruction + 1] - firstMoves_[instruction];
+}
+
+/**
+ * Returns the number of moves in the program.
+ */
+std::size_t
+ProgramUtilizationIndex::moveCount() const {
+    return firstMoves_.back();
+}
+
+/**
+ * Returns the number of utilization counters.
+ */
+std::size_t
+ProgramUtilizationIndex::counterCount() const {
+    return counters_.size();
+}
+
+/**
+ * Returns the given utilization counter.
+ *
+ * @param index Index of the counter.
+ */
+const ProgramUtilizationIndex::Counter&
+ProgramUtilizationIndex::counter(std::size_t index) const {
+    return counters_[index];
+}
+
+/**
+ * Computes the values of the utilization counters.
+ *
+ * Each counter is the sum of the execution counts of its moves. A counter
+ * is used if at least one of its moves was counted. The counters are
+ * independent of each other, so large programs are reduced in parallel.
+ *
+ * @param moveCounts Execution counts of the moves in the program order.
+ * @param countedMoves Non-zero for the moves that are to be counted, that
+ *        is, the moves of the instructions that were executed.
+ * @param totals The values of the counters are stored here.
+ * @param usedCounters Set to non-zero for the used counters.
+ * @param threadCount Number of threads to reduce with. By default the
+ *        number of host threads is used for large programs only.
+ */
+void
+ProgramUtilizationIndex::reduce(
+    const std::vector<ClockCycleCount>& moveCounts,
+    const std::vector<char>& countedMoves,
+    std::vector<ClockCycleCount>& totals,
+    std::vector<char>& usedCounters,
+    unsigned threadCount) const {
+
+    totals.assign(counters_.size(), 0);
+    usedCounters.assign(counters_.size(), 0);
+
+    if (threadCount == 0) {
+        threadCount = 
+            counterMoves_.size() < PARALLEL_REDUCTION_THRESHOLD ?
+            1 : std::thread::hardware_concurrency();
+    }
+    if (threadCount < 2) {
+        reduceRange(
+            0, counters_.size(), moveCounts, countedMoves, totals,
+            usedCounters);
+        return;
+    }
+
+    // split the counters to ranges with about equal number of moves, the
+    // ranges write to disjoint parts of the result vectors
+    std::vector<std::thread> threads;
+    const std::size_t movesPerThread = 
+        counterMoves_.size() / threadCount + 1;
+    std::size_t first = 0;
+    while (first < counters_.size()) {
+        std::size_t last = std::upper_bound(
+            firstCounterMoves_.begin() + first + 1, firstCounterMoves_.end(),
+            firstCounterMoves_[first] + movesPerThread) -
+            firstCounterMoves_.begin() - 1;
+        last = std::max(last, first + 1);
+        threads.push_back(
+            std::thread(
+                &ProgramUtilizationIndex::reduceRange, this, first, last,
+                std::cref(moveCounts), std::cref(countedMoves),
+                std::ref(totals), std::ref(usedCounters)));
+        first = last;
+    }
+    for (std::size_t i = 0; i < threads.size(); ++i) {
+        threads[i].join();
+    }
+}
+
+/**
+ * Computes the values of the given range of counters.
+ *
+ * @param first Index of the first counter to compute.
+ * @param last Index past the last counter to compute.
+ * @see reduce()
+ */
+void
+ProgramUtilizationIndex::reduceRange(
+    std::size_t first, std::size_t last,
+    const std::vector<ClockCycleCount>& moveCounts,
+    const std::vector<char>& countedMoves,
+    std::vector<ClockCycleCount>& totals,
+    std::vector<char>& usedCounters) const {
+
+    const std::size_t* moves = counterMoves_.data();
+    const ClockCycleCount* counts = moveCounts.data();
+    const char* counted = countedMoves.data();
+    for (std::size_t c = first; c < last; ++c) {
+        ClockCycleCount total = 0;
+        char used = 0;
+        const std::size_t end = firstCounterMoves_[c + 1];
+        for (std::size_t i = firstCounterMoves_[c]; i < end; ++i) {
+            total += counts[moves[i]];
+            used |= counted[moves[i]];
+        }
+        totals[c] = total;
+        usedCounters[c] = used;
+    }
+}
+
+/**
+ * Resolves the machine parts used by the moves of the given instruction.
+ *
+ * @param instruction The instruction.
+ */
+void
+ProgramUtilizationIndex::addInstruction(
+    const TTAProgram::Instruction& instruction) {
+
+    addresses_.push_back(instruction.address().location());
+    implicit_.push_back(instruction.size() == 0);
+
+    // output socket utilizations are counted only once per instruction,
+    // even though the socket is read by multiple buses
+    std::set<const TTAMachine::Socket*> countedOutputSockets;
+
+    std::size_t moveIndex = firstMoves_.back();
+    for (int i = 0; i < instruction.moveCount(); ++i, ++moveIndex) {
+        const TTAProgram::Move& move = instruction.move(i);
+        const TTAProgram::Terminal& source = move.source();
+        const TTAProgram::Terminal& destination = move.destination();
+
+        contributions_.push_back(
+            std::make_pair(
+                counterIndex(BUS_WRITES, move.bus().name()), moveIndex));
+
+        if (!source.isImmediate() &&
+            move.sourceSocket().name() != move.destinationSocket().name() &&
+            countedOutputSockets.insert(&move.sourceSocket()).second) {
+            contributions_.push_back(
+                std::make_pair(
+                    counterIndex(SOCKET_WRITES, move.sourceSocket().name()),
+                    moveIndex));
+        }
+        contributions_.push_back(
+            std::make_pair(
+                counterIndex(SOCKET_WRITES, move.destinationSocket().name()),
+                moveIndex));
+
+        if (destination.isFUPort() &&
+            dynamic_cast<const TTAMachine::BaseFUPort&>(
+                destination.port()).isTriggering()) {
+            const std::string operationUpper =
+                StringTools::stringToUpper(destination.operation().name());
+            const std::string fuName = destination.functionUnit().name();
+            contributions_.push_back(
+                std::make_pair(counterIndex(FU_TRIGGERS, fuName), moveIndex));
+            contributions_.push_back(
+                std::make_pair(
+                    counterIndex(OPERATION_EXECUTIONS, operationUpper),
+                    moveIndex));
+            contributions_.push_back(
+                std::make_pair(
+                    counterIndex(
+                        FU_OPERATION_EXECUTIONS, fuName, operationUpper),
+                    moveIndex));
+        }
+
+        if (source.isGPR()) {
+            contributions_.push_back(
+                std::make_pair(
+                    counterIndex(
+                        REGISTER_READS, source.registerFile().name(), "",
+                        source.index()),
+                    moveIndex));
+        }
+
+        if (!move.isUnconditional()) {
+            const TTAMachine::Guard& guard = move.guard().guard();
+            const TTAMachine::RegisterGuard* registerGuard =
+                dynamic_cast<const TTAMachine::RegisterGuard*>(&guard);
+            const TTAMachine::PortGuard* portGuard =
+                dynamic_cast<const TTAMachine::PortGuard*>(&guard);
+            if (registerGuard != NULL) {
+                contributions_.push_back(
+                    std::make_pair(
+                        counterIndex(
+                            GUARD_REGISTER_READS,
+                            registerGuard->registerFile()->name(), "",
+                            registerGuard->registerIndex()),
+                        moveIndex));
+            } else if (portGuard != NULL) {
+                const TTAMachine::FUPort& port = *portGuard->port();
+                contributions_.push_back(
+                    std::make_pair(
+                        counterIndex(
+                            FU_GUARD_READS, port.parentUnit()->name(),
+                            port.name()),
+                        moveIndex));
+            }
+        }
+
+        if (source.isImmediateRegister()) {
+            contributions_.push_back(
+                std::make_pair(
+                    counterIndex(
+                        REGISTER_READS, source.immediateUnit().name(), "",
+                        source.index()),
+                    moveIndex));
+        }
+
+        if (destination.isGPR()) {
+            contributions_.push_back(
+                std::make_pair(
+                    counterIndex(
+                        REGISTER_WRITES, destination.registerFile().name(),
+                        "", destination.index()),
+                    moveIndex));
+        }
+    }
+    firstMoves_.push_back(moveIndex);
+}
+
+/**
+ * Returns the index of the given counter, adding the counter if needed.
+ *
+ * @param kind The counted quantity.
+ * @param component Name of the counted component.
+ * @param part Name of the counted part of the component, if any.
+ * @param registerIndex Index of the counted register, if any.
+ * @return Index of the counter.
+ */
+std::size_t
+ProgramUtilizationIndex::counterIndex(
+    CounterKind kind, const std::string& component, const std::string& part,
+    int registerIndex) {
+
+    const std::string key =
+        Conversion::toString(static_cast<int>(kind)) + ":" + component + 
+        ":" + part + ":" + Conversion::toString(registerIndex);
+    std::map<std::string, std::size_t>::const_iterator i = 
+        counterKeys_.find(key);
+    if (i != counterKeys_.end()) {
+        return i->second;
+    }
+    Counter counter;
+    counter.kind = kind;
+    counter.component = component;
+    counter.part = part;
+    counter.registerIndex = registerIndex;
+    counters_.push_back(counter);
+    counterKeys_[key] = counters_.size() - 1;
+    return counters_.size() - 1;
+}
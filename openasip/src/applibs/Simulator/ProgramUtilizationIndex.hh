@@ -0,0 +1,140 @@
+/*
+    Copyright (c) 2002-2026 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file ProgramUtilizationIndex.hh
+ *
+ * Declaration of ProgramUtilizationIndex class.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_PROGRAM_UTILIZATION_INDEX_HH
+#define TTA_PROGRAM_UTILIZATION_INDEX_HH
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "BaseType.hh"
+#include "SimulatorConstants.hh"
+
+namespace TTAProgram {
+    class Program;
+    class Instruction;
+}
+
+/**
+ * The machine parts used by the moves of a program, resolved into dense
+ * utilization counters.
+ *
+ * The index is built once for a loaded program. Each move of the program
+ * gets a dense index in the program order, and each distinct counted
+ * quantity (writes of a bus, executions of an operation in an FU, reads
+ * of a register, etc.) gets a counter. Utilization statistics are then
+ * computed from the per-move execution counts of a simulation run by
+ * reduce(), which sums up the counts of the moves of each counter.
+ */
+class ProgramUtilizationIndex {
+public:
+    /// The quantities counted by the counters.
+    enum CounterKind {
+        BUS_WRITES,             ///< Writes to a bus.
+        SOCKET_WRITES,          ///< Transports through a socket.
+        FU_TRIGGERS,            ///< Operation triggers of an FU.
+        OPERATION_EXECUTIONS,   ///< Executions of an operation.
+        FU_OPERATION_EXECUTIONS,///< Executions of an operation in an FU.
+        REGISTER_READS,         ///< Reads of a register.
+        REGISTER_WRITES,        ///< Writes to a register.
+        GUARD_REGISTER_READS,   ///< Guard reads of a register.
+        FU_GUARD_READS          ///< Guard reads of an FU port.
+    };
+
+    /// A utilization counter.
+    struct Counter {
+        /// The counted quantity.
+        CounterKind kind;
+        /// Name of the bus, socket, unit or operation.
+        std::string component;
+        /// Name of the operation or the port in the unit, if any.
+        std::string part;
+        /// Index of the register, if any.
+        int registerIndex;
+    };
+
+    explicit ProgramUtilizationIndex(const TTAProgram::Program& program);
+    virtual ~ProgramUtilizationIndex();
+
+    std::size_t instructionCount() const;
+    std::size_t startInstruction() const;
+    InstructionAddress instructionAddress(std::size_t instruction) const;
+    bool isImplicit(std::size_t instruction) const;
+    std::size_t firstMove(std::size_t instruction) const;
+    std::size_t moveCount(std::size_t instruction) const;
+
+    std::size_t moveCount() const;
+    std::size_t counterCount() const;
+    const Counter& counter(std::size_t index) const;
+
+    void reduce(
+        const std::vector<ClockCycleCount>& moveCounts,
+        const std::vector<char>& countedMoves,
+        std::vector<ClockCycleCount>& totals,
+        std::vector<char>& usedCounters,
+        unsigned threadCount = 0) const;
+
+private:
+    void addInstruction(const TTAProgram::Instruction& instruction);
+    std::size_t counterIndex(
+        CounterKind kind, const std::string& component,
+        const std::string& part = "", int registerIndex = -1);
+    void reduceRange(
+        std::size_t first, std::size_t last,
+        const std::vector<ClockCycleCount>& moveCounts,
+        const std::vector<char>& countedMoves,
+        std::vector<ClockCycleCount>& totals,
+        std::vector<char>& usedCounters) const;
+
+    /// Addresses of the instructions in the program order.
+    std::vector<InstructionAddress> addresses_;
+    /// Tells whether each instruction is an implicit one.
+    std::vector<bool> implicit_;
+    /// Index of the first move of each instruction. Has an extra item
+    /// for the end of the last instruction.
+    std::vector<std::size_t> firstMoves_;
+    /// Index of the instruction at the start address of the program.
+    std::size_t startInstruction_;
+    /// The counters.
+    std::vector<Counter> counters_;
+    /// Index of the first move of each counter in counterMoves_. Has an
+    /// extra item for the end of the last counter.
+    std::vector<std::size_t> firstCounterMoves_;
+    /// The moves counted by each counter.
+    std::vector<std::size_t> counterMoves_;
+    /// Counted moves as (counter, move) pairs, used while building.
+    std::vector<std::pair<std::size_t, std::size_t> > contributions_;
+    /// Counters by their keys, used while building.
+    std::map<std::string, std::size_t> counterKeys_;
+};
+
+#endif
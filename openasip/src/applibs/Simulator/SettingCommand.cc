@@ -198,6 +198,95 @@ public:
     }
 };
 
+/**
+ * Setting action that sets the profiling of the simulation.
+ */
+class SetProfiling {
+public:
+
+    /**
+     * Sets the profiling of the simulation.
+     *
+     * @param simFront SimulatorFrontend to set the profiling for.
+     * @param newValue Value to set.
+     * @return True if setting was successful.
+     */
+    static bool execute(
+        SimulatorInterpreter&, SimulatorFrontend& simFront, bool newValue) {
+        simFront.setProfiling(newValue);
+        return true;
+    }
+
+    /**
+     * Returns the default value of this setting.
+     *
+     * @return The default value.
+     */
+    static const DataObject& defaultValue() {
+        static const DataObject defaultValue_("0");
+        return defaultValue_;
+    }
+    
+    /**
+     * Should the action warn if program & machine exist and value was changed
+     * 
+     * @return boolean value on whether or not to warn
+     */
+    static bool warnOnExistingProgramAndMachine() {
+        return true;
+    }
+};
+
+/**
+ * Setting action that sets the file the simulation profile is written to.
+ */
+class SetProfileFile {
+public:
+
+    /**
+     * Sets the profile file name.
+     *
+     * @param interpreter The interpreter to print the errors to.
+     * @param simFront SimulatorFrontend to set the profile file name for.
+     * @param newValue Value to set, an empty string for automatic naming.
+     * @return True if setting was successful.
+     */
+    static bool execute(
+        SimulatorInterpreter& interpreter,
+        SimulatorFrontend& simFront,
+        const std::string& newValue) {
+        if (newValue != "" &&
+            (!(FileSystem::fileIsCreatable(newValue) ||
+               FileSystem::fileIsWritable(newValue)) ||
+             FileSystem::fileIsDirectory(newValue))) {
+            interpreter.lineReader()->outputStream()
+                << "Could not open file for writing." << std::endl;
+            return false;
+        }
+        simFront.setProfileFileName(newValue);
+        return true;
+    }
+
+    /**
+     * Returns the default value of this setting.
+     *
+     * @return The default value.
+     */
+    static const DataObject& defaultValue() {
+        static const DataObject defaultValue_("");
+        return defaultValue_;
+    }
+
+    /**
+     * Should the action warn if program & machine exist and value was changed
+     *
+     * @return boolean value on whether or not to warn
+     */
+    static bool warnOnExistingProgramAndMachine() {
+        return false;
+    }
+};
+
 /**
  * Setting action that sets the FU resource conflict detection.
  */
@@ -724,6 +813,18 @@ SettingCommand::SettingCommand() :
                     Texts::TXT_INTERP_SETTING_PROFILE_SAVING).
                 str());
 
+    settings_["profiling"] =
+        new TemplatedSimulatorSetting<
+            BooleanSetting, SetProfiling>(
+                SimulatorToolbox::textGenerator().text(
+                    Texts::TXT_INTERP_SETTING_PROFILING).
+                str());
+
+    settings_["profile_file"] =
+        new TemplatedSimulatorSetting<StringSetting, SetProfileFile>(
+            SimulatorToolbox::textGenerator().text(
+                Texts::TXT_INTERP_SETTING_PROFILE_FILE).str());
+
     settings_["fu_conflict_detection"] =
         new TemplatedSimulatorSetting<
             BooleanSetting, SetFUConflictDetection>(
@@ -516,7 +516,9 @@ SimulationController::FUPortValue(
 /**
  * Builds the FU resource conflict detectors for each FU in the machine.
  *
- * Uses the "lazy FSA" detection model.
+ * Uses the FSA detection model. The automata are shared with the other
+ * simulations in the process and cached on disk, see
+ * FUFiniteStateAutomaton::sharedAutomaton().
  */
 void
 SimulationController::buildFUResourceConflictDetectors(
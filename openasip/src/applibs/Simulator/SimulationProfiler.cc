@@ -0,0 +1,529 @@
+/*
+    Copyright (c) 2002-2026 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file SimulationProfiler.cc
+ *
+ * Implementation of SimulationProfiler class.
+ *
+ * @note rating: red
+ */
+
+#include <ostream>
+#include <iomanip>
+
+#include "SimulationProfiler.hh"
+#include "SimulatorFrontend.hh"
+#include "SimulationEventHandler.hh"
+#include "InstructionMemory.hh"
+#include "ExecutableInstruction.hh"
+#include "Program.hh"
+#include "Procedure.hh"
+#include "Instruction.hh"
+#include "Move.hh"
+#include "Terminal.hh"
+#include "Address.hh"
+#include "Operation.hh"
+#include "Machine.hh"
+#include "FunctionUnit.hh"
+#include "ControlUnit.hh"
+#include "AddressSpace.hh"
+#include "BaseFUPort.hh"
+
+/// Call site of the frames not entered by a call.
+static const InstructionAddress NO_CALL_SITE = ~InstructionAddress(0);
+
+/**
+ * Constructor.
+ *
+ * Resolves the procedure, the jumps, the FU triggers and the memory
+ * accesses of each instruction and starts tracking the procedure
+ * transfers of the simulation.
+ *
+ * @param subject The simulator to profile.
+ * @param program The simulated program.
+ * @param instructions The instruction memory of the simulation, which
+ *        stores the execution counts of the instructions.
+ */
+SimulationProfiler::SimulationProfiler(
+    SimulatorFrontend& subject,
+    const TTAProgram::Program& program,
+    const InstructionMemory& instructions) :
+    Listener(), subject_(subject), instructions_(instructions),
+    firstAddress_(program.firstInstruction().address().location()),
+    delaySlots_(subject.machine().controlUnit()->delaySlots()),
+    currentProcedure_(-1), previousAddress_(0) {
+
+    std::map<const TTAProgram::CodeSnippet*, int> procedureIndices;
+    for (int i = 0; i < program.procedureCount(); ++i) {
+        const TTAProgram::Procedure& procedure = program.procedure(i);
+        procedureIndices[&procedure] = i;
+        procedureNames_.push_back(procedure.name());
+        procedureStarts_.push_back(procedure.startAddress().location());
+    }
+    const int noProcedure = procedureNames_.size();
+    procedureNames_.push_back("<no procedure>");
+    procedureStarts_.push_back(firstAddress_);
+
+    const TTAMachine::Machine& machine = subject.machine();
+    const TTAMachine::Machine::FunctionUnitNavigator fuNav =
+        machine.functionUnitNavigator();
+    for (int i = 0; i < fuNav.count(); ++i) {
+        fuNames_.push_back(fuNav.item(i)->name());
+    }
+    fuNames_.push_back(machine.controlUnit()->name());
+    const TTAMachine::Machine::AddressSpaceNavigator asNav =
+        machine.addressSpaceNavigator();
+    for (int i = 0; i < asNav.count(); ++i) {
+        addressSpaceNames_.push_back(asNav.item(i)->name());
+    }
+
+    const InstructionAddress lastAddress =
+        program.lastInstruction().address().location();
+    procedures_.assign(lastAddress - firstAddress_ + 1, noProcedure);
+    jumps_.assign(lastAddress - firstAddress_ + 1, false);
+    for (InstructionAddress address = firstAddress_; address <= lastAddress;
+         ++address) {
+        const TTAProgram::Instruction& instruction =
+            program.instructionAt(address);
+        const std::size_t index = address - firstAddress_;
+        if (instruction.isInProcedure()) {
+            procedures_[index] = procedureIndices[&instruction.parent()];
+        }
+        for (int i = 0; i < instruction.moveCount(); ++i) {
+            const TTAProgram::Move& move = instruction.move(i);
+            const TTAProgram::Terminal& destination = move.destination();
+            if (!destination.isFUPort()) {
+                continue;
+            }
+            if (destination.isOpcodeSetting() && move.isJump()) {
+                jumps_[index] = true;
+            }
+            if (!dynamic_cast<const TTAMachine::BaseFUPort&>(
+                    destination.port()).isTriggering()) {
+                continue;
+            }
+            const TTAMachine::FunctionUnit& fu = destination.functionUnit();
+            MoveEvent trigger = {
+                address, i, indexOf(fuNames_, fu.name()), false };
+            triggers_.push_back(trigger);
+
+            if (!destination.isOpcodeSetting() || !fu.hasAddressSpace()) {
+                continue;
+            }
+            const Operation& operation = destination.operation();
+            MoveEvent access = {
+                address, i, indexOf(addressSpaceNames_,
+                    fu.addressSpace()->name()), false };
+            if (operation.readsMemory()) {
+                memoryAccesses_.push_back(access);
+            }
+            if (operation.writesMemory()) {
+                access.write = true;
+                memoryAccesses_.push_back(access);
+            }
+        }
+    }
+
+    activeFrames_.assign(procedureNames_.size(), 0);
+    inclusiveCycles_.assign(procedureNames_.size(), 0);
+    callCounts_.assign(procedureNames_.size(), 0);
+
+    subject_.eventHandler().registerListener(
+        SimulationEventHandler::SE_NEW_INSTRUCTION, this);
+}
+
+/**
+ * Destructor.
+ */
+SimulationProfiler::~SimulationProfiler() {
+    subject_.eventHandler().unregisterListener(
+        SimulationEventHandler::SE_NEW_INSTRUCTION, this);
+}
+
+/**
+ * Follows the procedure transfers after each simulated instruction.
+ *
+ * Transfers are detected as in ProcedureTransferTracker: a change of
+ * the procedure is a return in case the last control flow instruction
+ * executed before it was a jump, otherwise a call.
+ */
+void
+SimulationProfiler::handleEvent() {
+
+    const InstructionAddress address = subject_.lastExecutedInstruction();
+    const std::size_t index = address - firstAddress_;
+    if (index >= procedures_.size()) {
+        return;
+    }
+    const int procedure = procedures_[index];
+    if (procedure == currentProcedure_) {
+        previousAddress_ = address;
+        return;
+    }
+
+    // the event is generated after the cycle count has been advanced
+    const ClockCycleCount cycle = subject_.cycleCount() - 1;
+    if (currentProcedure_ == -1) {
+        enter(procedure, NO_CALL_SITE, cycle);
+    } else {
+        InstructionAddress controlFlowAddress = 
+            previousAddress_ - delaySlots_;
+        if (previousAddress_ < firstAddress_ + delaySlots_) {
+            controlFlowAddress = previousAddress_;
+        }
+        if (jumps_[controlFlowAddress - firstAddress_]) {
+            // a return to a caller, or a jump to another procedure which
+            // then replaces the current one
+            int caller = static_cast<int>(callStack_.size()) - 2;
+            while (caller >= 0 && callStack_[caller].procedure != procedure) {
+                --caller;
+            }
+            if (caller >= 0) {
+                while (static_cast<int>(callStack_.size()) > caller + 1) {
+                    leave(cycle);
+                }
+            } else {
+                if (!callStack_.empty()) {
+                    leave(cycle);
+                }
+                enter(procedure, controlFlowAddress, cycle);
+            }
+        } else {
+            enter(procedure, controlFlowAddress, cycle);
+        }
+    }
+    currentProcedure_ = procedure;
+    previousAddress_ = address;
+}
+
+/**
+ * Returns the number of profiled procedures.
+ *
+ * The last procedure collects the instructions that are not in any
+ * procedure of the program.
+ */
+int
+SimulationProfiler::procedureCount() const {
+    return procedureNames_.size();
+}
+
+/**
+ * Returns the name of the given procedure.
+ *
+ * @param procedure Index of the procedure.
+ */
+std::string
+SimulationProfiler::procedureName(int procedure) const {
+    return procedureNames_.at(procedure);
+}
+
+/**
+ * Returns the cycles spent in the instructions of the given procedure.
+ *
+ * @param procedure Index of the procedure.
+ */
+ClockCycleCount
+SimulationProfiler::exclusiveCycles(int procedure) const {
+    ClockCycleCount cycles = 0;
+    for (std::size_t i = 0; i < procedures_.size(); ++i) {
+        if (procedures_[i] == procedure) {
+            cycles += executionCount(firstAddress_ + i);
+        }
+    }
+    return cycles;
+}
+
+/**
+ * Returns the cycles spent in the given procedure and the procedures
+ * called from it.
+ *
+ * Recursive calls are counted only once. Calls that have not returned
+ * yet are counted up to the current cycle.
+ *
+ * @param procedure Index of the procedure.
+ */
+ClockCycleCount
+SimulationProfiler::inclusiveCycles(int procedure) const {
+    ClockCycleCount cycles = inclusiveCycles_.at(procedure);
+    for (std::size_t i = 0; i < callStack_.size(); ++i) {
+        if (callStack_[i].procedure == procedure) {
+            cycles += totalCycles() - callStack_[i].entryCycle;
+            break;
+        }
+    }
+    return cycles;
+}
+
+/**
+ * Returns the number of times the given procedure was entered.
+ *
+ * @param procedure Index of the procedure.
+ */
+ClockCycleCount
+SimulationProfiler::callCount(int procedure) const {
+    return callCounts_.at(procedure);
+}
+
+/**
+ * Returns the number of operations triggered in the given FU.
+ *
+ * @param fuName Name of the function unit or the control unit.
+ */
+ClockCycleCount
+SimulationProfiler::triggerCount(const std::string& fuName) const {
+    const int fu = indexOf(fuNames_, fuName);
+    ClockCycleCount count = 0;
+    for (std::size_t i = 0; i < triggers_.size(); ++i) {
+        if (triggers_[i].target == fu) {
+            count += eventCount(triggers_[i]);
+        }
+    }
+    return count;
+}
+
+/**
+ * Returns the share of the simulated cycles in which an operation was
+ * triggered in the given FU.
+ *
+ * @param fuName Name of the function unit or the control unit.
+ */
+double
+SimulationProfiler::utilization(const std::string& fuName) const {
+    const ClockCycleCount cycles = totalCycles();
+    if (cycles == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(triggerCount(fuName)) / cycles;
+}
+
+/**
+ * Returns the number of memory reading operations executed in the given
+ * address space.
+ *
+ * @param addressSpaceName Name of the address space.
+ */
+ClockCycleCount
+SimulationProfiler::memoryReads(const std::string& addressSpaceName) const {
+    const int addressSpace = indexOf(addressSpaceNames_, addressSpaceName);
+    ClockCycleCount count = 0;
+    for (std::size_t i = 0; i < memoryAccesses_.size(); ++i) {
+        if (memoryAccesses_[i].target == addressSpace && 
+            !memoryAccesses_[i].write) {
+            count += eventCount(memoryAccesses_[i]);
+        }
+    }
+    return count;
+}
+
+/**
+ * Returns the number of memory writing operations executed in the given
+ * address space.
+ *
+ * @param addressSpaceName Name of the address space.
+ */
+ClockCycleCount
+SimulationProfiler::memoryWrites(const std::string& addressSpaceName) const {
+    const int addressSpace = indexOf(addressSpaceNames_, addressSpaceName);
+    ClockCycleCount count = 0;
+    for (std::size_t i = 0; i < memoryAccesses_.size(); ++i) {
+        if (memoryAccesses_[i].target == addressSpace && 
+            memoryAccesses_[i].write) {
+            count += eventCount(memoryAccesses_[i]);
+        }
+    }
+    return count;
+}
+
+/**
+ * Writes the profile in the callgrind format.
+ *
+ * The costs are given for each instruction address. The events are the
+ * executed cycles, operation triggers and memory reads and writes. Each
+ * call site lists the number of calls and the inclusive cycles of the
+ * procedures it called.
+ *
+ * @param output The stream to write to.
+ */
+void
+SimulationProfiler::writeCallgrindProfile(std::ostream& output) const {
+
+    enum { CYCLES, TRIGGERS, READS, WRITES, EVENT_COUNT };
+    std::vector<ClockCycleCount> costs(procedures_.size() * EVENT_COUNT, 0);
+    std::vector<ClockCycleCount> totals(EVENT_COUNT, 0);
+    for (std::size_t i = 0; i < procedures_.size(); ++i) {
+        costs[i * EVENT_COUNT + CYCLES] = executionCount(firstAddress_ + i);
+    }
+    for (std::size_t i = 0; i < triggers_.size(); ++i) {
+        costs[(triggers_[i].address - firstAddress_) * EVENT_COUNT +
+              TRIGGERS] += eventCount(triggers_[i]);
+    }
+    for (std::size_t i = 0; i < memoryAccesses_.size(); ++i) {
+        costs[(memoryAccesses_[i].address - firstAddress_) * EVENT_COUNT +
+              (memoryAccesses_[i].write ? WRITES : READS)] +=
+            eventCount(memoryAccesses_[i]);
+    }
+    for (std::size_t i = 0; i < costs.size(); ++i) {
+        totals[i % EVENT_COUNT] += costs[i];
+    }
+
+    // the calls that have not returned yet end at the current cycle
+    CallGraph callGraph = callGraph_;
+    for (std::size_t i = 0; i < callStack_.size(); ++i) {
+        if (callStack_[i].callSite != NO_CALL_SITE) {
+            callGraph[std::make_pair(
+                    callStack_[i].callSite, callStack_[i].procedure)].
+                inclusiveCycles += totalCycles() - callStack_[i].entryCycle;
+        }
+    }
+    std::vector<std::vector<CallGraph::const_iterator> > calls(
+        procedureNames_.size());
+    for (CallGraph::const_iterator i = callGraph.begin(); 
+         i != callGraph.end(); ++i) {
+        calls[procedures_[i->first.first - firstAddress_]].push_back(i);
+    }
+
+    output 
+        << "# callgrind format" << std::endl
+        << "version: 1" << std::endl
+        << "creator: ttasim" << std::endl
+        << "positions: instr" << std::endl
+        << "events: Cycles Triggers MemReads MemWrites" << std::endl
+        << "summary:";
+    for (int e = 0; e < EVENT_COUNT; ++e) {
+        output << " " << totals[e];
+    }
+    output << std::endl;
+
+    for (std::size_t p = 0; p < procedureNames_.size(); ++p) {
+        bool executed = !calls[p].empty();
+        for (std::size_t i = 0; i < procedures_.size() && !executed; ++i) {
+            executed = procedures_[i] == static_cast<int>(p) &&
+                costs[i * EVENT_COUNT + CYCLES] > 0;
+        }
+        if (!executed) {
+            continue;
+        }
+        output << std::endl << "fn=" << procedureNames_[p] << std::endl;
+        for (std::size_t i = 0; i < procedures_.size(); ++i) {
+            if (procedures_[i] != static_cast<int>(p) ||
+                costs[i * EVENT_COUNT + CYCLES] == 0) {
+                continue;
+            }
+            output << "0x" << std::hex << firstAddress_ + i << std::dec;
+            for (int e = 0; e < EVENT_COUNT; ++e) {
+                output << " " << costs[i * EVENT_COUNT + e];
+            }
+            output << std::endl;
+        }
+        for (std::size_t c = 0; c < calls[p].size(); ++c) {
+            const InstructionAddress callSite = calls[p][c]->first.first;
+            const int callee = calls[p][c]->first.second;
+            const CallEdge& edge = calls[p][c]->second;
+            output 
+                << "cfn=" << procedureNames_[callee] << std::endl
+                << "calls=" << edge.calls << " 0x" << std::hex
+                << procedureStarts_[callee] << std::endl
+                << "0x" << callSite << std::dec << " " 
+                << edge.inclusiveCycles << std::endl;
+        }
+    }
+}
+
+/**
+ * Pushes a call to the shadow call stack.
+ *
+ * @param procedure The called procedure.
+ * @param callSite Address of the calling instruction.
+ * @param cycle The cycle of the first instruction of the call.
+ */
+void
+SimulationProfiler::enter(
+    int procedure, InstructionAddress callSite, ClockCycleCount cycle) {
+    Frame frame = { procedure, callSite, cycle };
+    callStack_.push_back(frame);
+    ++activeFrames_[procedure];
+    ++callCounts_[procedure];
+    if (callSite != NO_CALL_SITE) {
+        CallEdge& edge = callGraph_[std::make_pair(callSite, procedure)];
+        ++edge.calls;
+    }
+}
+
+/**
+ * Pops the topmost call from the shadow call stack.
+ *
+ * @param cycle The cycle of the first instruction after the call.
+ */
+void
+SimulationProfiler::leave(ClockCycleCount cycle) {
+    const Frame frame = callStack_.back();
+    callStack_.pop_back();
+    const ClockCycleCount cycles = cycle - frame.entryCycle;
+    if (--activeFrames_[frame.procedure] == 0) {
+        inclusiveCycles_[frame.procedure] += cycles;
+    }
+    if (frame.callSite != NO_CALL_SITE) {
+        callGraph_[std::make_pair(frame.callSite, frame.procedure)].
+            inclusiveCycles += cycles;
+    }
+}
+
+/**
+ * Returns the execution count of the instruction at the given address.
+ */
+ClockCycleCount
+SimulationProfiler::executionCount(InstructionAddress address) const {
+    return instructions_.instructionAtConst(address).executionCount();
+}
+
+/**
+ * Returns the execution count of the move of the given event.
+ */
+ClockCycleCount
+SimulationProfiler::eventCount(const MoveEvent& event) const {
+    return instructions_.instructionAtConst(event.address).
+        moveExecutionCount(event.move);
+}
+
+/**
+ * Returns the number of simulated cycles.
+ */
+ClockCycleCount
+SimulationProfiler::totalCycles() const {
+    return subject_.cycleCount();
+}
+
+/**
+ * Returns the index of the given name, or -1 if it is not found.
+ */
+int
+SimulationProfiler::indexOf(
+    const std::vector<std::string>& names, const std::string& name) const {
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        if (names[i] == name) {
+            return i;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,175 @@
+/*
+    Copyright (c) 2002-2026 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file SimulationProfiler.hh
+ *
+ * Declaration of SimulationProfiler class.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_SIMULATION_PROFILER_HH
+#define TTA_SIMULATION_PROFILER_HH
+
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Listener.hh"
+#include "BaseType.hh"
+#include "SimulatorConstants.hh"
+
+class SimulatorFrontend;
+class InstructionMemory;
+
+namespace TTAProgram {
+    class Program;
+}
+
+/**
+ * Collects a procedure level profile of a simulation run.
+ *
+ * The instructions of the program are resolved to dense procedure, FU and
+ * address space indices when the profiler is created. During simulation
+ * the profiler only follows the procedure transfers with a shadow call
+ * stack, which gives the inclusive cycles of the procedures and the calls
+ * and inclusive cycles of each call site. The exclusive cycles, FU
+ * triggers and memory accesses are computed on demand from the execution
+ * counts the simulator keeps for each instruction and move.
+ *
+ * The profile can be written in the callgrind format, which is read by
+ * KCachegrind, QCachegrind and other callgrind viewers.
+ */
+class SimulationProfiler : public Listener {
+public:
+    SimulationProfiler(
+        SimulatorFrontend& subject,
+        const TTAProgram::Program& program,
+        const InstructionMemory& instructions);
+    virtual ~SimulationProfiler();
+
+    virtual void handleEvent();
+
+    int procedureCount() const;
+    std::string procedureName(int procedure) const;
+    ClockCycleCount exclusiveCycles(int procedure) const;
+    ClockCycleCount inclusiveCycles(int procedure) const;
+    ClockCycleCount callCount(int procedure) const;
+
+    ClockCycleCount triggerCount(const std::string& fuName) const;
+    double utilization(const std::string& fuName) const;
+
+    ClockCycleCount memoryReads(const std::string& addressSpaceName) const;
+    ClockCycleCount memoryWrites(const std::string& addressSpaceName) const;
+
+    void writeCallgrindProfile(std::ostream& output) const;
+
+private:
+    /// An FU trigger or a memory access of a move.
+    struct MoveEvent {
+        /// Address of the instruction of the move.
+        InstructionAddress address;
+        /// Index of the move in the instruction.
+        int move;
+        /// Index of the FU or the address space.
+        int target;
+        /// True if the move starts an operation that writes the memory.
+        bool write;
+    };
+
+    /// A procedure call in the shadow call stack.
+    struct Frame {
+        /// The called procedure.
+        int procedure;
+        /// Address of the calling instruction.
+        InstructionAddress callSite;
+        /// The cycle the procedure was entered in.
+        ClockCycleCount entryCycle;
+    };
+
+    /// Calls from a call site to a procedure.
+    struct CallEdge {
+        /// Number of calls.
+        ClockCycleCount calls;
+        /// Cycles spent in the calls that have returned.
+        ClockCycleCount inclusiveCycles;
+    };
+
+    /// Call edges indexed by the call site and the callee.
+    typedef std::map<std::pair<InstructionAddress, int>, CallEdge> CallGraph;
+
+    void enter(
+        int procedure, InstructionAddress callSite, ClockCycleCount cycle);
+    void leave(ClockCycleCount cycle);
+    ClockCycleCount executionCount(InstructionAddress address) const;
+    ClockCycleCount eventCount(const MoveEvent& event) const;
+    ClockCycleCount totalCycles() const;
+    int indexOf(
+        const std::vector<std::string>& names, const std::string& name) const;
+
+    /// The tracked simulator.
+    SimulatorFrontend& subject_;
+    /// The execution counts of the simulated instructions.
+    const InstructionMemory& instructions_;
+    /// Address of the first instruction of the program.
+    InstructionAddress firstAddress_;
+    /// Number of delay slots of the control unit.
+    int delaySlots_;
+    /// Names of the procedures. The last one collects the instructions
+    /// outside procedures.
+    std::vector<std::string> procedureNames_;
+    /// Start addresses of the procedures.
+    std::vector<InstructionAddress> procedureStarts_;
+    /// The procedure of each instruction.
+    std::vector<int> procedures_;
+    /// Tells whether each instruction contains a jump.
+    std::vector<bool> jumps_;
+    /// Names of the function units, including the control unit.
+    std::vector<std::string> fuNames_;
+    /// Names of the address spaces of the function units.
+    std::vector<std::string> addressSpaceNames_;
+    /// Operation triggers of the program.
+    std::vector<MoveEvent> triggers_;
+    /// Memory accessing operation triggers of the program.
+    std::vector<MoveEvent> memoryAccesses_;
+
+    /// The procedure of the previously executed instruction.
+    int currentProcedure_;
+    /// Address of the previously executed instruction.
+    InstructionAddress previousAddress_;
+    /// The shadow call stack.
+    std::vector<Frame> callStack_;
+    /// Number of frames of each procedure in the call stack.
+    std::vector<int> activeFrames_;
+    /// Inclusive cycles of the returned outermost calls of each procedure.
+    std::vector<ClockCycleCount> inclusiveCycles_;
+    /// Number of calls of each procedure.
+    std::vector<ClockCycleCount> callCounts_;
+    /// The calls of each call site.
+    CallGraph callGraph_;
+};
+
+#endif
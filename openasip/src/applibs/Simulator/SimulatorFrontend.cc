@@ -39,6 +39,7 @@
 #include <sstream>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "CompilerWarnings.hh"
 IGNORE_CLANG_WARNING("-Wkeyword-macro")
@@ -85,7 +86,8 @@ POP_CLANG_DIAGS
 #include "StopPointManager.hh"
 #include "TPEFTools.hh"
 #include "UtilizationStats.hh"
-#include "SimulationStatistics.hh"
+#include "ProgramUtilizationIndex.hh"
+#include "SimulationProfiler.hh"
 #include "RFAccessTracker.hh"
 #include "BusTracker.hh"
 #include "InstructionMemory.hh"
@@ -106,6 +108,7 @@ POP_CLANG_DIAGS
 #include "IdealSRAM.hh"
 #include "RemoteMemory.hh"
 #include "MemoryProxy.hh"
+#include "SharedMemory.hh"
 #include "DisassemblyFUPort.hh"
 
 using namespace TTAMachine;
@@ -131,7 +134,9 @@ SimulatorFrontend::SimulatorFrontend(SimulationType backendType) :
     staticCompilation_(true), traceFileNameSetByUser_(false), outputStream_(0),
     memoryAccessTracking_(false), eventHandler_(NULL), lastRunCycleCount_(0),
     lastRunTime_(0.0), simulationTimeout_(0), leaveCompiledDirty_(false),
-    callHistoryLength_(0), zeroFillMemoriesOnReset_(true) {
+    callHistoryLength_(0), zeroFillMemoriesOnReset_(true),
+    utilizationIndex_(NULL), profiling_(false), profiler_(NULL),
+    profileSaved_(false) {
 
     if (backendType == SIM_COMPILED) {
         setCompiledSimulation(true);
@@ -168,10 +173,14 @@ SimulatorFrontend::~SimulatorFrontend() {
     stopPointManager_ = NULL;
     delete tpef_;
     tpef_ = NULL;
+    delete profiler_;
+    profiler_ = NULL;
     delete eventHandler_;
     eventHandler_ = NULL;
     delete simCon_;
     simCon_ = NULL;
+    delete utilizationIndex_;
+    utilizationIndex_ = NULL;
     SequenceTools::deleteAllItems(memorySystems_);
 
     clearProgramErrorReports();
@@ -236,6 +245,8 @@ SimulatorFrontend::loadMachine(const Machine& machine) {
         delete currentProgram_;
         currentProgram_ = NULL;
     }
+    delete profiler_;
+    profiler_ = NULL;
     delete simCon_;
     simCon_ = NULL;
 
@@ -333,6 +344,8 @@ SimulatorFrontend::loadProgram(const std::string& fileName) {
     } catch (const Exception& e) {
         delete tpef_;
         tpef_ = NULL;
+        delete profiler_;
+        profiler_ = NULL;
         delete simCon_;
         simCon_ = NULL;
         std::string errorMsg = textGen.text(
@@ -383,6 +396,8 @@ SimulatorFrontend::loadProgram(const std::string& fileName) {
         if (results->errorCount() > 0) {
             delete tpef_;
             tpef_ = NULL;
+            delete profiler_;
+            profiler_ = NULL;
             delete simCon_;
             simCon_ = NULL;
             
@@ -453,6 +468,9 @@ SimulatorFrontend::initializeDataMemories(
     if (dataSections < 0) 
         return;
 
+    // the data of a definition is written to the memory as one block
+    std::vector<Memory::MAU> initData;
+
     for (int core = 0; core < 1; ++core) {
         // data memory initialization
         for (int i = 0; i < dataSections; ++i) {
@@ -494,10 +512,13 @@ SimulatorFrontend::initializeDataMemories(
                             addressSpace.name() +
                             " is out of address space bounds.");
                     } 
+                    initData.resize(def.size());
                     for (int m = 0; m < def.size(); m++) {
-                        dataMemory->write(
-                            startAddress.location() + m, def.MAU(m));
+                        initData[m] = def.MAU(m);
                     }
+                    dataMemory->writeBlock(
+                        startAddress.location(), initData.data(),
+                        initData.size());
                 }
 
             } catch (const InstanceNotFound& inf) {
@@ -508,6 +529,8 @@ SimulatorFrontend::initializeDataMemories(
                     errorMsg += " Reason: " + inf.errorMessage();
                 delete tpef_;
                 tpef_ = NULL;
+                delete profiler_;
+                profiler_ = NULL;
                 delete simCon_;
                 simCon_ = NULL;
                 throw IllegalProgram(
@@ -567,6 +590,8 @@ SimulatorFrontend::loadMachine(const std::string& fileName) {
         delete currentProgram_;
         currentProgram_ = NULL;
     }
+    delete profiler_;
+    profiler_ = NULL;
     delete simCon_;
     simCon_ = NULL;
 
@@ -657,6 +682,11 @@ SimulatorFrontend::initializeSimulation() {
 
     delete simCon_;
     simCon_ = NULL;
+    // the program or the machine has changed
+    delete utilizationIndex_;
+    utilizationIndex_ = NULL;
+    delete profiler_;
+    profiler_ = NULL;
     switch(currentBackend_) {
     case SIM_REMOTE:    
         simCon_ = 
@@ -1538,6 +1568,7 @@ SimulatorFrontend::initializeTracing() {
             }
         }
     }
+    setupProfiling();
     setupCallHistoryTracking();
 }
 
@@ -1554,6 +1585,8 @@ SimulatorFrontend::finishSimulation() {
     if (simCon_ == NULL)
         return;
 
+    saveProfile();
+
     SequenceTools::deleteAllItems(executionTrackers_);
     if (traceDBs_.size() == 0)
         return;
@@ -1743,9 +1776,16 @@ SimulatorFrontend::initializeMemorySystem() {
 
             if (shared && firstMemorySystem != NULL) {
                 // the memory model should have been created previously
-                // because all cores share the same memory
+                // because all cores share the same memory, each core
+                // gets its own port to it in case it buffers the writes
+                // per core
                 mem = firstMemorySystem->memory(space.name());
                 assert(mem != NULL);
+                SharedMemory* sharedMem =
+                    dynamic_cast<SharedMemory*>(mem.get());
+                if (sharedMem != NULL) {
+                    mem = sharedMem->addCore();
+                }
             } else {
                 switch (currentBackend_) {
                 case SIM_COMPILED:
@@ -1776,6 +1816,12 @@ SimulatorFrontend::initializeMemorySystem() {
                     mem = MemorySystem::MemoryPtr(
                         new MemoryProxy(*this, mem.get()));
                 }
+                // The interpretive simulators commit the writes of the
+                // cores to a shared memory at the end of the cycle.
+                if (shared && (currentBackend_ == SIM_NORMAL ||
+                               currentBackend_ == SIM_OTA)) {
+                    mem = MemorySystem::MemoryPtr(new SharedMemory(mem));
+                }
             }
             memorySystem_->addAddressSpace(space, mem, shared);
         }
@@ -1852,6 +1898,41 @@ SimulatorFrontend::profileDataSaving() const {
     return saveProfileData_;
 }
 
+/**
+ * Returns true in case the simulation is profiled.
+ *
+ * @return True in case profiling is enabled.
+ */
+bool
+SimulatorFrontend::profiling() const {
+    return profiling_;
+}
+
+/**
+ * Returns the profiler of the running simulation.
+ *
+ * The profiler stays available after the simulation has finished until
+ * the next simulation is initialized or the machine or the program is
+ * reloaded.
+ *
+ * @return The profiler, or NULL in case the simulation is not profiled.
+ */
+const SimulationProfiler*
+SimulatorFrontend::profiler() const {
+    return profiler_;
+}
+
+/**
+ * Returns the name of the file the callgrind profile is written to.
+ *
+ * @return The file name, or an empty string in case the name is derived
+ * from the program file name.
+ */
+std::string
+SimulatorFrontend::profileFileName() const {
+    return profileFileName_;
+}
+
 /**
  * Returns true in case utilization data saving is enabled.
  *
@@ -1955,6 +2036,30 @@ SimulatorFrontend::setProfileDataSaving(bool value) {
     saveProfileData_ = value;
 }
 
+/**
+ * Sets the profiling of the simulation on or off.
+ *
+ * The profile is written to a callgrind file when the simulation
+ * finishes.
+ *
+ * @param value Is profiling on or off.
+ */
+void
+SimulatorFrontend::setProfiling(bool value) {
+    profiling_ = value;
+}
+
+/**
+ * Sets the name of the file the callgrind profile is written to.
+ *
+ * @param fileName The file name, or an empty string to derive the name
+ * from the program file name.
+ */
+void
+SimulatorFrontend::setProfileFileName(const std::string& fileName) {
+    profileFileName_ = fileName;
+}
+
 #if 0
 /**
  * Sets the base file name of the TraceDB.
@@ -2175,21 +2280,24 @@ SimulatorFrontend::utilizationStatistics(int core) {
     UtilizationStats* utilizationStats = utilizationStats_.at(core);
 
     if (utilizationStats == NULL) {
+        // the program is indexed once, the statistics are recomputed from
+        // the execution counts after each simulation run
+        if (utilizationIndex_ == NULL) {
+            utilizationIndex_ = new ProgramUtilizationIndex(*currentProgram_);
+        }
         // stats calculation differs slightly for compiled & interpretive sims.
         if (!isCompiledSimulation()) {
             utilizationStats = new UtilizationStats();
-            SimulationStatistics stats(
-                *currentProgram_, 
+            utilizationStats->calculate(
+                *utilizationIndex_,
                 dynamic_cast<SimulationController*>(
                     simCon_)->instructionMemory(core));
-            stats.addStatistics(*utilizationStats);
-            stats.calculate();
         } else {
             CompiledSimUtilizationStats* compiledSimUtilizationStats =
                 new CompiledSimUtilizationStats();
             CompiledSimController& compiledSimCon = 
                 dynamic_cast<CompiledSimController&>(*simCon_);
-            compiledSimUtilizationStats->calculate(program(), 
+            compiledSimUtilizationStats->calculate(*utilizationIndex_, 
                 *compiledSimCon.compiledSimulation());
             utilizationStats = compiledSimUtilizationStats;
         }
@@ -2403,6 +2511,67 @@ SimulatorFrontend::setupCallHistoryTracking() {
     }    
 }
 
+/**
+ * Creates the profiler for a new simulation in case profiling is enabled.
+ *
+ * Only the interpretive simulation engines collect the per move
+ * execution counts the profiler needs.
+ */
+void
+SimulatorFrontend::setupProfiling() {
+    delete profiler_;
+    profiler_ = NULL;
+    SimulationController* simCon =
+        dynamic_cast<SimulationController*>(simCon_);
+    if (!profiling_ || simCon == NULL || !isProgramLoaded()) {
+        return;
+    }
+    profiler_ = new SimulationProfiler(
+        *this, *currentProgram_, simCon->instructionMemory(0));
+    profileSaved_ = false;
+}
+
+/**
+ * Writes the profile of the finished simulation.
+ *
+ * The profile is saved in the callgrind format to the file set with
+ * setProfileFileName(). If no file name is set, the program file name
+ * appended with ".callgrind" and a running number in case the file exists
+ * is used. The profiler is kept alive so the collected data can be queried
+ * until the next simulation is initialized.
+ */
+void
+SimulatorFrontend::saveProfile() {
+    if (profiler_ == NULL || profileSaved_) {
+        return;
+    }
+    profileSaved_ = true;
+    TCEString fileName = profileFileName_;
+    if (fileName == "") {
+        fileName = programFileName_;
+        fileName << ".callgrind";
+        int runningNumber = 1;
+        while (FileSystem::fileExists(fileName)) {
+            fileName = programFileName_;
+            fileName << ".callgrind." << runningNumber;
+            ++runningNumber;
+        }
+    }
+    std::ofstream profileStream(fileName.c_str());
+    if (profileStream.good()) {
+        profiler_->writeCallgrindProfile(profileStream);
+    }
+    if (!profileStream.good()) {
+        std::string errorMessage =
+            "Unable to write the simulation profile to " + fileName + ".";
+        if (outputStream_ != NULL) {
+            outputStream() << errorMessage << std::endl;
+        } else {
+            Application::logStream() << errorMessage << std::endl;
+        }
+    }
+}
+
 const CallPathTracker&
 SimulatorFrontend::callPathTracker(int core) const { 
     assert(callPathTrackers_.size() > 0);
@@ -57,6 +57,8 @@ class ExecutionTrace;
 class StopPointManager;
 class MemorySystem;
 class UtilizationStats;
+class ProgramUtilizationIndex;
+class SimulationProfiler;
 class RFAccessTracker;
 class BusTracker;
 class ExecutableInstruction;
@@ -162,10 +164,13 @@ public:
     bool rfAccessTracing() const;
     bool procedureTransferTracing() const;
     bool profileDataSaving() const;
+    bool profiling() const;
     bool utilizationDataSaving() const;
     bool staticCompilation() const;
 
     const RFAccessTracker& rfAccessTracker() const;
+    const SimulationProfiler* profiler() const;
+    std::string profileFileName() const;
 
     void setCompiledSimulation(bool value);
     void setExecutionTracing(bool value);
@@ -173,6 +178,8 @@ public:
     void setRFAccessTracing(bool value);
     void setProcedureTransferTracing(bool value);
     void setProfileDataSaving(bool value);
+    void setProfiling(bool value);
+    void setProfileFileName(const std::string& fileName);
     void setUtilizationDataSaving(bool value);
     void forceTraceDBFileName(const std::string& fileName) {
         forcedTraceDBFileName_ = fileName;
@@ -281,6 +288,8 @@ protected:
     void stopTimer();
 
     void setupCallHistoryTracking();
+    void setupProfiling();
+    void saveProfile();
 
     /// A type for storing a program error description.
     typedef std::pair<RuntimeErrorSeverity, std::string>
@@ -403,5 +412,15 @@ protected:
     /// Set to true in case should build a detailed model which simulates
     /// FU stages, possibly with an external system-level model.
     bool detailedSimulation_;
+    /// The utilization counters of the loaded program, built on demand.
+    ProgramUtilizationIndex* utilizationIndex_;
+    /// Set to true in case the simulation should be profiled.
+    bool profiling_;
+    /// The profiler of the running simulation, in case profiling is enabled.
+    SimulationProfiler* profiler_;
+    /// The file the profile is written to, empty for automatic naming.
+    std::string profileFileName_;
+    /// Set to true once the profile of the current simulation is written.
+    bool profileSaved_;
 };
 #endif
@@ -469,6 +469,15 @@ SimulatorTextGenerator::SimulatorTextGenerator() {
         Texts::TXT_INTERP_SETTING_PROFILE_SAVING,
         "Save program profile data to trace database after simulation.");
 
+    addText(
+        Texts::TXT_INTERP_SETTING_PROFILING,
+        "Write a callgrind profile of the simulation.");
+
+    addText(
+        Texts::TXT_INTERP_SETTING_PROFILE_FILE,
+        "File to write the callgrind profile to. Empty for "
+        "<program>.callgrind.");
+
     addText(
         Texts::TXT_INTERP_SETTING_HISTORY_FILENAME,
         "File to store the command history log in.");
@@ -199,6 +199,8 @@ namespace Texts {
         TXT_INTERP_SETTING_MEMORY_ACCESS_TRACKING,
         TXT_INTERP_SETTING_UTILIZATION_SAVING,
         TXT_INTERP_SETTING_PROFILE_SAVING,
+        TXT_INTERP_SETTING_PROFILING,
+        TXT_INTERP_SETTING_PROFILE_FILE,
         TXT_NO_PROGRAM_LOADED,
         TXT_AUTOMATIC_FINISH_IMPOSSIBLE,
         TXT_STARTUP_SETTINGS_CHANGED_WARNING
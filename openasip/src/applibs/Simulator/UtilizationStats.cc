@@ -44,7 +44,9 @@
 #include "FUPort.hh"
 #include "Guard.hh"
 #include "MoveGuard.hh"
-#include "hash_set.hh"
+#include "ProgramUtilizationIndex.hh"
+#include "InstructionMemory.hh"
+#include <set>
 #include "Application.hh"
 #include "TCEString.hh"
 
@@ -78,7 +80,7 @@ UtilizationStats::calculateForInstruction(
     // used to make sure output socket utilizations are computed only
     // maximum once per instruction, even though the socket is read by
     // multiple buses
-    hash_set<const char*> alreadyRegisteredOutputSockets;
+    std::set<const TTAMachine::Socket*> alreadyRegisteredOutputSockets;
 
     for (int i = 0; i < instructionData.moveCount(); ++i) {
         const TTAProgram::Move& move = instructionData.move(i);
@@ -93,13 +95,10 @@ UtilizationStats::calculateForInstruction(
         // socket utilizations
         if (!move.source().isImmediate() && 
             move.sourceSocket().name() != move.destinationSocket().name() &&
-            alreadyRegisteredOutputSockets.find(
-                move.sourceSocket().name().c_str()) ==
-            alreadyRegisteredOutputSockets.end()) {
+            alreadyRegisteredOutputSockets.insert(
+                &move.sourceSocket()).second) {
 
             sockets_[move.sourceSocket().name()] += execCount;
-            alreadyRegisteredOutputSockets.insert(
-                move.sourceSocket().name().c_str());
         }
         sockets_[move.destinationSocket().name()] += execCount;
 
@@ -182,6 +181,124 @@ UtilizationStats::calculateForInstruction(
     }
 }
 
+/**
+ * Accumulates the utilization counts of a simulation run of a program.
+ *
+ * Produces the same statistics as passing the executed instructions of
+ * the program to calculateForInstruction() in the order
+ * SimulationStatistics does, but the machine parts used by the moves are
+ * resolved only once in the given index.
+ *
+ * @param index The utilization index of the simulated program.
+ * @param executionCounts The instruction memory of the simulation.
+ */
+void
+UtilizationStats::calculate(
+    const ProgramUtilizationIndex& index,
+    const InstructionMemory& executionCounts) {
+
+    std::vector<ClockCycleCount> moveCounts(index.moveCount(), 0);
+    std::vector<char> countedMoves(index.moveCount(), 0);
+
+    for (std::size_t i = index.startInstruction(); 
+         i < index.instructionCount(); ++i) {
+
+        // implicit instructions are processed with the explicit ones
+        if (index.isImplicit(i)) {
+            continue;
+        }
+        const InstructionAddress address = index.instructionAddress(i);
+        const ExecutableInstruction& execInstr = 
+            executionCounts.instructionAtConst(address);
+        if (execInstr.executionCount() == 0) {
+            continue;
+        }
+
+        // the explicit instruction is followed by the implicit instructions
+        // of the same address, both in the index and in the memory
+        const InstructionMemory::InstructionContainer& implicitInstructions =
+            executionCounts.implicitInstructionsAt(address);
+        const ExecutableInstruction* executed = &execInstr;
+        std::size_t instruction = i;
+        for (std::size_t implicit = 0;; ++implicit) {
+            const std::size_t first = index.firstMove(instruction);
+            for (std::size_t m = 0; m < index.moveCount(instruction); ++m) {
+                moveCounts[first + m] = executed->moveExecutionCount(m);
+                countedMoves[first + m] = 1;
+            }
+            ++instruction;
+            if (implicit == implicitInstructions.size() ||
+                instruction == index.instructionCount() ||
+                !index.isImplicit(instruction)) {
+                break;
+            }
+            executed = implicitInstructions[implicit];
+        }
+    }
+    calculate(index, moveCounts, countedMoves);
+}
+
+/**
+ * Accumulates the utilization counts from the given move execution counts.
+ *
+ * @param index The utilization index of the simulated program.
+ * @param moveCounts Execution counts of the moves in the program order.
+ * @param countedMoves Non-zero for the moves of the executed instructions.
+ */
+void
+UtilizationStats::calculate(
+    const ProgramUtilizationIndex& index,
+    const std::vector<ClockCycleCount>& moveCounts,
+    const std::vector<char>& countedMoves) {
+
+    std::vector<ClockCycleCount> totals;
+    std::vector<char> usedCounters;
+    index.reduce(moveCounts, countedMoves, totals, usedCounters);
+
+    for (std::size_t i = 0; i < index.counterCount(); ++i) {
+        if (!usedCounters[i]) {
+            continue;
+        }
+        const ProgramUtilizationIndex::Counter& counter = index.counter(i);
+        const ClockCycleCount total = totals[i];
+        switch (counter.kind) {
+        case ProgramUtilizationIndex::BUS_WRITES:
+            buses_[counter.component] += total;
+            break;
+        case ProgramUtilizationIndex::SOCKET_WRITES:
+            sockets_[counter.component] += total;
+            break;
+        case ProgramUtilizationIndex::FU_TRIGGERS:
+            fus_[counter.component] += total;
+            break;
+        case ProgramUtilizationIndex::OPERATION_EXECUTIONS:
+            operations_[counter.component] += total;
+            break;
+        case ProgramUtilizationIndex::FU_OPERATION_EXECUTIONS:
+            fuOperations_[counter.component][counter.part] += total;
+            break;
+        case ProgramUtilizationIndex::REGISTER_READS:
+            rfAccesses_[counter.component][counter.registerIndex].first +=
+                total;
+            break;
+        case ProgramUtilizationIndex::REGISTER_WRITES:
+            rfAccesses_[counter.component][counter.registerIndex].second +=
+                total;
+            break;
+        case ProgramUtilizationIndex::GUARD_REGISTER_READS:
+            guardRfAccesses_[counter.component][counter.registerIndex].first
+                += total;
+            break;
+        case ProgramUtilizationIndex::FU_GUARD_READS:
+            guardFUAccesses_[counter.component][counter.part] += total;
+            break;
+        }
+        if (counter.registerIndex > highestRegister_) {
+            highestRegister_ = counter.registerIndex;
+        }
+    }
+}
+
 /**
  * Returns the count of writes to the given bus.
  *
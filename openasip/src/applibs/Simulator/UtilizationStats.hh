@@ -35,6 +35,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 #include "SimulationStatisticsCalculator.hh"
 #include "SimulatorConstants.hh"
@@ -43,6 +44,9 @@ namespace TTAMachine {
     class Guard;
 }
 
+class ProgramUtilizationIndex;
+class InstructionMemory;
+
 /**
  * Calculates processor utilization data from instructions and their
  * execution counts.
@@ -72,6 +76,10 @@ public:
         const TTAProgram::Instruction& instructionData, 
         const ExecutableInstruction& executionCounts);
 
+    void calculate(
+        const ProgramUtilizationIndex& index,
+        const InstructionMemory& executionCounts);
+
     ClockCycleCount busWrites(const std::string& busName) const;
     ClockCycleCount socketWrites(const std::string& socketName) const;
     ClockCycleCount triggerCount(const std::string& fuName) const;
@@ -96,6 +104,12 @@ public:
     
     int highestUsedRegisterIndex() const;
 
+protected:
+    void calculate(
+        const ProgramUtilizationIndex& index,
+        const std::vector<ClockCycleCount>& moveCounts,
+        const std::vector<char>& countedMoves);
+
 private:
     /// Socket write counts.
     ComponentUtilizationIndex sockets_;
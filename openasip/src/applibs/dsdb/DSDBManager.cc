@@ -31,7 +31,10 @@
  * @note rating: red
  */
 
+#include <algorithm>
+#include <map>
 #include <boost/format.hpp>
+#include <boost/functional/hash.hpp>
 #include <boost/tuple/tuple_comparison.hpp>
 #include <utility>
 #include "DSDBManager.hh"
@@ -42,6 +45,16 @@
 #include "IDFSerializer.hh"
 #include "Conversion.hh"
 #include "Machine.hh"
+#include "ControlUnit.hh"
+#include "RegisterFile.hh"
+#include "ImmediateUnit.hh"
+#include "Segment.hh"
+#include "Socket.hh"
+#include "Bridge.hh"
+#include "AddressSpace.hh"
+#include "ImmediateSlot.hh"
+#include "InstructionTemplate.hh"
+#include "Port.hh"
 #include "MachineImplementation.hh"
 #include "DataObject.hh"
 #include "FileSystem.hh"
@@ -56,6 +69,482 @@ using std::make_pair;
 using std::string;
 using namespace CostEstimator;
 
+namespace {
+
+/// Number of label refinement rounds over the component references.
+const int CANONICAL_ROUNDS = 3;
+
+/**
+ * Returns the given object state tree as a string.
+ *
+ * The children of each state are sorted by their strings, so the result
+ * does not depend on the order in which the components are declared.
+ *
+ * If a name map is given, the name of the root state is left out and the
+ * values found in the map are replaced by the mapped strings. The name
+ * attributes of the child states are the names of operations, ports and
+ * other parts of the component, not references to other components, so
+ * only the names found in the scoped names are replaced among them.
+ *
+ * @param state The state tree.
+ * @param names The names to replace, or NULL.
+ * @param scopedNames Names that are unique only within their parents.
+ * @param root True if the state is the root of the tree.
+ * @return The string.
+ */
+std::string
+stateString(
+    const ObjectState& state, const std::map<std::string, std::string>* names,
+    const std::set<std::string>& scopedNames, bool root) {
+
+    std::string result = state.name() + "{";
+    for (int i = 0; i < state.attributeCount(); i++) {
+        const ObjectState::Attribute& attribute = *state.attribute(i);
+        std::string value = attribute.value;
+        if (names != NULL) {
+            if (attribute.name == TTAMachine::Component::OSKEY_NAME) {
+                if (root) {
+                    continue;
+                }
+                if (scopedNames.count(value) != 0) {
+                    value = "*";
+                }
+            } else {
+                std::map<std::string, std::string>::const_iterator name =
+                    names->find(value);
+                if (name != names->end()) {
+                    value = name->second;
+                }
+            }
+        }
+        result += attribute.name + "=" + value + ";";
+    }
+    std::string value = state.stringValue();
+    if (names != NULL) {
+        std::map<std::string, std::string>::const_iterator name =
+            names->find(value);
+        if (name != names->end()) {
+            value = name->second;
+        }
+    }
+    result += value;
+
+    std::vector<std::string> children;
+    for (int i = 0; i < state.childCount(); i++) {
+        children.push_back(
+            stateString(*state.child(i), names, scopedNames, false));
+    }
+    std::sort(children.begin(), children.end());
+    for (const std::string& child : children) {
+        result += child;
+    }
+    return result + "}";
+}
+
+/**
+ * Adds the values in the given state tree that refer to components by
+ * their names to a list.
+ */
+void
+addReferences(
+    const ObjectState& state, const std::map<std::string, std::string>& names,
+    std::vector<std::string>& references) {
+
+    for (int i = 0; i < state.attributeCount(); i++) {
+        const ObjectState::Attribute& attribute = *state.attribute(i);
+        if (attribute.name != TTAMachine::Component::OSKEY_NAME &&
+            names.count(attribute.value) != 0) {
+            references.push_back(attribute.value);
+        }
+    }
+    if (names.count(state.stringValue()) != 0) {
+        references.push_back(state.stringValue());
+    }
+    for (int i = 0; i < state.childCount(); i++) {
+        addReferences(*state.child(i), names, references);
+    }
+}
+
+/**
+ * Name independent labels of the components of a machine.
+ *
+ * A component is first labeled with its state, the names of all the
+ * components hidden. The labels are then refined a few rounds: the names
+ * referred to in the state are replaced by the labels of the named
+ * components, and the labels of the components referring to the component
+ * are added. Components are thus told apart by their place in the machine
+ * instead of by their names, as in Machine::fingerprint().
+ *
+ * Ports and segments are named uniquely only within their parents, so
+ * their names are always hidden and they are labeled by their own states
+ * and the labels of the components they refer to.
+ */
+class ComponentLabels {
+public:
+    /**
+     * Adds the given components to be labeled.
+     *
+     * @param components The components.
+     * @param scoped True if the names are unique only within the parents
+     *               of the components.
+     */
+    template <typename ComponentType>
+    void add(
+        const std::vector<ComponentType*>& components, bool scoped = false) {
+        for (ComponentType* component : components) {
+            index_[component] = names_.size();
+            names_.push_back(component->name());
+            scoped_.push_back(scoped);
+            states_.push_back(component->saveState());
+        }
+    }
+
+    ~ComponentLabels() {
+        for (ObjectState* state : states_) {
+            delete state;
+        }
+    }
+
+    /**
+     * Computes the labels of the added components.
+     */
+    void compute() {
+        std::map<std::string, std::string> hidden;
+        std::map<std::string, std::vector<std::size_t> > byName;
+        std::set<std::string> scopedNames;
+        for (std::size_t i = 0; i < names_.size(); i++) {
+            hidden[names_[i]] = "*";
+            if (scoped_[i]) {
+                scopedNames.insert(names_[i]);
+            } else {
+                byName[names_[i]].push_back(i);
+            }
+        }
+        std::vector<std::vector<std::string> > references(states_.size());
+        for (std::size_t i = 0; i < states_.size(); i++) {
+            addReferences(*states_[i], hidden, references[i]);
+        }
+        labels_.clear();
+        for (ObjectState* state : states_) {
+            labels_.push_back(boost::hash<std::string>()(
+                stateString(*state, &hidden, scopedNames, true)));
+        }
+
+        for (int round = 0; round < CANONICAL_ROUNDS; round++) {
+            std::map<std::string, std::vector<std::size_t> > named;
+            for (std::size_t i = 0; i < names_.size(); i++) {
+                if (!scoped_[i]) {
+                    named[names_[i]].push_back(labels_[i]);
+                }
+            }
+            std::map<std::string, std::string> labeled = hidden;
+            for (auto& name : named) {
+                std::sort(name.second.begin(), name.second.end());
+                std::string label;
+                for (std::size_t value : name.second) {
+                    label += Conversion::toString(value) + ",";
+                }
+                labeled[name.first] = label;
+            }
+            std::vector<std::vector<std::size_t> > referrers(states_.size());
+            for (std::size_t i = 0; i < states_.size(); i++) {
+                for (const std::string& name : references[i]) {
+                    for (std::size_t j : byName[name]) {
+                        referrers[j].push_back(labels_[i]);
+                    }
+                }
+            }
+            std::vector<std::size_t> refined;
+            for (std::size_t i = 0; i < states_.size(); i++) {
+                std::string label =
+                    stateString(*states_[i], &labeled, scopedNames, true);
+                std::sort(referrers[i].begin(), referrers[i].end());
+                for (std::size_t referrer : referrers[i]) {
+                    label += Conversion::toString(referrer) + ",";
+                }
+                refined.push_back(boost::hash<std::string>()(label));
+            }
+            labels_.swap(refined);
+        }
+    }
+
+    /**
+     * Returns the label of the given component.
+     */
+    std::size_t label(const void* component) const {
+        return labels_.at(index_.at(component));
+    }
+
+private:
+    /// Indices of the components.
+    std::map<const void*, std::size_t> index_;
+    /// Names of the components.
+    std::vector<std::string> names_;
+    /// True for the components named uniquely only within their parents.
+    std::vector<bool> scoped_;
+    /// States of the components.
+    std::vector<ObjectState*> states_;
+    /// Labels of the components.
+    std::vector<std::size_t> labels_;
+};
+
+/**
+ * Sorts the given components to an order that does not depend on their
+ * names or their declaration order.
+ *
+ * The components are ordered by their labels. Components with equal
+ * labels are ordered by their names.
+ *
+ * @param components The components to sort.
+ * @param labels The labels of the components.
+ */
+template <typename ComponentType>
+void
+sortComponents(
+    std::vector<ComponentType*>& components, const ComponentLabels& labels) {
+
+    typedef std::pair<std::pair<std::size_t, std::string>, ComponentType*>
+        KeyedComponent;
+    std::vector<KeyedComponent> keyed;
+    for (ComponentType* component : components) {
+        keyed.push_back(std::make_pair(
+            std::make_pair(labels.label(component), component->name()),
+            component));
+    }
+    std::sort(
+        keyed.begin(), keyed.end(),
+        [](const KeyedComponent& a, const KeyedComponent& b) {
+            return a.first < b.first;
+        });
+    for (std::size_t i = 0; i < keyed.size(); i++) {
+        components[i] = keyed[i].second;
+    }
+}
+
+/**
+ * Names the given components by their position in the sequence.
+ *
+ * The components are first given temporary names that are free in the
+ * machine, so the final names cannot clash with the names of components
+ * that are not renamed yet.
+ *
+ * @param components The components to rename.
+ * @param hasName Tells whether a name is already in use.
+ */
+template <typename ComponentType, typename NameLookup>
+void
+renameByPosition(
+    const std::vector<ComponentType*>& components, NameLookup hasName) {
+
+    int freeIndex = 0;
+    for (ComponentType* component : components) {
+        std::string name;
+        do {
+            name = "t" + Conversion::toString(freeIndex++);
+        } while (hasName(name));
+        component->setName(name);
+    }
+    for (std::size_t i = 0; i < components.size(); i++) {
+        components[i]->setName("c" + Conversion::toString(i));
+    }
+}
+
+/**
+ * Returns the components of the given navigator.
+ */
+template <typename ComponentType>
+std::vector<ComponentType*>
+components(const TTAMachine::Machine::Navigator<ComponentType>& navigator) {
+    std::vector<ComponentType*> result;
+    for (int i = 0; i < navigator.count(); i++) {
+        result.push_back(navigator.item(i));
+    }
+    return result;
+}
+
+/**
+ * Returns the ports of the given unit.
+ */
+std::vector<TTAMachine::Port*>
+ports(const TTAMachine::Unit& unit) {
+    std::vector<TTAMachine::Port*> result;
+    for (int i = 0; i < unit.portCount(); i++) {
+        result.push_back(unit.port(i));
+    }
+    return result;
+}
+
+/**
+ * Returns the segments of the given bus.
+ */
+std::vector<TTAMachine::Segment*>
+segments(const TTAMachine::Bus& bus) {
+    std::vector<TTAMachine::Segment*> result;
+    for (int i = 0; i < bus.segmentCount(); i++) {
+        result.push_back(bus.segment(i));
+    }
+    return result;
+}
+
+/**
+ * Returns the canonical form of the machine.
+ *
+ * The components of each kind are sorted to an order that does not
+ * depend on their names or declaration order, and renamed by their
+ * position in that order. The renamed machine is then written out with
+ * the components of each kind in sorted order.
+ *
+ * Two architectures with equal canonical forms differ only in the names
+ * and the declaration order of their components, so programs behave the
+ * same on them. Components that cannot be told apart by their labels are
+ * ordered by their original names, so a renamed copy of a machine with
+ * such components may get a canonical form of its own.
+ *
+ * @param mach The machine, which is renamed in place.
+ * @return The canonical form.
+ */
+std::string
+canonicalForm(TTAMachine::Machine& mach) {
+
+    std::vector<TTAMachine::FunctionUnit*> fus =
+        components(mach.functionUnitNavigator());
+    TTAMachine::ControlUnit* gcu = mach.controlUnit();
+    if (gcu != NULL) {
+        fus.push_back(gcu);
+    }
+    std::vector<TTAMachine::RegisterFile*> rfs =
+        components(mach.registerFileNavigator());
+    std::vector<TTAMachine::ImmediateUnit*> ius =
+        components(mach.immediateUnitNavigator());
+    std::vector<TTAMachine::Bus*> buses = components(mach.busNavigator());
+    std::vector<TTAMachine::Socket*> sockets =
+        components(mach.socketNavigator());
+    std::vector<TTAMachine::Bridge*> bridges =
+        components(mach.bridgeNavigator());
+    std::vector<TTAMachine::AddressSpace*> addressSpaces =
+        components(mach.addressSpaceNavigator());
+    std::vector<TTAMachine::ImmediateSlot*> immediateSlots =
+        components(mach.immediateSlotNavigator());
+    std::vector<TTAMachine::InstructionTemplate*> templates =
+        components(mach.instructionTemplateNavigator());
+
+    std::vector<TTAMachine::Unit*> units;
+    units.insert(units.end(), fus.begin(), fus.end());
+    units.insert(units.end(), rfs.begin(), rfs.end());
+    units.insert(units.end(), ius.begin(), ius.end());
+    std::vector<std::vector<TTAMachine::Port*> > unitPorts;
+    for (TTAMachine::Unit* unit : units) {
+        unitPorts.push_back(ports(*unit));
+    }
+    std::vector<std::vector<TTAMachine::Segment*> > busSegments;
+    for (TTAMachine::Bus* bus : buses) {
+        busSegments.push_back(segments(*bus));
+    }
+
+    ComponentLabels labels;
+    labels.add(units);
+    labels.add(buses);
+    labels.add(sockets);
+    labels.add(bridges);
+    labels.add(addressSpaces);
+    labels.add(immediateSlots);
+    labels.add(templates);
+    for (const std::vector<TTAMachine::Port*>& unitPort : unitPorts) {
+        labels.add(unitPort, true);
+    }
+    for (const std::vector<TTAMachine::Segment*>& segment : busSegments) {
+        labels.add(segment, true);
+    }
+    labels.compute();
+
+    // the order is decided before any component is renamed
+    sortComponents(fus, labels);
+    sortComponents(rfs, labels);
+    sortComponents(ius, labels);
+    sortComponents(buses, labels);
+    sortComponents(sockets, labels);
+    sortComponents(bridges, labels);
+    sortComponents(addressSpaces, labels);
+    sortComponents(immediateSlots, labels);
+    sortComponents(templates, labels);
+    for (std::vector<TTAMachine::Port*>& unitPort : unitPorts) {
+        sortComponents(unitPort, labels);
+    }
+    for (std::vector<TTAMachine::Segment*>& segment : busSegments) {
+        sortComponents(segment, labels);
+    }
+
+    const TTAMachine::Machine::FunctionUnitNavigator& fuNav =
+        mach.functionUnitNavigator();
+    renameByPosition(fus, [&fuNav, gcu](const std::string& name) {
+        return fuNav.hasItem(name) || (gcu != NULL && gcu->name() == name);
+    });
+    for (std::size_t i = 0; i < units.size(); i++) {
+        TTAMachine::Unit* unit = units[i];
+        renameByPosition(unitPorts[i], [unit](const std::string& name) {
+            return unit->hasPort(name);
+        });
+    }
+    renameByPosition(rfs, [&mach](const std::string& name) {
+        return mach.registerFileNavigator().hasItem(name);
+    });
+    renameByPosition(ius, [&mach](const std::string& name) {
+        return mach.immediateUnitNavigator().hasItem(name);
+    });
+    renameByPosition(buses, [&mach](const std::string& name) {
+        return mach.busNavigator().hasItem(name);
+    });
+    for (std::size_t i = 0; i < buses.size(); i++) {
+        TTAMachine::Bus* bus = buses[i];
+        renameByPosition(busSegments[i], [bus](const std::string& name) {
+            return bus->hasSegment(name);
+        });
+    }
+    renameByPosition(sockets, [&mach](const std::string& name) {
+        return mach.socketNavigator().hasItem(name);
+    });
+    renameByPosition(bridges, [&mach](const std::string& name) {
+        return mach.bridgeNavigator().hasItem(name);
+    });
+    renameByPosition(addressSpaces, [&mach](const std::string& name) {
+        return mach.addressSpaceNavigator().hasItem(name);
+    });
+    renameByPosition(immediateSlots, [&mach](const std::string& name) {
+        return mach.immediateSlotNavigator().hasItem(name);
+    });
+    renameByPosition(templates, [&mach](const std::string& name) {
+        return mach.instructionTemplateNavigator().hasItem(name);
+    });
+
+    ObjectState* state = mach.saveState();
+    std::string form = stateString(*state, NULL, std::set<std::string>(), true);
+    delete state;
+    return form;
+}
+
+/**
+ * Returns a hash of the canonical form of the given machine.
+ *
+ * @param mach The machine.
+ * @return The hash as a string.
+ */
+std::string
+canonicalHash(const TTAMachine::Machine& mach) {
+    // the copy constructor leaves out the machine level attributes
+    TTAMachine::Machine copy;
+    ObjectState* state = mach.saveState();
+    copy.loadState(state);
+    delete state;
+    std::string form = canonicalForm(copy);
+    std::string hash = Conversion::toHexString(form.length()).substr(2);
+    hash += "_";
+    hash += Conversion::toHexString(boost::hash<std::string>()(form))
+        .substr(2);
+    return hash;
+}
+
+}
+
 const string CREATE_ARCH_TABLE =
     "CREATE TABLE architecture ("
     "       id INTEGER PRIMARY KEY,"
@@ -63,6 +552,10 @@ const string CREATE_ARCH_TABLE =
     "       adf_hash VARCHAR,"
     "       adf_xml VARCHAR)";
 
+const string CREATE_CANONICAL_HASH_INDEX =
+    "CREATE INDEX architecture_canonical_hash_index "
+    "ON architecture(canonical_hash)";
+
 const string CREATE_IMPL_TABLE =
     "CREATE TABLE implementation ("
     "       id INTEGER PRIMARY KEY,"
@@ -118,6 +611,60 @@ DSDBManager::DSDBManager(const std::string& file)
         throw IOException(
             __FILE__, __LINE__, __func__, exception.errorMessage());
     }
+
+    // Update outdated DSDB.
+    // Version 0 indicates db without version number also.
+    int dbVersion = dbConnection_->version();
+
+    // Version 0 -> 1
+    if (dbVersion < 1) {
+        // structural fingerprints of the architectures
+        try {
+            dbConnection_->updateQuery(std::string(
+                "ALTER TABLE architecture ADD COLUMN fingerprint VARCHAR;"));
+            std::set<RowID> archIDs = architectureIDs();
+            for (std::set<RowID>::const_iterator i = archIDs.begin();
+                 i != archIDs.end(); i++) {
+                TTAMachine::Machine* mach = architecture(*i);
+                dbConnection_->updateQuery(
+                    (boost::format(
+                        "UPDATE architecture SET fingerprint = \'%s\' "
+                        "WHERE id = %d;") %
+                     mach->fingerprint() % *i).str());
+                delete mach;
+            }
+        } catch (const RelationalDBException& exception) {
+            throw IOException(
+                __FILE__, __LINE__, __func__, exception.errorMessage());
+        }
+        dbConnection_->updateVersion(1);
+    }
+
+    // Version 1 -> 2
+    if (dbVersion < 2) {
+        // hashes of the canonical forms of the architectures
+        try {
+            dbConnection_->updateQuery(std::string(
+                "ALTER TABLE architecture ADD COLUMN canonical_hash "
+                "VARCHAR;"));
+            dbConnection_->DDLQuery(CREATE_CANONICAL_HASH_INDEX);
+            std::set<RowID> archIDs = architectureIDs();
+            for (std::set<RowID>::const_iterator i = archIDs.begin();
+                 i != archIDs.end(); i++) {
+                TTAMachine::Machine* mach = architecture(*i);
+                dbConnection_->updateQuery(
+                    (boost::format(
+                        "UPDATE architecture SET canonical_hash = \'%s\' "
+                        "WHERE id = %d;") %
+                     canonicalHash(*mach) % *i).str());
+                delete mach;
+            }
+        } catch (const RelationalDBException& exception) {
+            throw IOException(
+                __FILE__, __LINE__, __func__, exception.errorMessage());
+        }
+        dbConnection_->updateVersion(2);
+    }
 }
 
 /**
@@ -221,10 +768,11 @@ DSDBManager::addArchitecture(const TTAMachine::Machine& mom) {
         dbConnection_->updateQuery(
             (boost::format(
                 "INSERT INTO architecture(id, adf_hash, adf_xml, "
-                "connection_count) VALUES"
-                "(NULL, \'%s\', \'%s\', %d);") %
+                "connection_count, fingerprint, canonical_hash) VALUES"
+                "(NULL, \'%s\', \'%s\', %d, \'%s\', \'%s\');") %
              mom.hash() % adf % 
-             MachineConnectivityCheck::totalConnectionCount(mom)).str());
+             MachineConnectivityCheck::totalConnectionCount(mom) %
+             mom.fingerprint() % canonicalHash(mom)).str());
         id = dbConnection_->lastInsertRowID();
         dbConnection_->commit();
     } catch (const RelationalDBException& e) {
@@ -544,7 +1092,7 @@ DSDBManager::setUnschedulable(RowID application, RowID architecture) {
  * @param application RowID of the application.
  * @param architecture RowID of the machine architecture.
  * @return True, if it's known that the application is unschedulable
- * for the given architecture.
+ * for the given architecture or a structurally equal one.
  */ 
 bool
 DSDBManager::isUnschedulable(
@@ -556,7 +1104,7 @@ DSDBManager::isUnschedulable(
         result = dbConnection_->query(
             "SELECT unschedulable FROM cycle_count WHERE application=" +
             Conversion::toString(application) + " AND " +
-            "architecture=" + Conversion::toString(architecture) + " "
+            "architecture IN " + equivalentArchitectures(architecture) + " "
             "AND unschedulable = 1;");
     } catch (Exception& e) {
         abortWithError(e.errorMessage());
@@ -693,22 +1241,62 @@ DSDBManager::architectureString(RowID id) const {
     return arch;
 }
 
+/**
+ * Returns an SQL list of the IDs of the architectures that are
+ * structurally equal to the given one, the architecture itself included.
+ *
+ * The architectures are compared by the hashes of their canonical forms
+ * that are stored when the architectures are added.
+ *
+ * @param id RowID of the machine architecture.
+ * @return The list of IDs in SQL syntax.
+ */
+std::string
+DSDBManager::equivalentArchitectures(RowID id) const {
+    const std::string idString = Conversion::toString(id);
+    return
+        "(SELECT id FROM architecture WHERE id=" + idString +
+        " OR canonical_hash=(SELECT canonical_hash FROM architecture "
+        "WHERE id=" + idString + "))";
+}
+
 /**
  * Returns the row ID of the given architecture.
  *
- * Searches for the architecture using its Machine::hash() string.
- *e
+ * Searches for the architecture using its Machine::fingerprint() and
+ * Machine::hash() strings. The fingerprint is cheap to compute, so the
+ * machine is serialized for the hash only if a structurally equal
+ * architecture is found. The hash keeps the component names of the stored
+ * architecture equal to the ones implementations refer to.
+ *
  * @param id RowID of the machine architecture. ILLEGAL_ROW_ID, if not found.
  * @return The architecture ID.
  */
 RowID
 DSDBManager::architectureId(const TTAMachine::Machine& mach) const {
 
+    const TCEString fingerprint = mach.fingerprint();
     RelationalDBQueryResult* result = NULL;
     try {
         result = dbConnection_->query(
-            TCEString("SELECT id FROM architecture WHERE adf_hash = \'") +
-            mach.hash() + "\';");
+            TCEString("SELECT id FROM architecture WHERE fingerprint = \'") +
+            fingerprint + "\';");
+    } catch (const Exception& e) {
+        delete result;
+        abortWithError(e.errorMessage());
+    }
+
+    bool candidates = result->hasNext();
+    delete result;
+    result = NULL;
+    if (!candidates) {
+        return ILLEGAL_ROW_ID;
+    }
+
+    try {
+        result = dbConnection_->query(
+            TCEString("SELECT id FROM architecture WHERE fingerprint = \'") +
+            fingerprint + "\' AND adf_hash = \'" + mach.hash() + "\';");
     } catch (const Exception& e) {
         delete result;
         abortWithError(e.errorMessage());
@@ -1220,6 +1808,8 @@ DSDBManager::energyEstimate(RowID application, RowID implementation) const {
  * Checks if cycle count exists for an application and architecture
  * with given IDs.
  *
+ * Cycle counts of structurally equal architectures are shared.
+ *
  * @param application ID of the application.
  * @param architecture ID of the machine architecture
  * @return True, if a cycle count exists in the DB.
@@ -1234,7 +1824,8 @@ DSDBManager::hasCycleCount(RowID application, RowID architecture) const {
             "SELECT cycles FROM cycle_count WHERE cycles IS NOT NULL AND "
             " application=" +
             Conversion::toString(application) + " AND " +
-            "architecture=" + Conversion::toString(architecture) + ";");
+            "architecture IN " + equivalentArchitectures(architecture) +
+            ";");
     } catch (Exception&) {
         assert(false);
     }
@@ -1251,6 +1842,8 @@ DSDBManager::hasCycleCount(RowID application, RowID architecture) const {
 
 /**
  * Returns cycle count for an application on specific architecture.
+ *
+ * Cycle counts of structurally equal architectures are shared.
  * 
  * @param application RowID of the application.
  * @param architecture RowID of the architecture.
@@ -1270,9 +1863,10 @@ DSDBManager::cycleCount(RowID application, RowID architecture) const {
 
     try {
         result = dbConnection_->query(
-            "SELECT cycles FROM cycle_count WHERE application=" +
-            Conversion::toString(application) + " AND architecture=" +
-            Conversion::toString(architecture) + ";");
+            "SELECT cycles FROM cycle_count WHERE cycles IS NOT NULL AND "
+            "application=" + Conversion::toString(application) +
+            " AND architecture IN " + equivalentArchitectures(architecture) +
+            ";");
 
     } catch (const Exception& e) {
         delete result;
@@ -244,6 +244,7 @@ public:
     int applicationCount() const;
 private:
     std::string architectureString(RowID id) const;
+    std::string equivalentArchitectures(RowID id) const;
     std::string implementationString(RowID id) const;
 
     /// Handle to the database.
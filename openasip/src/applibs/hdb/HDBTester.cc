@@ -41,15 +41,15 @@ using std::vector;
 using std::set;
 
 HDBTester::HDBTester(): infoStream_(NULL), errorStream_(NULL), sim_(SIM_GHDL),
-                        verbose_(false), leaveDirty_(false) {
+                        verbose_(false), leaveDirty_(false), jobs_(1) {
 }
 
 HDBTester::HDBTester(
     std::ostream& infoStream, 
     std::ostream& errorStream,
-    VhdlSim simulator, bool verbose, bool leaveDirty):
+    VhdlSim simulator, bool verbose, bool leaveDirty, unsigned int jobs):
     infoStream_(&infoStream), errorStream_(&errorStream), sim_(simulator),
-    verbose_(verbose), leaveDirty_(leaveDirty) {
+    verbose_(verbose), leaveDirty_(leaveDirty), jobs_(jobs) {
 }
 
 HDBTester::~HDBTester() {
@@ -66,23 +66,50 @@ HDBTester::testAllEntries(std::string hdbFile) {
         return false;
     }
 
+    vector<ImplementationTester::EntryResult> results;
     bool noFailures = true;
-    set<int> fus = implTester->fuEntryIDs();
-    for (set<int>::iterator iter = fus.begin(); iter != fus.end(); iter++) {
-        if (!testFU(*iter, implTester)) {
-            noFailures = false;
-            std::cerr << "FU Entry " << *iter << " from " << hdbFile
-                      << " failed." << std::endl;
+    try {
+        noFailures = implTester->validateEntries(
+            implTester->fuEntryIDs(), implTester->rfEntryIDs(), jobs_,
+            results);
+    } catch (Exception& e) {
+        if (errorStream_ != NULL) {
+            *errorStream_ 
+                << "Runtime error: " << e.errorMessage() << std::endl;
         }
+        delete implTester;
+        return false;
     }
 
-    set<int> rfs = implTester->rfEntryIDs();
-    for (set<int>::iterator iter = rfs.begin(); iter != rfs.end(); iter++) {
-        if (!testRF(*iter, implTester)) {
-            noFailures = false;
-            std::cerr << "RF Entry " << *iter << " from " << hdbFile
-                      << " failed." << std::endl;
+    int tested = 0;
+    int failed = 0;
+    for (unsigned int i = 0; i < results.size(); i++) {
+        const ImplementationTester::EntryResult& result = results.at(i);
+        string type = result.isFU ? "FU" : "RF";
+        if (!result.tested) {
+            if (infoStream_ != NULL) {
+                *infoStream_ << "Cannot test " << type << " id " 
+                             << result.entryID << " because: " 
+                             << result.reason << std::endl;
+            }
+            continue;
+        }
+        tested++;
+        if (result.success) {
+            continue;
+        }
+        failed++;
+        if (errorStream_ != NULL) {
+            for (unsigned int e = 0; e < result.errors.size(); e++) {
+                 *errorStream_ << result.errors.at(e);
+            }
         }
+        std::cerr << type << " Entry " << result.entryID << " from " 
+                  << hdbFile << " failed." << std::endl;
+    }
+    if (verbose_ && infoStream_ != NULL) {
+        *infoStream_ << "Tested " << tested << " of " << results.size()
+                     << " entries, " << failed << " failed." << std::endl;
     }
     delete implTester;
     return noFailures;
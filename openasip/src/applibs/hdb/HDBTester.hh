@@ -43,7 +43,8 @@ public:
     HDBTester(
         std::ostream& infoStream,
         std::ostream& errorStream,
-        VhdlSim simulator, bool verbose, bool leaveDirty);
+        VhdlSim simulator, bool verbose, bool leaveDirty,
+        unsigned int jobs = 1);
 
     virtual ~HDBTester();
 
@@ -66,6 +67,8 @@ private:
     VhdlSim sim_;
     bool verbose_;
     bool leaveDirty_;
+    /// Number of entries simulated concurrently, 0 for one per core.
+    unsigned int jobs_;
 };
 
 #endif
@@ -90,6 +90,16 @@ FUCollisionMatrixIndex::at(int index) {
     return *matrices_.at(index);
 }
 
+/**
+ * Returns the collision matrix at the given index.
+ *
+ * @param operation The index of the operation.
+ */
+const CollisionMatrix&
+FUCollisionMatrixIndex::at(int index) const {
+    return *matrices_.at(index);
+}
+
 /**
  * Returns the count of collision matrices in the index.
  *
@@ -50,6 +50,7 @@ public:
     virtual ~FUCollisionMatrixIndex();
 
     CollisionMatrix& at(int index);
+    const CollisionMatrix& at(int index) const;
     int size() const;
 private:
     /// Stores all collision matrices, including one for the pseudo NOP.
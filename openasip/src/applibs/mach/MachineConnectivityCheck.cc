@@ -34,6 +34,7 @@
 #include <set>
 
 #include "MachineConnectivityCheck.hh"
+#include "MachineConnectivityMatrix.hh"
 #include "MachineInfo.hh"
 #include "Application.hh"
 #include "Bus.hh"
@@ -130,14 +131,15 @@ MachineConnectivityCheck::isConnected(
     const TTAMachine::Port& destinationPort,
     const Guard* guard) {
 
-    // TODO: replace this cache's second value(bool) with set of buses.
-    PortPortBoolMap::const_iterator
-        i = portPortCache_.find(PortPortPair(&sourcePort, &destinationPort));
-    if (i != portPortCache_.end()) {
-        if (i->second == false || guard == NULL) {
-            return i->second;
-        }
+    const Machine* mach = sourcePort.parentUnit()->machine();
+    if (mach != NULL) {
+        MachineConnectivityMatrix::Handle connectivity =
+            MachineConnectivityMatrix::forMachine(*mach);
+        return guard == NULL ?
+            connectivity->isConnected(sourcePort, destinationPort) :
+            connectivity->isConnected(sourcePort, destinationPort, *guard);
     }
+
     std::set<const TTAMachine::Bus*> sourceBuses;
     MachineConnectivityCheck::appendConnectedDestinationBuses(
         sourcePort, sourceBuses);
@@ -149,8 +151,6 @@ MachineConnectivityCheck::isConnected(
     std::set<const TTAMachine::Bus*> sharedBuses;
     SetTools::intersection(sourceBuses, destinationBuses, sharedBuses);
     if (sharedBuses.size() > 0) {
-        portPortCache_[PortPortPair(&sourcePort,&destinationPort)] = true;
-
         if (guard == NULL) {
             return true;
         }
@@ -164,7 +164,6 @@ MachineConnectivityCheck::isConnected(
              
         return false; // bus found but lacks the guards
     } else {
-        portPortCache_[PortPortPair(&sourcePort,&destinationPort)] = false;
         return false;
     }
 }
@@ -183,6 +182,11 @@ MachineConnectivityCheck::canTransportImmediate(
     const TTAMachine::BaseRegisterFile& destRF,
     const Guard* guard) {
 
+    if (destRF.machine() != NULL) {
+        return MachineConnectivityMatrix::forMachine(*destRF.machine())->
+            canTransportImmediate(immediate, destRF, guard);
+    }
+
     std::set<const TTAMachine::Bus*> buses;
     MachineConnectivityCheck::appendConnectedSourceBuses(destRF, buses);
 
@@ -219,6 +223,12 @@ MachineConnectivityCheck::canTransportImmediate(
     const TTAMachine::Port& destinationPort,
     const Guard* guard) {
 
+    const Machine* mach = destinationPort.parentUnit()->machine();
+    if (mach != NULL) {
+        return MachineConnectivityMatrix::forMachine(*mach)->
+            canTransportImmediate(immediate, destinationPort, guard);
+    }
+
     std::set<const TTAMachine::Bus*> buses;
     MachineConnectivityCheck::appendConnectedSourceBuses(
         destinationPort, buses);
@@ -293,11 +303,11 @@ MachineConnectivityCheck::isConnected(
     const TTAMachine::BaseRegisterFile& sourceRF,
     const TTAMachine::Port& destPort) {
 
-    RfPortBoolMap::const_iterator
-        i = rfPortCache_.find(RfPortPair(&sourceRF, &destPort));
-    if (i != rfPortCache_.end()) {
-        return i->second;
-    }    
+    if (sourceRF.machine() != NULL) {
+        return MachineConnectivityMatrix::forMachine(*sourceRF.machine())->
+            isConnected(sourceRF, destPort);
+    }
+
     std::set<const TTAMachine::Bus*> destBuses = connectedSourceBuses(destPort);
     std::set<const TTAMachine::Bus*> srcBuses;
 
@@ -311,13 +321,7 @@ MachineConnectivityCheck::isConnected(
     std::set<const TTAMachine::Bus*> sharedBuses;
     SetTools::intersection(
         srcBuses, destBuses, sharedBuses);
-    if (sharedBuses.size() > 0) {
-        rfPortCache_[RfPortPair(&sourceRF,&destPort)] = true;
-        return true;
-    } else {
-        rfPortCache_[RfPortPair(&sourceRF,&destPort)] = false;
-        return false;
-    }
+    return sharedBuses.size() > 0;
 }
 
 /**
@@ -335,14 +339,15 @@ MachineConnectivityCheck::isConnected(
     const TTAMachine::BaseRegisterFile& sourceRF,
     const TTAMachine::BaseRegisterFile& destRF,
     const TTAMachine::Guard* guard) {
-    
-    RfRfBoolMap::const_iterator
-        i = rfRfCache_.find(RfRfPair(&sourceRF, &destRF));
-    if (i != rfRfCache_.end()) {
-        if (i->second == false || guard == NULL) {
-            return i->second;
-        }
+
+    if (sourceRF.machine() != NULL) {
+        MachineConnectivityMatrix::Handle connectivity =
+            MachineConnectivityMatrix::forMachine(*sourceRF.machine());
+        return guard == NULL ?
+            connectivity->isConnected(sourceRF, destRF) :
+            connectivity->isConnected(sourceRF, destRF, *guard);
     }
+
     std::set<const TTAMachine::Bus*> srcBuses;
     appendConnectedDestinationBuses(sourceRF, srcBuses);
 
@@ -352,7 +357,6 @@ MachineConnectivityCheck::isConnected(
     std::set<const TTAMachine::Bus*> sharedBuses;
     SetTools::intersection(srcBuses, dstBuses, sharedBuses);
     if (sharedBuses.size() > 0) {
-        rfRfCache_[RfRfPair(&sourceRF,&destRF)] = true;
         if (guard == NULL) {
             return true;
         }
@@ -365,7 +369,6 @@ MachineConnectivityCheck::isConnected(
         }
         return false; // bus found but lacks the guards
     } else {
-        rfRfCache_[RfRfPair(&sourceRF,&destRF)] = false;
         return false;
     }
 }
@@ -384,7 +387,12 @@ bool
 MachineConnectivityCheck::isConnected(
     const TTAMachine::BaseRegisterFile& sourceRF,
     const TTAMachine::FunctionUnit& destFU) {
-    
+
+    if (sourceRF.machine() != NULL) {
+        return MachineConnectivityMatrix::forMachine(*sourceRF.machine())->
+            isConnected(sourceRF, destFU);
+    }
+
     std::set<const TTAMachine::Bus*> srcBuses;
     appendConnectedDestinationBuses(sourceRF, srcBuses);
 
@@ -411,10 +419,10 @@ MachineConnectivityCheck::isConnected(
     const TTAMachine::Port& sourcePort,
     const TTAMachine::RegisterFile& destRF) {
 
-    PortRfBoolMap::const_iterator
-        i = portRfCache_.find(PortRfPair(&sourcePort, &destRF));
-    if (i != portRfCache_.end()) {
-        return i->second;
+    const Machine* mach = sourcePort.parentUnit()->machine();
+    if (mach != NULL) {
+        return MachineConnectivityMatrix::forMachine(*mach)->isConnected(
+            sourcePort, destRF);
     }
 
     std::set<const TTAMachine::Bus*> sourceBuses =
@@ -431,13 +439,7 @@ MachineConnectivityCheck::isConnected(
     std::set<const TTAMachine::Bus*> sharedBuses;
     SetTools::intersection(sourceBuses, destBuses, sharedBuses);
 
-    if (sharedBuses.size() > 0) {
-        portRfCache_[PortRfPair(&sourcePort,&destRF)] = true;
-        return true;
-    } else {
-        portRfCache_[PortRfPair(&sourcePort,&destRF)] = false;
-        return false;
-    }
+    return sharedBuses.size() > 0;
 }
 
 /**
@@ -1868,12 +1870,6 @@ MachineConnectivityCheck::addAnnotatedFUs(
     }
 }
 
-/* These are static */
-MachineConnectivityCheck::PortPortBoolMap MachineConnectivityCheck::portPortCache_;
-MachineConnectivityCheck::RfRfBoolMap MachineConnectivityCheck::rfRfCache_;
-MachineConnectivityCheck::RfPortBoolMap MachineConnectivityCheck::rfPortCache_;
-MachineConnectivityCheck::PortRfBoolMap MachineConnectivityCheck::portRfCache_;
-
 
 bool
 MachineConnectivityCheck::hasConditionalMoves(
@@ -1950,13 +1946,9 @@ MachineConnectivityCheck::isConnectedWithBothGuards(
     const TTAMachine::BaseRegisterFile& sourceRF,
     const TTAMachine::BaseRegisterFile& destRF,
     std::pair<const RegisterFile*,int> guardReg) {
-    
-    RfRfBoolMap::const_iterator
-        i = rfRfCache_.find(RfRfPair(&sourceRF, &destRF));
-    if (i != rfRfCache_.end()) {
-        if (i->second == false) {
-            return false;
-        }
+
+    if (!isConnected(sourceRF, destRF)) {
+        return false;
     }
     std::set<const TTAMachine::Bus*> srcBuses;
     appendConnectedDestinationBuses(sourceRF, srcBuses);
@@ -1970,7 +1962,6 @@ MachineConnectivityCheck::isConnectedWithBothGuards(
     bool trueOK = false;
     bool falseOK = false;
     if (sharedBuses.size() > 0) {
-        rfRfCache_[RfRfPair(&sourceRF,&destRF)] = true;
         for (auto bus: sharedBuses) {
             std::pair<bool, bool> guardsOK = hasBothGuards(bus, guardReg);
             trueOK |= guardsOK.first;
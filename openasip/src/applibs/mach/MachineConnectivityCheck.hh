@@ -298,28 +298,6 @@ static bool raConnected(const TTAMachine::Machine& machine);
 
 protected:
     MachineConnectivityCheck(const std::string& shortDesc_);
-private:
-    typedef std::pair<const TTAMachine::Port*,const TTAMachine::Port*> 
-    PortPortPair;
-
-    typedef std::pair<const TTAMachine::BaseRegisterFile*,
-                      const TTAMachine::BaseRegisterFile*> RfRfPair;
-
-    typedef std::pair<const TTAMachine::BaseRegisterFile*,
-                      const TTAMachine::Port*> RfPortPair;
-
-    typedef std::pair<const TTAMachine::Port*,
-                      const TTAMachine::BaseRegisterFile*> PortRfPair;
-
-    typedef std::map<PortPortPair,bool> PortPortBoolMap;
-    typedef std::map<RfRfPair,bool> RfRfBoolMap;
-    typedef std::map<RfPortPair,bool> RfPortBoolMap;
-    typedef std::map<PortRfPair,bool> PortRfBoolMap;
-
-    static PortPortBoolMap portPortCache_;
-    static RfRfBoolMap rfRfCache_;
-    static RfPortBoolMap rfPortCache_;
-    static PortRfBoolMap portRfCache_;
 };
 
 #endif
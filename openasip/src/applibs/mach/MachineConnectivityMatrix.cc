@@ -0,0 +1,485 @@
+/*
+    Copyright (c) 2002-2026 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file MachineConnectivityMatrix.cc
+ *
+ * Implementation of MachineConnectivityMatrix class.
+ *
+ * @note rating: red
+ */
+
+#include <map>
+#include <mutex>
+
+#include "MachineConnectivityMatrix.hh"
+#include "MachineConnectivityCheck.hh"
+#include "Machine.hh"
+#include "Bus.hh"
+#include "Segment.hh"
+#include "Socket.hh"
+#include "Port.hh"
+#include "Guard.hh"
+#include "FunctionUnit.hh"
+#include "ControlUnit.hh"
+#include "RegisterFile.hh"
+#include "ImmediateUnit.hh"
+#include "TerminalImmediate.hh"
+
+using namespace TTAMachine;
+
+/// Maximum number of machines kept in the shared matrix registry.
+static const unsigned MAX_CACHED_MACHINES = 32;
+
+/**
+ * Builds the connectivity matrix of the given machine.
+ *
+ * @param mach The machine.
+ */
+MachineConnectivityMatrix::MachineConnectivityMatrix(const Machine& mach) :
+    version_(mach.structureVersion()), portCount_(0),
+    unitCount_(0), busWords_(0),
+    reachability_(endpointCount(mach), endpointCount(mach), false) {
+
+    Machine::BusNavigator busNav = mach.busNavigator();
+    for (int i = 0; i < busNav.count(); ++i) {
+        buses_.push_back(busNav.item(i));
+    }
+    busWords_ = (buses_.size() + WORD_BITS - 1) / WORD_BITS;
+
+    std::vector<const Unit*> units;
+    for (const FunctionUnit* fu : mach.functionUnitNavigator()) {
+        units.push_back(fu);
+    }
+    if (mach.controlUnit() != NULL) {
+        units.push_back(mach.controlUnit());
+    }
+    for (const RegisterFile* rf : mach.registerFileNavigator()) {
+        units.push_back(rf);
+    }
+    for (const ImmediateUnit* iu : mach.immediateUnitNavigator()) {
+        units.push_back(iu);
+    }
+
+    // ports get the first endpoint indices, units the rest
+    for (const Unit* unit : units) {
+        for (int p = 0; p < unit->portCount(); ++p) {
+            portIndices_[unit->port(p)] = portCount_++;
+        }
+    }
+    int endpoints = portCount_ + units.size();
+    outputBuses_.resize(endpoints * busWords_, 0);
+    inputBuses_.resize(endpoints * busWords_, 0);
+    for (const Unit* unit : units) {
+        addUnit(*unit);
+    }
+
+    // group the guards of all buses into classes of equal guards
+    for (unsigned b = 0; b < buses_.size(); ++b) {
+        const Bus& bus = *buses_[b];
+        for (int g = 0; g < bus.guardCount(); ++g) {
+            const Guard* guard = bus.guard(g);
+            int index = -1;
+            for (unsigned c = 0; c < guards_.size(); ++c) {
+                if (guards_[c]->isEqual(*guard)) {
+                    index = c;
+                    break;
+                }
+            }
+            if (index == -1) {
+                index = guards_.size();
+                guards_.push_back(guard);
+                guardBuses_.resize(guards_.size() * busWords_, 0);
+            }
+            guardIndices_[guard] = index;
+            guardBuses_[index * busWords_ + b / WORD_BITS] |=
+                Word(1) << (b % WORD_BITS);
+        }
+    }
+
+    for (int src = 0; src < endpoints; ++src) {
+        for (int dst = 0; dst < endpoints; ++dst) {
+            if (intersects(outputBuses_, src, inputBuses_, dst)) {
+                reachability_.setBit(dst, src, true);
+            }
+        }
+    }
+}
+
+/**
+ * Destructor.
+ */
+MachineConnectivityMatrix::~MachineConnectivityMatrix() {
+}
+
+/**
+ * Returns the connectivity matrix of the given machine.
+ *
+ * The matrices are shared between all clients and threads of the process.
+ * A new matrix is built when the machine is queried for the first time or
+ * its structure has changed since the previous build. The matrices are
+ * matched by the structure version of the machine, not only its address,
+ * so a machine created at the address of a deleted one gets a new matrix.
+ *
+ * @param mach The machine.
+ * @return Handle to an up-to-date matrix of the machine.
+ */
+MachineConnectivityMatrix::Handle
+MachineConnectivityMatrix::forMachine(const Machine& mach) {
+    // fast path: the same machine is typically queried repeatedly
+    thread_local const Machine* lastMachine = NULL;
+    thread_local Handle lastMatrix;
+    if (lastMachine == &mach &&
+        lastMatrix->isUpToDate(mach)) {
+        return lastMatrix;
+    }
+
+    static std::mutex registryLock;
+    static std::map<const Machine*, Handle> registry;
+
+    std::lock_guard<std::mutex> lock(registryLock);
+    Handle& matrix = registry[&mach];
+    if (matrix == NULL || !matrix->isUpToDate(mach)) {
+        if (registry.size() > MAX_CACHED_MACHINES) {
+            // the registry is keyed by address, so it would otherwise
+            // accumulate matrices of machines deleted long ago
+            registry.clear();
+            registry[&mach] = Handle(new MachineConnectivityMatrix(mach));
+            lastMatrix = registry[&mach];
+        } else {
+            matrix = Handle(new MachineConnectivityMatrix(mach));
+            lastMatrix = matrix;
+        }
+    } else {
+        lastMatrix = matrix;
+    }
+    lastMachine = &mach;
+    return lastMatrix;
+}
+
+/**
+ * Tells whether the matrix was built from the given machine and the
+ * machine has not been modified since.
+ *
+ * The structure version stamps are unique to each machine and state, so
+ * a matrix is never up to date for another machine.
+ */
+bool
+MachineConnectivityMatrix::isUpToDate(const Machine& mach) const {
+    return mach.structureVersion() == version_;
+}
+
+/**
+ * Returns the dense index of the given port, or -1 if the port does not
+ * belong to the machine.
+ */
+int
+MachineConnectivityMatrix::portIndex(const Port& port) const {
+    auto i = portIndices_.find(&port);
+    return i == portIndices_.end() ? -1 : i->second;
+}
+
+/**
+ * Returns the dense index of the given unit, or -1 if the unit does not
+ * belong to the machine.
+ *
+ * Unit indices are in range [portCount(), portCount() + unitCount()).
+ */
+int
+MachineConnectivityMatrix::unitIndex(const Unit& unit) const {
+    auto i = unitIndices_.find(&unit);
+    return i == unitIndices_.end() ? -1 : i->second;
+}
+
+/**
+ * Returns the index of the class of guards equal to the given guard, or -1
+ * if no bus of the machine has such a guard.
+ */
+int
+MachineConnectivityMatrix::guardIndex(const Guard& guard) const {
+    auto i = guardIndices_.find(&guard);
+    if (i != guardIndices_.end()) {
+        return i->second;
+    }
+    // a guard object that is not part of the machine, compare by value
+    for (unsigned c = 0; c < guards_.size(); ++c) {
+        if (guards_[c]->isEqual(guard)) {
+            return c;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Checks whether there is a bus from the source port to the destination
+ * port.
+ */
+bool
+MachineConnectivityMatrix::isConnected(
+    const Port& source, const Port& destination) const {
+    return reaches(portIndex(source), portIndex(destination));
+}
+
+/**
+ * Checks whether there is a bus with the given guard from the source port
+ * to the destination port.
+ */
+bool
+MachineConnectivityMatrix::isConnected(
+    const Port& source, const Port& destination, const Guard& guard) const {
+    return reaches(
+        portIndex(source), portIndex(destination), guardIndex(guard));
+}
+
+/**
+ * Checks whether any output port of the source unit is connected to the
+ * destination port.
+ */
+bool
+MachineConnectivityMatrix::isConnected(
+    const Unit& source, const Port& destination) const {
+    return reaches(unitIndex(source), portIndex(destination));
+}
+
+/**
+ * Checks whether the source port is connected to any input port of the
+ * destination unit.
+ */
+bool
+MachineConnectivityMatrix::isConnected(
+    const Port& source, const Unit& destination) const {
+    return reaches(portIndex(source), unitIndex(destination));
+}
+
+/**
+ * Checks whether any output port of the source unit is connected to any
+ * input port of the destination unit.
+ */
+bool
+MachineConnectivityMatrix::isConnected(
+    const Unit& source, const Unit& destination) const {
+    return reaches(unitIndex(source), unitIndex(destination));
+}
+
+/**
+ * Checks whether any output port of the source unit is connected to any
+ * input port of the destination unit with a bus that has the given guard.
+ */
+bool
+MachineConnectivityMatrix::isConnected(
+    const Unit& source, const Unit& destination, const Guard& guard) const {
+    return reaches(
+        unitIndex(source), unitIndex(destination), guardIndex(guard));
+}
+
+/**
+ * Checks whether the immediate can be transported as an inline immediate
+ * to the destination port.
+ *
+ * @param guard If not NULL, the bus must also have the given guard.
+ */
+bool
+MachineConnectivityMatrix::canTransportImmediate(
+    const TTAProgram::TerminalImmediate& immediate,
+    const Port& destination, const Guard* guard) const {
+    return canTransportImmediate(
+        immediate, portIndex(destination), destination.parentUnit(), guard);
+}
+
+/**
+ * Checks whether the immediate can be transported as an inline immediate
+ * to any input port of the destination unit.
+ *
+ * @param guard If not NULL, the bus must also have the given guard.
+ */
+bool
+MachineConnectivityMatrix::canTransportImmediate(
+    const TTAProgram::TerminalImmediate& immediate,
+    const Unit& destination, const Guard* guard) const {
+    return canTransportImmediate(
+        immediate, unitIndex(destination), &destination, guard);
+}
+
+/**
+ * Counts the endpoints, ports and units, of the machine.
+ */
+int
+MachineConnectivityMatrix::endpointCount(const Machine& mach) {
+    int count = 0;
+    for (const FunctionUnit* fu : mach.functionUnitNavigator()) {
+        count += 1 + fu->portCount();
+    }
+    if (mach.controlUnit() != NULL) {
+        count += 1 + mach.controlUnit()->portCount();
+    }
+    for (const RegisterFile* rf : mach.registerFileNavigator()) {
+        count += 1 + rf->portCount();
+    }
+    for (const ImmediateUnit* iu : mach.immediateUnitNavigator()) {
+        count += 1 + iu->portCount();
+    }
+    return count;
+}
+
+/**
+ * Assigns the next unit index to the unit and records the buses of the
+ * unit and its ports.
+ *
+ * The ports of the unit must already have their indices.
+ */
+void
+MachineConnectivityMatrix::addUnit(const Unit& unit) {
+    int unitEndpoint = portCount_ + unitCount_++;
+    unitIndices_[&unit] = unitEndpoint;
+    for (int p = 0; p < unit.portCount(); ++p) {
+        int portEndpoint = portIndices_[unit.port(p)];
+        addPortBuses(portEndpoint, *unit.port(p));
+        for (int w = 0; w < busWords_; ++w) {
+            outputBuses_[unitEndpoint * busWords_ + w] |=
+                outputBuses_[portEndpoint * busWords_ + w];
+            inputBuses_[unitEndpoint * busWords_ + w] |=
+                inputBuses_[portEndpoint * busWords_ + w];
+        }
+    }
+}
+
+/**
+ * Records the buses connected to the sockets of the port.
+ */
+void
+MachineConnectivityMatrix::addPortBuses(int endpoint, const Port& port) {
+    const Socket* sockets[] = {port.outputSocket(), port.inputSocket()};
+    std::vector<Word>* masks[] = {&outputBuses_, &inputBuses_};
+    for (int s = 0; s < 2; ++s) {
+        if (sockets[s] == NULL) {
+            continue;
+        }
+        for (int i = 0; i < sockets[s]->segmentCount(); ++i) {
+            const Bus* bus = sockets[s]->segment(i)->parentBus();
+            for (unsigned b = 0; b < buses_.size(); ++b) {
+                if (buses_[b] == bus) {
+                    (*masks[s])[endpoint * busWords_ + b / WORD_BITS] |=
+                        Word(1) << (b % WORD_BITS);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Checks whether the given masks of two endpoints share any bus.
+ */
+bool
+MachineConnectivityMatrix::intersects(
+    const std::vector<Word>& first, int firstIndex,
+    const std::vector<Word>& second, int secondIndex) const {
+    for (int w = 0; w < busWords_; ++w) {
+        if ((first[firstIndex * busWords_ + w] &
+             second[secondIndex * busWords_ + w]) != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Unguarded reachability between two endpoints. Unknown endpoints (-1)
+ * are not connected to anything.
+ */
+bool
+MachineConnectivityMatrix::reaches(int source, int destination) const {
+    if (source < 0 || destination < 0) {
+        return false;
+    }
+    return reachability_.bitAt(destination, source);
+}
+
+/**
+ * Guarded reachability between two endpoints.
+ */
+bool
+MachineConnectivityMatrix::reaches(
+    int source, int destination, int guard) const {
+    if (guard < 0 || !reaches(source, destination)) {
+        return false;
+    }
+    for (int w = 0; w < busWords_; ++w) {
+        if ((outputBuses_[source * busWords_ + w] &
+             inputBuses_[destination * busWords_ + w] &
+             guardBuses_[guard * busWords_ + w]) != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Checks the inline immediate reachability of an endpoint.
+ *
+ * Only the buses writing into the destination (and having the guard) are
+ * visited, and the required width is computed once per extension mode.
+ *
+ * @param destinationUnit The unit of the destination, which gives the
+ *        machine whose address spaces the required width depends on.
+ */
+bool
+MachineConnectivityMatrix::canTransportImmediate(
+    const TTAProgram::TerminalImmediate& immediate,
+    int destination, const Unit* destinationUnit, const Guard* guard) const {
+
+    if (destination < 0) {
+        return false;
+    }
+    int guardClass = -1;
+    if (guard != NULL) {
+        guardClass = guardIndex(*guard);
+        if (guardClass < 0) {
+            return false;
+        }
+    }
+
+    int requiredBits[2] = {-1, -1};
+    for (int w = 0; w < busWords_; ++w) {
+        Word buses = inputBuses_[destination * busWords_ + w];
+        if (guardClass >= 0) {
+            buses &= guardBuses_[guardClass * busWords_ + w];
+        }
+        for (int bit = 0; buses != 0; ++bit, buses >>= 1) {
+            if ((buses & 1) == 0) {
+                continue;
+            }
+            const Bus& bus = *buses_[w * WORD_BITS + bit];
+            int& required = requiredBits[bus.signExtends() ? 1 : 0];
+            if (required == -1) {
+                required = MachineConnectivityCheck::requiredImmediateWidth(
+                    bus.signExtends(), immediate,
+                    *destinationUnit->machine());
+            }
+            if (bus.immediateWidth() >= required) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
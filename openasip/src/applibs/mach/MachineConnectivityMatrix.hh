@@ -0,0 +1,171 @@
+/*
+    Copyright (c) 2002-2026 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file MachineConnectivityMatrix.hh
+ *
+ * Declaration of MachineConnectivityMatrix class.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_MACHINE_CONNECTIVITY_MATRIX_HH
+#define TTA_MACHINE_CONNECTIVITY_MATRIX_HH
+
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+
+#include "BitMatrix.hh"
+
+namespace TTAMachine {
+    class Machine;
+    class Port;
+    class Unit;
+    class Bus;
+    class Guard;
+}
+
+namespace TTAProgram {
+    class TerminalImmediate;
+}
+
+/**
+ * Precomputed, read-only interconnection reachability of a machine.
+ *
+ * Every port and every unit (FU, GCU, RF and IU) of the machine gets a
+ * dense index. For each of them the buses it can write to and the buses
+ * that can write into it are stored as bus bit masks, and the unguarded
+ * reachability between all of them as a bit matrix. Guarded and inline
+ * immediate reachability are answered by intersecting the bus masks with
+ * per-guard bus masks, which is a couple of word operations per query.
+ *
+ * Instances are immutable after construction and can thus be shared
+ * between threads. The instance of a machine is obtained with
+ * forMachine(), which rebuilds it after the structure of the machine has
+ * changed.
+ *
+ * A matrix refers to the buses and guards of its machine, so it must not
+ * be queried after the machine is deleted. The shared matrices are
+ * matched by the structure version stamp, which is never reused, so
+ * forMachine() does not return the matrix of a deleted machine even if
+ * another machine is created at the same address.
+ */
+class MachineConnectivityMatrix {
+public:
+    typedef std::shared_ptr<const MachineConnectivityMatrix> Handle;
+
+    explicit MachineConnectivityMatrix(const TTAMachine::Machine& mach);
+    virtual ~MachineConnectivityMatrix();
+
+    static Handle forMachine(const TTAMachine::Machine& mach);
+
+    bool isUpToDate(const TTAMachine::Machine& mach) const;
+
+    int portIndex(const TTAMachine::Port& port) const;
+    int unitIndex(const TTAMachine::Unit& unit) const;
+    int guardIndex(const TTAMachine::Guard& guard) const;
+
+    int portCount() const { return portCount_; }
+    int unitCount() const { return unitCount_; }
+    int busCount() const { return static_cast<int>(buses_.size()); }
+
+    bool isConnected(
+        const TTAMachine::Port& source,
+        const TTAMachine::Port& destination) const;
+    bool isConnected(
+        const TTAMachine::Port& source,
+        const TTAMachine::Port& destination,
+        const TTAMachine::Guard& guard) const;
+    bool isConnected(
+        const TTAMachine::Unit& source,
+        const TTAMachine::Port& destination) const;
+    bool isConnected(
+        const TTAMachine::Port& source,
+        const TTAMachine::Unit& destination) const;
+    bool isConnected(
+        const TTAMachine::Unit& source,
+        const TTAMachine::Unit& destination) const;
+    bool isConnected(
+        const TTAMachine::Unit& source,
+        const TTAMachine::Unit& destination,
+        const TTAMachine::Guard& guard) const;
+
+    bool canTransportImmediate(
+        const TTAProgram::TerminalImmediate& immediate,
+        const TTAMachine::Port& destination,
+        const TTAMachine::Guard* guard = NULL) const;
+    bool canTransportImmediate(
+        const TTAProgram::TerminalImmediate& immediate,
+        const TTAMachine::Unit& destination,
+        const TTAMachine::Guard* guard = NULL) const;
+
+private:
+    /// Word of the bus bit masks.
+    typedef uint64_t Word;
+    /// Number of bits in a mask word.
+    static const int WORD_BITS = 64;
+
+    static int endpointCount(const TTAMachine::Machine& mach);
+    void addUnit(const TTAMachine::Unit& unit);
+    void addPortBuses(int endpoint, const TTAMachine::Port& port);
+    bool intersects(
+        const std::vector<Word>& first, int firstIndex,
+        const std::vector<Word>& second, int secondIndex) const;
+    bool reaches(int source, int destination) const;
+    bool reaches(int source, int destination, int guard) const;
+    bool canTransportImmediate(
+        const TTAProgram::TerminalImmediate& immediate, int destination,
+        const TTAMachine::Unit* destinationUnit,
+        const TTAMachine::Guard* guard) const;
+
+    /// Structure version of the machine at the time of building.
+    unsigned long version_;
+    /// Number of indexed ports. Ports are the first endpoints.
+    int portCount_;
+    /// Number of indexed units. Units follow the ports in the endpoints.
+    int unitCount_;
+    /// Number of mask words per endpoint or guard.
+    int busWords_;
+    /// Dense endpoint indices of the ports.
+    std::unordered_map<const TTAMachine::Port*, int> portIndices_;
+    /// Dense endpoint indices of the units.
+    std::unordered_map<const TTAMachine::Unit*, int> unitIndices_;
+    /// Dense indices of equal guard classes, for all guards of the machine.
+    std::unordered_map<const TTAMachine::Guard*, int> guardIndices_;
+    /// One representative of each equal guard class.
+    std::vector<const TTAMachine::Guard*> guards_;
+    /// The buses of the machine in bit index order.
+    std::vector<const TTAMachine::Bus*> buses_;
+    /// The buses each endpoint can write to.
+    std::vector<Word> outputBuses_;
+    /// The buses that can write into each endpoint.
+    std::vector<Word> inputBuses_;
+    /// The buses that have each guard class.
+    std::vector<Word> guardBuses_;
+    /// Unguarded reachability. Row is the source and column the destination.
+    BitMatrix reachability_;
+};
+
+#endif
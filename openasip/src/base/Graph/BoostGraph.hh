@@ -64,6 +64,7 @@ namespace boost {
 #include "hash_set.hh"
 #include "hash_map.hh"
 
+#include "ReachabilityMatrix.hh"
 #include "CompilerWarnings.hh"
 IGNORE_CLANG_WARNING("-Wunused-local-typedef")
 IGNORE_COMPILER_WARNING("-Wmaybe-uninitialized")
@@ -74,6 +75,7 @@ POP_CLANG_DIAGS
 
 #include "Exception.hh"
 #include "Graph.hh"
+#include "CompactGraph.hh"
 
 /**
  * Graph-based program representation.
@@ -82,6 +84,7 @@ POP_CLANG_DIAGS
  */
 template <typename GraphNode, typename GraphEdge>
 class BoostGraph : public GraphBase<GraphNode, GraphEdge> {
+    friend class CompactGraph<GraphNode, GraphEdge>;
 public:
 
     typedef std::set<GraphNode*, typename GraphNode::Comparator > NodeSet;
@@ -298,6 +301,8 @@ protected:
 
     void calculatePathLengthsFast() const;
 
+    bool calculatePathLengthsCompact(bool sinks) const;
+
     void calculateSinkDistance(
         const GraphNode& node, int len, bool looping = false) const;
     
@@ -360,6 +365,9 @@ protected:
     virtual void moveOutEdges(
         const Node& source, const Node& destination, BoostGraph* modifierGraph);
     void constructSubGraph(BoostGraph& subGraph, NodeSet& nodes);
+    void updatePathCacheOnConnect(
+        const GraphNode& nTail, const GraphNode& nHead, const GraphEdge& e);
+    void invalidatePathCache();
 
     /**
      * This class is used in the pririty queue, to select which node to
@@ -384,8 +392,9 @@ protected:
     std::set<Edge*> ownedEdges_;
     bool allowLoopEdges_;
     
-    // cache to speed up hasPath(), call findAllPaths() to initialize
-    typedef std::vector<std::vector<int> > PathCache;
+    // cache to speed up hasPath(), call findAllPaths() to initialize.
+    // Indexed by node descriptors, kept up to date when edges are added.
+    typedef ReachabilityMatrix PathCache;
     mutable PathCache* pathCache_;
 };
 
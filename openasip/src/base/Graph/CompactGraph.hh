@@ -0,0 +1,103 @@
+/*
+    Copyright (c) 2002-2026 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file CompactGraph.hh
+ *
+ * Declaration of CompactGraph class.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_COMPACT_GRAPH_HH
+#define TTA_COMPACT_GRAPH_HH
+
+#include <vector>
+
+template <typename GraphNode, typename GraphEdge> class BoostGraph;
+
+/**
+ * Read-only snapshot of a BoostGraph in compressed sparse row form.
+ *
+ * Nodes are identified by their dense index in the source graph. The out
+ * and in edges of all nodes are stored in flat arrays indexed through
+ * per-node offsets, and the weight of each edge is computed once when the
+ * snapshot is taken. This makes the whole-graph traversals of the
+ * read-mostly phases, such as the critical path computations, walk
+ * contiguous memory instead of the linked edge lists and the descriptor
+ * hash maps of the BoostGraph.
+ *
+ * The snapshot is not updated when the source graph changes; the
+ * BoostGraph stays the storage of the mutable phases and a new snapshot
+ * is taken when needed.
+ */
+template <typename GraphNode, typename GraphEdge>
+class CompactGraph {
+public:
+    explicit CompactGraph(const BoostGraph<GraphNode, GraphEdge>& graph);
+    virtual ~CompactGraph();
+
+    int nodeCount() const { return static_cast<int>(nodes_.size()); }
+    int edgeCount() const { return static_cast<int>(outHeads_.size()); }
+    GraphNode& node(int index) const { return *nodes_[index]; }
+
+    int outDegree(int node) const;
+    int inDegree(int node) const;
+    int outHead(int node, int index) const;
+    int inTail(int node, int index) const;
+    GraphEdge& outEdge(int node, int index) const;
+    GraphEdge& inEdge(int node, int index) const;
+    int outWeight(int node, int index) const;
+
+    bool hasBackEdges() const { return backEdgeCount_ > 0; }
+
+    bool topologicalOrder(std::vector<int>& order) const;
+    void sourceDistances(
+        const std::vector<int>& order, std::vector<int>& distances) const;
+    void sinkDistances(
+        const std::vector<int>& order, std::vector<int>& distances) const;
+
+private:
+    /// The nodes by their index.
+    std::vector<GraphNode*> nodes_;
+    /// Start of the out edges of each node, plus the end sentinel.
+    std::vector<int> outOffsets_;
+    /// Head node index of each out edge.
+    std::vector<int> outHeads_;
+    /// Each out edge.
+    std::vector<GraphEdge*> outEdges_;
+    /// Weight of each out edge, as given by the source graph.
+    std::vector<int> outWeights_;
+    /// Start of the in edges of each node, plus the end sentinel.
+    std::vector<int> inOffsets_;
+    /// Tail node index of each in edge.
+    std::vector<int> inTails_;
+    /// Position of each in edge in the out edge arrays.
+    std::vector<int> inEdges_;
+    /// Number of back edges in the graph.
+    int backEdgeCount_;
+};
+
+#include "CompactGraph.icc"
+
+#endif
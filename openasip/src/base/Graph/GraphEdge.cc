@@ -94,4 +94,4 @@ GraphEdge::edgeID() const {
 }
 
 
-int GraphEdge::edgeCounter_ = 0;
+std::atomic<int> GraphEdge::edgeCounter_(0);
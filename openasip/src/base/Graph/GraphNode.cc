@@ -78,4 +78,4 @@ GraphNode::dotString() const {
 }
 
 
-int GraphNode::idCounter_ = 0;
+std::atomic<int> GraphNode::idCounter_(0);
@@ -35,6 +35,7 @@
 #define TTA_GRAPH_NODE_HH
 
 #include <string>
+#include <atomic>
 
 /**
  * Node of the graph-based program representation.
@@ -61,7 +62,8 @@ public:
     };
 private:
     int nodeID_;
-    static int idCounter_;
+    /// Shared by all threads so that the ids stay unique.
+    static std::atomic<int> idCounter_;
 };
 
 #include "GraphNode.icc"
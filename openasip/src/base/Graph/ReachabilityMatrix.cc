@@ -0,0 +1,129 @@
+/*
+    Copyright (c) 2002-2026 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file ReachabilityMatrix.cc
+ *
+ * Implementation of ReachabilityMatrix class.
+ *
+ * @note rating: red
+ */
+
+#include "ReachabilityMatrix.hh"
+
+/**
+ * Constructor.
+ *
+ * @param nodeCount Number of nodes, none of which reaches any other.
+ */
+ReachabilityMatrix::ReachabilityMatrix(int nodeCount) :
+    nodeCount_(nodeCount), words_(0) {
+    reserve(nodeCount);
+}
+
+/**
+ * Destructor.
+ */
+ReachabilityMatrix::~ReachabilityMatrix() {
+}
+
+/**
+ * Adds a node that does not reach any other node.
+ *
+ * The rows are reallocated with room for twice the nodes when the
+ * reserved words run out, so adding nodes one by one stays cheap.
+ */
+void
+ReachabilityMatrix::addNode() {
+    if (nodeCount_ + 1 > words_ * WORD_BITS) {
+        reserve(2 * (nodeCount_ + 1));
+    }
+    ++nodeCount_;
+    bits_.resize(static_cast<std::size_t>(nodeCount_) * words_, 0);
+}
+
+/**
+ * Marks the given successor and all the nodes it reaches reachable from
+ * the given node.
+ *
+ * @param node The node whose row is updated.
+ * @param successor A direct successor of the node.
+ * @return True in case the row of the node changed.
+ */
+bool
+ReachabilityMatrix::addSuccessor(int node, int successor) {
+    Word* row = &bits_[static_cast<std::size_t>(node) * words_];
+    const Word* successorRow = 
+        &bits_[static_cast<std::size_t>(successor) * words_];
+    Word changed = 0;
+    for (int i = 0; i < words_; ++i) {
+        Word merged = row[i] | successorRow[i];
+        if (i == successor / WORD_BITS) {
+            merged |= Word(1) << (successor % WORD_BITS);
+        }
+        changed |= merged ^ row[i];
+        row[i] = merged;
+    }
+    return changed != 0;
+}
+
+/**
+ * Updates the closure after an edge from tail to head has been added.
+ *
+ * Every node that reaches the tail, and the tail itself, now reaches the
+ * head and everything reachable from it.
+ *
+ * @param tail Tail node of the new edge.
+ * @param head Head node of the new edge.
+ */
+void
+ReachabilityMatrix::connect(int tail, int head) {
+    if (reaches(tail, head)) {
+        return;
+    }
+    for (int node = 0; node < nodeCount_; ++node) {
+        if (node == tail || reaches(node, tail)) {
+            addSuccessor(node, head);
+        }
+    }
+}
+
+/**
+ * Reallocates the rows with room for the given number of nodes.
+ */
+void
+ReachabilityMatrix::reserve(int nodeCount) {
+    const int words = (nodeCount + WORD_BITS - 1) / WORD_BITS;
+    if (words <= words_) {
+        return;
+    }
+    std::vector<Word> bits(static_cast<std::size_t>(nodeCount_) * words, 0);
+    for (int node = 0; node < nodeCount_; ++node) {
+        for (int i = 0; i < words_; ++i) {
+            bits[static_cast<std::size_t>(node) * words + i] =
+                bits_[static_cast<std::size_t>(node) * words_ + i];
+        }
+    }
+    bits_.swap(bits);
+    words_ = words;
+}
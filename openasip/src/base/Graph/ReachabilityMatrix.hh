@@ -0,0 +1,82 @@
+/*
+    Copyright (c) 2002-2026 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file ReachabilityMatrix.hh
+ *
+ * Declaration of ReachabilityMatrix class.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_REACHABILITY_MATRIX_HH
+#define TTA_REACHABILITY_MATRIX_HH
+
+#include <vector>
+#include <cstdint>
+
+/**
+ * Transitive closure of a graph stored as one bit per node pair.
+ *
+ * Nodes are identified by dense indices. The row of each node has a bit
+ * set for every node reachable from it, which takes N*N/8 bytes in total.
+ * The matrix is built by merging the rows of the successors in reverse
+ * topological order and kept up to date on edge insertions with connect().
+ * Edge removals can break paths and need a rebuild.
+ */
+class ReachabilityMatrix {
+public:
+    explicit ReachabilityMatrix(int nodeCount);
+    virtual ~ReachabilityMatrix();
+
+    int nodeCount() const { return nodeCount_; }
+    void addNode();
+
+    /**
+     * Returns true in case there is a path from source to destination.
+     */
+    bool reaches(int source, int destination) const {
+        return (bits_[source * words_ + destination / WORD_BITS] >>
+                (destination % WORD_BITS)) & 1;
+    }
+
+    bool addSuccessor(int node, int successor);
+    void connect(int tail, int head);
+
+private:
+    /// Word of the rows.
+    typedef uint64_t Word;
+    /// Number of bits in a row word.
+    static const int WORD_BITS = 64;
+
+    void reserve(int nodeCount);
+
+    /// Number of nodes in the matrix.
+    int nodeCount_;
+    /// Number of words in each row, sized for the reserved node count.
+    int words_;
+    /// The rows of all nodes.
+    std::vector<Word> bits_;
+};
+
+#endif
@@ -244,6 +244,9 @@ Bus::setImmediateWidth(int width) {
         throw OutOfRange(__FILE__, __LINE__, procName);
     }
     immWidth_ = width;
+    if (machine() != NULL) {
+        machine()->structureChanged();
+    }
 }
 
 /**
@@ -252,6 +255,9 @@ Bus::setImmediateWidth(int width) {
 void
 Bus::setZeroExtends() {
     extensionMode_ = Machine::ZERO;
+    if (machine() != NULL) {
+        machine()->structureChanged();
+    }
 }
 
 
@@ -261,6 +267,9 @@ Bus::setZeroExtends() {
 void
 Bus::setSignExtends() {
     extensionMode_ = Machine::SIGN;
+    if (machine() != NULL) {
+        machine()->structureChanged();
+    }
 }
 
 
@@ -270,6 +279,9 @@ Bus::setSignExtends() {
 void
 Bus::setExtensionMode(const Machine::Extension extension) {
     extensionMode_ = extension;
+    if (machine() != NULL) {
+        machine()->structureChanged();
+    }
 }
 
 
@@ -415,6 +427,9 @@ Bus::addGuard(Guard& guard) {
     }
 
     guards_.push_back(&guard);
+    if (machine() != NULL) {
+        machine()->structureChanged();
+    }
 }
 
 /**
@@ -429,6 +444,9 @@ Bus::removeGuard(Guard& guard) {
     // run time check: can be called from Guard destructor only
     assert(guard.parentBus() == NULL);
     ContainerTools::removeValueIfExists(guards_, &guard);
+    if (machine() != NULL) {
+        machine()->structureChanged();
+    }
 }
 
 
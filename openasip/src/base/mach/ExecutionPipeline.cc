@@ -236,6 +236,35 @@ ExecutionPipeline::removeResourceUse(const std::string& name, int cycle) {
     internalRemoveResourceUse(name, cycle, 1);
 }
 
+/**
+ * Replaces the usages of this pipeline with the usages of the given one.
+ *
+ * The pipeline elements are looked up, or created, by name in the parent
+ * unit of this pipeline, so the source pipeline may belong to a unit of
+ * another machine. The source pipeline is valid already, thus the usages
+ * are copied as such without the checks of the add methods.
+ *
+ * @param source The pipeline to copy the usages from.
+ */
+void
+ExecutionPipeline::copyFrom(const ExecutionPipeline& source) {
+
+    removeAllResourceUses();
+
+    opReads_ = source.opReads_;
+    opWrites_ = source.opWrites_;
+    resourceUsage_.resize(source.resourceUsage_.size());
+
+    for (size_t cycle = 0; cycle < source.resourceUsage_.size(); cycle++) {
+        const ResourceSet& usages = source.resourceUsage_[cycle];
+        for (ResourceSet::const_iterator iter = usages.begin();
+             iter != usages.end(); iter++) {
+            resourceUsage_[cycle].insert(
+                addPipelineElement((*iter)->name()));
+        }
+    }
+}
+
 /**
  * Removes the all the usages of resources.
  */
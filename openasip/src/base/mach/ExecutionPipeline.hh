@@ -70,6 +70,7 @@ public:
     void removeResourceUse(const std::string& name);
     void removeResourceUse(const std::string& name, int cycle);
     void removeAllResourceUses();
+    void copyFrom(const ExecutionPipeline& source);
     void removeOperandUse(int operand, int cycle);
     bool isResourceUsed(const std::string& name, int cycle) const;
 
@@ -97,6 +97,9 @@ private:
      * immediate and its earliest transport on a data bus.
      */
     int latency_;
+
+    // Machine sets the latency of the copies it creates
+    friend class Machine;
 };
 }
 
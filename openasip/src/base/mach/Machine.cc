@@ -33,6 +33,10 @@
 
 #include <string>
 #include <set>
+#include <atomic>
+#include <map>
+#include <vector>
+#include <algorithm>
 #include <boost/functional/hash.hpp>
 
 #include "Machine.hh"
@@ -56,6 +60,15 @@
 #include "ADFSerializer.hh"
 #include "ObjectState.hh"
 #include "OperationTriggeredFormat.hh"
+#include "OperationTriggeredOperand.hh"
+#include "TemplateSlot.hh"
+#include "HWOperation.hh"
+#include "ExecutionPipeline.hh"
+#include "SpecialRegisterPort.hh"
+#include "RFPort.hh"
+#include "PipelineElement.hh"
+#include "StringTools.hh"
+#include "Conversion.hh"
 
 using std::string;
 using std::set;
@@ -70,6 +83,10 @@ const string Machine::OSKEY_TRIGGER_INVALIDATES_OLD_RESULTS
 	= "trigger-invalidates";
 const string Machine::OSKEY_FUNCTION_UNITS_ORDERED = "fu-ordered";
 
+/// Source of the structure version stamps. Shared by all machines so that
+/// a stamp never repeats even if a machine is recreated at the same address.
+static std::atomic<unsigned long> nextStructureVersion_(1);
+
 /**
  * Constructor.
  */
@@ -79,8 +96,9 @@ Machine::Machine() :
     dummyMachineTester_(new DummyMachineTester(*this)),
     EMPTY_ITEMP_NAME_("no_limm"), alwaysWriteResults_(false), 
     triggerInvalidatesResults_(false), fuOrdered_(false),
-    littleEndian_(true), bitness64_(false) {
+    littleEndian_(true), bitness64_(false), structureVersion_(0) {
 
+    structureChanged();
     new InstructionTemplate(EMPTY_ITEMP_NAME_, *this);
 }
     
@@ -88,7 +106,7 @@ Machine::Machine() :
 /**
  * Copy constructor.
  *
- * Creates a copy of the given machine.
+ * Creates a deep copy of the given machine.
  *
  * @param old The machine to be copied.
  */
@@ -96,12 +114,13 @@ Machine::Machine(const Machine& old) :
     Serializable(), controlUnit_(NULL), doValidityChecks_(false),
     machineTester_(new MachineTester(*this)), 
     dummyMachineTester_(new DummyMachineTester(*this)),
+    EMPTY_ITEMP_NAME_("no_limm"), alwaysWriteResults_(false),
+    triggerInvalidatesResults_(false), fuOrdered_(false),
     littleEndian_(old.littleEndian_),
-    bitness64_(old.bitness64_) {
-    
-    ObjectState* state = old.saveState();
-    loadState(state);
-    delete state;
+    bitness64_(old.bitness64_), structureVersion_(0) {
+
+    structureChanged();
+    copyComponents(old);
     doValidityChecks_ = true;
 }
     
@@ -331,6 +350,7 @@ Machine::setGlobalControl(ControlUnit& unit) {
         unit.setMachine(*this);
     } else {
         controlUnit_ = &unit;
+        structureChanged();
     }
 }
 
@@ -568,6 +588,7 @@ Machine::unsetGlobalControl() {
     } else {
         if (controlUnit_->machine() == NULL) {
             controlUnit_ = NULL;
+            structureChanged();
         } else {
             controlUnit_->unsetMachine();
         }
@@ -660,6 +681,7 @@ Machine::setBusPosition(const Bus& bus, int newPosition) {
     }
 
     busses_.moveToPosition(&bus, newPosition);
+    structureChanged();
 }
 
 /**
@@ -732,22 +754,7 @@ Machine::loadState(const ObjectState* state) {
         throw ObjectStateLoadingException(__FILE__, __LINE__, procName);
     }
 
-    // delete all the old components
-    busses_.deleteAll();
-    sockets_.deleteAll();
-    instructionTemplates_.deleteAll();
-    registerFiles_.deleteAll();
-    immediateUnits_.deleteAll();
-    functionUnits_.deleteAll();
-    addressSpaces_.deleteAll();
-    bridges_.deleteAll();
-    immediateSlots_.deleteAll();
-    operationTriggeredFormats_.deleteAll();
-
-    if (controlUnit_ != NULL) {
-        delete controlUnit_;
-        controlUnit_ = NULL;
-    }
+    deleteAllComponents();
 
     Component* toAdd = NULL;
 
@@ -882,9 +889,309 @@ Machine::loadState(const ObjectState* state) {
  */
 void
 Machine::copyFromMachine(Machine& machine) {
-    ObjectState* state = machine.saveState();
-    loadState(state);
-    delete state;
+    if (&machine != this) {
+        copyComponents(machine);
+    }
+}
+
+/**
+ * Deletes all the components of the machine.
+ */
+void
+Machine::deleteAllComponents() {
+    busses_.deleteAll();
+    sockets_.deleteAll();
+    instructionTemplates_.deleteAll();
+    registerFiles_.deleteAll();
+    immediateUnits_.deleteAll();
+    functionUnits_.deleteAll();
+    addressSpaces_.deleteAll();
+    bridges_.deleteAll();
+    immediateSlots_.deleteAll();
+    operationTriggeredFormats_.deleteAll();
+
+    if (controlUnit_ != NULL) {
+        delete controlUnit_;
+        controlUnit_ = NULL;
+    }
+}
+
+/**
+ * Replaces the components of this machine with copies of the components
+ * of the given machine.
+ *
+ * The components are created directly from the originals and the
+ * references between them are resolved through maps from the original
+ * components to their copies, instead of going through an ObjectState tree
+ * and resolving the references by name. The components are created and
+ * connected in the same order as in loadState(), so the copy saves to an
+ * identical ObjectState tree.
+ *
+ * @param source The machine to copy.
+ */
+void
+Machine::copyComponents(const Machine& source) {
+
+    deleteAllComponents();
+
+    setAlwaysWriteResults(source.alwaysWriteResults_);
+    setTriggerInvalidatesResults(source.triggerInvalidatesResults_);
+    setFUOrdered(source.fuOrdered_);
+    setLittleEndian(source.littleEndian_);
+    set64bits(source.bitness64_);
+
+    std::map<const AddressSpace*, AddressSpace*> addressSpaces;
+    std::map<const Bus*, Bus*> buses;
+    std::map<const Segment*, Segment*> segments;
+    std::map<const Socket*, Socket*> sockets;
+    std::map<const RegisterFile*, RegisterFile*> registerFiles;
+    std::map<const ImmediateUnit*, ImmediateUnit*> immediateUnits;
+    PortMap ports;
+
+    for (int i = 0; i < source.addressSpaces_.count(); i++) {
+        const AddressSpace* as = source.addressSpaces_.item(i);
+        AddressSpace* copy = new AddressSpace(
+            as->name(), as->width(), as->start(), as->end(), *this);
+        copy->setNumericalIds(as->numericalIds());
+        copy->setShared(as->isShared());
+        addressSpaces[as] = copy;
+    }
+
+    // buses and their segments in chain order
+    for (int i = 0; i < source.busses_.count(); i++) {
+        const Bus* bus = source.busses_.item(i);
+        Bus* copy = new Bus(
+            bus->name(), bus->width(), bus->immediateWidth(),
+            bus->signExtends() ? SIGN : ZERO);
+        addBus(*copy);
+        buses[bus] = copy;
+        for (int s = 0; s < bus->segmentCount(); s++) {
+            const Segment* segment = bus->segment(s);
+            segments[segment] = new Segment(segment->name(), *copy);
+        }
+    }
+
+    for (int i = 0; i < source.sockets_.count(); i++) {
+        const Socket* socket = source.sockets_.item(i);
+        Socket* copy = new Socket(socket->name());
+        if (socket->hasDataPortWidth()) {
+            copy->setDataPortWidth(socket->dataPortWidth());
+        }
+        addSocket(*copy);
+        sockets[socket] = copy;
+    }
+
+    for (int i = 0; i < source.functionUnits_.count(); i++) {
+        const FunctionUnit* fu = source.functionUnits_.item(i);
+        FunctionUnit* copy = new FunctionUnit(fu->name());
+        addFunctionUnit(*copy);
+        copyFunctionUnitContents(*fu, *copy, ports);
+        if (fu->hasAddressSpace()) {
+            copy->setAddressSpace(addressSpaces[fu->addressSpace()]);
+        }
+    }
+
+    for (int i = 0; i < source.registerFiles_.count(); i++) {
+        const RegisterFile* rf = source.registerFiles_.item(i);
+        RegisterFile* copy = new RegisterFile(
+            rf->name(), rf->size(), rf->width(), rf->maxReads(),
+            rf->maxWrites(), rf->guardLatency(), rf->type(),
+            rf->zeroRegister());
+        addRegisterFile(*copy);
+        registerFiles[rf] = copy;
+        for (int p = 0; p < rf->portCount(); p++) {
+            const Port* port = rf->port(p);
+            ports[port] = new RFPort(port->name(), *copy);
+        }
+    }
+
+    for (int i = 0; i < source.immediateUnits_.count(); i++) {
+        const ImmediateUnit* iu = source.immediateUnits_.item(i);
+        ImmediateUnit* copy = new ImmediateUnit(
+            iu->name(), iu->size(), iu->width(), iu->maxReads(),
+            iu->guardLatency(), iu->extensionMode());
+        copy->setLatency(iu->latency());
+        copy->setType(iu->type());
+        copy->setZeroRegister(iu->zeroRegister());
+        addImmediateUnit(*copy);
+        registerFiles[iu] = copy;
+        immediateUnits[iu] = copy;
+        for (int p = 0; p < iu->portCount(); p++) {
+            const Port* port = iu->port(p);
+            ports[port] = new RFPort(port->name(), *copy);
+        }
+    }
+
+    if (source.controlUnit_ != NULL) {
+        const ControlUnit* gcu = source.controlUnit_;
+        ControlUnit* copy = new ControlUnit(
+            gcu->name(), gcu->delaySlots(), gcu->globalGuardLatency());
+        setGlobalControl(*copy);
+        copyFunctionUnitContents(*gcu, *copy, ports);
+        if (gcu->hasAddressSpace()) {
+            copy->setAddressSpace(addressSpaces[gcu->addressSpace()]);
+        }
+        if (gcu->hasReturnAddressPort()) {
+            copy->setReturnAddressPort(
+                *copy->specialRegisterPort(
+                    gcu->returnAddressPort()->name()));
+        }
+    }
+
+    for (int i = 0; i < source.bridges_.count(); i++) {
+        const Bridge* bridge = source.bridges_.item(i);
+        new Bridge(
+            bridge->name(), *buses[bridge->sourceBus()],
+            *buses[bridge->destinationBus()]);
+    }
+
+    for (int i = 0; i < source.immediateSlots_.count(); i++) {
+        new ImmediateSlot(source.immediateSlots_.item(i)->name(), *this);
+    }
+
+    // socket connections, then port connections in the unit order of
+    // loadState() so that the sockets list their ports in the same order
+    for (int i = 0; i < source.sockets_.count(); i++) {
+        const Socket* socket = source.sockets_.item(i);
+        Socket* copy = sockets[socket];
+        for (int s = 0; s < socket->segmentCount(); s++) {
+            copy->attachBus(*segments[socket->segment(s)]);
+        }
+        if (socket->direction() != Socket::UNKNOWN) {
+            copy->setDirection(socket->direction());
+        }
+    }
+
+    std::vector<const Unit*> units;
+    for (int i = 0; i < source.functionUnits_.count(); i++) {
+        units.push_back(source.functionUnits_.item(i));
+    }
+    for (int i = 0; i < source.registerFiles_.count(); i++) {
+        units.push_back(source.registerFiles_.item(i));
+    }
+    for (int i = 0; i < source.immediateUnits_.count(); i++) {
+        units.push_back(source.immediateUnits_.item(i));
+    }
+    if (source.controlUnit_ != NULL) {
+        units.push_back(source.controlUnit_);
+    }
+    for (size_t i = 0; i < units.size(); i++) {
+        for (int p = 0; p < units[i]->portCount(); p++) {
+            const Port* port = units[i]->port(p);
+            if (port->socket1_ != NULL) {
+                ports[port]->attachSocket(*sockets[port->socket1_]);
+            }
+            if (port->socket2_ != NULL) {
+                ports[port]->attachSocket(*sockets[port->socket2_]);
+            }
+        }
+    }
+
+    for (int i = 0; i < source.busses_.count(); i++) {
+        const Bus* bus = source.busses_.item(i);
+        Bus* copy = buses[bus];
+        for (int g = 0; g < bus->guardCount(); g++) {
+            const Guard* guard = bus->guard(g);
+            const PortGuard* portGuard =
+                dynamic_cast<const PortGuard*>(guard);
+            const RegisterGuard* regGuard =
+                dynamic_cast<const RegisterGuard*>(guard);
+            if (portGuard != NULL) {
+                new PortGuard(
+                    guard->isInverted(),
+                    *dynamic_cast<FUPort*>(ports[portGuard->port()]),
+                    *copy);
+            } else if (regGuard != NULL) {
+                new RegisterGuard(
+                    guard->isInverted(),
+                    *registerFiles[regGuard->registerFile()],
+                    regGuard->registerIndex(), copy);
+            } else {
+                new UnconditionalGuard(guard->isInverted(), *copy);
+            }
+        }
+    }
+
+    for (int i = 0; i < source.instructionTemplates_.count(); i++) {
+        const InstructionTemplate* iTemp =
+            source.instructionTemplates_.item(i);
+        InstructionTemplate* copy =
+            new InstructionTemplate(iTemp->name(), *this);
+        for (int s = 0; s < iTemp->slotCount(); s++) {
+            const TemplateSlot* slot = iTemp->slot(s);
+            copy->addSlot(
+                slot->slot(), slot->width(),
+                *immediateUnits[slot->destination()]);
+        }
+    }
+
+    for (int i = 0; i < source.operationTriggeredFormats_.count(); i++) {
+        const OperationTriggeredFormat* format =
+            source.operationTriggeredFormats_.item(i);
+        OperationTriggeredFormat* copy =
+            new OperationTriggeredFormat(format->name(), *this);
+        for (int o = 0; o < format->operationCount(); o++) {
+            copy->addOperation(format->operationAtIndex(o));
+        }
+        std::vector<OperationTriggeredOperand*> operands =
+            format->operands();
+        for (size_t o = 0; o < operands.size(); o++) {
+            OperationTriggeredOperand* operand =
+                new OperationTriggeredOperand(operands[o]->name(), *copy);
+            operand->setType(operands[o]->type());
+            operand->setDirection(operands[o]->direction());
+        }
+    }
+
+    if (instructionTemplates_.count() == 0) {
+        new InstructionTemplate(EMPTY_ITEMP_NAME_, *this);
+    }
+}
+
+/**
+ * Copies the ports, operations and pipelines of a function unit to another
+ * function unit.
+ *
+ * @param source The function unit to copy.
+ * @param target The empty copy of the function unit.
+ * @param ports The map from the original ports to their copies, the copied
+ *              ports are added to it.
+ */
+void
+Machine::copyFunctionUnitContents(
+    const FunctionUnit& source, FunctionUnit& target, PortMap& ports) {
+
+    target.setOrderNumber(source.orderNumber());
+
+    for (int i = 0; i < source.portCount(); i++) {
+        const BaseFUPort* port = source.port(i);
+        const FUPort* fuPort = dynamic_cast<const FUPort*>(port);
+        if (fuPort != NULL) {
+            ports[port] = new FUPort(
+                fuPort->name(), fuPort->width(), target,
+                fuPort->isTriggering(), fuPort->isOpcodeSetting(),
+                fuPort->noRegister());
+        } else {
+            ControlUnit* gcu = dynamic_cast<ControlUnit*>(&target);
+            assert(gcu != NULL);
+            ports[port] = new SpecialRegisterPort(
+                port->name(), port->width(), *gcu);
+        }
+    }
+
+    for (int i = 0; i < source.operationCount(); i++) {
+        const HWOperation* operation = source.operation(i);
+        HWOperation* copy = new HWOperation(operation->name(), target);
+        for (int p = 0; p < source.operationPortCount(); p++) {
+            const FUPort* port = source.operationPort(p);
+            if (operation->isBound(*port)) {
+                copy->bindPort(
+                    operation->io(*port),
+                    *dynamic_cast<FUPort*>(ports[port]));
+            }
+        }
+        copy->pipeline()->copyFrom(*operation->pipeline());
+    }
 }
 
 
@@ -940,6 +1247,407 @@ Machine::hash() const {
     return hash;
 }
 
+namespace {
+
+/// Number of label refinement rounds over the interconnection graph.
+const int FINGERPRINT_ROUNDS = 3;
+
+/**
+ * Combines a value to a fingerprint hash.
+ */
+template <typename ValueType>
+void
+combine(std::size_t& seed, const ValueType& value) {
+    boost::hash_combine(seed, value);
+}
+
+/**
+ * Combines the values of a container to a hash in sorted order, so that
+ * the result does not depend on the order of the values.
+ */
+void
+combineSorted(std::size_t& seed, std::vector<std::size_t> values) {
+    std::sort(values.begin(), values.end());
+    combine(seed, values.size());
+    for (std::size_t value : values) {
+        combine(seed, value);
+    }
+}
+
+/**
+ * Returns a name independent label of an address space.
+ */
+std::size_t
+addressSpaceLabel(const AddressSpace* as) {
+    std::size_t label = 0;
+    if (as == NULL) {
+        return label;
+    }
+    combine(label, std::string("as"));
+    combine(label, as->width());
+    combine(label, as->start());
+    combine(label, as->end());
+    std::set<unsigned> ids = as->numericalIds();
+    for (unsigned id : ids) {
+        combine(label, id);
+    }
+    return label;
+}
+
+/**
+ * Returns a name independent label of a function unit.
+ *
+ * The operations, their pipelines and operand bindings are described
+ * without the port and pipeline resource names: ports are described with
+ * the operands bound to them and resources with the operation cycles that
+ * use them.
+ *
+ * @param fu The function unit.
+ * @param portLabels Labels of the ports of the unit are added to this.
+ */
+std::size_t
+functionUnitLabel(
+    const FunctionUnit& fu, std::map<const Port*, std::size_t>& portLabels) {
+
+    std::vector<std::size_t> operations;
+    std::map<std::string, std::vector<std::size_t> > resourceUses;
+    std::map<const Port*, std::vector<std::size_t> > bindings;
+    for (int i = 0; i < fu.operationCount(); i++) {
+        const HWOperation* op = fu.operation(i);
+        const ExecutionPipeline* pipeline = op->pipeline();
+        std::size_t opName =
+            boost::hash<std::string>()(StringTools::stringToLower(op->name()));
+
+        std::size_t opLabel = opName;
+        for (int cycle = 0; cycle < pipeline->latency(); cycle++) {
+            ExecutionPipeline::OperandSet reads =
+                pipeline->readOperands(cycle);
+            ExecutionPipeline::OperandSet writes =
+                pipeline->writtenOperands(cycle);
+            combine(opLabel, cycle);
+            combine(opLabel, reads.size());
+            for (int operand : reads) {
+                combine(opLabel, operand);
+            }
+            combine(opLabel, writes.size());
+            for (int operand : writes) {
+                combine(opLabel, operand);
+            }
+
+            ExecutionPipeline::ResourceSet resources =
+                pipeline->resourceUsages(cycle);
+            for (ExecutionPipeline::ResourceSet::const_iterator r =
+                     resources.begin(); r != resources.end(); r++) {
+                std::size_t use = opName;
+                combine(use, cycle);
+                resourceUses[(*r)->name()].push_back(use);
+            }
+        }
+        operations.push_back(opLabel);
+
+        for (int operand = 1; operand <= op->operandCount(); operand++) {
+            if (!op->isBound(operand)) {
+                continue;
+            }
+            std::size_t binding = opName;
+            combine(binding, operand);
+            bindings[op->port(operand)].push_back(binding);
+        }
+    }
+
+    std::vector<std::size_t> resources;
+    for (auto& uses : resourceUses) {
+        std::size_t resource = 0;
+        combineSorted(resource, uses.second);
+        resources.push_back(resource);
+    }
+
+    std::size_t label = 0;
+    combine(label, std::string("fu"));
+    combineSorted(label, operations);
+    combineSorted(label, resources);
+    combine(label, addressSpaceLabel(fu.addressSpace()));
+
+    const ControlUnit* gcu = dynamic_cast<const ControlUnit*>(&fu);
+    if (gcu != NULL) {
+        combine(label, std::string("gcu"));
+        combine(label, gcu->delaySlots());
+        combine(label, gcu->globalGuardLatency());
+    }
+
+    // ports are labeled after the unit label is known
+    std::vector<std::size_t> ports;
+    std::vector<std::pair<const Port*, std::size_t> > portDescriptions;
+    for (int i = 0; i < fu.portCount(); i++) {
+        const BaseFUPort* port = fu.port(i);
+        std::size_t description = 0;
+        combine(description, port->width());
+        const FUPort* opPort = dynamic_cast<const FUPort*>(port);
+        if (opPort != NULL) {
+            combine(description, opPort->isTriggering());
+            combine(description, opPort->isOpcodeSetting());
+            combine(description, opPort->noRegister());
+            combineSorted(description, bindings[port]);
+        } else {
+            combine(description, std::string("special"));
+            combine(description,
+                    gcu != NULL && gcu->hasReturnAddressPort() &&
+                    gcu->returnAddressPort() == port);
+        }
+        ports.push_back(description);
+        portDescriptions.push_back(std::make_pair(port, description));
+    }
+    combineSorted(label, ports);
+
+    for (auto& description : portDescriptions) {
+        std::size_t portLabel = label;
+        combine(portLabel, description.second);
+        portLabels[description.first] = portLabel;
+    }
+    return label;
+}
+
+/**
+ * Returns a name independent label of a register file or an immediate unit
+ * and adds the labels of its ports to the given map.
+ */
+std::size_t
+registerFileLabel(
+    const BaseRegisterFile& rf,
+    std::map<const Port*, std::size_t>& portLabels) {
+
+    std::size_t label = 0;
+    combine(label, rf.width());
+    combine(label, rf.numberOfRegisters());
+
+    const ImmediateUnit* iu = dynamic_cast<const ImmediateUnit*>(&rf);
+    const RegisterFile* regFile = dynamic_cast<const RegisterFile*>(&rf);
+    if (iu != NULL) {
+        combine(label, std::string("iu"));
+        combine(label, static_cast<int>(iu->extensionMode()));
+        combine(label, iu->latency());
+    } else if (regFile != NULL) {
+        combine(label, std::string("rf"));
+        combine(label, regFile->maxReads());
+        combine(label, regFile->maxWrites());
+        combine(label, static_cast<int>(regFile->type()));
+        combine(label, regFile->guardLatency());
+        combine(label, regFile->zeroRegister());
+    }
+
+    for (int i = 0; i < rf.portCount(); i++) {
+        std::size_t portLabel = label;
+        combine(portLabel, rf.port(i)->width());
+        portLabels[rf.port(i)] = portLabel;
+    }
+    return label;
+}
+
+}
+
+/**
+ * Returns a structural fingerprint of the machine.
+ *
+ * Unlike hash(), the fingerprint is computed directly from the object
+ * model and does not depend on the names of the components or the order in
+ * which they are declared. Machines that differ only in those produce the
+ * same fingerprint.
+ *
+ * The interconnection is described by refining the labels of buses,
+ * sockets and ports a few rounds with the labels of their neighbours, so
+ * the components are distinguished by their place in the network instead
+ * of by their names.
+ *
+ * The converse does not hold: equal fingerprints do not guarantee equal
+ * machines. Besides hash collisions, the connections of a socket are
+ * hashed per bus, not per segment, and operation triggered instruction
+ * formats are hashed by name only. Use the fingerprint as a lookup key and
+ * compare the machines themselves before treating them as equal.
+ *
+ * @return The fingerprint as a string.
+ */
+TCEString
+Machine::fingerprint() const {
+
+    std::map<const Port*, std::size_t> portLabels;
+    std::map<const BaseRegisterFile*, std::size_t> rfLabels;
+    std::vector<std::size_t> units;
+
+    for (const FunctionUnit* fu : functionUnits_) {
+        std::size_t label = functionUnitLabel(*fu, portLabels);
+        if (fuOrdered_) {
+            combine(label, fu->orderNumber());
+        }
+        units.push_back(label);
+    }
+    if (controlUnit_ != NULL) {
+        units.push_back(functionUnitLabel(*controlUnit_, portLabels));
+    }
+    for (const RegisterFile* rf : registerFiles_) {
+        rfLabels[rf] = registerFileLabel(*rf, portLabels);
+        units.push_back(rfLabels[rf]);
+    }
+    for (const ImmediateUnit* iu : immediateUnits_) {
+        rfLabels[iu] = registerFileLabel(*iu, portLabels);
+        units.push_back(rfLabels[iu]);
+    }
+
+    // the interconnection network as a graph of buses, sockets and ports
+    std::map<const void*, int> nodeIndex;
+    std::vector<std::size_t> labels;
+    std::vector<std::vector<std::pair<int, int> > > neighbours;
+    auto addNode = [&](const void* component, std::size_t label) {
+        nodeIndex[component] = labels.size();
+        labels.push_back(label);
+        neighbours.push_back(std::vector<std::pair<int, int> >());
+    };
+    auto connect = [&](const void* a, const void* b, int kind, int reverse) {
+        int ia = nodeIndex[a];
+        int ib = nodeIndex[b];
+        neighbours[ia].push_back(std::make_pair(ib, kind));
+        neighbours[ib].push_back(std::make_pair(ia, reverse));
+    };
+
+    for (auto& port : portLabels) {
+        addNode(port.first, port.second);
+    }
+    for (const Bus* bus : busses_) {
+        std::size_t label = 0;
+        combine(label, std::string("bus"));
+        combine(label, bus->width());
+        combine(label, bus->immediateWidth());
+        combine(label, bus->signExtends());
+        combine(label, bus->segmentCount());
+        std::vector<std::size_t> guards;
+        for (int i = 0; i < bus->guardCount(); i++) {
+            const Guard* guard = bus->guard(i);
+            std::size_t guardLabel = 0;
+            combine(guardLabel, guard->isInverted());
+            const RegisterGuard* regGuard =
+                dynamic_cast<const RegisterGuard*>(guard);
+            const PortGuard* portGuard =
+                dynamic_cast<const PortGuard*>(guard);
+            if (regGuard != NULL) {
+                combine(guardLabel, rfLabels[regGuard->registerFile()]);
+                combine(guardLabel, regGuard->registerIndex());
+            } else if (portGuard != NULL) {
+                combine(guardLabel, portLabels[portGuard->port()]);
+            } else {
+                combine(guardLabel, std::string("unconditional"));
+            }
+            guards.push_back(guardLabel);
+        }
+        combineSorted(label, guards);
+        addNode(bus, label);
+    }
+    for (const Socket* socket : sockets_) {
+        std::size_t label = 0;
+        combine(label, std::string("socket"));
+        combine(label, static_cast<int>(socket->direction()));
+        addNode(socket, label);
+    }
+
+    const int SOCKET_BUS = 1, BUS_SOCKET = 2, SOCKET_PORT = 3,
+        PORT_SOCKET = 4, BRIDGE_NEXT = 5, BRIDGE_PREVIOUS = 6;
+    for (const Socket* socket : sockets_) {
+        std::set<Bus*> buses = socket->connectedBuses();
+        for (const Bus* bus : buses) {
+            connect(socket, bus, SOCKET_BUS, BUS_SOCKET);
+        }
+        for (int i = 0; i < socket->portCount(); i++) {
+            connect(socket, socket->port(i), SOCKET_PORT, PORT_SOCKET);
+        }
+    }
+    for (const Bridge* bridge : bridges_) {
+        connect(
+            bridge->sourceBus(), bridge->destinationBus(),
+            BRIDGE_NEXT, BRIDGE_PREVIOUS);
+    }
+
+    for (int round = 0; round < FINGERPRINT_ROUNDS; round++) {
+        std::vector<std::size_t> refined(labels.size());
+        for (std::size_t node = 0; node < labels.size(); node++) {
+            std::vector<std::size_t> adjacent;
+            for (auto& neighbour : neighbours[node]) {
+                std::size_t edge = labels[neighbour.first];
+                combine(edge, neighbour.second);
+                adjacent.push_back(edge);
+            }
+            refined[node] = labels[node];
+            combineSorted(refined[node], adjacent);
+        }
+        labels.swap(refined);
+    }
+
+    std::vector<std::size_t> templates;
+    for (const InstructionTemplate* templ : instructionTemplates_) {
+        std::vector<std::size_t> slots;
+        for (int i = 0; i < templ->slotCount(); i++) {
+            const TemplateSlot* slot = templ->slot(i);
+            std::size_t slotLabel = 0;
+            if (slot->bus() != NULL) {
+                combine(slotLabel, labels[nodeIndex[slot->bus()]]);
+            } else {
+                combine(slotLabel, std::string("immediate slot"));
+            }
+            combine(slotLabel, slot->width());
+            combine(slotLabel, rfLabels[slot->destination()]);
+            slots.push_back(slotLabel);
+        }
+        std::size_t label = 0;
+        combineSorted(label, slots);
+        templates.push_back(label);
+    }
+
+    std::vector<std::size_t> immediateSlots;
+    for (const ImmediateSlot* slot : immediateSlots_) {
+        immediateSlots.push_back(slot->width());
+    }
+
+    std::vector<std::size_t> addressSpaces;
+    for (const AddressSpace* as : addressSpaces_) {
+        addressSpaces.push_back(addressSpaceLabel(as));
+    }
+
+    std::vector<std::size_t> formats;
+    for (const OperationTriggeredFormat* format :
+             operationTriggeredFormats_) {
+        formats.push_back(boost::hash<std::string>()(format->name()));
+    }
+
+    std::size_t h = 0;
+    combineSorted(h, units);
+    combineSorted(h, labels);
+    combineSorted(h, templates);
+    combineSorted(h, immediateSlots);
+    combineSorted(h, addressSpaces);
+    combineSorted(h, formats);
+    combine(h, alwaysWriteResults_);
+    combine(h, triggerInvalidatesResults_);
+    combine(h, fuOrdered_);
+    combine(h, littleEndian_);
+    combine(h, bitness64_);
+
+    TCEString fingerprint =
+        (Conversion::toHexString(labels.size())).substr(2);
+    fingerprint += "_";
+    fingerprint += (Conversion::toHexString(h)).substr(2);
+    return fingerprint;
+}
+
+/**
+ * Marks the structure of the machine modified.
+ *
+ * Called by the components whenever a component is added or removed or
+ * the connectivity between components changes, so that clients caching
+ * information derived from the machine can detect stale data by comparing
+ * the stamp returned by structureVersion().
+ */
+void
+Machine::structureChanged() {
+    structureVersion_ = nextStructureVersion_++;
+}
+
 /**
  * Returns true if result value always needs to be written to GPR.
  *
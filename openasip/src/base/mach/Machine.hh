@@ -36,6 +36,7 @@
 
 #include <vector>
 #include <string>
+#include <map>
 
 #include "Exception.hh"
 #include "Serializable.hh"
@@ -50,6 +51,7 @@ class Bus;
 class Socket;
 class AddressSpace;
 class Unit;
+class Port;
 class Bridge;
 class InstructionTemplate;
 class FunctionUnit;
@@ -142,6 +144,12 @@ public:
     void writeToADF(const std::string& adfFileName) const;
 
     TCEString hash() const;
+    TCEString fingerprint() const;
+
+    /// Returns a stamp that changes whenever the interconnection or the
+    /// set of components of the machine is modified.
+    unsigned long structureVersion() const { return structureVersion_; }
+    void structureChanged();
 
     bool hasOperation(const TCEString& opName) const;
     bool isRISCVMachine() const;
@@ -280,6 +288,14 @@ private:
         ContainerType& container,
         ObjectState* parent);
 
+    /// Maps the ports of a copied machine to the ports of the copy.
+    typedef std::map<const Port*, Port*> PortMap;
+
+    void deleteAllComponents();
+    void copyComponents(const Machine& source);
+    static void copyFunctionUnitContents(
+        const FunctionUnit& source, FunctionUnit& target, PortMap& ports);
+
     /// Contains all the busses attached to the machine.
     ComponentContainer<Bus> busses_;
     /// Contains all the sockets attached to the machine.
@@ -328,6 +344,9 @@ private:
     bool littleEndian_;
     // True in case the machine is 64-bit. Also has to be little-endian.
     bool bitness64_;
+    // Stamp of the latest structural modification, unique over all
+    // machine instances of the process.
+    unsigned long structureVersion_;
 };
 }
 
@@ -215,6 +215,7 @@ Port::attachSocket(Socket& socket) {
     // bookeeping of Socket internal state - private Socket operation
     // reserved solely to Port class!
     socket.attachPort(*this);
+    parentUnit()->machine()->structureChanged();
 
     // sanity check
     if (socket2_ != NULL) {
@@ -247,6 +248,10 @@ Port::detachSocket(Socket& socket) {
     // bookeeping of Socket internal state - private Socket operation
     // reserved solely to Port class!
     socket.detachPort(*this);
+
+    if (parentUnit() != NULL && parentUnit()->machine() != NULL) {
+        parentUnit()->machine()->structureChanged();
+    }
 }
 
 /**
@@ -111,6 +111,9 @@ private:
     Socket* socket1_;
     /// Connection to the second socket.
     Socket* socket2_;
+
+    // Machine copies the socket connections in their original order
+    friend class Machine;
 };
 }
 
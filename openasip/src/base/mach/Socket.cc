@@ -141,6 +141,7 @@ Socket::setDirection(Direction direction) {
     MachineTester& tester = machine()->machineTester();
     if (tester.canSetDirection(*this, direction)) {
         direction_ = direction;
+        machine()->structureChanged();
     } else {
         string errorMsg = MachineTestReporter::socketDirectionSettingError(
             *this, direction, tester);
@@ -178,6 +179,7 @@ Socket::attachBus(Segment& bus) {
         const Connection* conn = new Connection(*this, bus);
         busses_.push_back(conn);
         bus.attachSocket(*this);
+        machine()->structureChanged();
     } else {
         assert(false);
     }
@@ -228,6 +230,10 @@ Socket::detachBus(Segment& bus) {
     if (segmentCount() == 0) {
         direction_ = UNKNOWN;
     }
+
+    if (machine() != NULL) {
+        machine()->structureChanged();
+    }
 }
 
 /**
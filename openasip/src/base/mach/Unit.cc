@@ -217,6 +217,9 @@ Unit::addPort(Port& port) {
     // check that a port with same name does not exist
     if (!hasPort(port.name())) {
         ports_.push_back(&port);
+        if (machine() != NULL) {
+            machine()->structureChanged();
+        }
         return;
     }
 
@@ -239,6 +242,9 @@ Unit::removePort(Port& port) {
     assert(port.parentUnit() == NULL);
     bool removed = ContainerTools::removeValueIfExists(ports_, &port);
     assert(removed);
+    if (machine() != NULL) {
+        machine()->structureChanged();
+    }
 }
 
 
@@ -108,6 +108,12 @@ public:
     virtual void advanceClock() {}
     virtual void reset() {}
     virtual void fillWithZeros();
+    virtual void writeBlock(
+        ULongWord address, const MAU* data, std::size_t count) override;
+    virtual void readBlock(
+        ULongWord address, MAU* data, std::size_t count) override;
+    virtual void fill(
+        ULongWord address, MAU value, std::size_t count) override;
 
     void writeBE(ULongWord address, int count, ULongWord data) override;
 
@@ -97,6 +97,57 @@ IdealSRAM::read(ULongWord address) {
     return data_->readData(address - start_);
 }
 
+/**
+ * Writes a block of MAUs directly to the memory a page at a time.
+ *
+ * @param address The first address to write.
+ * @param data The MAUs to write.
+ * @param count Number of MAUs to write.
+ * @exception OutOfRange in case the block is out of range of the memory.
+ */
+void
+IdealSRAM::writeBlock(ULongWord address, const MAU* data, std::size_t count) {
+    if (count == 0) {
+        return;
+    }
+    checkBlockRange(address, count);
+    data_->write(address - start_, data, count);
+}
+
+/**
+ * Reads a block of MAUs from the memory a page at a time.
+ *
+ * @param address The first address to read.
+ * @param data The read MAUs are stored here, must have room for count MAUs.
+ * @param count Number of MAUs to read.
+ * @exception OutOfRange in case the block is out of range of the memory.
+ */
+void
+IdealSRAM::readBlock(ULongWord address, MAU* data, std::size_t count) {
+    if (count == 0) {
+        return;
+    }
+    checkBlockRange(address, count);
+    data_->read(address - start_, data, count);
+}
+
+/**
+ * Writes the same MAU to a block of the memory a page at a time.
+ *
+ * @param address The first address to write.
+ * @param value The MAU to write.
+ * @param count Number of MAUs to write.
+ * @exception OutOfRange in case the block is out of range of the memory.
+ */
+void
+IdealSRAM::fill(ULongWord address, MAU value, std::size_t count) {
+    if (count == 0) {
+        return;
+    }
+    checkBlockRange(address, count);
+    data_->fill(address - start_, value, count);
+}
+
 /**
  * Fills the whole memory with zeros.
  *
@@ -64,6 +64,12 @@ public:
     using Memory::read;
 
     virtual void fillWithZeros();
+    virtual void writeBlock(
+        ULongWord address, const MAU* data, std::size_t count) override;
+    virtual void readBlock(
+        ULongWord address, MAU* data, std::size_t count) override;
+    virtual void fill(
+        ULongWord address, MAU value, std::size_t count) override;
 
     IdealSRAM(const IdealSRAM&) = delete;
     IdealSRAM& operator=(const IdealSRAM&) = delete;
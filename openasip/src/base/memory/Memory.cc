@@ -30,6 +30,7 @@
  * @note rating: red
  */
 
+#include <algorithm>
 #include <cstddef>
 #include <ios>
 
@@ -692,6 +693,74 @@ Memory::readLE(ULongWord address, int size, ULongWord& data) {
     }
 }
 
+/**
+ * Writes a block of MAUs directly to the memory.
+ *
+ * The data is visible immediately, it does not wait for the end of the
+ * clock cycle. The default implementation writes the MAUs one at a time.
+ *
+ * @param address The first address to write.
+ * @param data The MAUs to write.
+ * @param count Number of MAUs to write.
+ * @exception OutOfRange in case the block is out of range of the memory.
+ */
+void
+Memory::writeBlock(ULongWord address, const MAU* data, std::size_t count) {
+
+    if (count == 0) {
+        return;
+    }
+    checkBlockRange(address, count);
+    for (std::size_t i = 0; i < count; ++i) {
+        write(address + i, data[i]);
+    }
+}
+
+/**
+ * Reads a block of MAUs from the memory.
+ *
+ * The default implementation reads the MAUs one at a time.
+ *
+ * @param address The first address to read.
+ * @param data The read MAUs are stored here, must have room for count MAUs.
+ * @param count Number of MAUs to read.
+ * @exception OutOfRange in case the block is out of range of the memory.
+ */
+void
+Memory::readBlock(ULongWord address, MAU* data, std::size_t count) {
+
+    if (count == 0) {
+        return;
+    }
+    checkBlockRange(address, count);
+    for (std::size_t i = 0; i < count; ++i) {
+        data[i] = read(address + i);
+    }
+}
+
+/**
+ * Writes the same MAU to a block of the memory directly.
+ *
+ * The data is visible immediately, it does not wait for the end of the
+ * clock cycle. The default implementation writes the MAUs one at a time.
+ *
+ * @param address The first address to write.
+ * @param value The MAU to write.
+ * @param count Number of MAUs to write.
+ * @exception OutOfRange in case the block is out of range of the memory.
+ */
+void
+Memory::fill(ULongWord address, MAU value, std::size_t count) {
+
+    if (count == 0) {
+        return;
+    }
+    checkBlockRange(address, count);
+    for (std::size_t i = 0; i < count; ++i) {
+        write(address + i, value);
+    }
+}
+
 /**
  * Fills the whole memory with zeros.
  *
@@ -714,14 +783,7 @@ Memory::fillWithZeros() {
  */
 void
 Memory::reset() {
-    RequestQueue::iterator iter = writeRequests_->begin();
-    while (iter != writeRequests_->end()) {
-        delete[] (*iter)->data_;
-        (*iter)->data_ = NULL;
-        delete (*iter);
-        ++iter;
-    }
-    writeRequests_->clear();
+    clearWriteRequests();
 }
 
 /**
@@ -833,6 +895,50 @@ Memory::advanceClock() {
     writeRequests_->clear();
 }
 
+/**
+ * Commits the part of the uncommitted write requests that falls inside
+ * the given address range.
+ *
+ * The requests are left in the queue so the rest of the address space
+ * can be committed separately, for example by another thread. The queue
+ * must be cleared with clearWriteRequests() once all of it is committed.
+ *
+ * @param low The lowest address to commit.
+ * @param high The highest address to commit.
+ */
+void
+Memory::commitWriteRequests(ULongWord low, ULongWord high) {
+
+    for (std::size_t r = 0; r < writeRequests_->size(); ++r) {
+        const WriteRequest* req = (*writeRequests_)[r];
+        ULongWord first = req->address_;
+        ULongWord last = first + req->size_ - 1;
+        if (last < low || first > high) {
+            continue;
+        }
+        ULongWord from = std::max(first, low);
+        ULongWord to = std::min(last, high);
+        for (ULongWord addr = from; addr <= to; ++addr) {
+            write(addr, req->data_[addr - first]);
+        }
+    }
+}
+
+/**
+ * Discards all the uncommitted write requests.
+ */
+void
+Memory::clearWriteRequests() {
+    RequestQueue::iterator iter = writeRequests_->begin();
+    while (iter != writeRequests_->end()) {
+        delete[] (*iter)->data_;
+        (*iter)->data_ = NULL;
+        delete (*iter);
+        ++iter;
+    }
+    writeRequests_->clear();
+}
+
 /**
  * Helper for checking the legality of the memory access address range.
  *
@@ -854,3 +960,23 @@ Memory::checkRange(ULongWord startAddress, int numberOfMAUs) {
              % startAddress % numberOfMAUs).str());
     }
 }
+
+/**
+ * Checks that a block of MAUs is inside the address space of the memory.
+ *
+ * @param startAddress The first address of the block.
+ * @param numberOfMAUs The size of the block, at least one.
+ * @exception OutOfRange If the block is not inside the address space.
+ */
+void
+Memory::checkBlockRange(ULongWord startAddress, std::size_t numberOfMAUs) {
+
+    if (startAddress < start() || startAddress > end() ||
+        numberOfMAUs - 1 > end() - startAddress) {
+        throw OutOfRange(
+            __FILE__, __LINE__, __func__,
+            (boost::format(
+                "Memory access at %d of size %d is out of the address space.")
+             % startAddress % numberOfMAUs).str());
+    }
+}
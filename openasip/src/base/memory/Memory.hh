@@ -35,6 +35,8 @@
 #ifndef TTA_MEMORY_MODEL_HH
 #define TTA_MEMORY_MODEL_HH
 
+#include <cstddef>
+
 #include "BaseType.hh"
 
 struct WriteRequest;
@@ -66,6 +68,12 @@ struct RequestQueue;
  * the case with the compiled simulation engine and the DirectAccessMemory
  * implementation it uses for simulating data memory.
  *
+ * Blocks of MAUs can be written, read and filled at once with the block
+ * methods. They access the storage directly like write() and read() of a
+ * single MAU. The default implementations loop over the single MAU methods
+ * and derived classes override them with faster ones where the storage
+ * allows.
+ *
  * The Memory abstraction deals with MAUs (commonly bytes). The client can
  * access the Memory for storing writing doubles and floats in case it
  * implements floating point memory operations. Interface for those is
@@ -110,6 +118,11 @@ public:
     virtual void readLE(ULongWord address, FloatWord& data);
     virtual void readLE(ULongWord address, DoubleWord& data);
 
+    virtual void writeBlock(
+        ULongWord address, const MAU* data, std::size_t count);
+    virtual void readBlock(ULongWord address, MAU* data, std::size_t count);
+    virtual void fill(ULongWord address, MAU value, std::size_t count);
+
     virtual void reset();
     virtual void fillWithZeros();
 
@@ -128,6 +141,9 @@ protected:
     void unpackBE(const ULongWord& value, int size, Memory::MAUTable data);
     void packLE(const Memory::MAUTable data, int size, ULongWord& value);
     void unpackLE(const ULongWord& value, int size, Memory::MAUTable data);
+    void checkBlockRange(ULongWord startAddress, std::size_t numberOfMAUs);
+    void commitWriteRequests(ULongWord low, ULongWord high);
+    void clearWriteRequests();
 
     bool littleEndian_;
 private:
@@ -46,3 +46,38 @@ RemoteMemory::read(ULongWord address)
 	assert(controller_);
 	return controller_->readMem(address, addressspace_ );
 }
+
+/**
+ * Writes a block of MAUs to the physical memory.
+ *
+ * The block is range checked once and passed to the controller without
+ * the per MAU dispatch of the base class.
+ */
+void
+RemoteMemory::writeBlock(ULongWord address, const MAU* data, std::size_t count)
+{
+	if (count == 0) {
+		return;
+	}
+	assert(controller_);
+	checkBlockRange(address, count);
+	for (std::size_t i = 0; i < count; ++i) {
+		controller_->writeMem(address + i, data[i], addressspace_);
+	}
+}
+
+/**
+ * Reads a block of MAUs from the physical memory.
+ */
+void
+RemoteMemory::readBlock(ULongWord address, MAU* data, std::size_t count)
+{
+	if (count == 0) {
+		return;
+	}
+	assert(controller_);
+	checkBlockRange(address, count);
+	for (std::size_t i = 0; i < count; ++i) {
+		data[i] = controller_->readMem(address + i, addressspace_);
+	}
+}
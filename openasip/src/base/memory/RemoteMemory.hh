@@ -66,6 +66,10 @@ public:
 	// overload the pure viruals of Memory
 	virtual void write(ULongWord address, MAU data) override;
 	virtual Memory::MAU read(ULongWord address) override;
+	virtual void writeBlock(
+        ULongWord address, const MAU* data, std::size_t count) override;
+	virtual void readBlock(
+        ULongWord address, MAU* data, std::size_t count) override;
 	
 private:
 	RemoteController* controller_;
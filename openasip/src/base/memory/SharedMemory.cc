@@ -0,0 +1,283 @@
+/*
+    Copyright (c) 2002-2026 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file SharedMemory.cc
+ *
+ * Definition of SharedMemory class.
+ *
+ * @note rating: red
+ */
+
+#include <algorithm>
+
+#include "SharedMemory.hh"
+#include "MemoryContents.hh"
+#include "Conversion.hh"
+#include "Exception.hh"
+
+/**
+ * The port of a single core to a shared memory.
+ *
+ * Buffers the write requests of the core and accesses the storage of the
+ * shared memory directly otherwise. The buffered writes are committed by
+ * the owning SharedMemory, advancing the clock of the port does nothing.
+ */
+class SharedMemory::CorePort : public Memory {
+public:
+    explicit CorePort(MemoryPtr storage) :
+        Memory(
+            storage->start(), storage->end(), storage->MAUSize(),
+            storage->isLittleEndian()),
+        storage_(storage) {}
+
+    virtual void advanceClock() override {}
+
+    virtual void write(ULongWord address, MAU data) override {
+        storage_->write(address, data);
+    }
+    virtual Memory::MAU read(ULongWord address) override {
+        return storage_->read(address);
+    }
+    virtual void writeBlock(
+        ULongWord address, const MAU* data, std::size_t count) override {
+        storage_->writeBlock(address, data, count);
+    }
+    virtual void readBlock(
+        ULongWord address, MAU* data, std::size_t count) override {
+        storage_->readBlock(address, data, count);
+    }
+    virtual void fill(
+        ULongWord address, MAU value, std::size_t count) override {
+        storage_->fill(address, value, count);
+    }
+    virtual void fillWithZeros() override {
+        storage_->fillWithZeros();
+    }
+
+    /// Commits the buffered writes inside the given address range.
+    void commit(ULongWord low, ULongWord high) {
+        commitWriteRequests(low, high);
+    }
+    /// Discards the buffered writes.
+    void clear() {
+        clearWriteRequests();
+    }
+
+private:
+    /// The storage of the shared memory.
+    MemoryPtr storage_;
+};
+
+/**
+ * Constructor.
+ *
+ * @param storage The memory model the writes of the cores are committed to.
+ * @param policy The order in which the writes of the cores are committed.
+ * @param bankCount Number of banks to partition the address space to.
+ */
+SharedMemory::SharedMemory(
+    MemoryPtr storage, ConflictPolicy policy, unsigned bankCount) :
+    Memory(
+        storage->start(), storage->end(), storage->MAUSize(),
+        storage->isLittleEndian()),
+    storage_(storage), policy_(policy), bankSize_(0), bankCount_(1) {
+
+    const ULongWord size = storage->end() - storage->start() + 1;
+    const ULongWord pages = (size + MEM_CHUNK_SIZE - 1) / MEM_CHUNK_SIZE;
+    const ULongWord banks =
+        std::max<ULongWord>(1, std::min<ULongWord>(bankCount, pages));
+    bankSize_ = ((pages + banks - 1) / banks) * MEM_CHUNK_SIZE;
+    bankCount_ = (size + bankSize_ - 1) / bankSize_;
+}
+
+/**
+ * Destructor.
+ */
+SharedMemory::~SharedMemory() {
+}
+
+/**
+ * Creates the port of a new core to the memory.
+ *
+ * The cores are numbered in the order they are added, the first core
+ * being the SharedMemory itself.
+ *
+ * @return The memory model the new core should use.
+ */
+SharedMemory::MemoryPtr
+SharedMemory::addCore() {
+    ports_.push_back(boost::shared_ptr<CorePort>(new CorePort(storage_)));
+    return ports_.back();
+}
+
+/**
+ * Returns the number of cores sharing the memory.
+ */
+unsigned
+SharedMemory::coreCount() const {
+    return ports_.size() + 1;
+}
+
+/**
+ * Returns the number of banks the address space is partitioned to.
+ *
+ * Can be smaller than requested in case the memory is too small to have
+ * as many banks.
+ */
+unsigned
+SharedMemory::bankCount() const {
+    return bankCount_;
+}
+
+/**
+ * Returns the conflict policy of the memory.
+ */
+SharedMemory::ConflictPolicy
+SharedMemory::conflictPolicy() const {
+    return policy_;
+}
+
+/**
+ * Returns the memory model the writes are committed to.
+ */
+Memory&
+SharedMemory::storage() {
+    return *storage_;
+}
+
+/**
+ * Commits the buffered writes of all the cores and clears the buffers.
+ *
+ * The write buffer of each core is scanned once regardless of the number
+ * of banks. The banks matter only to drivers that commit them in parallel
+ * with commitBank(). The clock of the storage is advanced last so that
+ * a wrapped memory, such as an access tracker, sees the cycle end.
+ */
+void
+SharedMemory::advanceClock() {
+    for (unsigned core = 0; core < coreCount(); ++core) {
+        commitCore(core, start(), end());
+    }
+    clearWriteBuffers();
+    storage_->advanceClock();
+}
+
+/**
+ * Commits the buffered writes of all the cores that fall into a bank.
+ *
+ * The buffers are left intact. Meant for drivers that commit the banks
+ * in parallel host threads, a serial driver should use advanceClock().
+ * No core may access the memory meanwhile.
+ *
+ * @param bank The index of the bank.
+ * @exception OutOfRange If there is no such bank.
+ */
+void
+SharedMemory::commitBank(unsigned bank) {
+    if (bank >= bankCount_) {
+        throw OutOfRange(
+            __FILE__, __LINE__, __func__,
+            "Bank index " + Conversion::toString(bank) +
+            " out of range.");
+    }
+    const ULongWord low = start() + bank * bankSize_;
+    const ULongWord high = std::min(low + bankSize_ - 1, end());
+    for (unsigned core = 0; core < coreCount(); ++core) {
+        commitCore(core, low, high);
+    }
+}
+
+/**
+ * Discards the buffered writes of all the cores.
+ *
+ * Called after all the banks have been committed with commitBank().
+ */
+void
+SharedMemory::clearWriteBuffers() {
+    clearWriteRequests();
+    for (std::size_t i = 0; i < ports_.size(); ++i) {
+        ports_[i]->clear();
+    }
+}
+
+/**
+ * Commits the writes of the core at the given position of the commit order.
+ *
+ * @param core The position in the commit order.
+ * @param low The lowest address to commit.
+ * @param high The highest address to commit.
+ */
+void
+SharedMemory::commitCore(unsigned core, ULongWord low, ULongWord high) {
+    if (policy_ == FIRST_CORE_WINS) {
+        core = coreCount() - 1 - core;
+    }
+    if (core == 0) {
+        commitWriteRequests(low, high);
+    } else {
+        ports_[core - 1]->commit(low, high);
+    }
+}
+
+void
+SharedMemory::write(ULongWord address, MAU data) {
+    storage_->write(address, data);
+}
+
+Memory::MAU
+SharedMemory::read(ULongWord address) {
+    return storage_->read(address);
+}
+
+void
+SharedMemory::writeBlock(
+    ULongWord address, const MAU* data, std::size_t count) {
+    storage_->writeBlock(address, data, count);
+}
+
+void
+SharedMemory::readBlock(ULongWord address, MAU* data, std::size_t count) {
+    storage_->readBlock(address, data, count);
+}
+
+void
+SharedMemory::fill(ULongWord address, MAU value, std::size_t count) {
+    storage_->fill(address, value, count);
+}
+
+/**
+ * Resets the memory.
+ *
+ * Clears the pending writes of all the cores.
+ */
+void
+SharedMemory::reset() {
+    clearWriteBuffers();
+    storage_->reset();
+}
+
+void
+SharedMemory::fillWithZeros() {
+    storage_->fillWithZeros();
+}
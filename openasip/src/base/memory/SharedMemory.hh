@@ -0,0 +1,119 @@
+/*
+    Copyright (c) 2002-2026 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file SharedMemory.hh
+ *
+ * Declaration of SharedMemory class.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_SHARED_MEMORY_HH
+#define TTA_SHARED_MEMORY_HH
+
+#include <vector>
+#include <boost/shared_ptr.hpp>
+
+#include "Memory.hh"
+
+/**
+ * Memory model for a memory shared between multiple simulated cores.
+ *
+ * Each core accesses the memory through its own port, which buffers the
+ * write requests of that core locally. The cores can thus be simulated
+ * in parallel host threads without a shared request queue: during a
+ * cycle the storage is only read and each core appends to its own
+ * buffer. The SharedMemory object itself acts as the port of the first
+ * core, the ports of the other cores are created with addCore().
+ *
+ * At the clock edge the buffered writes are committed to the storage
+ * core by core in a fixed order. The conflict policy selects the order
+ * and thus which core's value survives when several cores write the same
+ * address during the same cycle.
+ *
+ * The address space can be partitioned into banks of consecutive
+ * addresses. The buffered writes of the banks can be committed
+ * independently of each other with commitBank(), for example by a pool
+ * of host threads, after which clearWriteBuffers() must be called.
+ * advanceClock() ignores the banks and scans each buffer only once.
+ * The bank size is rounded to the page size of the paged storage of
+ * IdealSRAM so that two banks never touch the same storage page.
+ */
+class SharedMemory : public Memory {
+public:
+    typedef boost::shared_ptr<Memory> MemoryPtr;
+
+    /// The core whose value is stored on conflicting writes.
+    enum ConflictPolicy {
+        LAST_CORE_WINS, ///< The write of the highest numbered core.
+        FIRST_CORE_WINS ///< The write of the lowest numbered core.
+    };
+
+    SharedMemory(
+        MemoryPtr storage, ConflictPolicy policy = LAST_CORE_WINS,
+        unsigned bankCount = 1);
+    virtual ~SharedMemory();
+
+    MemoryPtr addCore();
+    unsigned coreCount() const;
+    unsigned bankCount() const;
+    ConflictPolicy conflictPolicy() const;
+    Memory& storage();
+
+    virtual void advanceClock() override;
+    void commitBank(unsigned bank);
+    void clearWriteBuffers();
+
+    virtual void write(ULongWord address, MAU data) override;
+    virtual Memory::MAU read(ULongWord address) override;
+    using Memory::write;
+    using Memory::read;
+    virtual void writeBlock(
+        ULongWord address, const MAU* data, std::size_t count) override;
+    virtual void readBlock(
+        ULongWord address, MAU* data, std::size_t count) override;
+    virtual void fill(
+        ULongWord address, MAU value, std::size_t count) override;
+
+    virtual void reset() override;
+    virtual void fillWithZeros() override;
+
+private:
+    class CorePort;
+
+    void commitCore(unsigned core, ULongWord low, ULongWord high);
+
+    /// The memory model the writes are committed to.
+    MemoryPtr storage_;
+    /// The order in which the cores' writes are committed.
+    ConflictPolicy policy_;
+    /// Number of MAUs in a bank.
+    ULongWord bankSize_;
+    /// Number of banks the address space is partitioned to.
+    unsigned bankCount_;
+    /// The ports of the cores after the first one, in core order.
+    std::vector<boost::shared_ptr<CorePort> > ports_;
+};
+
+#endif
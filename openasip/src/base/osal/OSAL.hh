@@ -50,6 +50,7 @@
 #include "OperationPool.hh"
 #include "OperationState.hh"
 #include "OperationGlobals.hh"
+#include "OSALVector.hh"
 
 #include "SimulateTriggerWrappers.icc"
 
@@ -353,6 +354,42 @@ bool simulateTrigger( \
 #define SET_SUBFLOAT64(OPERAND, ELEMENT, VALUE) \
     (io[(OPERAND) - 1]->setDoubleWordElement(ELEMENT, VALUE))
 
+/**
+ * Lane-wise vector operation macros.
+ *
+ * The operations are computed for all lanes of the given element type in
+ * the output operand at once, directly on the raw operand storage. Common
+ * operations use host SIMD instructions. See OSALVector.hh.
+ */
+#define VECTOR_LANES(OPERAND, TYPE) \
+    (OSALVector::laneCount<TYPE>(*io[(OPERAND) - 1]))
+#define VECTOR_ADD(TYPE, OUT, IN1, IN2) \
+    (OSALVector::add<TYPE>(*io[(IN1) - 1], *io[(IN2) - 1], *io[(OUT) - 1]))
+#define VECTOR_SUB(TYPE, OUT, IN1, IN2) \
+    (OSALVector::sub<TYPE>(*io[(IN1) - 1], *io[(IN2) - 1], *io[(OUT) - 1]))
+#define VECTOR_MUL(TYPE, OUT, IN1, IN2) \
+    (OSALVector::mul<TYPE>(*io[(IN1) - 1], *io[(IN2) - 1], *io[(OUT) - 1]))
+#define VECTOR_AND(TYPE, OUT, IN1, IN2) \
+    (OSALVector::bitAnd<TYPE>( \
+        *io[(IN1) - 1], *io[(IN2) - 1], *io[(OUT) - 1]))
+#define VECTOR_IOR(TYPE, OUT, IN1, IN2) \
+    (OSALVector::bitOr<TYPE>( \
+        *io[(IN1) - 1], *io[(IN2) - 1], *io[(OUT) - 1]))
+#define VECTOR_XOR(TYPE, OUT, IN1, IN2) \
+    (OSALVector::bitXor<TYPE>( \
+        *io[(IN1) - 1], *io[(IN2) - 1], *io[(OUT) - 1]))
+#define VECTOR_BCAST(TYPE, OUT, VALUE) \
+    (OSALVector::broadcast<TYPE>((VALUE), *io[(OUT) - 1]))
+/**
+ * Computes FUNC, a function or lambda taking and returning TYPE, for all
+ * lanes. The two input version is VECTOR_LANEWISE2.
+ */
+#define VECTOR_LANEWISE(TYPE, OUT, IN, FUNC) \
+    (OSALVector::lanewise<TYPE>(*io[(IN) - 1], *io[(OUT) - 1], FUNC))
+#define VECTOR_LANEWISE2(TYPE, OUT, IN1, IN2, FUNC) \
+    (OSALVector::lanewise<TYPE>( \
+        *io[(IN1) - 1], *io[(IN2) - 1], *io[(OUT) - 1], FUNC))
+
 /**
  * Operand accessor macro.
  *
@@ -0,0 +1,525 @@
+/*
+    Copyright (c) 2002-2026 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file OSALVector.hh
+ *
+ * Lane-wise vector operation helpers for operation behavior definitions.
+ *
+ * The helpers operate directly on the raw little-endian storage of
+ * SimValues instead of accessing the vector lanes one at a time through
+ * the SimValue element accessors. On x86 hosts the most common lane-wise
+ * operations are computed with SSE2, or AVX2 when the host supports it.
+ * Other hosts and operations use plain lane loops.
+ *
+ * @note This file is used in compiled simulation. Keep dependencies *clean*
+ * @note rating: red
+ */
+
+#ifndef TTA_OSAL_VECTOR_HH
+#define TTA_OSAL_VECTOR_HH
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "BaseType.hh"
+#include "SimValue.hh"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && \
+    defined(__SSE2__) && HOST_BIGENDIAN == 0
+#define OSAL_VECTOR_X86 1
+#include <immintrin.h>
+#endif
+
+namespace OSALVector {
+
+/**
+ * Returns the number of lanes of the given element type in the value.
+ */
+template <typename T>
+inline std::size_t
+laneCount(const SimValue& value) {
+    return value.width() / (sizeof(T) * BYTE_BITWIDTH);
+}
+
+/**
+ * Reads a lane from raw SimValue storage in host endianness.
+ */
+template <typename T>
+inline T
+lane(const Byte* data, std::size_t index) {
+    T value;
+#if HOST_BIGENDIAN == 1
+    Byte* bytes = reinterpret_cast<Byte*>(&value);
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        bytes[i] = data[(index + 1) * sizeof(T) - 1 - i];
+    }
+#else
+    std::memcpy(&value, data + index * sizeof(T), sizeof(T));
+#endif
+    return value;
+}
+
+/**
+ * Writes a lane in host endianness to raw SimValue storage.
+ */
+template <typename T>
+inline void
+setLane(Byte* data, std::size_t index, T value) {
+#if HOST_BIGENDIAN == 1
+    const Byte* bytes = reinterpret_cast<const Byte*>(&value);
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        data[(index + 1) * sizeof(T) - 1 - i] = bytes[i];
+    }
+#else
+    std::memcpy(data + index * sizeof(T), &value, sizeof(T));
+#endif
+}
+
+/**
+ * Computes a binary operation for each lane of the output.
+ *
+ * @param in1 The first input vector.
+ * @param in2 The second input vector.
+ * @param out The output vector, its width defines the lane count.
+ * @param func The operation computed for the lanes.
+ */
+template <typename T, typename Func>
+inline void
+lanewise(const SimValue& in1, const SimValue& in2, SimValue& out, Func func) {
+    const std::size_t lanes = laneCount<T>(out);
+    for (std::size_t i = 0; i < lanes; ++i) {
+        setLane<T>(
+            out.rawData_, i,
+            func(lane<T>(in1.rawData_, i), lane<T>(in2.rawData_, i)));
+    }
+}
+
+/**
+ * Computes a unary operation for each lane of the output.
+ */
+template <typename T, typename Func>
+inline void
+lanewise(const SimValue& in, SimValue& out, Func func) {
+    const std::size_t lanes = laneCount<T>(out);
+    for (std::size_t i = 0; i < lanes; ++i) {
+        setLane<T>(out.rawData_, i, func(lane<T>(in.rawData_, i)));
+    }
+}
+
+/**
+ * Sets all lanes of the output to the given value.
+ */
+template <typename T>
+inline void
+broadcast(T value, SimValue& out) {
+    const std::size_t lanes = laneCount<T>(out);
+    for (std::size_t i = 0; i < lanes; ++i) {
+        setLane<T>(out.rawData_, i, value);
+    }
+}
+
+/**
+ * Integer lane arithmetic is done in the unsigned type of the same width
+ * so that overflows wrap around like in the modeled hardware. Lanes
+ * narrower than int would be promoted to signed int, which may overflow
+ * in multiplication, so their products are computed in unsigned int.
+ */
+template <typename T, bool = std::is_integral<T>::value>
+struct Arithmetic {
+    typedef typename std::make_unsigned<T>::type Type;
+    typedef typename std::conditional<
+        (sizeof(T) < sizeof(unsigned int)), unsigned int, Type>::type
+    Product;
+};
+
+template <typename T>
+struct Arithmetic<T, false> {
+    typedef T Type;
+    typedef T Product;
+};
+
+/// Lane-wise operations with host SIMD implementations.
+namespace Ops {
+
+#ifdef OSAL_VECTOR_X86
+typedef __m128i Sse;
+typedef __m256i Avx;
+#define OSAL_VECTOR_AVX2 __attribute__((target("avx2")))
+
+/// Tags that select the host instructions for a lane type. The compiled
+/// simulator is built as C++11, so the selection is done by overloading
+/// on these instead of with if constexpr.
+struct FloatLanes {};
+struct DoubleLanes {};
+template <std::size_t Bytes>
+struct IntLanes {};
+
+template <typename T>
+struct LaneKind {
+    typedef IntLanes<sizeof(T)> Type;
+};
+
+template <>
+struct LaneKind<float> {
+    typedef FloatLanes Type;
+};
+
+template <>
+struct LaneKind<double> {
+    typedef DoubleLanes Type;
+};
+
+struct AddSimd {
+    static Sse sse(Sse a, Sse b, FloatLanes) {
+        return _mm_castps_si128(
+            _mm_add_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+    }
+    static Sse sse(Sse a, Sse b, DoubleLanes) {
+        return _mm_castpd_si128(
+            _mm_add_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+    }
+    static Sse sse(Sse a, Sse b, IntLanes<1>) { return _mm_add_epi8(a, b); }
+    static Sse sse(Sse a, Sse b, IntLanes<2>) { return _mm_add_epi16(a, b); }
+    static Sse sse(Sse a, Sse b, IntLanes<4>) { return _mm_add_epi32(a, b); }
+    static Sse sse(Sse a, Sse b, IntLanes<8>) { return _mm_add_epi64(a, b); }
+    OSAL_VECTOR_AVX2 static Avx avx(Avx a, Avx b, FloatLanes) {
+        return _mm256_castps_si256(
+            _mm256_add_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b)));
+    }
+    OSAL_VECTOR_AVX2 static Avx avx(Avx a, Avx b, DoubleLanes) {
+        return _mm256_castpd_si256(
+            _mm256_add_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b)));
+    }
+    OSAL_VECTOR_AVX2 static Avx avx(Avx a, Avx b, IntLanes<1>) {
+        return _mm256_add_epi8(a, b);
+    }
+    OSAL_VECTOR_AVX2 static Avx avx(Avx a, Avx b, IntLanes<2>) {
+        return _mm256_add_epi16(a, b);
+    }
+    OSAL_VECTOR_AVX2 static Avx avx(Avx a, Avx b, IntLanes<4>) {
+        return _mm256_add_epi32(a, b);
+    }
+    OSAL_VECTOR_AVX2 static Avx avx(Avx a, Avx b, IntLanes<8>) {
+        return _mm256_add_epi64(a, b);
+    }
+};
+
+struct SubSimd {
+    static Sse sse(Sse a, Sse b, FloatLanes) {
+        return _mm_castps_si128(
+            _mm_sub_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+    }
+    static Sse sse(Sse a, Sse b, DoubleLanes) {
+        return _mm_castpd_si128(
+            _mm_sub_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+    }
+    static Sse sse(Sse a, Sse b, IntLanes<1>) { return _mm_sub_epi8(a, b); }
+    static Sse sse(Sse a, Sse b, IntLanes<2>) { return _mm_sub_epi16(a, b); }
+    static Sse sse(Sse a, Sse b, IntLanes<4>) { return _mm_sub_epi32(a, b); }
+    static Sse sse(Sse a, Sse b, IntLanes<8>) { return _mm_sub_epi64(a, b); }
+    OSAL_VECTOR_AVX2 static Avx avx(Avx a, Avx b, FloatLanes) {
+        return _mm256_castps_si256(
+            _mm256_sub_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b)));
+    }
+    OSAL_VECTOR_AVX2 static Avx avx(Avx a, Avx b, DoubleLanes) {
+        return _mm256_castpd_si256(
+            _mm256_sub_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b)));
+    }
+    OSAL_VECTOR_AVX2 static Avx avx(Avx a, Avx b, IntLanes<1>) {
+        return _mm256_sub_epi8(a, b);
+    }
+    OSAL_VECTOR_AVX2 static Avx avx(Avx a, Avx b, IntLanes<2>) {
+        return _mm256_sub_epi16(a, b);
+    }
+    OSAL_VECTOR_AVX2 static Avx avx(Avx a, Avx b, IntLanes<4>) {
+        return _mm256_sub_epi32(a, b);
+    }
+    OSAL_VECTOR_AVX2 static Avx avx(Avx a, Avx b, IntLanes<8>) {
+        return _mm256_sub_epi64(a, b);
+    }
+};
+
+/// Multiplication has host SIMD instructions only for floating point and
+/// 16-bit lanes in SSE2.
+struct MulSimd {
+    static Sse sse(Sse a, Sse b, FloatLanes) {
+        return _mm_castps_si128(
+            _mm_mul_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+    }
+    static Sse sse(Sse a, Sse b, DoubleLanes) {
+        return _mm_castpd_si128(
+            _mm_mul_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+    }
+    static Sse sse(Sse a, Sse b, IntLanes<2>) {
+        return _mm_mullo_epi16(a, b);
+    }
+    OSAL_VECTOR_AVX2 static Avx avx(Avx a, Avx b, FloatLanes) {
+        return _mm256_castps_si256(
+            _mm256_mul_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b)));
+    }
+    OSAL_VECTOR_AVX2 static Avx avx(Avx a, Avx b, DoubleLanes) {
+        return _mm256_castpd_si256(
+            _mm256_mul_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b)));
+    }
+    OSAL_VECTOR_AVX2 static Avx avx(Avx a, Avx b, IntLanes<2>) {
+        return _mm256_mullo_epi16(a, b);
+    }
+};
+#endif
+
+template <typename T>
+struct Add {
+    typedef typename Arithmetic<T>::Type A;
+    static T scalar(T a, T b) { return T(A(a) + A(b)); }
+#ifdef OSAL_VECTOR_X86
+    static const bool SIMD = true;
+    static Sse sse(Sse a, Sse b) {
+        return AddSimd::sse(a, b, typename LaneKind<T>::Type());
+    }
+    OSAL_VECTOR_AVX2 static Avx avx(Avx a, Avx b) {
+        return AddSimd::avx(a, b, typename LaneKind<T>::Type());
+    }
+#endif
+};
+
+template <typename T>
+struct Sub {
+    typedef typename Arithmetic<T>::Type A;
+    static T scalar(T a, T b) { return T(A(a) - A(b)); }
+#ifdef OSAL_VECTOR_X86
+    static const bool SIMD = true;
+    static Sse sse(Sse a, Sse b) {
+        return SubSimd::sse(a, b, typename LaneKind<T>::Type());
+    }
+    OSAL_VECTOR_AVX2 static Avx avx(Avx a, Avx b) {
+        return SubSimd::avx(a, b, typename LaneKind<T>::Type());
+    }
+#endif
+};
+
+/**
+ * Other lane types than floating point and 16-bit integers use the lane
+ * loop.
+ */
+template <typename T>
+struct Mul {
+    typedef typename Arithmetic<T>::Product P;
+    static T scalar(T a, T b) { return T(P(a) * P(b)); }
+#ifdef OSAL_VECTOR_X86
+    static const bool SIMD =
+        std::is_floating_point<T>::value || sizeof(T) == 2;
+    static Sse sse(Sse a, Sse b) {
+        return MulSimd::sse(a, b, typename LaneKind<T>::Type());
+    }
+    OSAL_VECTOR_AVX2 static Avx avx(Avx a, Avx b) {
+        return MulSimd::avx(a, b, typename LaneKind<T>::Type());
+    }
+#endif
+};
+
+template <typename T>
+struct And {
+    static T scalar(T a, T b) { return a & b; }
+#ifdef OSAL_VECTOR_X86
+    static const bool SIMD = true;
+    static Sse sse(Sse a, Sse b) { return _mm_and_si128(a, b); }
+    OSAL_VECTOR_AVX2 static Avx avx(Avx a, Avx b) {
+        return _mm256_and_si256(a, b);
+    }
+#endif
+};
+
+template <typename T>
+struct Ior {
+    static T scalar(T a, T b) { return a | b; }
+#ifdef OSAL_VECTOR_X86
+    static const bool SIMD = true;
+    static Sse sse(Sse a, Sse b) { return _mm_or_si128(a, b); }
+    OSAL_VECTOR_AVX2 static Avx avx(Avx a, Avx b) {
+        return _mm256_or_si256(a, b);
+    }
+#endif
+};
+
+template <typename T>
+struct Xor {
+    static T scalar(T a, T b) { return a ^ b; }
+#ifdef OSAL_VECTOR_X86
+    static const bool SIMD = true;
+    static Sse sse(Sse a, Sse b) { return _mm_xor_si128(a, b); }
+    OSAL_VECTOR_AVX2 static Avx avx(Avx a, Avx b) {
+        return _mm256_xor_si256(a, b);
+    }
+#endif
+};
+
+}
+
+#ifdef OSAL_VECTOR_X86
+/**
+ * Returns true if the simulation host supports AVX2.
+ */
+inline bool
+hostHasAVX2() {
+    static const bool hasAVX2 =
+        (__builtin_cpu_init(), __builtin_cpu_supports("avx2"));
+    return hasAVX2;
+}
+
+/**
+ * Computes the operation for the leading 32-byte chunks with AVX2.
+ *
+ * @return The number of bytes computed.
+ */
+template <typename Op>
+OSAL_VECTOR_AVX2 inline std::size_t
+applyAVX2(const Byte* in1, const Byte* in2, Byte* out, std::size_t bytes) {
+    std::size_t i = 0;
+    for (; i + sizeof(__m256i) <= bytes; i += sizeof(__m256i)) {
+        __m256i a = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(in1 + i));
+        __m256i b = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(in2 + i));
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i*>(out + i), Op::avx(a, b));
+    }
+    return i;
+}
+
+/**
+ * Computes the operation for the leading 16-byte chunks with SSE2.
+ *
+ * @return The number of bytes computed.
+ */
+template <typename Op>
+inline std::size_t
+applySSE2(const Byte* in1, const Byte* in2, Byte* out, std::size_t bytes) {
+    std::size_t i = 0;
+    for (; i + sizeof(__m128i) <= bytes; i += sizeof(__m128i)) {
+        __m128i a = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(in1 + i));
+        __m128i b = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(in2 + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), Op::sse(a, b));
+    }
+    return i;
+}
+
+/**
+ * Computes the operation for the leading lanes with host SIMD
+ * instructions.
+ *
+ * @return The number of lanes computed.
+ */
+template <typename Op>
+inline std::size_t
+applySIMD(
+    const SimValue& in1, const SimValue& in2, SimValue& out,
+    std::size_t bytes, std::true_type) {
+    std::size_t done = 0;
+    if (hostHasAVX2()) {
+        done = applyAVX2<Op>(
+            in1.rawData_, in2.rawData_, out.rawData_, bytes);
+    }
+    done += applySSE2<Op>(
+        in1.rawData_ + done, in2.rawData_ + done, out.rawData_ + done,
+        bytes - done);
+    return done;
+}
+
+/**
+ * Operations without host SIMD instructions compute no lanes here.
+ */
+template <typename Op>
+inline std::size_t
+applySIMD(
+    const SimValue&, const SimValue&, SimValue&, std::size_t,
+    std::false_type) {
+    return 0;
+}
+#endif
+
+/**
+ * Computes one of the operations in Ops for each lane of the output.
+ *
+ * The lanes are computed with host SIMD instructions when available and
+ * the rest, if any, one lane at a time.
+ */
+template <typename T, template <typename> class Op>
+inline void
+apply(const SimValue& in1, const SimValue& in2, SimValue& out) {
+    const std::size_t lanes = laneCount<T>(out);
+    std::size_t done = 0;
+#ifdef OSAL_VECTOR_X86
+    done = applySIMD<Op<T> >(
+        in1, in2, out, lanes * sizeof(T),
+        std::integral_constant<bool, Op<T>::SIMD>()) / sizeof(T);
+#endif
+    for (std::size_t i = done; i < lanes; ++i) {
+        setLane<T>(
+            out.rawData_, i,
+            Op<T>::scalar(lane<T>(in1.rawData_, i), lane<T>(in2.rawData_, i)));
+    }
+}
+
+template <typename T>
+inline void
+add(const SimValue& in1, const SimValue& in2, SimValue& out) {
+    apply<T, Ops::Add>(in1, in2, out);
+}
+
+template <typename T>
+inline void
+sub(const SimValue& in1, const SimValue& in2, SimValue& out) {
+    apply<T, Ops::Sub>(in1, in2, out);
+}
+
+template <typename T>
+inline void
+mul(const SimValue& in1, const SimValue& in2, SimValue& out) {
+    apply<T, Ops::Mul>(in1, in2, out);
+}
+
+template <typename T>
+inline void
+bitAnd(const SimValue& in1, const SimValue& in2, SimValue& out) {
+    apply<T, Ops::And>(in1, in2, out);
+}
+
+template <typename T>
+inline void
+bitOr(const SimValue& in1, const SimValue& in2, SimValue& out) {
+    apply<T, Ops::Ior>(in1, in2, out);
+}
+
+template <typename T>
+inline void
+bitXor(const SimValue& in1, const SimValue& in2, SimValue& out) {
+    apply<T, Ops::Xor>(in1, in2, out);
+}
+
+}
+
+#endif
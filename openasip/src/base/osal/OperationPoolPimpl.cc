@@ -33,6 +33,7 @@
 
 #include <string>
 #include <vector>
+#include <mutex>
 
 #include "OperationPool.hh"
 #include "OperationModule.hh"
@@ -68,11 +69,13 @@ using std::string;
 OperationPoolPimpl::OperationTable OperationPoolPimpl::operationCache_;
 OperationIndex* OperationPoolPimpl::index_(NULL);
 const llvm::MCInstrInfo* OperationPoolPimpl::llvmTargetInstrInfo_(NULL);
+std::recursive_mutex OperationPoolPimpl::cacheLock_;
 
 /**
  * The constructor
  */
 OperationPoolPimpl::OperationPoolPimpl() {
+    std::lock_guard<std::recursive_mutex> lock(cacheLock_);
     // if this is a first created instance of OperationPool,
     // initialize the OperationIndex instance with the search paths
     if (index_ == NULL) {
@@ -98,6 +101,7 @@ OperationPoolPimpl::~OperationPoolPimpl() {
  */
 void
 OperationPoolPimpl::cleanupCache() {
+    std::lock_guard<std::recursive_mutex> lock(cacheLock_);
     AssocTools::deleteAllValues(operationCache_);
     delete index_;
     index_ = NULL;
@@ -115,6 +119,8 @@ OperationPoolPimpl::cleanupCache() {
 Operation&
 OperationPoolPimpl::operation(const char* name) {
 
+    // the pool may be shared by threads scheduling different functions.
+    std::lock_guard<std::recursive_mutex> lock(cacheLock_);
     OperationTable::iterator it =
         operationCache_.find(StringTools::stringToLower(name));
     if (it != operationCache_.end()) {
@@ -219,6 +225,7 @@ bool
 OperationPoolPimpl::sharesState(const Operation& op) {
     if (op.affectsCount() > 0 || op.affectedByCount() > 0)
         return true;
+    std::lock_guard<std::recursive_mutex> lock(cacheLock_);
     for (const auto& entry : operationCache_) {
         const Operation& other = *entry.second;
         if (other.dependsOn(op))
@@ -36,6 +36,7 @@
 #include "OperationContext.hh"
 #include "OperationPool.hh"
 #include "RISCVFields.hh"
+#include "RISCVInstructionExecutor.hh"
 #include "RISCVTools.hh"
 
 namespace RISCVInstructionExecutor {
@@ -46,21 +47,13 @@ std::map<std::string, int> customOps = {};
 std::unique_ptr<OperationPool> pool = nullptr;
 
 /**
- * Helper function that executes an OSAL instruction.
+ * Helper function that finds an OSAL operation with a behavior.
  *
- * Takes in the opName, instruction width, and the inputs, and returns the
- * output vector.
- *
- * @param opName operation to be executed
- * @param width instruction width (typically 32 or 64)
- * @param inputs array of input values
- * @param inputsCount number of values in the inputs array
- * @return vector of SimValue objects.
+ * @param opName operation to be found
+ * @return The operation.
  */
-std::vector<SimValue>
-executeInstructionHelper(
-    const char* opName, uint8_t width, const uint64_t* inputs,
-    int inputsCount) {
+Operation&
+findOperation(const char* opName) {
     if (RISCVInstructionExecutor::pool == nullptr) {
         RISCVInstructionExecutor::pool = std::make_unique<OperationPool>();
     }
@@ -81,50 +74,123 @@ executeInstructionHelper(
                         "implementation found for operation '") +
             opName + "'");
     }
+    return op;
+}
 
-    OperationContext opContext(opName);
-    behavior.createState(opContext);
+}  // namespace RISCVInstructionExecutor
+
+/**
+ * An operation resolved for repeated execution.
+ *
+ * Holds the operand values so that executing the operation needs no
+ * operation lookup or memory allocation.
+ */
+struct RISCVOperationHandle {
+    explicit RISCVOperationHandle(Operation& op)
+        : behavior(op.behavior()), context(op.name()),
+          inputs(op.numberOfInputs()), outputs(op.numberOfOutputs()),
+          values(inputs + outputs), valuePtrs(inputs + outputs), width(0) {
+        for (int i = 0; i < inputs + outputs; ++i) {
+            valuePtrs[i] = &values[i];
+        }
+    }
+
+    /// The behavior of the operation.
+    OperationBehavior& behavior;
+    /// The context the operation is executed in.
+    OperationContext context;
+    /// Number of inputs of the operation.
+    const int inputs;
+    /// Number of outputs of the operation.
+    const int outputs;
+    /// The input values followed by the output values.
+    std::vector<SimValue> values;
+    /// Pointers to the values, given to the behavior.
+    std::vector<SimValue*> valuePtrs;
+    /// Current bit width of the values.
+    int width;
+};
+
+namespace RISCVInstructionExecutor {
+
+/**
+ * Helper function that executes a resolved OSAL operation.
+ *
+ * The results are left to the output values of the handle.
+ *
+ * @param handle the resolved operation
+ * @param width instruction width (typically 32 or 64)
+ * @param inputs array of input values
+ * @param inputsCount number of values in the inputs array
+ */
+template <typename T>
+void
+executeHandle(
+    RISCVOperationHandle& handle, int width, const T* inputs,
+    uint32_t inputsCount) {
 
-    if (inputsCount < op.numberOfInputs()) {
-        behavior.deleteState(opContext);
+    if (inputsCount < static_cast<uint32_t>(handle.inputs)) {
         THROW_EXCEPTION(
             IllegalParameters,
             std::string("ExecuteInstruction error: Not enough input values"));
     }
 
-    const int opInputs = op.numberOfInputs();
-    const int opOutputs = op.numberOfOutputs();
-    const int opValues = opInputs + opOutputs;
-
-    std::vector<std::unique_ptr<SimValue>> simValues(opValues);
-
-    for (int i = 0; i < opInputs; ++i) {
-        simValues[i] = std::make_unique<SimValue>(inputs[i], width);
+    if (handle.width != width) {
+        for (size_t i = 0; i < handle.values.size(); ++i) {
+            handle.values[i].setBitWidth(width);
+        }
+        handle.width = width;
     }
-    for (int i = 0; i < opOutputs; ++i) {
-        simValues[opInputs + i] = std::make_unique<SimValue>(0, width);
+    for (int i = 0; i < handle.inputs; ++i) {
+        handle.values[i] = static_cast<ULongWord>(inputs[i]);
     }
-
-    std::vector<SimValue*> simValPtrs(opValues);
-    for (int i = 0; i < opValues; ++i) {
-        simValPtrs[i] = simValues[i].get();
+    for (int i = 0; i < handle.outputs; ++i) {
+        handle.values[handle.inputs + i] = ULongWord(0);
     }
 
-    if (!behavior.simulateTrigger(simValPtrs.data(), opContext)) {
-        behavior.deleteState(opContext);
+    handle.behavior.createState(handle.context);
+    bool ready = false;
+    try {
+        ready = handle.behavior.simulateTrigger(
+            handle.valuePtrs.data(), handle.context);
+    } catch (...) {
+        // the context is reused by the next execution of the handle
+        handle.behavior.deleteState(handle.context);
+        throw;
+    }
+    handle.behavior.deleteState(handle.context);
+    if (!ready) {
         THROW_EXCEPTION(
             ModuleRunTimeError,
             std::string(
                 "ExecuteInstruction error: operation execution failed"));
     }
+}
 
-    std::vector<SimValue> results(opOutputs);
-    for (int i = 0; i < opOutputs; i++) {
-        results[i] = *simValues[opInputs + i];
+/**
+ * Helper function that executes a resolved operation several times.
+ *
+ * @param handle the resolved operation
+ * @param width instruction width (typically 32 or 64)
+ * @param inputs inputsCount input values for each execution
+ * @param inputsCount number of input values for each execution
+ * @param executions number of executions
+ * @param outputs the output values of each execution are stored here
+ */
+template <typename T>
+void
+executeHandleBatch(
+    RISCVOperationHandle& handle, int width, const T* inputs,
+    uint32_t inputsCount, uint32_t executions, T* outputs) {
+
+    for (uint32_t e = 0; e < executions; ++e) {
+        executeHandle(handle, width, inputs + e * inputsCount, inputsCount);
+        T* output = outputs + e * handle.outputs;
+        for (int i = 0; i < handle.outputs; ++i) {
+            output[i] = static_cast<T>(
+                handle.values[handle.inputs + i].uLongWordValue());
+        }
     }
-
-    behavior.deleteState(opContext);
-    return results;
 }
 
 }  // namespace RISCVInstructionExecutor
@@ -295,16 +361,12 @@ executeInstruction32(
     }
 
     try {
-        std::vector<uint64_t> inputs64(inputsCount);
-        for (uint32_t i = 0; i < inputsCount; i++) {
-            inputs64[i] = static_cast<uint64_t>(inputs[i]);
-        }
-
-        std::vector<SimValue> results =
-            RISCVInstructionExecutor::executeInstructionHelper(
-                opName, 32, inputs64.data(), inputsCount);
-        for (size_t i = 0; i < results.size(); i++) {
-            output[i] = results.at(i).uIntWordValue();
+        RISCVOperationHandle handle(
+            RISCVInstructionExecutor::findOperation(opName));
+        RISCVInstructionExecutor::executeHandle(
+            handle, 32, inputs, inputsCount);
+        for (int i = 0; i < handle.outputs; i++) {
+            output[i] = handle.values[handle.inputs + i].uIntWordValue();
         }
         return 0;
     } catch (Exception& e) {
@@ -344,12 +406,179 @@ executeInstruction64(
     }
 
     try {
-        std::vector<SimValue> results =
-            RISCVInstructionExecutor::executeInstructionHelper(
-                opName, 64, inputs, inputsCount);
-        for (size_t i = 0; i < results.size(); i++) {
-            output[i] = results.at(i).uLongWordValue();
+        RISCVOperationHandle handle(
+            RISCVInstructionExecutor::findOperation(opName));
+        RISCVInstructionExecutor::executeHandle(
+            handle, 64, inputs, inputsCount);
+        for (int i = 0; i < handle.outputs; i++) {
+            output[i] = handle.values[handle.inputs + i].uLongWordValue();
+        }
+        return 0;
+    } catch (Exception& e) {
+        if (error != nullptr) {
+            *error = strdup(e.errorMessage().c_str());
+        }
+        return -1;
+    }
+}
+
+/**
+ * Resolves an operation for repeated execution.
+ *
+ * The operation is searched like in executeInstruction32(). Executing the
+ * returned handle with executeOperation32(), executeOperation64() or
+ * their batch versions needs no operation lookup or memory allocation.
+ * A handle must not be used by several threads at the same time.
+ *
+ * @param opName The operation name as it is in the machine file.
+ * @param handle The resolved operation. Must be released with
+ * releaseOperation() by the client.
+ * @param error Will not be touched in case of success. Must be freed by
+ * the client.
+ * @return 0 on success, -1 on failure.
+ */
+int
+resolveOperation(
+    const char* opName, RISCVOperationHandle** handle, char** error) {
+    if (handle == nullptr) {
+        if (error != nullptr) {
+            *error =
+                strdup("ResolveOperation error: Handle parameter is null");
+        }
+        return -1;
+    }
+
+    try {
+        *handle = new RISCVOperationHandle(
+            RISCVInstructionExecutor::findOperation(opName));
+        return 0;
+    } catch (Exception& e) {
+        if (error != nullptr) {
+            *error = strdup(e.errorMessage().c_str());
         }
+        return -1;
+    }
+}
+
+/**
+ * Releases an operation handle returned by resolveOperation().
+ *
+ * @param handle The handle to release, can be null.
+ */
+void
+releaseOperation(RISCVOperationHandle* handle) {
+    delete handle;
+}
+
+/**
+ * Returns the number of output values of a resolved operation.
+ *
+ * This is the number of values stored per execution by the execute
+ * functions.
+ */
+uint32_t
+operationOutputCount(const RISCVOperationHandle* handle) {
+    return handle != nullptr ? handle->outputs : 0;
+}
+
+/**
+ * Executes a resolved custom 32-wide instruction.
+ *
+ * @param handle The operation resolved with resolveOperation().
+ * @param inputs Input value(s) of the operation. Can contain more values
+ * than the operation needs, in that case only the first values will be
+ * used.
+ * @param inputsCount number of inputs
+ * @param output The results of the operation.
+ * @param error Will not be touched in case of success. Must be freed by
+ * the client.
+ * @return 0 on success, -1 on failure.
+ */
+int
+executeOperation32(
+    RISCVOperationHandle* handle, const uint32_t* inputs,
+    uint32_t inputsCount, uint32_t* output, char** error) {
+    return executeOperationBatch32(
+        handle, inputs, inputsCount, 1, output, error);
+}
+
+/**
+ * Executes a resolved custom 64-wide instruction.
+ *
+ * @see executeOperation32()
+ */
+int
+executeOperation64(
+    RISCVOperationHandle* handle, const uint64_t* inputs,
+    uint32_t inputsCount, uint64_t* output, char** error) {
+    return executeOperationBatch64(
+        handle, inputs, inputsCount, 1, output, error);
+}
+
+/**
+ * Executes a resolved custom 32-wide instruction several times.
+ *
+ * The executions are done in order and stop at the first failing one.
+ *
+ * @param handle The operation resolved with resolveOperation().
+ * @param inputs The input values of the executions one after another,
+ * inputsCount values for each.
+ * @param inputsCount number of inputs for each execution
+ * @param executions number of executions
+ * @param outputs The results of the executions one after another,
+ * operationOutputCount() values for each.
+ * @param error Will not be touched in case of success. Must be freed by
+ * the client.
+ * @return 0 on success, -1 on failure.
+ */
+int
+executeOperationBatch32(
+    RISCVOperationHandle* handle, const uint32_t* inputs,
+    uint32_t inputsCount, uint32_t executions, uint32_t* outputs,
+    char** error) {
+    if (handle == nullptr || outputs == nullptr) {
+        if (error != nullptr) {
+            *error = strdup(
+                "ExecuteOperation32 error: Handle or output parameter is "
+                "null");
+        }
+        return -1;
+    }
+
+    try {
+        RISCVInstructionExecutor::executeHandleBatch(
+            *handle, 32, inputs, inputsCount, executions, outputs);
+        return 0;
+    } catch (Exception& e) {
+        if (error != nullptr) {
+            *error = strdup(e.errorMessage().c_str());
+        }
+        return -1;
+    }
+}
+
+/**
+ * Executes a resolved custom 64-wide instruction several times.
+ *
+ * @see executeOperationBatch32()
+ */
+int
+executeOperationBatch64(
+    RISCVOperationHandle* handle, const uint64_t* inputs,
+    uint32_t inputsCount, uint32_t executions, uint64_t* outputs,
+    char** error) {
+    if (handle == nullptr || outputs == nullptr) {
+        if (error != nullptr) {
+            *error = strdup(
+                "ExecuteOperation64 error: Handle or output parameter is "
+                "null");
+        }
+        return -1;
+    }
+
+    try {
+        RISCVInstructionExecutor::executeHandleBatch(
+            *handle, 64, inputs, inputsCount, executions, outputs);
         return 0;
     } catch (Exception& e) {
         if (error != nullptr) {
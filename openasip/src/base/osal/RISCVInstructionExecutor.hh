@@ -31,6 +31,9 @@
 
 extern "C" {
 
+/// An operation resolved for repeated execution.
+typedef struct RISCVOperationHandle RISCVOperationHandle;
+
 int initializeMachine(const char* machinePath, char** error);
 
 int resetMachine();
@@ -44,6 +47,31 @@ int executeInstruction32(
 int executeInstruction64(
     const char* opName, const uint64_t* inputs, uint32_t inputsCount,
     uint64_t* output, char** error);
+
+int resolveOperation(
+    const char* opName, RISCVOperationHandle** handle, char** error);
+
+void releaseOperation(RISCVOperationHandle* handle);
+
+uint32_t operationOutputCount(const RISCVOperationHandle* handle);
+
+int executeOperation32(
+    RISCVOperationHandle* handle, const uint32_t* inputs,
+    uint32_t inputsCount, uint32_t* output, char** error);
+
+int executeOperation64(
+    RISCVOperationHandle* handle, const uint64_t* inputs,
+    uint32_t inputsCount, uint64_t* output, char** error);
+
+int executeOperationBatch32(
+    RISCVOperationHandle* handle, const uint32_t* inputs,
+    uint32_t inputsCount, uint32_t executions, uint32_t* outputs,
+    char** error);
+
+int executeOperationBatch64(
+    RISCVOperationHandle* handle, const uint64_t* inputs,
+    uint32_t inputsCount, uint32_t executions, uint64_t* outputs,
+    char** error);
 }
 
 #endif
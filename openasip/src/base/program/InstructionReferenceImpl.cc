@@ -151,6 +151,19 @@ void
 InstructionReferenceImpl::setInstruction(Instruction& ins) {
     ins_ = &ins;
 }
+
+/**
+ * Sets the manager owning this object.
+ * 
+ * This method should be only called by InstructionReferenceManager.
+ *
+ * @param irm The new owner.
+ */
+void 
+InstructionReferenceImpl::setReferenceManager(
+    InstructionReferenceManager& irm) {
+    refMan_ = &irm;
+}
     
 /**
  * Returns a reference pointing into instruction handled by this object.
@@ -57,6 +57,7 @@ public:
     bool removeRef(InstructionReference& ref);
     InstructionReferenceManager& referencemanager();
     void setInstruction(Instruction& ins);
+    void setReferenceManager(InstructionReferenceManager& irm);
     void merge(InstructionReferenceImpl& other);
     inline Instruction& instruction();
     inline unsigned int count();
@@ -170,6 +170,35 @@ InstructionReferenceManager::referenceDied(Instruction* ins) {
     references_.erase(iter);
 }
 
+/**
+ * Moves all the instruction references of this manager to another one.
+ *
+ * Used for merging references into code that was built apart from the
+ * rest of the program into the manager of the program. This manager is
+ * left empty.
+ *
+ * @param target The manager to move the references to.
+ */
+void
+InstructionReferenceManager::moveReferencesTo(
+    InstructionReferenceManager& target) {
+
+    RefMap moved;
+    moved.swap(references_);
+    for (RefMap::iterator iter = moved.begin(); iter != moved.end(); iter++) {
+        RefMap::iterator existing = target.references_.find(iter->first);
+        if (existing == target.references_.end()) {
+            iter->second->setReferenceManager(target);
+            target.references_[iter->first] = iter->second;
+        } else {
+            // the moved impl dies in this manager once all its references
+            // point to the existing one.
+            references_[iter->first] = iter->second;
+            existing->second->merge(*iter->second);
+        }
+    }
+}
+
 /**
  * Performs sanity checks to the instruction references.
  *
@@ -93,6 +93,7 @@ public:
     bool hasReference(Instruction& ins) const;
     unsigned int referenceCount(Instruction& ins) const;
     void referenceDied(Instruction* ins);
+    void moveReferencesTo(InstructionReferenceManager& target);
 
     void validate();
 
@@ -32,7 +32,10 @@
  */
 
 #include <string>
+#include <set>
 #include <sstream>
+#include <thread>
+#include <algorithm>
 #include <boost/format.hpp>
 
 #include "POMDisassembler.hh"
@@ -56,6 +59,7 @@
 #include "UnboundedRegisterFile.hh"
 #include "Guard.hh"
 #include "Machine.hh"
+#include "AddressSpace.hh"
 #include "TCEString.hh"
 #include "InstructionReference.hh"
 #include "Move.hh"
@@ -102,7 +106,8 @@ using namespace TTAProgram;
  *                       the end of instruction lines as comments.
  */
 POMDisassembler::POMDisassembler(const Program& program, bool printAddresses) :
-    program_(program), printAddresses_(printAddresses) {
+    program_(program), printAddresses_(printAddresses),
+    labelIndexBuilt_(false) {
 }
 
 /**
@@ -113,7 +118,8 @@ POMDisassembler::POMDisassembler(const Program& program, bool printAddresses) :
  *                       the end of instruction lines as comments.
  */
 POMDisassembler::POMDisassembler(bool printAddresses) :
-    program_(NullProgram::instance()), printAddresses_(printAddresses) {
+    program_(NullProgram::instance()), printAddresses_(printAddresses),
+    labelIndexBuilt_(false) {
 }
 
 
@@ -842,6 +848,17 @@ POMDisassembler::destinationLabels(
 
     std::stringstream stringStream;
     InstructionAddress addr = proc.startAddress().location() + instrIndex;
+    if (labelIndexBuilt_ && &proc.parent() == &program_) {
+        LabelIndex::const_iterator labels = labelIndex_.find(addr);
+        if (labels != labelIndex_.end()) {
+            for (unsigned int i = 0; i < labels->second.size(); ++i) {
+                stringStream
+                    << labelPositionDescription(labels->second[i])
+                    << std::endl;
+            }
+        }
+        return stringStream.str();
+    }
     const int lc = POMDisassembler::labelCount(proc.parent(), addr);
     for (int labelIndex = 0; labelIndex < lc; ++labelIndex) {
         stringStream
@@ -887,12 +904,170 @@ POMDisassembler::disassembleProcedures() {
 
     std::stringstream stringStream;
 
+    buildLabelIndex();
+    try {
+        for (int procIndex = 0; procIndex < program_.procedureCount();
+             ++procIndex) {
+            const Procedure& proc = program_.procedureAtIndex(procIndex);
+            stringStream << disassembleProcedure(proc);
+        }
+    } catch (...) {
+        clearLabelIndex();
+        throw;
+    }
+    clearLabelIndex();
+    return stringStream.str();
+}
+
+/**
+ * Writes the disassembly of all procedures to a stream.
+ *
+ * The output is the same as the one of disassembleProcedures(). The
+ * procedures are split to chunks of consecutive procedures which are
+ * disassembled by a group of threads at a time. The chunks of a group
+ * are written in order as soon as the group is ready, so the disassembly
+ * of the whole program is never kept in memory.
+ *
+ * @param output The stream to write to.
+ * @param threadCount The number of threads to use, 0 for the number of
+ *        hardware threads.
+ * @param chunkInstructions The minimum number of instructions in a chunk.
+ * @exception Exception Can leak exceptions if the traversed program is
+ * malformed, etc.
+ */
+void
+POMDisassembler::disassembleProcedures(
+    std::ostream& output, unsigned int threadCount, int chunkInstructions) {
+
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // the instruction addresses are cached lazily, compute them before
+    // the threads read them
     for (int procIndex = 0; procIndex < program_.procedureCount();
          ++procIndex) {
         const Procedure& proc = program_.procedureAtIndex(procIndex);
-        stringStream << disassembleProcedure(proc);
+        for (int i = 0; i < proc.instructionCount(); ++i) {
+            proc.instructionAtIndex(i).address();
+        }
     }
-    return stringStream.str();
+
+    std::vector<int> chunkStarts;
+    int chunkSize = chunkInstructions;
+    for (int procIndex = 0; procIndex < program_.procedureCount();
+         ++procIndex) {
+        if (chunkSize >= chunkInstructions) {
+            chunkStarts.push_back(procIndex);
+            chunkSize = 0;
+        }
+        chunkSize += program_.procedureAtIndex(procIndex).instructionCount();
+    }
+    chunkStarts.push_back(program_.procedureCount());
+    const unsigned int chunkCount = chunkStarts.size() - 1;
+
+    buildLabelIndex();
+    std::vector<std::string> texts(threadCount);
+    std::vector<std::exception_ptr> errors(threadCount);
+    for (unsigned int first = 0; first < chunkCount; first += threadCount) {
+        const unsigned int count = std::min(threadCount, chunkCount - first);
+        std::vector<std::thread> threads;
+        for (unsigned int i = 0; i < count; ++i) {
+            errors[i] = std::exception_ptr();
+            if (i > 0) {
+                threads.push_back(
+                    std::thread(
+                        &POMDisassembler::disassembleProcedureRange, this,
+                        chunkStarts[first + i], chunkStarts[first + i + 1],
+                        std::ref(texts[i]), std::ref(errors[i])));
+            }
+        }
+        disassembleProcedureRange(
+            chunkStarts[first], chunkStarts[first + 1], texts[0], errors[0]);
+        for (unsigned int i = 0; i < threads.size(); ++i) {
+            threads[i].join();
+        }
+        for (unsigned int i = 0; i < count; ++i) {
+            if (errors[i]) {
+                clearLabelIndex();
+                std::rethrow_exception(errors[i]);
+            }
+            output << texts[i];
+        }
+    }
+    clearLabelIndex();
+}
+
+/**
+ * Disassembles a range of procedures of the program.
+ *
+ * Exceptions are stored instead of thrown, this is run in a thread.
+ *
+ * @param firstProc Index of the first procedure.
+ * @param lastProc Index past the last procedure.
+ * @param text The disassembly is stored here.
+ * @param error Set to the exception thrown by the disassembly, if any.
+ */
+void
+POMDisassembler::disassembleProcedureRange(
+    int firstProc, int lastProc, std::string& text,
+    std::exception_ptr& error) {
+
+    try {
+        std::string result;
+        for (int procIndex = firstProc; procIndex < lastProc; ++procIndex) {
+            result += disassembleProcedure(
+                program_.procedureAtIndex(procIndex));
+        }
+        text.swap(result);
+    } catch (...) {
+        error = std::current_exception();
+    }
+}
+
+/**
+ * Collects the instruction labels of the program by address.
+ *
+ * The labels at an address are the ones label() returns for it, so
+ * destinationLabels() can use the index instead of scanning all the
+ * labels and procedures of the program for each instruction.
+ */
+void
+POMDisassembler::buildLabelIndex() {
+
+    labelIndex_.clear();
+    const AddressSpace& space = program_.startAddress().space();
+    const GlobalScope& scope = program_.globalScopeConst();
+    for (int i = 0; i < scope.globalCodeLabelCount(); ++i) {
+        const CodeLabel& label = scope.globalCodeLabel(i);
+        if (&label.address().space() == &space) {
+            labelIndex_[label.address().location()].push_back(label.name());
+        }
+    }
+
+    // a procedure name replaces a single label at its start address
+    std::set<Word> procedureStarts;
+    for (int i = 0; i < program_.procedureCount(); ++i) {
+        const Procedure& proc = program_.procedureAtIndex(i);
+        Word start = proc.startAddress().location();
+        if (!procedureStarts.insert(start).second) {
+            continue;
+        }
+        std::vector<std::string>& labels = labelIndex_[start];
+        if (labels.size() <= 1) {
+            labels.assign(1, proc.name());
+        }
+    }
+    labelIndexBuilt_ = true;
+}
+
+/**
+ * Stops using the label index, the program might change after this.
+ */
+void
+POMDisassembler::clearLabelIndex() {
+    labelIndex_.clear();
+    labelIndexBuilt_ = false;
 }
 
 /**
@@ -1026,6 +1201,8 @@ POMDisassembler::disassembler(
 }
 
 
+const int POMDisassembler::CHUNK_INSTRUCTIONS = 4096;
+
 TCEString
 POMDisassembler::printAddress(const TTAProgram::Instruction& instr) const {
     return TCEString("\t# @") << instr.address().location();
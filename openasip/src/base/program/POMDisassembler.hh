@@ -35,6 +35,12 @@
 #ifndef TTA_POM_DISASSEMBLER_HH
 #define TTA_POM_DISASSEMBLER_HH
 
+#include <exception>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
 #include "BaseType.hh"
 #include "Exception.hh"
 
@@ -104,6 +110,9 @@ public:
         int addr = -1);
     virtual TCEString disassembleProcedure(const TTAProgram::Procedure& proc);
     virtual TCEString disassembleProcedures();
+    void disassembleProcedures(
+        std::ostream& output, unsigned int threadCount,
+        int chunkInstructions = CHUNK_INSTRUCTIONS);
     virtual TCEString disassembleProgram();
     virtual TCEString codeSectionDescription(Word startAddress);
     virtual TCEString dataSectionDescription(
@@ -133,6 +142,15 @@ protected:
     /// True if instruction indices (addresses) should be printed at the end of lines.
     bool printAddresses_;
 private:
+    /// Labels of the program by instruction address.
+    typedef std::map<Word, std::vector<std::string> > LabelIndex;
+
+    void buildLabelIndex();
+    void clearLabelIndex();
+    void disassembleProcedureRange(
+        int firstProc, int lastProc, std::string& text,
+        std::exception_ptr& error);
+
     static int labelCount(const TTAProgram::Program& program, Word address);
     static std::string label(
         const TTAProgram::Program&, Word address, int index);
@@ -155,5 +173,13 @@ private:
         const TTAProgram::Terminal& terminal);
 
     static bool isCallOrJump(const TTAProgram::Terminal& terminal);
+
+    /// Labels of program_ while disassembling all of its procedures.
+    LabelIndex labelIndex_;
+    /// True if labelIndex_ is in use.
+    bool labelIndexBuilt_;
+    /// Default minimum number of instructions in a chunk of procedures
+    /// disassembled by one thread.
+    static const int CHUNK_INSTRUCTIONS;
 };
 #endif
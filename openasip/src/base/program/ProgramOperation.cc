@@ -838,7 +838,7 @@ ProgramOperation::hasConstantOperand() const {
     return false;
 }
 
-unsigned int ProgramOperation::idCounter = 0;
+std::atomic<unsigned int> ProgramOperation::idCounter(0);
 
 const TTAMachine::FunctionUnit*
 ProgramOperation::fuFromOutMove(const MoveNode& outputNode) const {
@@ -46,24 +46,52 @@ using std::copy;
 using std::list;
 using std::map;
 using ReferenceManager::SafePointer;
+using ReferenceManager::ActiveReferenceContext;
 
 /**
  * Constructor.
  */
 Binary::Binary() :
-    strings_(&SafePointer::null), tpefVersion_(TPEFHeaders::TPEF_V2) {
+    strings_(&SafePointer::null), tpefVersion_(TPEFHeaders::TPEF_V2),
+    referenceContext_(NULL) {
 }
 
 /**
  * Destructor.
+ *
+ * If the binary owns a reference context, the sections are deleted in it
+ * and only its bookkeeping is freed.
  */
 Binary::~Binary() {
-    while (sections_.size() != 0) {
-        delete sections_[sections_.size() - 1];
-        sections_[sections_.size() - 1] = NULL;
-        sections_.pop_back();
+    {
+        ActiveReferenceContext active(referenceContext_);
+        while (sections_.size() != 0) {
+            delete sections_[sections_.size() - 1];
+            sections_[sections_.size() - 1] = NULL;
+            sections_.pop_back();
+        }
+    }
+
+    if (referenceContext_ != NULL) {
+        delete referenceContext_;
+        referenceContext_ = NULL;
+    } else {
+        SafePointer::cleanup();
     }
-    SafePointer::cleanup();
+}
+
+/**
+ * Sets the reference context that holds the references of the binary.
+ *
+ * The binary takes the ownership of the context and deletes it in its
+ * destructor.
+ *
+ * @param context The context, NULL to use the default context.
+ */
+void
+Binary::setReferenceContext(ReferenceManager::ReferenceContext* context) {
+    assert(referenceContext_ == NULL || referenceContext_ == context);
+    referenceContext_ = context;
 }
 
 }
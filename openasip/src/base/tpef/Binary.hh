@@ -95,6 +95,9 @@ public:
     void setTPEFVersion(TPEFHeaders::TPEFVersion version);
     TPEFHeaders::TPEFVersion TPEFVersion() const;
 
+    ReferenceManager::ReferenceContext* referenceContext() const;
+    void setReferenceContext(ReferenceManager::ReferenceContext* context);
+
 private:
     Binary(const Binary&);
     Binary operator=(const Binary&);
@@ -112,6 +115,10 @@ private:
 
     /// Indicates TPEF format version used.
     TPEFHeaders::TPEFVersion tpefVersion_;
+
+    /// Reference context owned by the binary, NULL if the references of the
+    /// binary are in the default context.
+    ReferenceManager::ReferenceContext* referenceContext_;
 };
 }
 
@@ -48,6 +48,8 @@ namespace TPEF {
 using std::set;
 using std::string;
 using ReferenceManager::SafePointer;
+using ReferenceManager::ReferenceContext;
+using ReferenceManager::ActiveReferenceContext;
 
 // initializes an instance of static member
 set<BinaryReader*>* BinaryReader::prototypes_ = NULL;
@@ -102,9 +104,18 @@ BinaryReader::readBinary(BinaryStream& stream) {
 	        // isMyStreamtype must leave stream as it was
                 assert(stream.readPosition() == startPos);
 
-                SafePointer::cleanupKeyTables();
-
-                Binary *readBinary = (*readers)->readData(stream);
+                // every binary gets references of its own, so reading
+                // does not mix them with references of other binaries
+                ReferenceContext* context = new ReferenceContext();
+                ActiveReferenceContext active(context);
+                Binary* readBinary = NULL;
+                try {
+                    readBinary = (*readers)->readData(stream);
+                } catch (...) {
+                    delete context;
+                    throw;
+                }
+                readBinary->setReferenceContext(context);
 
                 try {
                     SafePointer::resolve();
@@ -143,7 +154,8 @@ BinaryReader::readBinary(BinaryStream& stream) {
                     throw error;
                 }
 
-                // clean up after reading, to avoid abuse of reference manager
+                // clean up after reading, only the resolved references
+                // are kept with the binary
                 SafePointer::cleanupKeyTables();
 
                 return readBinary;
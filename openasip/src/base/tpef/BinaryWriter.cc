@@ -41,6 +41,7 @@
 namespace TPEF {
 
 using ReferenceManager::SafePointer;
+using ReferenceManager::ActiveReferenceContext;
 
 /**
  * Constructor.
@@ -65,6 +66,10 @@ BinaryWriter::writeBinary(BinaryStream& stream, const Binary* bin) const {
 
     assert(writerToUse_ != NULL);
 
+    // the references of a binary that was read from a file are in the
+    // context of the binary
+    ActiveReferenceContext active(bin->referenceContext());
+
     // init referencemanager and replacers
     SafePointer::cleanupKeyTables();
     ValueReplacer::initialize(stream);
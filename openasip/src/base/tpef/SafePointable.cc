@@ -52,7 +52,30 @@ SafePointable::~SafePointable() {
  * Constructor.
  *
  */
-SafePointable::SafePointable() {
+SafePointable::SafePointable() : referenceContext_(NULL) {
+}
+
+/**
+ *
+ * Copy constructor.
+ *
+ * The references to the original object are not references to the copy.
+ *
+ */
+SafePointable::SafePointable(const SafePointable&) :
+    referenceContext_(NULL) {
+}
+
+/**
+ *
+ * Assignment operator.
+ *
+ * Keeps the reference context of the object.
+ *
+ */
+SafePointable&
+SafePointable::operator=(const SafePointable&) {
+    return *this;
 }
 
 }
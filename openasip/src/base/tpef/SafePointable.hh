@@ -41,6 +41,11 @@
 
 namespace TPEF {
 
+namespace ReferenceManager {
+    class SafePointer;
+    class ReferenceContext;
+}
+
 /**
  * All classes that implement the SafePointable interface can be used
  * in reference manager.
@@ -51,7 +56,16 @@ public:
 protected:
     // this is an 'interface' class so we don't want direct instances of it
     SafePointable();
+    SafePointable(const SafePointable& other);
+    SafePointable& operator=(const SafePointable& other);
+
+private:
+    friend class ReferenceManager::SafePointer;
+    friend class ReferenceManager::ReferenceContext;
 
+    /// Context in which the references to the object are kept, NULL if
+    /// the object is not referenced yet.
+    ReferenceManager::ReferenceContext* referenceContext_;
 };
 }
 #endif
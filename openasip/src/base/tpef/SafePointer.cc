@@ -53,23 +53,84 @@ using std::copy;
 namespace TPEF {
 namespace ReferenceManager {
 
-// static member variable initialization
-// These need to be pointers to be able to call SafePointer::cleanup()
-// safely from ~Binary() (which can be from global objects aswell).
-// Otherwise these globals can be freed before the global Binary is 
-// causing invalid free() calls.
-SectionIndexMap* SafePointer::sectionIndexMap_ = new SectionIndexMap;
-SectionOffsetMap* SafePointer::sectionOffsetMap_ = new SectionOffsetMap;
-FileOffsetMap* SafePointer::fileOffsetMap_ = new FileOffsetMap;
-SectionMap* SafePointer::sectionMap_= new SectionMap;
-
-SafePointer::KeyForCacheMap* SafePointer::keyForCache_ = 
-    new SafePointer::KeyForCacheMap;
-
-// These are constructed to heap to make sure they are not
-// destructed before any global or static object.
-ReferenceMap* SafePointer::referenceMap_ = new ReferenceMap;
-SafePointerSet* SafePointer::aliveSafePointers_ = new SafePointerSet;
+// The default context is constructed to heap and never freed to be able to
+// call SafePointer::cleanup() safely from ~Binary() (which can be from
+// global objects aswell). Otherwise it could be freed before the global
+// Binary is causing invalid free() calls.
+ReferenceContext* ReferenceContext::defaultContext_ = new ReferenceContext;
+thread_local ReferenceContext* ReferenceContext::activeContext_ = NULL;
+
+//////////////////////////////////////////////////////////////////////////////
+// ReferenceContext
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Constructor.
+ */
+ReferenceContext::ReferenceContext() {
+}
+
+/**
+ * Destructor.
+ *
+ * Frees the bookkeeping of the context. SafePointers still registered in
+ * the context are detached from it, their references are not updated
+ * anymore.
+ */
+ReferenceContext::~ReferenceContext() {
+    for (ReferenceMap::iterator i = referenceMap_.begin();
+         i != referenceMap_.end(); i++) {
+        const_cast<SafePointable*>(i->first)->referenceContext_ = NULL;
+    }
+    {
+        ActiveReferenceContext active(this);
+        SafePointer::cleanup();
+    }
+    for (SafePointerSet::iterator i = aliveSafePointers_.begin();
+         i != aliveSafePointers_.end(); i++) {
+        (*i)->context_ = NULL;
+    }
+}
+
+/**
+ * Returns the context that is active in the calling thread.
+ *
+ * @return The active context.
+ */
+ReferenceContext&
+ReferenceContext::current() {
+    if (activeContext_ != NULL) {
+        return *activeContext_;
+    }
+    return *defaultContext_;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// ActiveReferenceContext
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Activates the given context in the calling thread.
+ *
+ * @param context Context to activate, if NULL the active context is not
+ * changed.
+ */
+ActiveReferenceContext::ActiveReferenceContext(ReferenceContext* context) :
+    previous_(ReferenceContext::activeContext_), changed_(context != NULL) {
+
+    if (changed_) {
+        ReferenceContext::activeContext_ = context;
+    }
+}
+
+/**
+ * Restores the context that was active before.
+ */
+ActiveReferenceContext::~ActiveReferenceContext() {
+    if (changed_) {
+        ReferenceContext::activeContext_ = previous_;
+    }
+}
 
 //////////////////////////////////////////////////////////////////////////////
 // SafePointerList
@@ -197,9 +258,9 @@ SafePointer::null(static_cast<SafePointable*>(NULL));
  * @param key Key to use while requesting the reference.
  */
 SafePointer::SafePointer(SectionIndexKey key) :
-    object_(NULL) {
+    object_(NULL), context_(&ReferenceContext::current()) {
 
-    genericRegisterPointer(key, *sectionIndexMap_, this);
+    genericRegisterPointer(key, context_->sectionIndexMap_, this);
 }
 
 /**
@@ -208,9 +269,9 @@ SafePointer::SafePointer(SectionIndexKey key) :
  * @param key Key to use while requesting the reference.
  */
 SafePointer::SafePointer(SectionOffsetKey key) :
-    object_(NULL) {
+    object_(NULL), context_(&ReferenceContext::current()) {
 
-    genericRegisterPointer(key, *sectionOffsetMap_, this);
+    genericRegisterPointer(key, context_->sectionOffsetMap_, this);
 }
 
 /**
@@ -219,9 +280,9 @@ SafePointer::SafePointer(SectionOffsetKey key) :
  * @param key Key to use while requesting the reference.
  */
 SafePointer::SafePointer(FileOffsetKey key) :
-    object_(NULL) {
+    object_(NULL), context_(&ReferenceContext::current()) {
 
-    genericRegisterPointer(key, *fileOffsetMap_, this);
+    genericRegisterPointer(key, context_->fileOffsetMap_, this);
 }
 
 /**
@@ -230,21 +291,28 @@ SafePointer::SafePointer(FileOffsetKey key) :
  * @param key Key object to use while requesting the reference.
  */
 SafePointer::SafePointer(SectionKey key) :
-    object_(NULL) {
+    object_(NULL), context_(&ReferenceContext::current()) {
 
-    genericRegisterPointer(key, *sectionMap_, this);
+    genericRegisterPointer(key, context_->sectionMap_, this);
 }
 
 /**
  * Construct a SafePointer using object reference.
  *
+ * The pointer is registered in the context in which the object is
+ * referenced, whichever context is active, so the pointer is updated when
+ * the object is deleted.
+ *
  * @param object Object to use while requesting the reference.
  */
 SafePointer::SafePointer(SafePointable* object) :
-    object_(object) {
+    object_(object), context_(NULL) {
 
     if (object != NULL) {
-        genericRegisterPointer(object, *referenceMap_, this);
+        ActiveReferenceContext active(object->referenceContext_);
+        context_ = &ReferenceContext::current();
+        object->referenceContext_ = context_;
+        genericRegisterPointer(object, context_->referenceMap_, this);
     }
 }
 
@@ -265,10 +333,11 @@ SafePointer::~SafePointer() {
  */
 bool
 SafePointer::isAlive(SafePointer* pointerToCheck) {
+    ReferenceContext& context = ReferenceContext::current();
 
     return
         (pointerToCheck != NULL &&
-         AssocTools::containsKey(*aliveSafePointers_, pointerToCheck));
+         AssocTools::containsKey(context.aliveSafePointers_, pointerToCheck));
 }
 
 /**
@@ -280,12 +349,14 @@ SafePointer::isAlive(SafePointer* pointerToCheck) {
  */
 bool
 SafePointer::isReferenced(const SafePointable* object) {
+    ActiveReferenceContext active(object->referenceContext_);
+    ReferenceContext& context = ReferenceContext::current();
 
-    if (!MapTools::containsKey(*referenceMap_, object)) {
+    if (!MapTools::containsKey(context.referenceMap_, object)) {
         return false;
     }
 
-    SafePointerList* theList = (*referenceMap_)[object];
+    SafePointerList* theList = context.referenceMap_[object];
     theList->cleanupDead();
 
     return (theList->length() > 0);
@@ -304,7 +375,8 @@ SafePointer::isReferenced(const SafePointable* object) {
  */
 void
 SafePointer::addObjectReference(SectionIndexKey key, const SafePointable* obj) {
-    genericAddObjectReference(key, *sectionIndexMap_, obj);
+    genericAddObjectReference(
+        key, ReferenceContext::current().sectionIndexMap_, obj);
 }
 
 /**
@@ -320,7 +392,8 @@ SafePointer::addObjectReference(SectionIndexKey key, const SafePointable* obj) {
 void
 SafePointer::addObjectReference(
     SectionOffsetKey key, const SafePointable* obj) {
-    genericAddObjectReference(key, *sectionOffsetMap_, obj);
+    genericAddObjectReference(
+        key, ReferenceContext::current().sectionOffsetMap_, obj);
 }
 
 /**
@@ -335,7 +408,8 @@ SafePointer::addObjectReference(
  */
 void
 SafePointer::addObjectReference(FileOffsetKey key, const SafePointable* obj) {
-    genericAddObjectReference(key, *fileOffsetMap_, obj);
+    genericAddObjectReference(
+        key, ReferenceContext::current().fileOffsetMap_, obj);
 }
 
 /**
@@ -350,7 +424,8 @@ SafePointer::addObjectReference(FileOffsetKey key, const SafePointable* obj) {
  */
 void
 SafePointer::addObjectReference(SectionKey key, const SafePointable* obj) {
-    genericAddObjectReference(key, *sectionMap_, obj);
+    genericAddObjectReference(
+        key, ReferenceContext::current().sectionMap_, obj);
 }
 
 /**
@@ -364,7 +439,8 @@ SafePointer::addObjectReference(SectionKey key, const SafePointable* obj) {
  */
 SectionIndexKey
 SafePointer::sectionIndexKeyFor(const SafePointable* obj) {
-    return genericKeyFor<SectionIndexKey>(obj, *sectionIndexMap_);
+    return genericKeyFor<SectionIndexKey>(
+        obj, ReferenceContext::current().sectionIndexMap_);
 }
 
 /**
@@ -378,7 +454,8 @@ SafePointer::sectionIndexKeyFor(const SafePointable* obj) {
  */
 SectionOffsetKey
 SafePointer::sectionOffsetKeyFor(const SafePointable* obj) {
-    return genericKeyFor<SectionOffsetKey>(obj, *sectionOffsetMap_);
+    return genericKeyFor<SectionOffsetKey>(
+        obj, ReferenceContext::current().sectionOffsetMap_);
 }
 
 /**
@@ -392,7 +469,8 @@ SafePointer::sectionOffsetKeyFor(const SafePointable* obj) {
  */
 FileOffsetKey
 SafePointer::fileOffsetKeyFor(const SafePointable* obj) {
-    return genericKeyFor<FileOffsetKey>(obj, *fileOffsetMap_);
+    return genericKeyFor<FileOffsetKey>(
+        obj, ReferenceContext::current().fileOffsetMap_);
 }
 
 /**
@@ -406,25 +484,29 @@ SafePointer::fileOffsetKeyFor(const SafePointable* obj) {
  */
 SectionKey
 SafePointer::sectionKeyFor(const SafePointable* obj) {
-    return genericKeyFor<SectionKey>(obj, *sectionMap_);
+    return genericKeyFor<SectionKey>(
+        obj, ReferenceContext::current().sectionMap_);
 }
 
 /**
  * Inform of deletion of an object.
  *
  * All SafePointers that are pointing to the deleted object are set
- * to NULL and the object's entry is removed from the ReferenceMap.
+ * to NULL and the object's entry is removed from the ReferenceMap of the
+ * context in which the object is referenced.
  *
  * @param obj Deleted object.
  */
 void
 SafePointer::notifyDeleted(const SafePointable* obj) {
+    ActiveReferenceContext active(obj->referenceContext_);
+    ReferenceContext& context = ReferenceContext::current();
 
-    if (!MapTools::containsKey(*referenceMap_, obj)) {
+    if (!MapTools::containsKey(context.referenceMap_, obj)) {
         return;
     }
 
-    SafePointerList *listOfObj = (*referenceMap_)[obj];
+    SafePointerList *listOfObj = context.referenceMap_[obj];
 
     assert(listOfObj != NULL);
     listOfObj->cleanup();
@@ -434,14 +516,15 @@ SafePointer::notifyDeleted(const SafePointable* obj) {
 
     // TODO: for hashmap implementation this will take *very* long time
     //       so fix this before change typedefs in SafePointer.hh
-    if (!MapTools::containsValue(*sectionMap_,       listOfObj) &&
-        !MapTools::containsValue(*sectionIndexMap_,  listOfObj) &&
-        !MapTools::containsValue(*sectionOffsetMap_, listOfObj) &&
-        !MapTools::containsValue(*fileOffsetMap_,    listOfObj)) {
+    if (!MapTools::containsValue(context.sectionMap_,       listOfObj) &&
+        !MapTools::containsValue(context.sectionIndexMap_,  listOfObj) &&
+        !MapTools::containsValue(context.sectionOffsetMap_, listOfObj) &&
+        !MapTools::containsValue(context.fileOffsetMap_,    listOfObj)) {
         delete listOfObj;
     }
 
-    referenceMap_->erase(obj);
+    context.referenceMap_.erase(obj);
+    const_cast<SafePointable*>(obj)->referenceContext_ = NULL;
 }
 
 /**
@@ -454,13 +537,15 @@ SafePointer::notifyDeleted(const SafePointable* obj) {
 void
 SafePointer::notifyDeleted(SafePointer* safePointer) {
 
-    // the null safe pointer is an exception, it shouldn't be never deleted
-    if (safePointer == &null) {
+    // the null safe pointer is an exception, it shouldn't be never deleted,
+    // pointers of freed contexts are not registered anywhere anymore
+    if (safePointer == &null || safePointer->context_ == NULL) {
         return;
     }
 
     unsigned int pointersFound = 0;
-    pointersFound = (*aliveSafePointers_).erase(safePointer);
+    pointersFound = safePointer->context_->aliveSafePointers_.erase(
+        safePointer);
     assert(pointersFound == 1);
 }
 
@@ -478,9 +563,11 @@ SafePointer::notifyDeleted(SafePointer* safePointer) {
  */
 void
 SafePointer::resolve() {
+    ReferenceContext& context = ReferenceContext::current();
+
     // try to resolve references in sectionOffsetMap
-    for (SectionOffsetMap::iterator i = sectionOffsetMap_->begin();
-         i != sectionOffsetMap_->end(); i++) {
+    for (SectionOffsetMap::iterator i = context.sectionOffsetMap_.begin();
+         i != context.sectionOffsetMap_.end(); i++) {
 
         SectionOffsetKey key = (*i).first;
 
@@ -489,14 +576,14 @@ SafePointer::resolve() {
         SafePointable* object = l->reference();
 
         // if reference is resolved continue
-        if (MapTools::containsKey(*referenceMap_, object)) {
+        if (MapTools::containsKey(context.referenceMap_, object)) {
             continue;
         }
 
         // there is no section with the identification code of the section
         // offset key
         if (!MapTools::containsKey(
-                *sectionMap_, SectionKey(key.sectionId()))) {
+                context.sectionMap_, SectionKey(key.sectionId()))) {
             std::stringstream errorMessage;
             errorMessage << "Cannot find section with identification code "
                          << key.sectionId() << " in the section map.";
@@ -512,7 +599,7 @@ SafePointer::resolve() {
 
         // try to get the pointer to the section to request chunk from
         SafePointerList* pointersToSection =
-            (*sectionMap_)[SectionKey(key.sectionId())];
+            context.sectionMap_[SectionKey(key.sectionId())];
 
         assert(pointersToSection != NULL);
 
@@ -566,7 +653,7 @@ SafePointer::resolve() {
     const ReferenceKey *unresolvedKey = NULL;
     SafePointer *firstUnresolvedPointerOfList = NULL;
 
-    if (unresolvedReferences(*sectionMap_, &unresolvedKey)) {
+    if (unresolvedReferences(context.sectionMap_, &unresolvedKey)) {
         const SectionKey *sectionKey =
             dynamic_cast<const SectionKey*>(unresolvedKey);
 
@@ -575,10 +662,10 @@ SafePointer::resolve() {
 
         // get first of unresolved pointers in safe pointer list
         firstUnresolvedPointerOfList =
-            (*sectionMap_->find(*sectionKey)).second->front();
+            (*context.sectionMap_.find(*sectionKey)).second->front();
     }
 
-    if (unresolvedReferences(*sectionIndexMap_,  &unresolvedKey)) {
+    if (unresolvedReferences(context.sectionIndexMap_,  &unresolvedKey)) {
         const SectionIndexKey *indexKey =
             dynamic_cast<const SectionIndexKey*>(unresolvedKey);
 
@@ -589,10 +676,10 @@ SafePointer::resolve() {
                      << indexKey->index() << std::endl;
 
         firstUnresolvedPointerOfList =
-            (*sectionIndexMap_->find(*indexKey)).second->front();
+            (*context.sectionIndexMap_.find(*indexKey)).second->front();
     }
 
-    if (unresolvedReferences(*sectionOffsetMap_,  &unresolvedKey)) {
+    if (unresolvedReferences(context.sectionOffsetMap_,  &unresolvedKey)) {
 
         const SectionOffsetKey *sectionOffsetKey =
             dynamic_cast<const SectionOffsetKey*>(unresolvedKey);
@@ -604,10 +691,11 @@ SafePointer::resolve() {
                      << sectionOffsetKey->offset() << std::endl;
 
         firstUnresolvedPointerOfList =
-            (*sectionOffsetMap_->find(*sectionOffsetKey)).second->front();
+            (*context.sectionOffsetMap_.find(
+                *sectionOffsetKey)).second->front();
     }
 
-    if (unresolvedReferences(*fileOffsetMap_,  &unresolvedKey)) {
+    if (unresolvedReferences(context.fileOffsetMap_,  &unresolvedKey)) {
         const FileOffsetKey *fileOffsetKey =
             dynamic_cast<const FileOffsetKey*>(unresolvedKey);
 
@@ -616,7 +704,7 @@ SafePointer::resolve() {
                      << fileOffsetKey->fileOffset() << std::endl;
 
         firstUnresolvedPointerOfList =
-            (*fileOffsetMap_->find(*fileOffsetKey)).second->front();
+            (*context.fileOffsetMap_.find(*fileOffsetKey)).second->front();
     }
 
     if (errorMessage.str() != "") {
@@ -642,32 +730,35 @@ SafePointer::resolve() {
  */
 void
 SafePointer::cleanupKeyTables() {
+    ReferenceContext& context = ReferenceContext::current();
 
     set<SafePointerList*> listsToDelete;
-    safelyCleanupKeyTable(*sectionIndexMap_, listsToDelete);
-    safelyCleanupKeyTable(*sectionOffsetMap_, listsToDelete);
-    safelyCleanupKeyTable(*fileOffsetMap_, listsToDelete);
-    safelyCleanupKeyTable(*sectionMap_, listsToDelete);
+    safelyCleanupKeyTable(context.sectionIndexMap_, listsToDelete);
+    safelyCleanupKeyTable(context.sectionOffsetMap_, listsToDelete);
+    safelyCleanupKeyTable(context.fileOffsetMap_, listsToDelete);
+    safelyCleanupKeyTable(context.sectionMap_, listsToDelete);
 
     AssocTools::deleteAllItems(listsToDelete);
 
     // clear keyForCache...
-    keyForCache_->clear();
+    context.keyForCache_.clear();
 }
 
 /**
- * Frees all dynamically allocated memory consumed in reference managing.
+ * Frees all dynamically allocated memory consumed in reference managing
+ * of the active context.
  *
- * Deletes all entires in all maps, safe pointer lists in them and all
- * alive safe pointers. This method should be called in the destructor of
- * Binary or in the end of the program.
+ * Deletes all entires in all maps and safe pointer lists in them. This
+ * method should be called in the destructor of Binary or in the end of the
+ * program.
  *
  */
 void
 SafePointer::cleanup() {
+    ReferenceContext& context = ReferenceContext::current();
 
     cleanupKeyTables();
-    MapTools::deleteAllValues(*referenceMap_);
+    MapTools::deleteAllValues(context.referenceMap_);
 }
 
 // Debugging methods.......
@@ -678,71 +769,80 @@ SafePointer::cleanup() {
 // functions for testing
 const SectionIndexMap*
 SafePointer::SIMap() {
-    return sectionIndexMap_;
+    return &ReferenceContext::current().sectionIndexMap_;
 }
 
 const SafePointerList*
 SafePointer::SIMapAt(SectionIndexKey k) {
+    ReferenceContext& context = ReferenceContext::current();
+
     // make sure we don't change the map
-    if (MapTools::containsKey(*sectionIndexMap_, k)) {
-        return (*sectionIndexMap_)[k];
+    if (MapTools::containsKey(context.sectionIndexMap_, k)) {
+        return context.sectionIndexMap_[k];
     }
     return NULL;
 }
 
 const SectionOffsetMap*
 SafePointer::SOMap() {
-    return sectionOffsetMap_;
+    return &ReferenceContext::current().sectionOffsetMap_;
 }
 
 const SafePointerList*
 SafePointer::SOMapAt(SectionOffsetKey k) {
+    ReferenceContext& context = ReferenceContext::current();
+
     // make sure we don't change the map
-    if (MapTools::containsKey(*sectionOffsetMap_, k)) {
-        return (*sectionOffsetMap_)[k];
+    if (MapTools::containsKey(context.sectionOffsetMap_, k)) {
+        return context.sectionOffsetMap_[k];
     }
     return NULL;
 }
 
 const FileOffsetMap*
 SafePointer::FOMap() {
-
-    return fileOffsetMap_;
+    return &ReferenceContext::current().fileOffsetMap_;
 }
 
 const SafePointerList*
 SafePointer::FOMapAt(FileOffsetKey k) {
+    ReferenceContext& context = ReferenceContext::current();
+
     // make sure we don't change the map
-    if (MapTools::containsKey(*fileOffsetMap_, k)) {
-        return (*fileOffsetMap_)[k];
+    if (MapTools::containsKey(context.fileOffsetMap_, k)) {
+        return context.fileOffsetMap_[k];
     }
     return NULL;
 }
 
 const ReferenceMap*
 SafePointer::RMap() {
-    return referenceMap_;
+    return &ReferenceContext::current().referenceMap_;
 }
 
 const SafePointerList*
 SafePointer::RMapAt(SafePointable* k) {
+    ReferenceContext& context = ReferenceContext::current();
+
     // make sure we don't change the map
-    if (MapTools::containsKey(*referenceMap_, k)) {
-        return (*referenceMap_)[k];
+    if (MapTools::containsKey(context.referenceMap_, k)) {
+        return context.referenceMap_[k];
     }
     return NULL;
 }
 
 const SectionMap*
 SafePointer::SMap() {
-    return sectionMap_;
+    return &ReferenceContext::current().sectionMap_;
 }
 
 const SafePointerList*
 SafePointer::SMapAt(SectionKey k) {
+    ReferenceContext& context = ReferenceContext::current();
+
     // make sure we don't change the map
-    if (MapTools::containsKey(*sectionMap_, k)) {
-        return (*sectionMap_)[k];
+    if (MapTools::containsKey(context.sectionMap_, k)) {
+        return context.sectionMap_[k];
     }
     return NULL;
 }
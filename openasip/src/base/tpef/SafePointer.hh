@@ -170,6 +170,89 @@ typedef std::map<const SafePointable*, SafePointerList*> ReferenceMap;
 //typedef hash_map<const SafePointable*, SafePointerList*,
 //                 HashFunctions> ReferenceMap;
 
+/// Key type for the keyFor cache, void* is pointer to key map
+/// (sectionMap, sectionOffsetMap, ...).
+typedef std::pair<const SafePointable*, void*> KeyForCacheKey;
+/// Map for the keyFor cache.
+typedef std::map<KeyForCacheKey, const ReferenceKey*> KeyForCacheMap;
+
+///////////////////////////////////////////////////////////////////////////////
+// ReferenceContext
+///////////////////////////////////////////////////////////////////////////////
+/**
+ * Reference bookkeeping of one group of objects, usually of one Binary.
+ *
+ * The static methods of SafePointer work on the context that is active in
+ * the calling thread. Unless another context is activated with
+ * ActiveReferenceContext, that is the process wide default context.
+ * BinaryReader reads every binary into a context of its own, which is owned
+ * and freed by the Binary, so the bookkeeping of different binaries does not
+ * mix and does not grow with the number of binaries read in the process.
+ *
+ * An object is referenced in the context in which it was first referenced.
+ * Later references to the object and its deletion are handled in that
+ * context whichever context is active, so the objects of a binary can be
+ * referenced and deleted without activating its context. Keys can only be
+ * connected to objects of the active context. The objects of one context
+ * must not be used by several threads at the same time.
+ */
+class ReferenceContext {
+public:
+    ReferenceContext();
+    virtual ~ReferenceContext();
+
+    static ReferenceContext& current();
+
+private:
+    friend class SafePointer;
+    friend class ActiveReferenceContext;
+
+    ReferenceContext(const ReferenceContext&) = delete;
+    ReferenceContext& operator=(const ReferenceContext&) = delete;
+
+    /// Map of SafePointers that are requested using SectionIndexKeys.
+    SectionIndexMap sectionIndexMap_;
+    /// Map of SafePointers that are requested using SectionOffsetKeys.
+    SectionOffsetMap sectionOffsetMap_;
+    /// Map of SafePointers that are requested using FileOffsetKeys.
+    FileOffsetMap fileOffsetMap_;
+    /// Map of SafePointers that are requested using SectionKeys.
+    SectionMap sectionMap_;
+    /// Map of SafePointers that have resolved references.
+    ReferenceMap referenceMap_;
+    /// Set that cointains all alive (not deleted) SafePointers of the
+    /// context for extra safety.
+    SafePointerSet aliveSafePointers_;
+    /// Cache to make genericKeyFor function to work O(1) speed after
+    /// first call.
+    KeyForCacheMap keyForCache_;
+
+    /// The process wide default context.
+    static ReferenceContext* defaultContext_;
+    /// The context that is active in the calling thread, NULL if default.
+    static thread_local ReferenceContext* activeContext_;
+};
+
+/**
+ * Activates a ReferenceContext in the calling thread for the lifetime of
+ * the object and restores the previously active one after that.
+ */
+class ActiveReferenceContext {
+public:
+    explicit ActiveReferenceContext(ReferenceContext* context);
+    ~ActiveReferenceContext();
+
+private:
+    ActiveReferenceContext(const ActiveReferenceContext&) = delete;
+    ActiveReferenceContext& operator=(
+        const ActiveReferenceContext&) = delete;
+
+    /// Context that was active before this one, NULL if none.
+    ReferenceContext* previous_;
+    /// True if the active context was changed.
+    bool changed_;
+};
+
 
 ///////////////////////////////////////////////////////////////////////////////
 // SafePointer
@@ -184,6 +267,10 @@ typedef std::map<const SafePointable*, SafePointerList*> ReferenceMap;
  * of keys. These keys refer for example to sections and offsets in source
  * binary file while reading the binary. After the binary is read and the
  * object model of binary is constructed, these keys and keytables have no use.
+ *
+ * Pointers created with keys are kept in the ReferenceContext that is
+ * active in the calling thread. Pointers to objects are kept in the
+ * context of the object.
  */
 class SafePointer {
 public:
@@ -311,39 +398,13 @@ protected:
     SafePointer& operator=(SafePointer&) = delete;
 
 private:
+    friend class ReferenceContext;
 
     /// The reference to the real object.
     SafePointable* object_;
 
-    /// Map of SafePointers that are requested using SectionIndexKeys.
-    static SectionIndexMap* sectionIndexMap_;
-
-    /// Map of SafePointers that are requested using SectionOffsetKeys.
-    static SectionOffsetMap* sectionOffsetMap_;
-
-    /// Map of SafePointers that are requested using FileOffsetKeys.
-    static FileOffsetMap* fileOffsetMap_;
-
-    /// Map of SafePointers that are requested using SectionKeys.
-    static SectionMap* sectionMap_;
-
-    /// Map of SafePointers that have resolved references.
-    static ReferenceMap* referenceMap_;
-
-    /// Set that cointains all alive (not deleted) SafePointers for extra
-    /// safety.
-    static SafePointerSet* aliveSafePointers_;
-
-    // KeyFor cache stuff to make genericKeyFor function to work O(1) speed
-    // after first call
-
-    /// Key type for cache, void* is pointer to key map
-    /// (sectioMap_, sectionOffsetMap, ...)
-    typedef std::pair<const SafePointable*, void*> KeyForCacheKey;
-    typedef std::map<KeyForCacheKey,const ReferenceKey*> KeyForCacheMap;
-
-    /// Map for cache.
-    static KeyForCacheMap* keyForCache_;
+    /// Context the pointer is registered in, NULL if none.
+    ReferenceContext* context_;
 
 #ifndef NDEBUG
     std::string debugString_;
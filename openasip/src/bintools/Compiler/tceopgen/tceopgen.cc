@@ -32,8 +32,13 @@
 
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <set>
+#include <functional>
+#include <filesystem>
+#include <cstdio>
 #include <assert.h>
+#include <unistd.h>
 #include <algorithm>
 #include "OperationPool.hh"
 #include "Operation.hh"
@@ -41,9 +46,14 @@
 #include "OperationIndex.hh"
 #include "Operand.hh"
 #include "Application.hh"
+#include "Environment.hh"
+#include "FileSystem.hh"
 #include "TCEString.hh"
 
 enum mode {NORMAL, FU_ADDRESSABLE, ADDRESSPACE};
+
+/// Identifies the format of the cached headers.
+const std::string CACHE_FILE_HEADER = "OpenASIP tceops.h 1";
 /**
  * Returns a C type string for the given operand type.
  */
@@ -371,6 +381,152 @@ writeParallelRegionMacros(std::ostream& os) {
        << "asm volatile (\".pregion_end\")" << std::endl;
 }
 
+/**
+ * Writes the whole tceops.h header.
+ */
+void
+writeHeader(std::ostream& os) {
+    os << "#ifndef TCE_TCEOPS_H" << std::endl
+       << "#define TCE_TCEOPS_H" << std::endl;
+
+    writeCustomOpMacros(os);
+    //for single output operations generate user friendly wrappers
+    writeFunctionCallWrappers(os);
+    writeParallelRegionMacros(os);
+
+    os << std::endl << "#endif" << std::endl;
+}
+
+/**
+ * Returns a description of the operation definitions the header is
+ * generated from.
+ *
+ * The description lists the OSAL search paths and the operation property
+ * files found in them with their sizes and modification times. It is
+ * cheap to compute as the operation modules are not loaded.
+ */
+std::string
+osalDescription() {
+    std::ostringstream description;
+    description << Application::TCEVersionString() << std::endl;
+    std::vector<std::string> paths = Environment::osalPaths();
+    for (unsigned int i = 0; i < paths.size(); i++) {
+        description << paths[i] << std::endl;
+        std::vector<std::string> modules;
+        FileSystem::globPath(
+            paths[i] + FileSystem::DIRECTORY_SEPARATOR +
+            FileSystem::STRING_WILD_CARD +
+            OperationIndex::PROPERTY_FILE_EXTENSION, modules);
+        for (unsigned int m = 0; m < modules.size(); m++) {
+            std::error_code ec;
+            std::uintmax_t size = std::filesystem::file_size(modules[m], ec);
+            std::filesystem::file_time_type modified =
+                std::filesystem::last_write_time(modules[m], ec);
+            description
+                << modules[m] << " " << size << " "
+                << modified.time_since_epoch().count() << std::endl;
+        }
+    }
+    return description.str();
+}
+
+/**
+ * Reads a header generated earlier from the same operation definitions.
+ *
+ * @param fileName The cache file.
+ * @param description Description of the current operation definitions.
+ * @param header The cached header is stored here.
+ * @return True if the header was found in the cache.
+ */
+bool
+readCachedHeader(
+    const std::string& fileName, const std::string& description,
+    std::string& header) {
+
+    std::ifstream file(fileName.c_str(), std::ios::binary);
+    std::string fileHeader;
+    std::size_t descriptionSize = 0;
+    if (!std::getline(file, fileHeader) || fileHeader != CACHE_FILE_HEADER ||
+        !(file >> descriptionSize) || file.get() != '\n' ||
+        descriptionSize != description.size()) {
+        return false;
+    }
+    std::string fileDescription(descriptionSize, '\0');
+    if (!file.read(&fileDescription[0], descriptionSize) ||
+        fileDescription != description) {
+        return false;
+    }
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    header = contents.str();
+    return !header.empty();
+}
+
+/**
+ * Writes the generated header to the cache.
+ *
+ * The file is written under a temporary name and then renamed so that
+ * concurrent compilations never read a partially written header.
+ *
+ * @param fileName The cache file.
+ * @param description Description of the operation definitions.
+ * @param header The generated header.
+ */
+void
+writeCachedHeader(
+    const std::string& fileName, const std::string& description,
+    const std::string& header) {
+
+    const std::string directory = FileSystem::directoryOfPath(fileName);
+    if (!FileSystem::fileIsDirectory(directory) &&
+        !FileSystem::createDirectory(directory)) {
+        return;
+    }
+    const std::string tempName =
+        fileName + "." + Conversion::toString(getpid()) + ".tmp";
+    std::ofstream file(tempName.c_str(), std::ios::binary);
+    file << CACHE_FILE_HEADER << std::endl
+         << description.size() << std::endl
+         << description << header;
+    file.close();
+    if (!file || std::rename(tempName.c_str(), fileName.c_str()) != 0) {
+        std::remove(tempName.c_str());
+    }
+}
+
+/**
+ * Returns the tceops.h header for the current operation definitions.
+ *
+ * If a cache directory is given, the header is reused from there when
+ * the OSAL search paths and their operation property files have not
+ * changed since it was generated.
+ *
+ * @param cacheDir The cache directory, or an empty string for no cache.
+ * @return The header.
+ */
+std::string
+generateHeader(const std::string& cacheDir) {
+
+    std::string header;
+    if (cacheDir.empty()) {
+        std::ostringstream os;
+        writeHeader(os);
+        return os.str();
+    }
+    const std::string description = osalDescription();
+    std::ostringstream fileName;
+    fileName
+        << cacheDir << FileSystem::DIRECTORY_SEPARATOR << "tceops-"
+        << std::hex << std::hash<std::string>()(description) << ".h";
+    if (!readCachedHeader(fileName.str(), description, header)) {
+        std::ostringstream os;
+        writeHeader(os);
+        header = os.str();
+        writeCachedHeader(fileName.str(), description, header);
+    }
+    return header;
+}
+
 /**
  * tceopgen main function.
  *
@@ -378,42 +534,45 @@ writeParallelRegionMacros(std::ostream& os) {
  */
 int main(int argc, char* argv[]) {
 
-    if (!(argc == 1 || argc == 3) ||
-        (argc == 3 && Conversion::toString(argv[1]) != std::string("-o"))) {
-
+    std::string outputFile;
+    std::string cacheDir;
+    bool validArgs = argc % 2 == 1;
+    for (int i = 1; validArgs && i + 1 < argc; i += 2) {
+        const std::string option = argv[i];
+        if (option == "-o") {
+            outputFile = argv[i + 1];
+        } else if (option == "-c") {
+            cacheDir = argv[i + 1];
+        } else {
+            validArgs = false;
+        }
+    }
+    if (!validArgs) {
         std::cout << "Usage: tceopgen" << std::endl
-                  << "   -o Output File." << std::endl;
+                  << "   -o Output File." << std::endl
+                  << "   -c Cache directory for reusing headers generated "
+                  << "earlier." << std::endl;
         return EXIT_FAILURE;
     }
 
-
     std::ostream* outStream = NULL;
     std::ofstream* customFile = NULL;
 
-    if (argc == 1) {
+    if (outputFile.empty()) {
         outStream = &std::cout;
-    } else if (argc == 3) {
+    } else {
         customFile = new std::ofstream();
-        customFile->open(argv[2]);
+        customFile->open(outputFile.c_str());
         if (!customFile->good()) {
-            std::cerr << "Error opening '" << argv[2]
+            std::cerr << "Error opening '" << outputFile
                       << "' for writing." << std::endl;
+            delete customFile;
             return EXIT_FAILURE;
         }       
         outStream = customFile;
-    } else  {
-        assert(false);
     }
 
-    *outStream << "#ifndef TCE_TCEOPS_H" << std::endl
-              << "#define TCE_TCEOPS_H" << std::endl;
-
-    writeCustomOpMacros(*outStream);
-    //for single output operations generate user friendly wrappers
-    writeFunctionCallWrappers(*outStream);
-    writeParallelRegionMacros(*outStream);
-
-    *outStream << std::endl << "#endif" << std::endl;
+    *outStream << generateHeader(cacheDir);
 
     if (customFile != NULL) {
         customFile->close();
@@ -422,4 +581,3 @@ int main(int argc, char* argv[]) {
 
     return EXIT_SUCCESS;   
 }
-
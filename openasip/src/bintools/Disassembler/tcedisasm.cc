@@ -34,6 +34,7 @@
 #include <iostream>
 #include <fstream>
 #include <map>
+#include <vector>
 #include "CmdLineOptions.hh"
 #include "BinaryReader.hh"
 #include "Binary.hh"
@@ -54,6 +55,9 @@ using std::cout;
 using std::cerr;
 using std::endl;
 
+/// Size of the output file buffer.
+const std::size_t OUTPUT_BUFFER_SIZE = 1 << 20;
+
 /**
  * Commandline options.
  */
@@ -79,10 +83,16 @@ public:
             new BoolCmdLineOptionParser(
                 "stdout", "Print to standard output","s");
 
+        IntegerCmdLineOptionParser* threads =
+            new IntegerCmdLineOptionParser(
+                "threads", "Number of threads disassembling the code, "
+                "default is the number of hardware threads", "j");
+
         addOption(lineNumbers);
         addOption(outputFile);
         addOption(flatFile);
         addOption(toStdout);
+        addOption(threads);
     }
 
     std::string outputFile() {
@@ -105,6 +115,12 @@ public:
         return findOption("stdout")->isFlagOn();
     }
 
+    unsigned int threadCount() {
+        CmdLineOptionParser* option = findOption("threads");
+        return option->isDefined() && option->integer() > 0 ?
+            option->integer() : 0;
+    }
+
     void printVersion() const {
         std::cout << "tcedisasm - OpenASIP TTA parallel disassembler " 
                   << Application::TCEVersionString() << std::endl;
@@ -186,7 +202,11 @@ int main(int argc, char *argv[]) {
     }
 
     std::ostream* output = &std::cout;
+    // the disassembly is written in large blocks, the buffer must outlive
+    // the stream which flushes it when destroyed
+    std::vector<char> fileBuffer(OUTPUT_BUFFER_SIZE);
     std::fstream file;
+    file.rdbuf()->pubsetbuf(&fileBuffer[0], fileBuffer.size());
     std::string outputFileName = 
         options.outputFileDefined() ? 
         options.outputFile() : inputFileName + ".S";
@@ -212,12 +232,12 @@ int main(int argc, char *argv[]) {
     POMDisassembler disassembler(*program);
     Word first = disassembler.startAddress();
     if (!options.flatFile()) {
-        *output << "CODE " << first << " ;" << endl << endl;
+        *output << "CODE " << first << " ;\n\n";
         try {
-            *output << POMDisassembler::disassemble(
-                *program, options.lineNumbers())
-                    << endl << endl;
-
+            disassembler.setPrintAddresses(options.lineNumbers());
+            disassembler.disassembleProcedures(
+                *output, options.threadCount());
+            *output << "\n\n";
         } catch (Exception& e) {
             std::cerr << "Disassebly failed because of exception: " <<
                 e.errorMessage() << std::endl;
@@ -233,7 +253,7 @@ int main(int argc, char *argv[]) {
 
             *output << "DATA " << aSpace.name() << " "
                     << mem.dataDefinition(0).startAddress().location()
-                    << " ;" << endl;
+                    << " ;\n";
 
             // Definitions are put in a map to order them.
             // TODO: the indexing API of DataMemory could be used for this?
@@ -251,16 +271,16 @@ int main(int argc, char *argv[]) {
 
             for (; iter != definitions.end(); iter++) {
                 const TTAProgram::DataDefinition* def = (*iter).second;
-                *output << endl << "DA " << std::dec << def->size();
+                *output << "\nDA " << std::dec << def->size();
                 if (def->isInitialized())  {
                     for (int mau = 0; mau < def->size(); mau++) {
-                        *output << endl << "1:0x" << std::hex << def->MAU(mau);
+                        *output << "\n1:0x" << std::hex << def->MAU(mau);
                     }
                 }
-                *output << " ;" << endl;
+                *output << " ;\n";
             }
         }
-        *output << endl;
+        *output << "\n";
     } else {
         // assumes instruction addresses always start from 0
         TTAProgram::Program::InstructionVector instr =
@@ -269,9 +289,10 @@ int main(int argc, char *argv[]) {
                  instr.begin(); i != instr.end(); ++i) {
             *output 
                 << POMDisassembler::disassemble(**i, options.lineNumbers())
-                << std::endl;
+                << "\n";
         }
     }  
+    output->flush();
 
     return 0;
 }
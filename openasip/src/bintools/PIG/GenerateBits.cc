@@ -37,6 +37,8 @@
 
 #include <iostream>
 #include <cmath>
+#include <memory>
+#include <set>
 
 #include <boost/format.hpp>
 
@@ -53,6 +55,7 @@
 #include "BinaryStream.hh"
 #include "BinaryReader.hh"
 #include "FileSystem.hh"
+#include "StringTools.hh"
 
 using std::cerr;
 using std::endl;
@@ -146,12 +149,18 @@ isInstructionMemory(const TTAMachine::AddressSpace& as) {
 /**
  * Returns the name of the program's imem image file for the given TPEF file.
  *
+ * When several formats are generated in the same run, the formats that
+ * share the .img ending get the format name in the file name.
+ *
  * @param tpefFile Name of the TPEF file.
  * @param format The image output format
+ * @param formatInName Tells whether to add the format to the file name.
  * @return Name of the program image file.
  */
 std::string
-programImemImageFile(const std::string& tpefFile, const std::string& format) {
+programImemImageFile(
+    const std::string& tpefFile, const std::string& format,
+    bool formatInName) {
 
     string imageFile = FileSystem::fileNameBody(tpefFile);
     if (format == "mif") {
@@ -161,6 +170,8 @@ programImemImageFile(const std::string& tpefFile, const std::string& format) {
         imageFile += "_imem_pkg.vhdl";
     } else if (format == "coe") {
         imageFile += ".coe";
+    } else if (formatInName && format != "") {
+        imageFile += "_" + format + ".img";
     } else {
         imageFile += ".img";
     }  
@@ -194,6 +205,47 @@ programDataImageFile(
     return imageFile;
 }
 
+/**
+ * Tells whether the given string names an image output format.
+ *
+ * @param format The format given on the command line.
+ * @return True if the format is known, empty string included.
+ */
+static bool
+isImageFormat(const std::string& format) {
+    return format == "" || format == "binary" || format == "ascii" ||
+        format == "array" || format == "mif" || format == "vhdl" ||
+        format == "coe" || format == "hex" || format == "bin2n";
+}
+
+/**
+ * Returns the image output format of the given format name.
+ *
+ * @param format The format given on the command line.
+ * @return The output format, ASCII for the empty string.
+ */
+static ProgramImageGenerator::OutputFormat
+imageFormat(const std::string& format) {
+    if (format == "binary") {
+        return ProgramImageGenerator::BINARY;
+    } else if (format == "array") {
+        return ProgramImageGenerator::ARRAY;
+    } else if (format == "mif") {
+        return ProgramImageGenerator::MIF;
+    } else if (format == "vhdl") {
+        return ProgramImageGenerator::VHDL;
+    } else if (format == "coe") {
+        return ProgramImageGenerator::COE;
+    } else if (format == "hex") {
+        return ProgramImageGenerator::HEX;
+    } else if (format == "bin2n") {
+        return ProgramImageGenerator::BIN2N;
+    } else {
+        assert(format == "ascii" || format == "");
+        return ProgramImageGenerator::ASCII;
+    }
+}
+
 /**
  * Parses the given parameter which has form 'paramname=paramvalue" to
  * different strings.
@@ -319,7 +371,14 @@ int main(int argc, char* argv[]) {
     }
     
     string bemFile = options->bemFile();
-    string piFormat = options->programImageOutputFormat();
+    // several program image formats can be given separated by commas,
+    // each program is then encoded once for all of them
+    std::vector<string> piFormats;
+    StringTools::chopString(
+        options->programImageOutputFormat(), ",", piFormats);
+    if (piFormats.empty()) {
+        piFormats.push_back("");
+    }
     string diFormat = options->dataImageOutputFormat();
     int dmemMAUsPerLine = options->dataMemoryWidthInMAUs();
     string compressor = options->compressorPlugin();
@@ -370,17 +429,26 @@ int main(int argc, char* argv[]) {
         compressorParams.push_back(newParam);
     }
     
-    if (adfFile == "" || 
-        (piFormat != "" && piFormat != "binary" && piFormat != "ascii" &&
-         piFormat != "array" && piFormat != "mif" && piFormat != "vhdl" &&
-         piFormat != "coe" && piFormat != "hex" && piFormat != "bin2n") ||
-        (diFormat != "" && diFormat != "binary" &&
-         diFormat != "ascii" && diFormat != "array" && diFormat != "mif" &&
-         diFormat != "vhdl" && diFormat != "coe" && diFormat != "hex" && diFormat != "bin2n")) {
+    bool validFormats = isImageFormat(diFormat);
+    for (size_t i = 0; i < piFormats.size(); i++) {
+        validFormats = validFormats && isImageFormat(piFormats[i]);
+    }
+    if (adfFile == "" || !validFormats) {
         options->printHelp();
         return EXIT_FAILURE;
     }
 
+    // a format given twice would open its image file twice, the empty
+    // format is the same as ascii
+    std::vector<string> uniqueFormats;
+    std::set<ProgramImageGenerator::OutputFormat> seenFormats;
+    for (size_t i = 0; i < piFormats.size(); i++) {
+        if (seenFormats.insert(imageFormat(piFormats[i])).second) {
+            uniqueFormats.push_back(piFormats[i]);
+        }
+    }
+    piFormats.swap(uniqueFormats);
+
     std::vector<Binary*> tpefTable;        
     ProgramImageGenerator::TPEFMap tpefMap;
     try {
@@ -432,45 +500,31 @@ int main(int argc, char* argv[]) {
 
             Binary* program = tpefTable[i];
             string tpefFile = FileSystem::fileOfPath(options->tpefFile(i));
-            string imageFile = programImemImageFile(tpefFile, piFormat);
-            ofstream piStream(imageFile.c_str());
-            if (piFormat == "binary") {
-                imageGenerator.generateProgramImage(
-                    tpefFile, piStream, ProgramImageGenerator::BINARY);
-            } else if (piFormat == "array") {
-                imageGenerator.generateProgramImage(
-                    tpefFile, piStream, ProgramImageGenerator::ARRAY,
-                    imemMAUsPerLine);
-            } else if (piFormat == "mif") {
-                imageGenerator.generateProgramImage(
-                    tpefFile, piStream, ProgramImageGenerator::MIF,
-                    imemMAUsPerLine);
-            } else if (piFormat == "vhdl") {
-                imageGenerator.generateProgramImage(
-                    tpefFile, piStream, ProgramImageGenerator::VHDL,
-                    imemMAUsPerLine);
-            } else if (piFormat == "coe") {
-                imageGenerator.generateProgramImage(
-                    tpefFile, piStream, ProgramImageGenerator::COE,
-                    imemMAUsPerLine);
-            } else if (piFormat == "hex") {
-                imageGenerator.generateProgramImage(
-                    tpefFile, piStream, ProgramImageGenerator::HEX,
-                    imemMAUsPerLine);
-	    } else if (piFormat == "bin2n") {
-                imageGenerator.generateProgramImage(
-                    tpefFile, piStream, ProgramImageGenerator::BIN2N,
-                    imemMAUsPerLine);
-            } else {
-                assert(piFormat == "ascii" || piFormat == "");
-                imageGenerator.generateProgramImage(
-                    tpefFile, piStream, ProgramImageGenerator::ASCII,
-                    imemMAUsPerLine);
+            const bool formatInName = piFormats.size() > 1;
+            std::vector<std::unique_ptr<ofstream> > piStreams;
+            ProgramImageGenerator::ImageStreamList images;
+            for (size_t f = 0; f < piFormats.size(); f++) {
+                string imageFile = programImemImageFile(
+                    tpefFile, piFormats[f], formatInName);
+                piStreams.push_back(
+                    std::unique_ptr<ofstream>(
+                        new ofstream(imageFile.c_str())));
+                images.push_back(
+                    ProgramImageGenerator::ImageStream(
+                        imageFormat(piFormats[f]), piStreams.back().get()));
             }
-            piStream.close();
-
-            if (piFormat == "ascii" || piFormat == "") {
-                copyImageToTb(imageFile, progeOutputDir, TB_IMEM_FILE);
+            imageGenerator.generateProgramImages(
+                tpefFile, images, imemMAUsPerLine, 0);
+            // close the images before copying them
+            piStreams.clear();
+
+            for (size_t f = 0; f < piFormats.size(); f++) {
+                if (piFormats[f] == "ascii" || piFormats[f] == "") {
+                    copyImageToTb(
+                        programImemImageFile(
+                            tpefFile, piFormats[f], formatInName),
+                        progeOutputDir, TB_IMEM_FILE);
+                }
             }
 
             if (generateDataImages) {
@@ -483,50 +537,15 @@ int main(int argc, char* argv[]) {
                             programDataImageFile(
                                 tpefFile, diFormat, as->name());
                         ofstream stream(fileName.c_str());
-                        if (diFormat == "binary") {
-                            imageGenerator.generateDataImage(
-                                tpefFile, *program, as->name(), stream,
-                                ProgramImageGenerator::BINARY, 1, true);
-                        } else if (diFormat == "array") {
-                            imageGenerator.generateDataImage(
-                                tpefFile, *program, as->name(), stream,
-                                ProgramImageGenerator::ARRAY,
-                                dmemMAUsPerLine, true);
-                        } else if (diFormat == "mif") {
-                            imageGenerator.generateDataImage(
-                                tpefFile, *program, as->name(), stream,
-                                ProgramImageGenerator::MIF,
-                                dmemMAUsPerLine, true);
-                        } else if (diFormat == "vhdl") {
-                            imageGenerator.generateDataImage(
-                                tpefFile, *program, as->name(), stream,
-                                ProgramImageGenerator::VHDL,
-                                dmemMAUsPerLine, true);
-                        } else if (diFormat == "coe") {
-                            imageGenerator.generateDataImage(
-                                tpefFile, *program, as->name(), stream,
-                                ProgramImageGenerator::COE,
-                                dmemMAUsPerLine, true);
-                        } else if (diFormat == "hex") {
-                            imageGenerator.generateDataImage(
-                                tpefFile, *program, as->name(), stream,
-                                ProgramImageGenerator::HEX,
-                                dmemMAUsPerLine, true);
-                        } else if (diFormat == "bin2n") {
-                            imageGenerator.generateDataImage(
-                                tpefFile, *program, as->name(), stream,
-                                ProgramImageGenerator::BIN2N,
-                                dmemMAUsPerLine, true);
-                        } else {
-                            assert(diFormat == "ascii" || diFormat == "");
-                            imageGenerator.generateDataImage(
-                                tpefFile, *program, as->name(), stream,
-                                ProgramImageGenerator::ASCII,
-                                dmemMAUsPerLine, true);
-                        }
+                        ProgramImageGenerator::OutputFormat format =
+                            imageFormat(diFormat);
+                        imageGenerator.generateDataImage(
+                            tpefFile, *program, as->name(), stream, format,
+                            format == ProgramImageGenerator::BINARY ?
+                            1 : dmemMAUsPerLine, true);
                         stream.close();
 
-                        if (diFormat == "ascii" || piFormat == "") {
+                        if (diFormat == "ascii" || diFormat == "") {
                             std::string dmemInitFile("dmem_");
                             dmemInitFile += as->name() + "_init.img";
                             copyImageToTb(
@@ -73,7 +73,8 @@ PIGCmdLineOptions::PIGCmdLineOptions() : CmdLineOptions("") {
     StringCmdLineOptionParser* piOutputMode = new StringCmdLineOptionParser(
         PI_FORMAT_PARAM_NAME,
         "The output format of program image(s) ('ascii', 'array', 'mif', "
-        "'coe', 'vhdl', 'hex', 'binary' or 'bin2n'). Default is 'ascii'.",
+        "'coe', 'vhdl', 'hex', 'binary' or 'bin2n'). Default is 'ascii'. "
+        "Several formats can be given separated by commas.",
         "f");
     addOption(piOutputMode);
 
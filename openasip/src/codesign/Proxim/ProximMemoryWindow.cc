@@ -44,6 +44,7 @@
 #include "ProximSimulationThread.hh"
 #include "Machine.hh"
 #include "MemoryProxy.hh"
+#include "SharedMemory.hh"
 #include "Conversion.hh"
 
 BEGIN_EVENT_TABLE(ProximMemoryWindow, ProximSimulatorWindow)
@@ -191,8 +192,13 @@ ProximMemoryWindow::onSimulationStop(wxEvent&) {
     memoryControl_->clearHighlights();
 
     MemorySystem& memorySystem = simulator_->memorySystem();
-    MemoryProxy* mem = dynamic_cast<MemoryProxy*>(
-        memorySystem.memory(asChoice_->GetSelection()).get());
+    Memory* tracked = memorySystem.memory(asChoice_->GetSelection()).get();
+    // the proxy of a shared address space is wrapped by the shared memory
+    SharedMemory* shared = dynamic_cast<SharedMemory*>(tracked);
+    if (shared != NULL) {
+        tracked = &shared->storage();
+    }
+    MemoryProxy* mem = dynamic_cast<MemoryProxy*>(tracked);
 
     if (mem != NULL) {
 
@@ -78,8 +78,15 @@ int main(int argc, char* argv[]) {
 
     bool verbose = options.verbose();
     bool leaveDirty = options.leaveDirty();
+    int jobs = options.jobs();
+    if (jobs < 0) {
+        std::cerr << "Number of jobs must not be negative" << std::endl;
+        options.printHelp();
+        return EXIT_FAILURE;
+    }
 
-    HDBTester tester(std::cout, std::cerr, sim, verbose, leaveDirty);
+    HDBTester tester(
+        std::cout, std::cerr, sim, verbose, leaveDirty, jobs);
     
     bool testAll = true;
     if (options.isFUEntryIDGiven()) {
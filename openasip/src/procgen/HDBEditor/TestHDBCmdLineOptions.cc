@@ -41,6 +41,7 @@ const std::string TestHDBCmdLineOptions::RF_ID_PARAM_NAME = "rfid";
 const std::string TestHDBCmdLineOptions::VERBOSE_PARAM_NAME = "verbose";
 const std::string TestHDBCmdLineOptions::DIRTY_PARAM_NAME = "leave-dirty";
 const std::string TestHDBCmdLineOptions::SIM_PARAM_NAME = "simulator";
+const std::string TestHDBCmdLineOptions::JOBS_PARAM_NAME = "jobs";
 
 /**
  * The constructor.
@@ -70,6 +71,12 @@ TestHDBCmdLineOptions::TestHDBCmdLineOptions(): CmdLineOptions("") {
             "Accepted values are 'ghdl' and 'modelsim'. Default is ghdl",
             "s");
     addOption(simulator);
+    IntegerCmdLineOptionParser* jobs =
+        new IntegerCmdLineOptionParser(
+            JOBS_PARAM_NAME, "Number of entries simulated in parallel when "
+            "the whole HDB is tested. 0 uses one per processor core. "
+            "Default is 1.", "j");
+    addOption(jobs);
 }
 
 /**
@@ -158,6 +165,19 @@ std::string TestHDBCmdLineOptions::vhdlSim() const {
     return option->String();
 }
 
+/** 
+ * Returns the number of entries simulated in parallel
+ *
+ * @return The number of parallel jobs, 1 if not given
+ */
+int TestHDBCmdLineOptions::jobs() const {
+    CmdLineOptionParser* option = findOption(JOBS_PARAM_NAME);
+    if (!option->isDefined()) {
+        return 1;
+    }
+    return option->integer();
+}
+
 /**
  * Prints the version of the application.
  */
@@ -57,6 +57,8 @@ public:
 
     std::string vhdlSim() const;
 
+    int jobs() const;
+
     virtual void printVersion() const;
     virtual void printHelp() const;
 
@@ -71,6 +73,8 @@ private:
     static const std::string DIRTY_PARAM_NAME;
     /// Long name of VHDL simulator parameter
     static const std::string SIM_PARAM_NAME;
+    /// Long name of parallel jobs parameter
+    static const std::string JOBS_PARAM_NAME;
 };
 
 #endif
@@ -1095,6 +1095,29 @@ Environment::llvmtceCachePath() {
     return path;
 }
 
+/**
+ * Returns full path to the directory for caching the FU conflict detection
+ * state machines of the simulator.
+ *
+ * The default directory can be overridden with the environment variable
+ * TTASIM_FSA_CACHE.
+ */
+string
+Environment::fsaCachePath() {
+
+    std::string path = environmentVariable("TTASIM_FSA_CACHE");
+    if (path != "") {
+        return path;
+    }
+    path =
+        FileSystem::homeDirectory() +
+        FileSystem::DIRECTORY_SEPARATOR + string(".openasip") +
+        FileSystem::DIRECTORY_SEPARATOR + string("ttasim") +
+        FileSystem::DIRECTORY_SEPARATOR + string("fsa");
+
+    return path;
+}
+
 /**
  * Finds a first match of a given list of files from PATH env variable.
  *
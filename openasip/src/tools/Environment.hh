@@ -94,6 +94,7 @@ public:
     static std::string defaultTextEditorPath();
 
     static std::string llvmtceCachePath();
+    static std::string fsaCachePath();
 
     static std::vector<std::string> implementationTesterTemplatePaths();
     static std::string simTraceDirPath();
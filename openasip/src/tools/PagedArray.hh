@@ -78,7 +78,8 @@ public:
     PagedArray(std::size_t size);
     virtual ~PagedArray();
 
-    void write(IndexType index, const ValueTable data, std::size_t size);
+    void write(IndexType index, const ValueType* data, std::size_t size);
+    void fill(IndexType index, const ValueType& value, std::size_t size);
     void writeData(IndexType index, const ValueType& data);
     ValueType readData(IndexType index);
     void read(IndexType index, ValueVector& data, size_t size);
@@ -92,6 +93,7 @@ public:
 
 private:
     void deletePages();
+    ValueType* allocatePage(std::size_t pageIndex);
 
     /// Storage for the data pages.
     /// Created pages are stored in table from which they are found
@@ -30,6 +30,7 @@
 
 #include <cassert>
 #include "Reversible.hh"
+#include "ReversibleArena.hh"
 
 /** Delete the undo information. cannot revert after this */
 Reversible::~Reversible() {
@@ -39,7 +40,7 @@ Reversible::~Reversible() {
 
 /** Delete children without reverting them.
     They cannot be reverted after this */
-void Reversible::deleteChildren(std::stack<Reversible*>& children) {
+void Reversible::deleteChildren(UndoStack& children) {
     while (!children.empty()) {
         Reversible* child = children.top();
         assert(child != nullptr);
@@ -52,7 +53,7 @@ void Reversible::deleteChildren(std::stack<Reversible*>& children) {
  * Undoes one stack of children.
  */
 void
-Reversible::undoAndRemoveChildren(std::stack<Reversible*>& children) {
+Reversible::undoAndRemoveChildren(UndoStack& children) {
     while (!children.empty()) {
         Reversible* child = children.top();
         assert(child != nullptr);
@@ -106,7 +107,7 @@ Reversible::undoOnlyMe() {}
  * @return true if running child succeeded, false if failed.
  */
 bool
-Reversible::runChild(std::stack<Reversible*>& children, Reversible* child) {
+Reversible::runChild(UndoStack& children, Reversible* child) {
     if ((*child)()) {
         children.push(child);
         return true;
@@ -156,4 +157,34 @@ bool Reversible::runChild(Reversible* child, bool pre) {
     }
 }
 
-int Reversible::idCounter_ = 0;
+/**
+ * Allocates the record from the arena of the calling thread.
+ */
+void*
+Reversible::operator new(std::size_t size) {
+    return ReversibleArena::instance().allocate(size);
+}
+
+/**
+ * Returns the record to the arena of the calling thread.
+ */
+void
+Reversible::operator delete(void* record, std::size_t size) {
+    ReversibleArena::instance().deallocate(record, size);
+}
+
+/**
+ * Releases the memory of all records of the calling thread at once.
+ *
+ * Should be called when the undo information has been deleted, for
+ * example when the schedule of a basic block has been committed.
+ *
+ * @return True in case the memory was released, false if there were
+ *         still live records.
+ */
+bool
+Reversible::releaseMemory() {
+    return ReversibleArena::instance().release();
+}
+
+std::atomic<int> Reversible::idCounter_(0);
@@ -31,35 +31,71 @@
 #ifndef TTA_REVERSIBLE_HH
 #define TTA_REVERSIBLE_HH
 
-#include <stack>
+#include <cstddef>
+#include <atomic>
 
 class Reversible {
 public:
+    /**
+     * Stack of the undo records of children.
+     *
+     * The records are linked through themselves, so the undo log takes
+     * no memory besides the records, which all come from the arena.
+     * A record can be in one stack at a time.
+     */
+    class UndoStack {
+    public:
+        UndoStack() : top_(NULL), size_(0) {}
+        bool empty() const { return top_ == NULL; }
+        std::size_t size() const { return size_; }
+        Reversible* top() const { return top_; }
+        void push(Reversible* record) {
+            record->nextUndo_ = top_;
+            top_ = record;
+            ++size_;
+        }
+        void pop() {
+            top_ = top_->nextUndo_;
+            --size_;
+        }
+    private:
+        /// The latest pushed record.
+        Reversible* top_;
+        /// Number of records in the stack.
+        std::size_t size_;
+    };
+
     /** This performs the operation. Returns true if success, false if fail. */
     virtual bool operator()() = 0;
     virtual void undo();
     virtual ~Reversible();
-    void deleteChildren(std::stack<Reversible*>& children);
+    void deleteChildren(UndoStack& children);
     int id() { return id_; }
-    Reversible() : id_(idCounter_++) {}
+    Reversible() : id_(idCounter_++), nextUndo_(NULL) {}
+
+    static void* operator new(std::size_t size);
+    static void operator delete(void* record, std::size_t size);
+    static bool releaseMemory();
 protected:
     bool runPreChild(Reversible *preChild);
     bool runPostChild(Reversible *preChild);
-    bool runChild(std::stack<Reversible*>& children, Reversible* child);
+    bool runChild(UndoStack& children, Reversible* child);
     bool runChild(Reversible* child, bool pre);
 
     void undoAndRemovePreChildren();
     void undoAndRemovePostChildren();
-    void undoAndRemoveChildren(std::stack<Reversible*>& children);
+    void undoAndRemoveChildren(UndoStack& children);
     virtual void undoOnlyMe();
 
     // normally no need to touch these directly, only through the helpers.
-    std::stack<Reversible*> preChildren_;
-    std::stack<Reversible*> postChildren_;
+    UndoStack preChildren_;
+    UndoStack postChildren_;
 
 private:
     int id_;
-    static int idCounter_;
+    /// The record below this one in the undo stack this is in.
+    Reversible* nextUndo_;
+    static std::atomic<int> idCounter_;
 };
 
 #endif
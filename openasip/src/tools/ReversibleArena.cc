@@ -0,0 +1,138 @@
+/*
+    Copyright (c) 2002-2026 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file ReversibleArena.cc
+ *
+ * Implementation of ReversibleArena class.
+ *
+ * @note rating: red
+ */
+
+#include <new>
+
+#include "ReversibleArena.hh"
+
+/**
+ * Constructor.
+ */
+ReversibleArena::ReversibleArena() :
+    next_(NULL), end_(NULL), freeLists_(MAX_POOLED_SIZE / ALIGNMENT + 1, NULL),
+    liveRecords_(0) {
+}
+
+/**
+ * Destructor. Frees all the chunks.
+ */
+ReversibleArena::~ReversibleArena() {
+    for (std::size_t i = 0; i < chunks_.size(); ++i) {
+        ::operator delete(chunks_[i]);
+    }
+}
+
+/**
+ * Returns the arena of the calling thread.
+ */
+ReversibleArena&
+ReversibleArena::instance() {
+    static thread_local ReversibleArena arena;
+    return arena;
+}
+
+/**
+ * Allocates memory for a record.
+ *
+ * @param size Size of the record in bytes.
+ * @return The memory of the record.
+ */
+void*
+ReversibleArena::allocate(std::size_t size) {
+    if (size > MAX_POOLED_SIZE) {
+        return ::operator new(size);
+    }
+    const std::size_t sizeClass = (size + ALIGNMENT - 1) / ALIGNMENT;
+    ++liveRecords_;
+    FreeRecord*& freeList = freeLists_[sizeClass];
+    if (freeList != NULL) {
+        FreeRecord* record = freeList;
+        freeList = record->next;
+        return record;
+    }
+    const std::size_t bytes = sizeClass * ALIGNMENT;
+    if (next_ == NULL || static_cast<std::size_t>(end_ - next_) < bytes) {
+        char* chunk = static_cast<char*>(::operator new(CHUNK_SIZE));
+        chunks_.push_back(chunk);
+        next_ = chunk;
+        end_ = chunk + CHUNK_SIZE;
+    }
+    void* record = next_;
+    next_ += bytes;
+    return record;
+}
+
+/**
+ * Returns the memory of a record to the arena.
+ *
+ * @param record The record, allocated from this arena.
+ * @param size Size of the record in bytes, as given to allocate().
+ */
+void
+ReversibleArena::deallocate(void* record, std::size_t size) {
+    if (size > MAX_POOLED_SIZE) {
+        ::operator delete(record);
+        return;
+    }
+    FreeRecord* freeRecord = static_cast<FreeRecord*>(record);
+    FreeRecord*& freeList = freeLists_[(size + ALIGNMENT - 1) / ALIGNMENT];
+    freeRecord->next = freeList;
+    freeList = freeRecord;
+    --liveRecords_;
+}
+
+/**
+ * Releases all the memory of the records at once.
+ *
+ * Only done when no record is alive anymore, for example after a basic
+ * block has been committed and its undo information deleted. The first
+ * chunk is kept for the next block.
+ *
+ * @return True in case the memory was released.
+ */
+bool
+ReversibleArena::release() {
+    if (liveRecords_ != 0) {
+        return false;
+    }
+    for (std::size_t i = 1; i < chunks_.size(); ++i) {
+        ::operator delete(chunks_[i]);
+    }
+    if (!chunks_.empty()) {
+        chunks_.resize(1);
+        next_ = chunks_.front();
+        end_ = next_ + CHUNK_SIZE;
+    }
+    for (std::size_t i = 0; i < freeLists_.size(); ++i) {
+        freeLists_[i] = NULL;
+    }
+    return true;
+}
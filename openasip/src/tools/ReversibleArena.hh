@@ -0,0 +1,94 @@
+/*
+    Copyright (c) 2002-2026 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file ReversibleArena.hh
+ *
+ * Declaration of ReversibleArena class.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_REVERSIBLE_ARENA_HH
+#define TTA_REVERSIBLE_ARENA_HH
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * Pooled memory for the undo records of Reversible operations.
+ *
+ * Schedulers create and throw away large numbers of small short lived
+ * Reversible objects while trying out transformations. The records are
+ * carved from large chunks with a bump pointer and freed records are
+ * recycled through per size class free lists, so neither a failed attempt
+ * nor its undo calls the system allocator.
+ *
+ * There is one arena per thread. A record must be deleted in the thread
+ * that created it.
+ */
+class ReversibleArena {
+public:
+    ReversibleArena();
+    virtual ~ReversibleArena();
+
+    static ReversibleArena& instance();
+
+    void* allocate(std::size_t size);
+    void deallocate(void* record, std::size_t size);
+    bool release();
+
+    /// Returns the number of records allocated and not yet deallocated.
+    std::size_t liveRecords() const { return liveRecords_; }
+    /// Returns the number of memory chunks held by the arena.
+    std::size_t chunkCount() const { return chunks_.size(); }
+
+private:
+    /// A freed record, linked to the next free one of the same size.
+    struct FreeRecord {
+        FreeRecord* next;
+    };
+
+    /// Alignment and size class granularity of the records.
+    static const std::size_t ALIGNMENT = 16;
+    /// Records larger than this are left to the system allocator.
+    static const std::size_t MAX_POOLED_SIZE = 1024;
+    /// Size of the memory chunks the records are carved from.
+    static const std::size_t CHUNK_SIZE = 64 * 1024;
+
+    ReversibleArena(const ReversibleArena&);
+    ReversibleArena& operator=(const ReversibleArena&);
+
+    /// The memory chunks, the first one is kept over releases.
+    std::vector<char*> chunks_;
+    /// Next unused byte of the last chunk.
+    char* next_;
+    /// End of the last chunk.
+    char* end_;
+    /// Free records of each size class.
+    std::vector<FreeRecord*> freeLists_;
+    /// Number of live records.
+    std::size_t liveRecords_;
+};
+
+#endif
@@ -38,6 +38,7 @@
 #include <iostream>
 
 #include "Estimator.hh"
+#include "EstimationSession.hh"
 #include "FileSystem.hh"
 #include "HDBManager.hh"
 #include "FUEntry.hh"
@@ -86,6 +87,7 @@ public:
     void testStrictMatchWithInterpolatingRFPlugin();
     void testInterpolatingFUPlugin();
     void testStrictMatchWithInterpolatingFUPlugin();
+    void testEstimationSession();
 
 private:
     Estimator estimator_;
@@ -294,4 +296,73 @@ InterpolatingPluginTest::testStrictMatchWithInterpolatingFUPlugin() {
     TS_ASSERT_EQUALS(fuCompDelay, 7777);
 }
 
+/**
+ * Tests that the estimation session reuses the estimates of equal units.
+ */
+void
+InterpolatingPluginTest::testEstimationSession() {
+
+    ADFSerializer* serializer = new ADFSerializer();
+    serializer->setSourceFile(ADF_FILE);
+
+    Machine* machine = serializer->readMachine();
+    
+    Machine::FunctionUnitNavigator fuNav = machine->functionUnitNavigator();   
+
+    TS_ASSERT_EQUALS(fuNav.count(), 2);
+    FunctionUnit* interpolatedFU = fuNav.item(0);
+    FunctionUnit* exactFU = fuNav.item(1);
+
+    UnitImplementationLocation fuImpl(HDB_FILE, 1, "fu");
+    MachineImplementation idf;
+    fuImpl.setParent(idf);
+
+    EstimationSession session;
+    TS_ASSERT_DELTA(
+        session.functionUnitArea(*interpolatedFU, fuImpl),
+        (1000.0 + (10.0 / 12.0) * (1230.0 - 1000.0)), EPSILON);
+    TS_ASSERT_EQUALS(session.cacheHits(), 0);
+    TS_ASSERT_EQUALS(session.cacheMisses(), 1);
+
+    // units with different architecture do not share estimates
+    TS_ASSERT_EQUALS(session.functionUnitArea(*exactFU, fuImpl), 1230);
+    TS_ASSERT_EQUALS(session.cacheMisses(), 2);
+
+    // the name of the unit does not affect the estimate
+    interpolatedFU->setName("renamed");
+    TS_ASSERT_DELTA(
+        session.functionUnitArea(*interpolatedFU, fuImpl),
+        (1000.0 + (10.0 / 12.0) * (1230.0 - 1000.0)), EPSILON);
+    TS_ASSERT_EQUALS(session.cacheHits(), 1);
+
+    TS_ASSERT_EQUALS(
+        session.functionUnitPortReadDelay(*exactFU->operationPort(0), fuImpl),
+        2233);
+    TS_ASSERT_EQUALS(
+        session.functionUnitPortReadDelay(*exactFU->operationPort(0), fuImpl),
+        2233);
+    TS_ASSERT_EQUALS(session.cacheHits(), 2);
+
+    session.clear();
+    TS_ASSERT_EQUALS(session.functionUnitArea(*exactFU, fuImpl), 1230);
+    TS_ASSERT_EQUALS(session.cacheHits(), 0);
+    TS_ASSERT_EQUALS(session.cacheMisses(), 1);
+
+    // a full session drops the least recently used estimate
+    EstimationSession small(2);
+    small.functionUnitArea(*interpolatedFU, fuImpl);
+    small.functionUnitArea(*exactFU, fuImpl);
+    small.functionUnitArea(*interpolatedFU, fuImpl);
+    TS_ASSERT_EQUALS(small.cacheHits(), 1);
+    small.functionUnitPortReadDelay(*exactFU->operationPort(0), fuImpl);
+    small.functionUnitArea(*interpolatedFU, fuImpl);
+    TS_ASSERT_EQUALS(small.cacheHits(), 2);
+    TS_ASSERT_EQUALS(small.functionUnitArea(*exactFU, fuImpl), 1230);
+    TS_ASSERT_EQUALS(small.cacheHits(), 2);
+    TS_ASSERT_EQUALS(small.cacheMisses(), 4);
+
+    delete machine;
+    delete serializer;
+}
+
 #endif
@@ -36,6 +36,8 @@
 #include <TestSuite.h>
 #include <string>
 #include <fstream>
+#include <sstream>
+#include <cstdlib>
 
 #include "FUFiniteStateAutomaton.hh"
 #include "ADFSerializer.hh"
@@ -44,6 +46,7 @@
 #include "ResourceVectorSet.hh"
 #include "CollisionMatrix.hh"
 #include "Conversion.hh"
+#include "FileSystem.hh"
 
 class FUFiniteStateAutomatonTest : public CxxTest::TestSuite {
 public:
@@ -53,6 +56,7 @@ public:
     void testCollisionMatrices();
     void testFSA();
     void testLazyFSA();
+    void testSharedFSA();
 
 private:
     TTAMachine::FunctionUnit* fullPipeAluFU;
@@ -61,6 +65,7 @@ private:
 };
 
 const std::string FU_ADF = "data/test_fus.adf";
+const std::string FSA_CACHE_DIR = "fsa_cache";
 
 void 
 FUFiniteStateAutomatonTest::setUp() {
@@ -189,5 +194,50 @@ FUFiniteStateAutomatonTest::testLazyFSA() {
 
 }
 
+/**
+ * Tests sharing and caching the completely built FSAs.
+ */
+void
+FUFiniteStateAutomatonTest::testSharedFSA() {
+
+    setenv("TTASIM_FSA_CACHE", FSA_CACHE_DIR.c_str(), 1);
+    FileSystem::removeFileOrDirectory(FSA_CACHE_DIR);
+
+    FUFiniteStateAutomaton::Handle shared =
+        FUFiniteStateAutomaton::sharedAutomaton(*fullPipeAluFU);
+    TS_ASSERT(shared->isComplete());
+    TS_ASSERT_EQUALS(
+        FUFiniteStateAutomaton::sharedAutomaton(*fullPipeAluFU).get(),
+        shared.get());
+    TS_ASSERT_EQUALS(
+        FileSystem::directoryContents(FSA_CACHE_DIR).size(), 1u);
+
+    // the transitions read back match the built ones
+    std::stringstream table;
+    shared->writeTransitions(table);
+    FUFiniteStateAutomaton fsa(*fullPipeAluFU, true);
+    TS_ASSERT(!fsa.isComplete());
+    TS_ASSERT(fsa.readTransitions(table));
+    TS_ASSERT(fsa.isComplete());
+    TS_ASSERT_EQUALS(fsa.stateCount(), shared->stateCount());
+    for (int state = 0; state < fsa.stateCount(); ++state) {
+        for (int op = 0; op <= fullPipeAluFU->operationCount(); ++op) {
+            TS_ASSERT_EQUALS(
+                fsa.destinationState(state, op),
+                shared->destinationState(state, op));
+        }
+    }
+    TS_ASSERT(fsa.buildStateMachine());
+
+    // a table of another pipeline is not accepted
+    table.clear();
+    table.seekg(0);
+    FUFiniteStateAutomaton other(*simpleFU, true);
+    TS_ASSERT(!other.readTransitions(table));
+    TS_ASSERT(!other.isComplete());
+
+    FileSystem::removeFileOrDirectory(FSA_CACHE_DIR);
+    unsetenv("TTASIM_FSA_CACHE");
+}
 
 #endif
@@ -0,0 +1,210 @@
+/*
+    Copyright (c) 2002-2026 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file ImplementationTesterTest.hh
+ *
+ * A test suite for ImplementationTester.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_IMPLEMENTATION_TESTER_TEST_HH
+#define TTA_IMPLEMENTATION_TESTER_TEST_HH
+
+#include <chrono>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <TestSuite.h>
+
+#include "ImplementationTester.hh"
+#include "ImplementationSimulator.hh"
+#include "FileSystem.hh"
+#include "Conversion.hh"
+
+/**
+ * Simulator that does not run an HDL simulator.
+ *
+ * The simulation of the testbench of RF 3 fails. The later entries finish
+ * their simulations first.
+ */
+class StubSimulator : public ImplementationSimulator {
+public:
+    StubSimulator(
+        const std::string& tbFile, const std::vector<std::string>& hdlFiles,
+        int entryID) :
+        ImplementationSimulator(tbFile, hdlFiles, true, false),
+        entryID_(entryID) {
+    }
+
+    virtual bool compile(std::vector<std::string>&) {
+        outputStream() << "compile " << FileSystem::fileOfPath(tbFile())
+                       << std::endl;
+        return true;
+    }
+
+    virtual bool simulate(std::vector<std::string>& errors) {
+        std::this_thread::sleep_for(
+            std::chrono::milliseconds(20 * (5 - entryID_)));
+        outputStream() << "simulate " << FileSystem::fileOfPath(tbFile())
+                       << std::endl;
+        if (entryID_ == 3) {
+            errors.push_back("TCE Assert: stub failure");
+            return false;
+        }
+        return true;
+    }
+
+private:
+    int entryID_;
+};
+
+/**
+ * Tester which simulates the testbenches with StubSimulator.
+ */
+class StubImplementationTester : public ImplementationTester {
+public:
+    StubImplementationTester(const std::string& hdbFile) :
+        ImplementationTester(hdbFile, SIM_GHDL, false, false) {
+    }
+
+protected:
+    virtual ImplementationSimulator* createSimulator(
+        const std::string& testbench,
+        const std::vector<std::string>& hdlFiles) const {
+
+        std::string name = FileSystem::fileNameBody(testbench);
+        int entryID = Conversion::toInt(name.substr(name.rfind('_') + 1));
+        return new StubSimulator(testbench, hdlFiles, entryID);
+    }
+};
+
+class ImplementationTesterTest : public CxxTest::TestSuite {
+public:
+    void setUp();
+    void tearDown();
+
+    void testValidateEntries();
+
+private:
+    std::string validate(
+        unsigned int jobs,
+        std::vector<ImplementationTester::EntryResult>& results,
+        bool& noFailures);
+
+    static const std::string HDB_FILE;
+};
+
+const std::string ImplementationTesterTest::HDB_FILE = "data/rf.hdb";
+
+/**
+ * Called before each test.
+ */
+void
+ImplementationTesterTest::setUp() {
+}
+
+/**
+ * Called after each test.
+ */
+void
+ImplementationTesterTest::tearDown() {
+}
+
+/**
+ * Validates all RF entries of the test HDB.
+ *
+ * @return The output printed to std::cout.
+ */
+std::string
+ImplementationTesterTest::validate(
+    unsigned int jobs,
+    std::vector<ImplementationTester::EntryResult>& results,
+    bool& noFailures) {
+
+    StubImplementationTester tester(HDB_FILE);
+    std::ostringstream output;
+    std::streambuf* cout = std::cout.rdbuf(output.rdbuf());
+    try {
+        noFailures = tester.validateEntries(
+            std::set<int>(), tester.rfEntryIDs(), jobs, results);
+    } catch (...) {
+        std::cout.rdbuf(cout);
+        throw;
+    }
+    std::cout.rdbuf(cout);
+    return output.str();
+}
+
+/**
+ * Tests validating several entries with concurrent simulations.
+ */
+void
+ImplementationTesterTest::testValidateEntries() {
+    std::vector<ImplementationTester::EntryResult> results;
+    bool noFailures = true;
+    std::string output = validate(4, results, noFailures);
+
+    TS_ASSERT(!noFailures);
+    TS_ASSERT_EQUALS(results.size(), 4u);
+    for (size_t i = 0; i < results.size(); i++) {
+        const ImplementationTester::EntryResult& result = results.at(i);
+        TS_ASSERT(!result.isFU);
+        TS_ASSERT_EQUALS(result.entryID, static_cast<int>(i) + 1);
+        TS_ASSERT(result.tested);
+        if (result.entryID == 3) {
+            TS_ASSERT(!result.success);
+            TS_ASSERT_EQUALS(result.errors.size(), 1u);
+        } else {
+            TS_ASSERT(result.success);
+            TS_ASSERT(result.errors.empty());
+        }
+    }
+
+    // the outputs are printed in the entry order although the
+    // simulations finish in the reverse order
+    std::ostringstream expected;
+    for (int id = 1; id <= 4; id++) {
+        expected << "compile tb_rf_" << id << ".vhdl" << std::endl
+                 << "simulate tb_rf_" << id << ".vhdl" << std::endl;
+    }
+    TS_ASSERT_EQUALS(output, expected.str());
+
+    std::vector<ImplementationTester::EntryResult> serialResults;
+    bool serialNoFailures = true;
+    TS_ASSERT_EQUALS(
+        validate(1, serialResults, serialNoFailures), expected.str());
+    TS_ASSERT_EQUALS(serialNoFailures, noFailures);
+    TS_ASSERT_EQUALS(serialResults.size(), results.size());
+    for (size_t i = 0;
+         i < results.size() && i < serialResults.size(); i++) {
+        TS_ASSERT_EQUALS(serialResults.at(i).success, results.at(i).success);
+        TS_ASSERT_EQUALS(serialResults.at(i).errors, results.at(i).errors);
+    }
+}
+
+#endif
@@ -0,0 +1,130 @@
+/*
+    Copyright (c) 2002-2026 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file SchedulingBudgetTest.hh
+ *
+ * A test suite for SchedulingBudget.
+ *
+ * @note rating: red
+ */
+
+#ifndef SCHEDULING_BUDGET_TEST_HH
+#define SCHEDULING_BUDGET_TEST_HH
+
+#include <TestSuite.h>
+
+#include <chrono>
+#include <thread>
+
+#include "SchedulingBudget.hh"
+
+/**
+ * Class for testing SchedulingBudget.
+ */
+class SchedulingBudgetTest : public CxxTest::TestSuite {
+public:
+    void testUnlimited();
+    void testStepLimit();
+    void testTimeLimit();
+    void testRestart();
+};
+
+/**
+ * Tests that a budget without limits is never exceeded.
+ */
+void
+SchedulingBudgetTest::testUnlimited() {
+    SchedulingBudget budget;
+    TS_ASSERT(!budget.isLimited());
+    budget.start();
+    for (int i = 0; i < 10000; ++i) {
+        TS_ASSERT(budget.consume());
+    }
+    TS_ASSERT(!budget.isExceeded());
+    TS_ASSERT_EQUALS(budget.steps(), 10000);
+}
+
+/**
+ * Tests that the step limit allows exactly the given number of steps and
+ * that an exceeded budget stays exceeded.
+ */
+void
+SchedulingBudgetTest::testStepLimit() {
+    SchedulingBudget budget(-1, 3);
+    TS_ASSERT(budget.isLimited());
+    budget.start();
+    TS_ASSERT(budget.consume());
+    TS_ASSERT(budget.consume());
+    TS_ASSERT(budget.consume());
+    TS_ASSERT(!budget.isExceeded());
+    TS_ASSERT(!budget.consume());
+    TS_ASSERT(budget.isExceeded());
+    TS_ASSERT(!budget.consume());
+    TS_ASSERT_EQUALS(budget.steps(), 4);
+}
+
+/**
+ * Tests that the budget is exceeded once the wall time limit has passed.
+ */
+void
+SchedulingBudgetTest::testTimeLimit() {
+    SchedulingBudget budget(10);
+    TS_ASSERT(budget.isLimited());
+    budget.start();
+    TS_ASSERT(budget.consume());
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    TS_ASSERT(budget.elapsedTime() >= 10);
+    TS_ASSERT(!budget.consume());
+    TS_ASSERT(budget.isExceeded());
+}
+
+/**
+ * Tests that start() gives the next scheduling pass the whole budget
+ * again, as the basic block, loop and test-only passes each start their
+ * own period.
+ */
+void
+SchedulingBudgetTest::testRestart() {
+    SchedulingBudget budget(10, 2);
+    budget.start();
+    budget.consume();
+    budget.consume();
+    TS_ASSERT(!budget.consume());
+    TS_ASSERT(budget.isExceeded());
+
+    budget.start();
+    TS_ASSERT(!budget.isExceeded());
+    TS_ASSERT_EQUALS(budget.steps(), 0);
+    TS_ASSERT(budget.consume());
+    TS_ASSERT(budget.consume());
+    TS_ASSERT(!budget.consume());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    TS_ASSERT(!budget.consume());
+    budget.start();
+    TS_ASSERT(budget.elapsedTime() < 10);
+    TS_ASSERT(budget.consume());
+}
+
+#endif
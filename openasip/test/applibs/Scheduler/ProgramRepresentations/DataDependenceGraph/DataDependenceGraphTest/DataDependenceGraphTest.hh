@@ -53,6 +53,13 @@
 #include "InterPassDatum.hh"
 #include "BasicBlock.hh"
 #include "Move.hh"
+#include "RegisterFile.hh"
+#include "Terminal.hh"
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
 
 using TTAProgram::Move;
 
@@ -97,7 +104,15 @@ public:
 
     void testSpecialRegIPData();
 
+    void testProcessingOrder();
+
+    void testRegisterCycles();
+
     MoveNode& findMoveNodeById(DataDependenceGraph& ddg, int id);
+
+private:
+    std::vector<std::string> describe(
+        DataDependenceGraph& ddg, const BasicBlockNode* bbn);
 };
 
 
@@ -1471,4 +1486,215 @@ void DataDependenceGraphTest::testSpecialRegIPData() {
     delete currentProgram;
 }
 
+/**
+ * Returns a description of the nodes of a BB and the edges between them
+ * which does not depend on the node and edge ids, only on their order.
+ *
+ * The nodes are named by their position in the BB. The edges are listed
+ * in the id order, as the schedulers see them in the BB subgraphs. The
+ * edges over loops are left out.
+ *
+ * @param ddg The DDG.
+ * @param bbn The BB to describe, or NULL to describe all nodes.
+ */
+std::vector<std::string>
+DataDependenceGraphTest::describe(
+    DataDependenceGraph& ddg, const BasicBlockNode* bbn) {
+
+    std::vector<MoveNode*> nodes;
+    for (int i = 0; i < ddg.nodeCount(); i++) {
+        MoveNode& node = ddg.node(i);
+        if (bbn == NULL || &ddg.getBasicBlockNode(node) == bbn) {
+            nodes.push_back(&node);
+        }
+    }
+    std::sort(nodes.begin(), nodes.end(), GraphNode::Comparator());
+
+    std::vector<std::string> description;
+    std::map<const MoveNode*, std::string> names;
+    for (unsigned int i = 0; i < nodes.size(); i++) {
+        const MoveNode& node = *nodes[i];
+        names[&node] = Conversion::toString(i);
+        description.push_back(
+            names[&node] + " " +
+            (node.isMove() ? node.move().toString() : std::string("-")));
+    }
+
+    std::vector<DataDependenceEdge*> edges;
+    for (int i = 0; i < ddg.edgeCount(); i++) {
+        DataDependenceEdge& edge = ddg.edge(i);
+        if (edge.loopDepth() == 0 &&
+            names.find(&ddg.tailNode(edge)) != names.end() &&
+            names.find(&ddg.headNode(edge)) != names.end()) {
+            edges.push_back(&edge);
+        }
+    }
+    std::sort(edges.begin(), edges.end(), GraphEdge::Comparator());
+    for (unsigned int i = 0; i < edges.size(); i++) {
+        const DataDependenceEdge& edge = *edges[i];
+        description.push_back(
+            names[&ddg.tailNode(edge)] + " -> " +
+            names[&ddg.headNode(edge)] + " " + edge.toString());
+    }
+    return description;
+}
+
+/**
+ * Tests that the builder, which processes the BBs in reverse post-order,
+ * creates the same nodes and edges inside each BB, in the same order, as
+ * when the BB is built alone. The schedulers use the order to break ties.
+ */
+void
+DataDependenceGraphTest::testProcessingOrder() {
+
+    TPEF::BinaryStream binaryStream("data/rallocated_arrmul.tpef");
+    ADFSerializer adfSerializer;
+    adfSerializer.setSourceFile("data/10_bus_full_connectivity.adf");
+    TTAMachine::Machine* machine = adfSerializer.readMachine();
+    TPEF::Binary* tpef = TPEF::BinaryReader::readBinary(binaryStream);
+    TTAProgram::TPEFProgramFactory factory(
+        *tpef, *machine, &UniversalMachine::instance());
+    TTAProgram::Program* program = factory.build();
+    {
+        for (int p = 0; p < program->procedureCount(); p++) {
+            // the BBs are built alone from another copy of the procedure
+            // so that the bookkeeping of the procedure DDG is not reused.
+            ControlFlowGraph cfg(program->procedure(p));
+            ControlFlowGraph bbCFG(program->procedure(p));
+            TS_ASSERT_EQUALS(cfg.nodeCount(), bbCFG.nodeCount());
+
+            DataDependenceGraphBuilder builder;
+            DataDependenceGraph* ddg = builder.build(
+                cfg, DataDependenceGraph::ALL_ANTIDEPS, *machine,
+                &UniversalMachine::instance());
+
+            for (int i = 0; i < cfg.nodeCount() && i < bbCFG.nodeCount();
+                 i++) {
+                BasicBlockNode& bbn = cfg.node(i);
+                if (!bbn.isNormalBB()) {
+                    continue;
+                }
+                DataDependenceGraphBuilder bbBuilder;
+                DataDependenceGraph* bbDDG = bbBuilder.build(
+                    bbCFG.node(i).basicBlock(),
+                    DataDependenceGraph::ALL_ANTIDEPS, *machine, "bb",
+                    &UniversalMachine::instance());
+
+                std::vector<std::string> inProcedure = describe(*ddg, &bbn);
+                std::vector<std::string> alone = describe(*bbDDG, NULL);
+                TS_ASSERT_EQUALS(inProcedure.size(), alone.size());
+                for (unsigned int j = 0;
+                     j < inProcedure.size() && j < alone.size(); j++) {
+                    TS_ASSERT_EQUALS(inProcedure[j], alone[j]);
+                }
+                delete bbDDG;
+            }
+            delete ddg;
+        }
+    }
+    delete program;
+    delete tpef;
+    delete machine;
+}
+
+/**
+ * Tests that lastRegisterCycles() and firstRegisterCycles() give the same
+ * cycles as lastRegisterCycle() and firstRegisterCycle() of each register.
+ *
+ * The moves of each BB are placed in the program order, one per cycle.
+ * The cycles are compared with all moves placed and with every third move
+ * unplaced.
+ */
+void
+DataDependenceGraphTest::testRegisterCycles() {
+
+    TPEF::BinaryStream binaryStream("data/rallocated_arrmul.tpef");
+    ADFSerializer adfSerializer;
+    adfSerializer.setSourceFile("data/10_bus_full_connectivity.adf");
+    TTAMachine::Machine* machine = adfSerializer.readMachine();
+    TPEF::Binary* tpef = TPEF::BinaryReader::readBinary(binaryStream);
+    TTAProgram::TPEFProgramFactory factory(
+        *tpef, *machine, &UniversalMachine::instance());
+    TTAProgram::Program* program = factory.build();
+
+    std::map<const TTAMachine::BaseRegisterFile*, int> firstRegisters;
+    std::vector<std::pair<const TTAMachine::RegisterFile*, int> > registers;
+    TTAMachine::Machine::RegisterFileNavigator rfNav =
+        machine->registerFileNavigator();
+    for (int i = 0; i < rfNav.count(); i++) {
+        const TTAMachine::RegisterFile* rf = rfNav.item(i);
+        firstRegisters[rf] = registers.size();
+        for (int r = 0; r < rf->size(); r++) {
+            registers.push_back(std::make_pair(rf, r));
+        }
+    }
+
+    // whether some tested BB writes a register more than once
+    bool rewrittenRegisters = false;
+    {
+        DataDependenceGraphBuilder builder;
+        for (int p = 0; p < program->procedureCount(); p++) {
+            ControlFlowGraph cfg(program->procedure(p));
+            for (int b = 0; b < cfg.nodeCount(); b++) {
+                BasicBlockNode& bbn = cfg.node(b);
+                if (!bbn.isNormalBB()) {
+                    continue;
+                }
+                DataDependenceGraph* ddg = builder.build(
+                    bbn.basicBlock(), DataDependenceGraph::ALL_ANTIDEPS,
+                    *machine, "", &UniversalMachine::instance());
+
+                std::vector<int> writes(registers.size(), 0);
+                for (int i = 0; i < ddg->nodeCount(); i++) {
+                    const TTAProgram::Terminal& destination =
+                        ddg->node(i).move().destination();
+                    if (destination.isGPR()) {
+                        auto first =
+                            firstRegisters.find(&destination.registerFile());
+                        if (first != firstRegisters.end()) {
+                            int reg = first->second + destination.index();
+                            if (++writes[reg] > 1) {
+                                rewrittenRegisters = true;
+                            }
+                        }
+                    }
+                }
+
+                for (int unplaced = 0; unplaced < 2; unplaced++) {
+                    for (int i = 0; i < ddg->nodeCount(); i++) {
+                        MoveNode& node = ddg->node(i);
+                        if (node.isPlaced()) {
+                            node.unsetCycle();
+                        }
+                        if (unplaced == 0 || i % 3 != 1) {
+                            node.setCycle(i);
+                        }
+                    }
+
+                    std::vector<int> lastCycles(registers.size());
+                    std::vector<int> firstCycles(registers.size());
+                    ddg->lastRegisterCycles(firstRegisters, lastCycles);
+                    ddg->firstRegisterCycles(firstRegisters, firstCycles);
+                    for (unsigned int r = 0; r < registers.size(); r++) {
+                        TS_ASSERT_EQUALS(
+                            lastCycles[r],
+                            ddg->lastRegisterCycle(
+                                *registers[r].first, registers[r].second));
+                        TS_ASSERT_EQUALS(
+                            firstCycles[r],
+                            ddg->firstRegisterCycle(
+                                *registers[r].first, registers[r].second));
+                    }
+                }
+                delete ddg;
+            }
+        }
+    }
+    TS_ASSERT(rewrittenRegisters);
+
+    delete program;
+    delete tpef;
+    delete machine;
+}
+
 #endif
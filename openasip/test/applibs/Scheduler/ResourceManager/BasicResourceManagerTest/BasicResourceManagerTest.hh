@@ -66,6 +66,8 @@
 #include "BasicBlock.hh"
 #include "Conversion.hh"
 #include "Immediate.hh"
+#include "ExecutionPipelineResourceTable.hh"
+#include "FunctionUnit.hh"
 
 // In case some debug info is needed, uncomment
 #define DEBUG_OUTPUT
@@ -87,6 +89,7 @@ public:
     void testMULConflict();
     void testLIMMPSocketReads();
     void testNoRegisterTriggerInvalidates();
+    void testTriggerCollisions();
 
 };
 
@@ -1234,4 +1237,150 @@ BasicResourceManagerTest::testNoRegisterTriggerInvalidates() {
     delete targetMachine;
 
 }
+/**
+ * Tests whether a trigger of an operation collides with a trigger of
+ * another operation the given number of cycles later by walking through
+ * the resource reservation tables of the operations.
+ */
+static bool
+triggersCollide(
+    const ExecutionPipelineResourceTable& table, int op, int other,
+    int distance) {
+
+    for (int i = 0; i < (int)table.maximalLatency(); i++) {
+        int otherCycle = i - distance;
+        if (otherCycle < 0 || otherCycle >= (int)table.maximalLatency()) {
+            continue;
+        }
+        for (unsigned int res = 0; res < table.numberOfResources(); res++) {
+            if (table.operationPipeline(op, i, res) &&
+                table.operationPipeline(other, otherCycle, res)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * Tests that the precomputed trigger collisions agree with the full check
+ * of the resource reservation tables.
+ */
+void
+BasicResourceManagerTest::testTriggerCollisions() {
+
+    TTAProgram::Program* srcProgram = NULL;
+    TTAMachine::Machine* targetMachine = NULL;
+
+    CATCH_ANY(
+        targetMachine =
+        TTAMachine::Machine::loadFromADF(
+            "data/machine2.adf"));
+
+    CATCH_ANY(
+        srcProgram =
+        TTAProgram::Program::loadFromUnscheduledTPEF(
+            "data/arrmul_reg_allocated_10_bus.tpef",
+             *targetMachine));
+
+    // the collision lists of every operation pair of every FU
+    const TTAMachine::Machine::FunctionUnitNavigator& fuNav =
+        targetMachine->functionUnitNavigator();
+    for (int f = 0; f < fuNav.count(); f++) {
+        const ExecutionPipelineResourceTable& table =
+            ExecutionPipelineResourceTable::resourceTable(*fuNav.item(f));
+        const int latency = table.maximalLatency();
+        for (int op = 0; op < (int)table.pipelineSize(); op++) {
+            const ExecutionPipelineResourceTable::CollisionVector&
+                collisions = table.collisions(op);
+            for (int other = 0; other < (int)table.pipelineSize(); other++) {
+                for (int d = -latency; d <= latency; d++) {
+                    bool listed = false;
+                    for (unsigned int c = 0; c < collisions.size(); c++) {
+                        if (collisions[c].operation == other &&
+                            collisions[c].distance == d) {
+                            listed = true;
+                        }
+                    }
+                    TS_ASSERT_EQUALS(
+                        listed, triggersCollide(table, op, other, d));
+                }
+            }
+        }
+    }
+
+    // conflicting and non-conflicting MUL triggers in the RM
+    {
+    TTAProgram::Procedure& procedure = srcProgram->procedure(1);
+    ControlFlowGraph cfg(procedure);
+    SimpleResourceManager* rm =
+        SimpleResourceManager::createRM(*targetMachine);
+    MoveNode* node1 = new MoveNode(procedure.instructionAt(44).movePtr(0));
+    MoveNode* node2 = new MoveNode(procedure.instructionAt(45).movePtr(0));
+    MoveNode* node3 = new MoveNode(procedure.instructionAt(46).movePtr(0));
+    ProgramOperationPtr po1 =
+        ProgramOperationPtr(
+            new ProgramOperation(
+                node2->move().destination().operation()));
+    po1->addNode(*node1);
+    po1->addNode(*node2);
+    po1->addNode(*node3);
+    node1->addDestinationOperationPtr(po1);
+    node2->addDestinationOperationPtr(po1);
+    node3->setSourceOperationPtr(po1);
+
+    MoveNode* node4 = node1->copy();
+    MoveNode* node5 = node2->copy();
+    MoveNode* node6 = node3->copy();
+    po1->removeInputNode(*node4);
+    po1->removeInputNode(*node5);
+    po1->removeOutputNode(*node6);
+    ProgramOperationPtr po2 =
+        ProgramOperationPtr(
+            new ProgramOperation(
+                node5->move().destination().operation()));
+
+    node4->clearDestinationOperation();
+    node5->clearDestinationOperation();
+    po2->addNode(*node4);
+    po2->addNode(*node5);
+    po2->addNode(*node6);
+    node4->addDestinationOperationPtr(po2);
+    node5->addDestinationOperationPtr(po2);
+    node6->setSourceOperationPtr(po2);
+
+    const ExecutionPipelineResourceTable& table =
+        ExecutionPipelineResourceTable::resourceTable(
+            *fuNav.item("mul2"));
+    const int mul = table.operationIndex("MUL");
+
+    TS_ASSERT_THROWS_NOTHING(rm->assign(0,*node1));
+    TS_ASSERT_THROWS_NOTHING(rm->assign(0,*node2));
+    TS_ASSERT_THROWS_NOTHING(rm->assign(3,*node3));
+
+    // triggers of the second MUL while the pipeline of the first is busy
+    bool conflicting = false;
+    bool nonConflicting = false;
+    for (int cycle = 1; cycle < (int)table.maximalLatency(); cycle++) {
+        bool collides = triggersCollide(table, mul, mul, cycle);
+        conflicting |= collides;
+        nonConflicting |= !collides;
+        TS_ASSERT_EQUALS(rm->canAssign(cycle, *node5), !collides);
+    }
+    TS_ASSERT(conflicting);
+    TS_ASSERT(nonConflicting);
+
+    // the collision counts are cleared when the trigger is unassigned
+    TS_ASSERT_THROWS_NOTHING(rm->unassign(*node3));
+    TS_ASSERT_THROWS_NOTHING(rm->unassign(*node2));
+    TS_ASSERT_THROWS_NOTHING(rm->unassign(*node1));
+    for (int cycle = 0; cycle <= (int)table.maximalLatency(); cycle++) {
+        TS_ASSERT_EQUALS(rm->canAssign(cycle, *node5), true);
+    }
+    SimpleResourceManager::disposeRM(rm, false);
+    }
+    delete srcProgram;
+    delete targetMachine;
+}
+
 #endif
@@ -0,0 +1,270 @@
+/*
+    Copyright (c) 2002-2026 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file ProgramUtilizationIndexTest.hh
+ *
+ * A test suite for ProgramUtilizationIndex.
+ *
+ * @note rating: red
+ */
+
+#ifndef PROGRAM_UTILIZATION_INDEX_TEST_HH
+#define PROGRAM_UTILIZATION_INDEX_TEST_HH
+
+#include <TestSuite.h>
+
+#include <string>
+#include <vector>
+
+#include "ProgramUtilizationIndex.hh"
+#include "UtilizationStats.hh"
+#include "ExecutableInstruction.hh"
+#include "ExecutableMove.hh"
+#include "Program.hh"
+#include "Instruction.hh"
+#include "NullInstruction.hh"
+#include "Machine.hh"
+#include "Bus.hh"
+#include "Socket.hh"
+#include "FunctionUnit.hh"
+#include "ControlUnit.hh"
+#include "HWOperation.hh"
+#include "RegisterFile.hh"
+#include "ImmediateUnit.hh"
+
+using namespace TTAMachine;
+using namespace TTAProgram;
+
+/**
+ * Class for testing ProgramUtilizationIndex.
+ */
+class ProgramUtilizationIndexTest : public CxxTest::TestSuite {
+public:
+    void setUp();
+    void tearDown();
+
+    void testIndex();
+    void testStatistics();
+
+private:
+    /// Exposes the index based calculation for the test.
+    class IndexedStats : public UtilizationStats {
+    public:
+        using UtilizationStats::calculate;
+    };
+
+    void compareStats(
+        const Machine& machine, const UtilizationStats& expected,
+        const UtilizationStats& actual);
+};
+
+/// The program is shared with the program object model tests.
+#define PROGRAM_DATA_DIR "../../../base/program/ProgramTest/data/"
+
+/**
+ * Called before each test.
+ */
+void
+ProgramUtilizationIndexTest::setUp() {
+}
+
+/**
+ * Called after each test.
+ */
+void
+ProgramUtilizationIndexTest::tearDown() {
+}
+
+/**
+ * Tests that the moves of the index match the moves of the program.
+ */
+void
+ProgramUtilizationIndexTest::testIndex() {
+
+    Machine* machine =
+        Machine::loadFromADF(PROGRAM_DATA_DIR "multiaspace.adf");
+    Program* program = Program::loadFromTPEF(
+        PROGRAM_DATA_DIR "multiaspace.tpef", *machine);
+    ProgramUtilizationIndex index(*program);
+
+    std::size_t instructions = 0;
+    std::size_t moves = 0;
+    const Instruction* instruction = &program->firstInstruction();
+    while (instruction != &NullInstruction::instance()) {
+        TS_ASSERT_EQUALS(
+            index.instructionAddress(instructions),
+            instruction->address().location());
+        TS_ASSERT_EQUALS(index.firstMove(instructions), moves);
+        TS_ASSERT_EQUALS(
+            index.moveCount(instructions),
+            static_cast<std::size_t>(instruction->moveCount()));
+        moves += instruction->moveCount();
+        ++instructions;
+        instruction = &program->nextInstruction(*instruction);
+    }
+    TS_ASSERT_EQUALS(index.instructionCount(), instructions);
+    TS_ASSERT_EQUALS(index.moveCount(), moves);
+    TS_ASSERT(index.counterCount() > 0);
+
+    // the parallel reduction gives the same counters as the serial one
+    std::vector<ClockCycleCount> moveCounts(moves);
+    std::vector<char> countedMoves(moves);
+    for (std::size_t i = 0; i < moves; ++i) {
+        moveCounts[i] = i * 7 % 13;
+        countedMoves[i] = i % 5 != 0;
+    }
+    std::vector<ClockCycleCount> serialTotals;
+    std::vector<char> serialUsed;
+    index.reduce(moveCounts, countedMoves, serialTotals, serialUsed, 1);
+    for (unsigned threads = 2; threads <= 8; threads *= 2) {
+        std::vector<ClockCycleCount> totals;
+        std::vector<char> used;
+        index.reduce(moveCounts, countedMoves, totals, used, threads);
+        TS_ASSERT(totals == serialTotals);
+        TS_ASSERT(used == serialUsed);
+    }
+
+    delete program;
+    delete machine;
+}
+
+/**
+ * Tests that the statistics computed with the index are the same as the
+ * ones computed instruction by instruction.
+ */
+void
+ProgramUtilizationIndexTest::testStatistics() {
+
+    Machine* machine =
+        Machine::loadFromADF(PROGRAM_DATA_DIR "multiaspace.adf");
+    Program* program = Program::loadFromTPEF(
+        PROGRAM_DATA_DIR "multiaspace.tpef", *machine);
+    ProgramUtilizationIndex index(*program);
+
+    // give each move its own execution count
+    UtilizationStats expected;
+    std::vector<ClockCycleCount> moveCounts;
+    const Instruction* instruction = &program->firstInstruction();
+    while (instruction != &NullInstruction::instance()) {
+        ExecutableInstruction executableInstruction;
+        for (int i = 0; i < instruction->moveCount(); ++i) {
+            moveCounts.push_back(moveCounts.size() % 4 + 1);
+            executableInstruction.addExecutableMove(
+                new DummyExecutableMove(moveCounts.back()));
+        }
+        expected.calculateForInstruction(
+            *instruction, executableInstruction);
+        instruction = &program->nextInstruction(*instruction);
+    }
+
+    std::vector<char> countedMoves(moveCounts.size(), 1);
+    IndexedStats actual;
+    actual.calculate(index, moveCounts, countedMoves);
+    compareStats(*machine, expected, actual);
+
+    delete program;
+    delete machine;
+}
+
+/**
+ * Compares the utilizations of all the components of the machine.
+ */
+void
+ProgramUtilizationIndexTest::compareStats(
+    const Machine& machine, const UtilizationStats& expected,
+    const UtilizationStats& actual) {
+
+    const Machine::BusNavigator buses = machine.busNavigator();
+    for (int i = 0; i < buses.count(); ++i) {
+        const std::string name = buses.item(i)->name();
+        TS_ASSERT_EQUALS(actual.busWrites(name), expected.busWrites(name));
+    }
+    const Machine::SocketNavigator sockets = machine.socketNavigator();
+    for (int i = 0; i < sockets.count(); ++i) {
+        const std::string name = sockets.item(i)->name();
+        TS_ASSERT_EQUALS(
+            actual.socketWrites(name), expected.socketWrites(name));
+    }
+
+    std::vector<const FunctionUnit*> units;
+    const Machine::FunctionUnitNavigator fus =
+        machine.functionUnitNavigator();
+    for (int i = 0; i < fus.count(); ++i) {
+        units.push_back(fus.item(i));
+    }
+    units.push_back(machine.controlUnit());
+    for (std::size_t i = 0; i < units.size(); ++i) {
+        const FunctionUnit& unit = *units[i];
+        TS_ASSERT_EQUALS(
+            actual.triggerCount(unit.name()),
+            expected.triggerCount(unit.name()));
+        for (int op = 0; op < unit.operationCount(); ++op) {
+            const std::string opName = unit.operation(op)->name();
+            TS_ASSERT_EQUALS(
+                actual.operationExecutions(opName),
+                expected.operationExecutions(opName));
+            TS_ASSERT_EQUALS(
+                actual.operationExecutions(unit.name(), opName),
+                expected.operationExecutions(unit.name(), opName));
+        }
+        for (int port = 0; port < unit.portCount(); ++port) {
+            const std::string portName = unit.port(port)->name();
+            TS_ASSERT_EQUALS(
+                actual.FUGuardAccesses(unit.name(), portName),
+                expected.FUGuardAccesses(unit.name(), portName));
+        }
+    }
+
+    const Machine::RegisterFileNavigator rfs =
+        machine.registerFileNavigator();
+    for (int i = 0; i < rfs.count(); ++i) {
+        const RegisterFile& rf = *rfs.item(i);
+        for (int r = 0; r < rf.numberOfRegisters(); ++r) {
+            TS_ASSERT_EQUALS(
+                actual.registerReads(rf.name(), r),
+                expected.registerReads(rf.name(), r));
+            TS_ASSERT_EQUALS(
+                actual.registerWrites(rf.name(), r),
+                expected.registerWrites(rf.name(), r));
+            TS_ASSERT_EQUALS(
+                actual.guardRegisterReads(rf.name(), r),
+                expected.guardRegisterReads(rf.name(), r));
+        }
+    }
+    const Machine::ImmediateUnitNavigator ius =
+        machine.immediateUnitNavigator();
+    for (int i = 0; i < ius.count(); ++i) {
+        const ImmediateUnit& iu = *ius.item(i);
+        for (int r = 0; r < iu.numberOfRegisters(); ++r) {
+            TS_ASSERT_EQUALS(
+                actual.registerReads(iu.name(), r),
+                expected.registerReads(iu.name(), r));
+        }
+    }
+    TS_ASSERT_EQUALS(
+        actual.highestUsedRegisterIndex(),
+        expected.highestUsedRegisterIndex());
+}
+
+#endif
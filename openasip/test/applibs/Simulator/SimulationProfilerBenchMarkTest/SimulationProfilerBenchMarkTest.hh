@@ -0,0 +1,122 @@
+/*
+    Copyright (c) 2002-2026 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file SimulationProfilerBenchMarkTest.hh
+ *
+ * A benchmark for the overhead of profiling the simulation.
+ *
+ * @note rating: red
+ */
+
+#ifndef SIMULATION_PROFILER_BENCHMARK_TEST_HH
+#define SIMULATION_PROFILER_BENCHMARK_TEST_HH
+
+#include <TestSuite.h>
+
+#include <chrono>
+
+#include "Application.hh"
+#include "SimulatorFrontend.hh"
+#include "Assembler.hh"
+#include "Binary.hh"
+#include "BinaryStream.hh"
+#include "TPEFProgramFactory.hh"
+#include "Program.hh"
+#include "Machine.hh"
+#include "FileSystem.hh"
+
+class SimulationProfilerBenchMarkTest : public CxxTest::TestSuite {
+public:
+    void testOverhead();
+private:
+    double simulate(
+        const TTAMachine::Machine& machine,
+        const TTAProgram::Program& program, bool profiling);
+};
+
+//#define BENCHMARKING_ENABLED
+
+/// The machines of the scheduler testbench are used as the test data.
+#define TESTBENCH_ADF_DIR "../../../../scheduler/testbench/ADF/"
+
+#define PROFILE_FILE "data/loop.callgrind"
+
+/**
+ * Simulates the program until it ends.
+ *
+ * @param machine The simulated machine.
+ * @param program The simulated program.
+ * @param profiling Is the simulation profiled.
+ * @return The simulation time in seconds.
+ */
+double
+SimulationProfilerBenchMarkTest::simulate(
+    const TTAMachine::Machine& machine,
+    const TTAProgram::Program& program, bool profiling) {
+
+    SimulatorFrontend frontend;
+    frontend.loadMachine(machine);
+    frontend.setProfiling(profiling);
+    frontend.setProfileFileName(PROFILE_FILE);
+    frontend.loadProgram(program);
+
+    auto timer = std::chrono::steady_clock::now();
+    frontend.run();
+    double time = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - timer).count();
+    TS_ASSERT(frontend.hasSimulationEnded());
+    return time;
+}
+
+/**
+ * Compares the simulation times with and without profiling and logs them.
+ */
+void
+SimulationProfilerBenchMarkTest::testOverhead() {
+#ifdef BENCHMARKING_ENABLED
+    TTAMachine::Machine* machine = TTAMachine::Machine::loadFromADF(
+        TESTBENCH_ADF_DIR "minimal_with_io.adf");
+    TPEF::BinaryStream asmFile("data/loop.tceasm");
+    Assembler assembler(asmFile, *machine);
+    TPEF::Binary* tpef = assembler.compile();
+    TTAProgram::Program* program =
+        TTAProgram::TPEFProgramFactory(*tpef, *machine).build();
+
+    double plainTime = simulate(*machine, *program, false);
+    double profiledTime = simulate(*machine, *program, true);
+
+    Application::logStream()
+        << "loop.tceasm: without profiling " << plainTime * 1000
+        << " ms, with profiling " << profiledTime * 1000 << " ms ("
+        << (profiledTime / plainTime - 1.0) * 100 << " % overhead)"
+        << std::endl;
+
+    FileSystem::removeFileOrDirectory(PROFILE_FILE);
+    delete program;
+    delete tpef;
+    delete machine;
+#endif
+}
+
+#endif
@@ -0,0 +1,241 @@
+/*
+    Copyright (c) 2002-2026 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file SimulationProfilerTest.hh
+ *
+ * A test suite for SimulationProfiler.
+ *
+ * @note rating: red
+ */
+
+#ifndef SIMULATION_PROFILER_TEST_HH
+#define SIMULATION_PROFILER_TEST_HH
+
+#include <TestSuite.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "SimulationProfiler.hh"
+#include "SimulatorFrontend.hh"
+#include "Assembler.hh"
+#include "Binary.hh"
+#include "BinaryStream.hh"
+#include "TPEFProgramFactory.hh"
+#include "Program.hh"
+#include "Procedure.hh"
+#include "Address.hh"
+#include "Machine.hh"
+#include "FileSystem.hh"
+
+/**
+ * Class for testing SimulationProfiler.
+ */
+class SimulationProfilerTest : public CxxTest::TestSuite {
+public:
+    void setUp();
+    void tearDown();
+
+    void testCycles();
+    void testCallgrindProfile();
+    void testProfileFile();
+
+private:
+    void simulate();
+    std::string startAddress(int procedure) const;
+
+    /// The simulated machine.
+    TTAMachine::Machine* machine_;
+    /// The assembled program.
+    TPEF::Binary* tpef_;
+    /// The simulated program.
+    TTAProgram::Program* program_;
+    /// The simulator running the program.
+    SimulatorFrontend* frontend_;
+};
+
+/// The machines of the scheduler testbench are used as the test data.
+#define TESTBENCH_ADF_DIR "../../../../scheduler/testbench/ADF/"
+
+#define PROGRAM_FILE "data/calls.tceasm"
+#define PROFILE_FILE "data/calls.callgrind"
+
+/// Indices of the procedures of the test program.
+enum { START, MIDDLE, LEAF };
+
+/**
+ * Assembles the test program.
+ */
+void
+SimulationProfilerTest::setUp() {
+    machine_ = TTAMachine::Machine::loadFromADF(
+        TESTBENCH_ADF_DIR "minimal_with_io.adf");
+    TPEF::BinaryStream asmFile(PROGRAM_FILE);
+    Assembler assembler(asmFile, *machine_);
+    tpef_ = assembler.compile();
+    program_ = TTAProgram::TPEFProgramFactory(*tpef_, *machine_).build();
+    frontend_ = NULL;
+}
+
+/**
+ * Frees the simulator and removes the written profile.
+ */
+void
+SimulationProfilerTest::tearDown() {
+    delete frontend_;
+    frontend_ = NULL;
+    delete program_;
+    program_ = NULL;
+    delete tpef_;
+    tpef_ = NULL;
+    delete machine_;
+    machine_ = NULL;
+    if (FileSystem::fileExists(PROFILE_FILE)) {
+        FileSystem::removeFileOrDirectory(PROFILE_FILE);
+    }
+}
+
+/**
+ * Runs the test program with profiling enabled.
+ */
+void
+SimulationProfilerTest::simulate() {
+    frontend_ = new SimulatorFrontend();
+    frontend_->loadMachine(*machine_);
+    frontend_->setProfiling(true);
+    frontend_->setProfileFileName(PROFILE_FILE);
+    frontend_->loadProgram(*program_);
+    frontend_->run();
+    TS_ASSERT(frontend_->hasSimulationEnded());
+    TS_ASSERT(frontend_->profiler() != NULL);
+}
+
+/**
+ * Returns the start address of the given procedure in the callgrind
+ * format.
+ */
+std::string
+SimulationProfilerTest::startAddress(int procedure) const {
+    std::ostringstream address;
+    address << "0x" << std::hex
+            << program_->procedure(procedure).startAddress().location();
+    return address.str();
+}
+
+/**
+ * Tests the exclusive and inclusive cycles and the call counts of the
+ * procedures.
+ */
+void
+SimulationProfilerTest::testCycles() {
+    simulate();
+    const SimulationProfiler& profiler = *frontend_->profiler();
+
+    TS_ASSERT_EQUALS(frontend_->cycleCount(), 31u);
+    TS_ASSERT_EQUALS(profiler.procedureCount(), 4);
+    TS_ASSERT_EQUALS(profiler.procedureName(START), "start");
+    TS_ASSERT_EQUALS(profiler.procedureName(MIDDLE), "middle");
+    TS_ASSERT_EQUALS(profiler.procedureName(LEAF), "leaf");
+
+    TS_ASSERT_EQUALS(profiler.exclusiveCycles(START), 12u);
+    TS_ASSERT_EQUALS(profiler.exclusiveCycles(MIDDLE), 11u);
+    TS_ASSERT_EQUALS(profiler.exclusiveCycles(LEAF), 8u);
+
+    TS_ASSERT_EQUALS(profiler.inclusiveCycles(START), 31u);
+    TS_ASSERT_EQUALS(profiler.inclusiveCycles(MIDDLE), 15u);
+    TS_ASSERT_EQUALS(profiler.inclusiveCycles(LEAF), 8u);
+
+    TS_ASSERT_EQUALS(profiler.callCount(START), 1u);
+    TS_ASSERT_EQUALS(profiler.callCount(MIDDLE), 1u);
+    TS_ASSERT_EQUALS(profiler.callCount(LEAF), 2u);
+
+    // the calls and the returns are the only operations
+    TS_ASSERT_EQUALS(profiler.triggerCount("gcu"), 7u);
+    TS_ASSERT_EQUALS(profiler.triggerCount("ALU"), 0u);
+    TS_ASSERT_EQUALS(profiler.memoryReads("data"), 0u);
+    TS_ASSERT_EQUALS(profiler.memoryWrites("data"), 0u);
+}
+
+/**
+ * Tests the summary and the call edges of the callgrind profile.
+ */
+void
+SimulationProfilerTest::testCallgrindProfile() {
+    simulate();
+    std::ostringstream output;
+    frontend_->profiler()->writeCallgrindProfile(output);
+    const std::string profile = output.str();
+
+    TS_ASSERT_EQUALS(profile.find("# callgrind format\n"), 0u);
+    TS_ASSERT(
+        profile.find(
+            "events: Cycles Triggers MemReads MemWrites\n"
+            "summary: 31 7 0 0\n") != std::string::npos);
+    TS_ASSERT(profile.find("\nfn=start\n") != std::string::npos);
+    TS_ASSERT(profile.find("\nfn=middle\n") != std::string::npos);
+    TS_ASSERT(profile.find("\nfn=leaf\n") != std::string::npos);
+    TS_ASSERT(profile.find("<no procedure>") == std::string::npos);
+
+    // the call sites are the call instructions, the costs the inclusive
+    // cycles of the calls
+    const std::string middleStart = startAddress(MIDDLE);
+    const std::string leafStart = startAddress(LEAF);
+    TS_ASSERT(
+        profile.find(
+            "cfn=middle\ncalls=1 " + middleStart + "\n0x0 15\n") !=
+        std::string::npos);
+    TS_ASSERT(
+        profile.find(
+            "cfn=leaf\ncalls=1 " + leafStart + "\n0x4 4\n") !=
+        std::string::npos);
+    TS_ASSERT(
+        profile.find(
+            "cfn=leaf\ncalls=1 " + leafStart + "\n0xd 4\n") !=
+        std::string::npos);
+}
+
+/**
+ * Tests that the profile is written to the given file and the profiler
+ * stays available after the simulation has finished.
+ */
+void
+SimulationProfilerTest::testProfileFile() {
+    simulate();
+    std::ostringstream expected;
+    frontend_->profiler()->writeCallgrindProfile(expected);
+
+    frontend_->finishSimulation();
+    TS_ASSERT(FileSystem::fileExists(PROFILE_FILE));
+    TS_ASSERT(frontend_->profiler() != NULL);
+    TS_ASSERT_EQUALS(
+        frontend_->profiler()->exclusiveCycles(LEAF), 8u);
+
+    std::ifstream profileFile(PROFILE_FILE);
+    std::ostringstream written;
+    written << profileFile.rdbuf();
+    TS_ASSERT_EQUALS(written.str(), expected.str());
+}
+
+#endif
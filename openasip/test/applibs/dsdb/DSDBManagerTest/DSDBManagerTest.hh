@@ -42,11 +42,17 @@
 #include "IDFSerializer.hh"
 #include "ADFSerializer.hh"
 #include "Machine.hh"
+#include "Bus.hh"
+#include "Segment.hh"
+#include "Socket.hh"
+#include "FunctionUnit.hh"
+#include "ObjectState.hh"
 
 using std::string;
 
 static const std::string DSDB_TEST_FILE_1 = "dsdb1.ddb";
 static const std::string DSDB_TEST_FILE_2 = "dsdb2.ddb";
+static const std::string DSDB_TEST_FILE_3 = "dsdb3.ddb";
 
 /**
  * Class that tests DSDBManager class.
@@ -58,6 +64,7 @@ public:
 
     void testCreatingDSDB();
     void testDSDB();
+    void testSharedCycleCounts();
 };
 
 
@@ -263,4 +270,94 @@ DSDBManagerTest::testDSDB() {
     TS_ASSERT(FileSystem::fileExists(DSDB_TEST_FILE_1));
 }
 
+/**
+ * Tests that cycle counts are shared only between architectures that
+ * differ in component names.
+ */
+void
+DSDBManagerTest::testSharedCycleCounts() {
+
+    FileSystem::removeFileOrDirectory(DSDB_TEST_FILE_3);
+    DSDBManager* manager = NULL;
+    TS_ASSERT_THROWS_NOTHING(
+        manager = DSDBManager::createNew(DSDB_TEST_FILE_3));
+
+    TTAMachine::Machine* original =
+        TTAMachine::Machine::loadFromADF("data/test.adf");
+    RowID originalID = manager->addArchitecture(*original);
+
+    // a renamed copy is the same architecture
+    TTAMachine::Machine* renamed =
+        TTAMachine::Machine::loadFromADF("data/test.adf");
+    renamed->busNavigator().item(0)->setName("renamed_bus");
+    renamed->socketNavigator().item(0)->setName("renamed_socket");
+    RowID renamedID = manager->addArchitecture(*renamed);
+    TS_ASSERT_DIFFERS(renamedID, originalID);
+
+    // so is a renamed copy with the components declared in another order
+    ObjectState* state = original->saveState();
+    std::vector<ObjectState*> movedStates;
+    for (int i = 0; i < state->childCount(); i++) {
+        const std::string name = state->child(i)->name();
+        if (movedStates.empty() &&
+            name == TTAMachine::Socket::OSNAME_SOCKET) {
+            movedStates.push_back(state->child(i));
+        } else if (movedStates.size() == 1 &&
+                   name == TTAMachine::FunctionUnit::OSNAME_FU) {
+            movedStates.push_back(state->child(i));
+        }
+    }
+    TS_ASSERT_EQUALS(movedStates.size(), 2u);
+    for (ObjectState* child : movedStates) {
+        state->removeChild(child);
+        state->addChild(child);
+    }
+    TTAMachine::Machine reordered;
+    reordered.loadState(state);
+    delete state;
+    reordered.functionUnitNavigator().item(0)->setName("renamed_fu");
+    RowID reorderedID = manager->addArchitecture(reordered);
+    TS_ASSERT_DIFFERS(reorderedID, originalID);
+
+    // a socket moved to another segment of the same bus has the same
+    // fingerprint but is a different architecture
+    TTAMachine::Machine* segmented =
+        TTAMachine::Machine::loadFromADF("data/test.adf");
+    TTAMachine::Bus* bus = segmented->busNavigator().item(0);
+    new TTAMachine::Segment("seg2", *bus);
+    RowID segmentedID = manager->addArchitecture(*segmented);
+
+    TTAMachine::Machine* moved =
+        TTAMachine::Machine::loadFromADF("data/test.adf");
+    bus = moved->busNavigator().item(0);
+    TTAMachine::Segment* segment = new TTAMachine::Segment("seg2", *bus);
+    TTAMachine::Socket* socket = moved->socketNavigator().item(0);
+    TS_ASSERT(socket->isConnectedTo(*bus->segment(0)));
+    socket->detachBus(*bus->segment(0));
+    socket->attachBus(*segment);
+    TS_ASSERT_EQUALS(moved->fingerprint(), segmented->fingerprint());
+    RowID movedID = manager->addArchitecture(*moved);
+    TS_ASSERT_DIFFERS(movedID, segmentedID);
+
+    RowID appID = manager->addApplication("/path/to/application");
+    ClockCycleCount cc = 4242;
+    manager->addCycleCount(appID, originalID, cc);
+    TS_ASSERT(manager->hasCycleCount(appID, renamedID));
+    TS_ASSERT_EQUALS(manager->cycleCount(appID, renamedID), cc);
+    TS_ASSERT_EQUALS(manager->cycleCount(appID, reorderedID), cc);
+
+    manager->addCycleCount(appID, segmentedID, cc);
+    TS_ASSERT(!manager->hasCycleCount(appID, movedID));
+    manager->setUnschedulable(appID, movedID);
+    TS_ASSERT(manager->isUnschedulable(appID, movedID));
+    TS_ASSERT(!manager->isUnschedulable(appID, segmentedID));
+
+    delete original;
+    delete renamed;
+    delete segmented;
+    delete moved;
+    delete manager;
+    FileSystem::removeFileOrDirectory(DSDB_TEST_FILE_3);
+}
+
 #endif
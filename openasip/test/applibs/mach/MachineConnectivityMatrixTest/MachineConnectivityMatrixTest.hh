@@ -0,0 +1,216 @@
+/*
+    Copyright (c) 2002-2026 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file MachineConnectivityMatrixTest.hh
+ *
+ * A test suite for MachineConnectivityMatrix.
+ *
+ * @note rating: red
+ */
+
+#ifndef MACHINE_CONNECTIVITY_MATRIX_TEST_HH
+#define MACHINE_CONNECTIVITY_MATRIX_TEST_HH
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include <TestSuite.h>
+#include "MachineConnectivityMatrix.hh"
+#include "MachineConnectivityCheck.hh"
+#include "Machine.hh"
+#include "FunctionUnit.hh"
+#include "RegisterFile.hh"
+#include "Port.hh"
+#include "Socket.hh"
+#include "Guard.hh"
+#include "Bus.hh"
+
+/// The test machine, shared with MachineCheckTest.
+const std::string ADF =
+    "../MachineCheckTest/data/10_bus_reduced_connectivity.adf";
+
+class MachineConnectivityMatrixTest : public CxxTest::TestSuite {
+public:
+    void setUp();
+    void tearDown();
+
+    void testMatchesSocketWalk();
+    void testGuardedConnectivity();
+    void testInvalidation();
+    void testDeletedMachine();
+
+private:
+    std::vector<const TTAMachine::Port*> allPorts(
+        const TTAMachine::Machine& mach);
+    bool sharesBus(
+        const TTAMachine::Port& src, const TTAMachine::Port& dst,
+        const TTAMachine::Guard* guard);
+};
+
+void
+MachineConnectivityMatrixTest::setUp() {
+}
+
+void
+MachineConnectivityMatrixTest::tearDown() {
+}
+
+std::vector<const TTAMachine::Port*>
+MachineConnectivityMatrixTest::allPorts(const TTAMachine::Machine& mach) {
+    std::vector<const TTAMachine::Port*> ports;
+    for (const TTAMachine::FunctionUnit* fu : mach.functionUnitNavigator()) {
+        for (int i = 0; i < fu->portCount(); ++i) {
+            ports.push_back(fu->port(i));
+        }
+    }
+    for (const TTAMachine::RegisterFile* rf : mach.registerFileNavigator()) {
+        for (int i = 0; i < rf->portCount(); ++i) {
+            ports.push_back(rf->port(i));
+        }
+    }
+    return ports;
+}
+
+/**
+ * Reference implementation: walks the sockets of the two ports.
+ */
+bool
+MachineConnectivityMatrixTest::sharesBus(
+    const TTAMachine::Port& src, const TTAMachine::Port& dst,
+    const TTAMachine::Guard* guard) {
+    std::set<const TTAMachine::Bus*> srcBuses =
+        MachineConnectivityCheck::connectedDestinationBuses(src);
+    std::set<const TTAMachine::Bus*> dstBuses =
+        MachineConnectivityCheck::connectedSourceBuses(dst);
+    for (const TTAMachine::Bus* bus : srcBuses) {
+        if (dstBuses.count(bus) != 0 &&
+            (guard == NULL || bus->hasGuard(*guard))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Tests that the unguarded matrix agrees with walking the sockets.
+ */
+void
+MachineConnectivityMatrixTest::testMatchesSocketWalk() {
+    TTAMachine::Machine* mach = TTAMachine::Machine::loadFromADF(ADF);
+    MachineConnectivityMatrix matrix(*mach);
+    std::vector<const TTAMachine::Port*> ports = allPorts(*mach);
+
+    TS_ASSERT_EQUALS(matrix.busCount(), mach->busNavigator().count());
+    for (const TTAMachine::Port* src : ports) {
+        TS_ASSERT(matrix.portIndex(*src) >= 0);
+        for (const TTAMachine::Port* dst : ports) {
+            TS_ASSERT_EQUALS(
+                matrix.isConnected(*src, *dst), sharesBus(*src, *dst, NULL));
+        }
+    }
+    delete mach;
+}
+
+/**
+ * Tests guarded reachability against walking the sockets.
+ */
+void
+MachineConnectivityMatrixTest::testGuardedConnectivity() {
+    TTAMachine::Machine* mach = TTAMachine::Machine::loadFromADF(ADF);
+    MachineConnectivityMatrix matrix(*mach);
+    std::vector<const TTAMachine::Port*> ports = allPorts(*mach);
+
+    for (const TTAMachine::Bus* bus : mach->busNavigator()) {
+        for (int g = 0; g < bus->guardCount(); ++g) {
+            const TTAMachine::Guard& guard = *bus->guard(g);
+            TS_ASSERT(matrix.guardIndex(guard) >= 0);
+            for (const TTAMachine::Port* src : ports) {
+                for (const TTAMachine::Port* dst : ports) {
+                    TS_ASSERT_EQUALS(
+                        matrix.isConnected(*src, *dst, guard),
+                        sharesBus(*src, *dst, &guard));
+                }
+            }
+        }
+    }
+    delete mach;
+}
+
+/**
+ * Tests that a shared matrix is rebuilt after the machine is modified.
+ */
+void
+MachineConnectivityMatrixTest::testInvalidation() {
+    TTAMachine::Machine* mach = TTAMachine::Machine::loadFromADF(ADF);
+
+    MachineConnectivityMatrix::Handle first =
+        MachineConnectivityMatrix::forMachine(*mach);
+    TS_ASSERT_EQUALS(
+        first.get(), MachineConnectivityMatrix::forMachine(*mach).get());
+    TS_ASSERT(first->isUpToDate(*mach));
+
+    // disconnect some output port from all of its buses
+    TTAMachine::Port* port = NULL;
+    for (TTAMachine::FunctionUnit* fu : mach->functionUnitNavigator()) {
+        for (int i = 0; i < fu->portCount() && port == NULL; ++i) {
+            if (fu->port(i)->outputSocket() != NULL) {
+                port = fu->port(i);
+            }
+        }
+    }
+    TS_ASSERT(port != NULL);
+    port->detachSocket(*port->outputSocket());
+
+    TS_ASSERT(!first->isUpToDate(*mach));
+    MachineConnectivityMatrix::Handle second =
+        MachineConnectivityMatrix::forMachine(*mach);
+    TS_ASSERT_DIFFERS(first.get(), second.get());
+    for (const TTAMachine::Port* dst : allPorts(*mach)) {
+        TS_ASSERT(!second->isConnected(*port, *dst));
+    }
+    delete mach;
+}
+
+/**
+ * Tests that the shared matrix of a deleted machine is not returned for a
+ * machine created in its place.
+ */
+void
+MachineConnectivityMatrixTest::testDeletedMachine() {
+    TTAMachine::Machine* mach = TTAMachine::Machine::loadFromADF(ADF);
+    MachineConnectivityMatrix::Handle first =
+        MachineConnectivityMatrix::forMachine(*mach);
+    delete mach;
+
+    mach = TTAMachine::Machine::loadFromADF(ADF);
+    MachineConnectivityMatrix::Handle second =
+        MachineConnectivityMatrix::forMachine(*mach);
+    TS_ASSERT_DIFFERS(first.get(), second.get());
+    TS_ASSERT(!first->isUpToDate(*mach));
+    TS_ASSERT(second->isUpToDate(*mach));
+    delete mach;
+}
+
+#endif
@@ -51,6 +51,8 @@ public:
     
     void testRootNodeFinding();
     void testEdgeMoving();
+    void testPathFinding();
+    void testPathLengths();
 
 private:
     typedef BoostGraph<GraphNode, GraphEdge> TestGraph;
@@ -167,4 +169,112 @@ BoostGraphTest::testEdgeMoving() {
     TS_ASSERT_EQUALS(testGraph_.outDegree(*node0_), 3);
 }
 
+/**
+ * Test that the cached path queries agree with the uncached ones when
+ * the graph is modified.
+ */
+void
+BoostGraphTest::testPathFinding() {
+
+    TestGraph graph;
+    const int nodeCount = 70;
+    std::vector<GraphNode*> nodes;
+    for (int i = 0; i < nodeCount; ++i) {
+        nodes.push_back(new GraphNode(i));
+        graph.addNode(*nodes.back());
+    }
+    // a chain with a gap
+    for (int i = 0; i < nodeCount - 1; ++i) {
+        if (i != 40) {
+            graph.connectNodes(*nodes[i], *nodes[i + 1], *new GraphEdge);
+        }
+    }
+
+    graph.findAllPaths();
+    TS_ASSERT(graph.hasPath(*nodes[0], *nodes[40]));
+    TS_ASSERT(graph.hasPath(*nodes[41], *nodes[nodeCount - 1]));
+    TS_ASSERT(!graph.hasPath(*nodes[0], *nodes[41]));
+    TS_ASSERT(!graph.hasPath(*nodes[nodeCount - 1], *nodes[0]));
+
+    // new edges and nodes update the cache
+    GraphNode* extra = new GraphNode(nodeCount);
+    nodes.push_back(extra);
+    graph.addNode(*extra);
+    graph.connectNodes(*nodes[40], *extra, *new GraphEdge);
+    graph.connectNodes(*extra, *nodes[41], *new GraphEdge);
+    TS_ASSERT(graph.hasPath(*nodes[0], *nodes[nodeCount - 1]));
+    TS_ASSERT(graph.hasPath(*nodes[3], *extra));
+    TS_ASSERT(!graph.hasPath(*extra, *nodes[40]));
+
+    // removals drop the cache, the answers stay the same
+    graph.disconnectNodes(*extra, *nodes[41]);
+    TS_ASSERT(!graph.hasPath(*nodes[0], *nodes[41]));
+    graph.findAllPaths();
+    TS_ASSERT(!graph.hasPath(*nodes[0], *nodes[41]));
+    TS_ASSERT(graph.hasPath(*nodes[0], *extra));
+
+    for (int i = 0; i < nodeCount; ++i) {
+        for (int j = 0; j < nodeCount; ++j) {
+            bool expected = i == j || (i < j && (j <= 40 || i > 40));
+            TS_ASSERT_EQUALS(graph.hasPath(*nodes[i], *nodes[j]), expected);
+        }
+    }
+    for (int i = 0; i < nodeCount + 1; ++i) {
+        graph.removeNode(*nodes[i]);
+        delete nodes[i];
+    }
+}
+
+/**
+ * Test that the path lengths of an acyclic graph are the same whether
+ * computed from the compact snapshot or with the general algorithms.
+ */
+void
+BoostGraphTest::testPathLengths() {
+
+    // loop edges disallowed: the compact snapshot is used.
+    TestGraph acyclic(false);
+    // loop edges allowed: the general algorithms are used.
+    TestGraph general(true);
+    const int nodeCount = 30;
+    std::vector<GraphNode*> nodes;
+    for (int i = 0; i < nodeCount; ++i) {
+        nodes.push_back(new GraphNode(i));
+        acyclic.addNode(*nodes.back());
+        general.addNode(*nodes.back());
+    }
+    // a chain, shortcuts over it and a separate short chain at the end
+    for (int i = 0; i < nodeCount - 5; ++i) {
+        acyclic.connectNodes(*nodes[i], *nodes[i + 1], *new GraphEdge);
+        general.connectNodes(*nodes[i], *nodes[i + 1], *new GraphEdge);
+        if (i % 3 == 0 && i + 4 < nodeCount - 4) {
+            acyclic.connectNodes(*nodes[i], *nodes[i + 4], *new GraphEdge);
+            general.connectNodes(*nodes[i], *nodes[i + 4], *new GraphEdge);
+        }
+    }
+    for (int i = nodeCount - 4; i < nodeCount - 1; ++i) {
+        acyclic.connectNodes(*nodes[i], *nodes[i + 1], *new GraphEdge);
+        general.connectNodes(*nodes[i], *nodes[i + 1], *new GraphEdge);
+    }
+
+    TS_ASSERT_EQUALS(acyclic.height(), nodeCount - 5);
+    TS_ASSERT_EQUALS(acyclic.height(), general.height());
+    for (int i = 0; i < nodeCount; ++i) {
+        TS_ASSERT_EQUALS(
+            acyclic.maxSourceDistance(*nodes[i]),
+            general.maxSourceDistance(*nodes[i]));
+        TS_ASSERT_EQUALS(
+            acyclic.maxSinkDistance(*nodes[i]),
+            general.maxSinkDistance(*nodes[i]));
+    }
+    TS_ASSERT_EQUALS(acyclic.maxSourceDistance(*nodes[7]), 7);
+    TS_ASSERT_EQUALS(acyclic.maxSinkDistance(*nodes[nodeCount - 4]), 3);
+
+    for (int i = 0; i < nodeCount; ++i) {
+        acyclic.removeNode(*nodes[i]);
+        general.removeNode(*nodes[i]);
+        delete nodes[i];
+    }
+}
+
 #endif
@@ -0,0 +1,108 @@
+/*
+    Copyright (c) 2002-2026 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file MachineCopyBenchMarkTest.hh
+ *
+ * A benchmark for copying large machines with the copy constructor
+ * compared to a round trip through an ObjectState tree.
+ *
+ * @note rating: red
+ */
+
+#ifndef MACHINE_COPY_BENCHMARK_TEST_HH
+#define MACHINE_COPY_BENCHMARK_TEST_HH
+
+#include <TestSuite.h>
+
+#include <chrono>
+#include <string>
+
+#include "Application.hh"
+#include "Machine.hh"
+#include "ObjectState.hh"
+
+class MachineCopyBenchMarkTest : public CxxTest::TestSuite {
+public:
+    void testCopy();
+private:
+    void benchmark(const std::string& adfFile);
+};
+
+//#define BENCHMARKING_ENABLED
+
+#define COPY_ROUNDS 100
+
+/// The machines of the scheduler testbench are used as the test data.
+#define TESTBENCH_ADF_DIR "../../../../scheduler/testbench/ADF/"
+
+/**
+ * Copies the machine of the given ADF repeatedly with both methods and
+ * logs the average times.
+ *
+ * @param adfFile The ADF to copy.
+ */
+void
+MachineCopyBenchMarkTest::benchmark(const std::string& adfFile) {
+
+    TTAMachine::Machine* original =
+        TTAMachine::Machine::loadFromADF(adfFile);
+
+    auto timer = std::chrono::steady_clock::now();
+    for (int i = 0; i < COPY_ROUNDS; ++i) {
+        ObjectState* state = original->saveState();
+        TTAMachine::Machine copy;
+        copy.loadState(state);
+        delete state;
+    }
+    double stateTime = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - timer).count();
+
+    timer = std::chrono::steady_clock::now();
+    for (int i = 0; i < COPY_ROUNDS; ++i) {
+        TTAMachine::Machine copy(*original);
+    }
+    double copyTime = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - timer).count();
+
+    Application::logStream()
+        << adfFile << ": ObjectState round trip "
+        << stateTime / COPY_ROUNDS * 1000 << " ms, copy constructor "
+        << copyTime / COPY_ROUNDS * 1000 << " ms (average of "
+        << COPY_ROUNDS << ")" << std::endl;
+
+    delete original;
+}
+
+/**
+ * Runs the machine copying benchmark.
+ */
+void
+MachineCopyBenchMarkTest::testCopy() {
+#ifdef BENCHMARKING_ENABLED
+    benchmark(TESTBENCH_ADF_DIR "ti64x_subset_fc.adf");
+    benchmark(TESTBENCH_ADF_DIR "huge.adf");
+#endif
+}
+
+#endif
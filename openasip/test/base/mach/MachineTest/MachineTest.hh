@@ -34,6 +34,7 @@
 
 #include <string>
 #include <climits>
+#include <vector>
 
 #include <TestSuite.h>
 #include "Machine.hh"
@@ -51,10 +52,15 @@
 #include "InstructionTemplate.hh"
 #include "Exception.hh"
 #include "ObjectState.hh"
+#include "Guard.hh"
+#include "Conversion.hh"
 
 using std::string;
 using namespace TTAMachine;
 
+/// The machines of the scheduler testbench.
+#define TESTBENCH_ADF_DIR "../../../../scheduler/testbench/ADF/"
+
 /**
  * Test suite for testing Machine class.
  */
@@ -70,6 +76,8 @@ public:
     void testAddAndDeleteAddressSpace();
     void testAddingFUAndGCUOfSameName();
     void testSaveAndLoadState();
+    void testCopy();
+    void testFingerprint();
 
 private:
     Machine* mach_;
@@ -501,4 +509,106 @@ MachineTest::testSaveAndLoadState() {
     delete loadedMach;
 }
 
+/**
+ * Tests that copying a machine produces an equal, independent machine.
+ */
+void
+MachineTest::testCopy() {
+
+    Machine* original =
+        Machine::loadFromADF(
+            TESTBENCH_ADF_DIR "10_bus_full_connectivity.adf");
+
+    Machine copy(*original);
+    Machine copiedInto;
+    copiedInto.copyFromMachine(*original);
+    Machine copyOfCopy(copy);
+
+    TS_ASSERT_EQUALS(copy.hash(), original->hash());
+    TS_ASSERT_EQUALS(copiedInto.hash(), original->hash());
+    TS_ASSERT_EQUALS(copyOfCopy.hash(), original->hash());
+
+    // the copy must not refer to the components of the original
+    Machine::SocketNavigator socketNav = copy.socketNavigator();
+    for (int i = 0; i < socketNav.count(); i++) {
+        Socket* socket = socketNav.item(i);
+        for (int p = 0; p < socket->portCount(); p++) {
+            TS_ASSERT_EQUALS(
+                socket->port(p)->parentUnit()->machine(), &copy);
+        }
+        for (int s = 0; s < socket->segmentCount(); s++) {
+            TS_ASSERT_EQUALS(
+                socket->segment(s)->parentBus()->machine(), &copy);
+        }
+    }
+    Machine::BusNavigator busNav = copy.busNavigator();
+    for (int i = 0; i < busNav.count(); i++) {
+        Bus* bus = busNav.item(i);
+        for (int g = 0; g < bus->guardCount(); g++) {
+            PortGuard* guard = dynamic_cast<PortGuard*>(bus->guard(g));
+            if (guard != NULL) {
+                TS_ASSERT_EQUALS(
+                    guard->port()->parentUnit()->machine(), &copy);
+            }
+        }
+    }
+
+    const TCEString hash = original->hash();
+    delete original;
+    TS_ASSERT_EQUALS(copy.hash(), hash);
+}
+
+/**
+ * Tests that the fingerprint does not depend on the names and order of
+ * the components, but does depend on their structure.
+ */
+void
+MachineTest::testFingerprint() {
+
+    Machine* original =
+        Machine::loadFromADF(
+            TESTBENCH_ADF_DIR "10_bus_full_connectivity.adf");
+    Machine renamed(*original);
+
+    Machine::BusNavigator busNav = renamed.busNavigator();
+    std::vector<Bus*> buses;
+    for (int i = 0; i < busNav.count(); i++) {
+        buses.push_back(busNav.item(i));
+    }
+    for (std::size_t i = 0; i < buses.size(); i++) {
+        buses[i]->setName("renamed_bus" + Conversion::toString(i));
+        renamed.setBusPosition(*buses[i], buses.size() - 1 - i);
+    }
+    Machine::SocketNavigator socketNav = renamed.socketNavigator();
+    for (int i = 0; i < socketNav.count(); i++) {
+        socketNav.item(i)->setName(
+            "renamed_socket" + Conversion::toString(i));
+    }
+    Machine::FunctionUnitNavigator fuNav = renamed.functionUnitNavigator();
+    for (int i = 0; i < fuNav.count(); i++) {
+        fuNav.item(i)->setName("renamed_fu" + Conversion::toString(i));
+    }
+    Machine::RegisterFileNavigator rfNav = renamed.registerFileNavigator();
+    for (int i = 0; i < rfNav.count(); i++) {
+        rfNav.item(i)->setName("renamed_rf" + Conversion::toString(i));
+    }
+
+    TS_ASSERT_DIFFERS(renamed.hash(), original->hash());
+    TS_ASSERT_EQUALS(renamed.fingerprint(), original->fingerprint());
+
+    // structural changes change the fingerprint
+    Machine resized(*original);
+    RegisterFile* rf = resized.registerFileNavigator().item(0);
+    rf->setNumberOfRegisters(rf->numberOfRegisters() + 1);
+    TS_ASSERT_DIFFERS(resized.fingerprint(), original->fingerprint());
+
+    Machine reconnected(*original);
+    Socket* socket = reconnected.socketNavigator().item(0);
+    TS_ASSERT(socket->segmentCount() > 0);
+    socket->detachBus(*socket->segment(0));
+    TS_ASSERT_DIFFERS(reconnected.fingerprint(), original->fingerprint());
+
+    delete original;
+}
+
 #endif
@@ -35,7 +35,10 @@
 
 #include <TestSuite.h>
 
+#include <vector>
+
 #include "IdealSRAM.hh"
+#include "Exception.hh"
 
 /**
  * Class for testing IdealSRAM.
@@ -46,6 +49,7 @@ public:
     void tearDown();
 
     void testBasicInterface();
+    void testBlockInterface();
 
 private:
     /// Starting point of the memory.
@@ -126,5 +130,51 @@ IdealSRAMTest::testBasicInterface() {
     TS_ASSERT_DELTA(d, 123.123, 0.1);
 }
 
+/**
+ * Tests that the block methods write and read the memory directly also
+ * across the page boundaries of the storage.
+ */
+void
+IdealSRAMTest::testBlockInterface() {
+
+    IdealSRAM memory(0, 9999, MAUSIZE, false);
+
+    const std::size_t count = 3000;
+    std::vector<Memory::MAU> data(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        data[i] = i % 256;
+    }
+    memory.writeBlock(1000, &data[0], count);
+
+    // block writes are visible without advancing the clock
+    ULongWord result;
+    memory.read(1000 + 1500, 1, result);
+    TS_ASSERT_EQUALS(result, static_cast<ULongWord>(1500 % 256));
+
+    std::vector<Memory::MAU> readData(count + 20, 1);
+    memory.readBlock(990, &readData[0], count + 20);
+    for (std::size_t i = 0; i < 10; ++i) {
+        TS_ASSERT_EQUALS(readData[i], static_cast<Memory::MAU>(0));
+        TS_ASSERT_EQUALS(
+            readData[count + 10 + i], static_cast<Memory::MAU>(0));
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        TS_ASSERT_EQUALS(readData[10 + i], data[i]);
+    }
+
+    memory.fill(2000, 7, 100);
+    memory.fill(8000, 0, 1500);
+    TS_ASSERT_EQUALS(memory.read(1999), static_cast<Memory::MAU>(999 % 256));
+    TS_ASSERT_EQUALS(memory.read(2000), static_cast<Memory::MAU>(7));
+    TS_ASSERT_EQUALS(memory.read(2099), static_cast<Memory::MAU>(7));
+    TS_ASSERT_EQUALS(memory.read(2100), static_cast<Memory::MAU>(1100 % 256));
+    TS_ASSERT_EQUALS(memory.read(9000), static_cast<Memory::MAU>(0));
+
+    TS_ASSERT_THROWS(memory.writeBlock(9990, &data[0], 20), OutOfRange);
+    TS_ASSERT_THROWS(memory.readBlock(10000, &readData[0], 1), OutOfRange);
+    // empty blocks are accepted anywhere
+    memory.fill(20000, 1, 0);
+}
+
 
 #endif
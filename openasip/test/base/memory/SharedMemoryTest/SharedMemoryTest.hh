@@ -0,0 +1,248 @@
+/*
+    Copyright (c) 2002-2026 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file SharedMemoryTest.hh
+ *
+ * A test suite for SharedMemory.
+ *
+ * @note rating: red
+ */
+
+#ifndef SHARED_MEMORY_TEST_HH
+#define SHARED_MEMORY_TEST_HH
+
+#include <TestSuite.h>
+
+#include <thread>
+#include <vector>
+
+#include "SharedMemory.hh"
+#include "IdealSRAM.hh"
+#include "MemoryProxy.hh"
+#include "SimulatorFrontend.hh"
+#include "Exception.hh"
+
+/**
+ * Class for testing SharedMemory.
+ */
+class SharedMemoryTest : public CxxTest::TestSuite {
+public:
+    void setUp();
+    void tearDown();
+
+    void testCommitOrder();
+    void testBanks();
+    void testAccessTracking();
+};
+
+/**
+ * Called before each test.
+ */
+void
+SharedMemoryTest::setUp() {
+}
+
+/**
+ * Called after each test.
+ */
+void
+SharedMemoryTest::tearDown() {
+}
+
+/**
+ * Tests that the writes of the cores are buffered until the clock edge
+ * and committed in the order given by the conflict policy.
+ */
+void
+SharedMemoryTest::testCommitOrder() {
+
+    SharedMemory::MemoryPtr storage(new IdealSRAM(0, 4095, 8, false));
+    SharedMemory memory(storage);
+    SharedMemory::MemoryPtr core1 = memory.addCore();
+    SharedMemory::MemoryPtr core2 = memory.addCore();
+    TS_ASSERT_EQUALS(memory.coreCount(), 3u);
+
+    ULongWord result;
+    memory.write(100, 1, 1);
+    core1->write(100, 1, 2);
+    core2->write(100, 1, 3);
+    core1->write(200, 2, 0x1234);
+
+    // the cores neither see their own nor the others' writes yet
+    core1->advanceClock();
+    core1->read(100, 1, result);
+    TS_ASSERT_EQUALS(result, 0u);
+    memory.read(200, 2, result);
+    TS_ASSERT_EQUALS(result, 0u);
+
+    memory.advanceClock();
+    memory.read(100, 1, result);
+    TS_ASSERT_EQUALS(result, 3u);
+    core2->read(200, 2, result);
+    TS_ASSERT_EQUALS(result, 0x1234u);
+
+    // the buffers are cleared at the clock edge
+    core1->write(300, 1, 5);
+    memory.advanceClock();
+    memory.advanceClock();
+    core2->read(300, 1, result);
+    TS_ASSERT_EQUALS(result, 5u);
+    TS_ASSERT_EQUALS(core2->read(100), 3);
+
+    // reset drops the pending writes of all the cores
+    core2->write(400, 1, 7);
+    memory.reset();
+    memory.advanceClock();
+    TS_ASSERT_EQUALS(memory.read(400), 0);
+
+    SharedMemory::MemoryPtr storage2(new IdealSRAM(0, 4095, 8, false));
+    SharedMemory first(storage2, SharedMemory::FIRST_CORE_WINS);
+    SharedMemory::MemoryPtr port = first.addCore();
+    port->write(100, 1, 2);
+    first.write(100, 1, 1);
+    port->write(101, 1, 2);
+    first.advanceClock();
+    TS_ASSERT_EQUALS(port->read(100), 1);
+    TS_ASSERT_EQUALS(port->read(101), 2);
+}
+
+/**
+ * Tests that the banks can be committed separately and in parallel.
+ */
+void
+SharedMemoryTest::testBanks() {
+
+    const int pageSize = 1024;
+    SharedMemory::MemoryPtr storage(
+        new IdealSRAM(0, 16 * pageSize - 1, 8, false));
+    SharedMemory memory(storage, SharedMemory::LAST_CORE_WINS, 4);
+    TS_ASSERT_EQUALS(memory.bankCount(), 4u);
+    TS_ASSERT_THROWS(memory.commitBank(4), OutOfRange);
+
+    // a bank is at least a page of the storage
+    SharedMemory::MemoryPtr small(new IdealSRAM(0, 99, 8, false));
+    TS_ASSERT_EQUALS(SharedMemory(small, SharedMemory::LAST_CORE_WINS, 4)
+                     .bankCount(), 1u);
+    SharedMemory::MemoryPtr large(
+        new IdealSRAM(0, 16 * pageSize - 1, 8, false));
+    TS_ASSERT_EQUALS(SharedMemory(large, SharedMemory::LAST_CORE_WINS, 100)
+                     .bankCount(), 16u);
+
+    const int coreCount = 4;
+    std::vector<Memory*> cores;
+    cores.push_back(&memory);
+    std::vector<SharedMemory::MemoryPtr> ports;
+    for (int i = 1; i < coreCount; ++i) {
+        ports.push_back(memory.addCore());
+        cores.push_back(ports.back().get());
+    }
+
+    // each core writes its own words and one word shared by all cores,
+    // the shared word crosses the first bank boundary
+    std::vector<std::thread> threads;
+    for (int core = 0; core < coreCount; ++core) {
+        threads.push_back(std::thread([&cores, core]() {
+            for (int i = 0; i < 1000; ++i) {
+                cores[core]->write(16 * i + 4 * core, 4, i * 10 + core);
+            }
+            cores[core]->write(4 * 1024 - 2, 4, 0x11111111 * (core + 1));
+        }));
+    }
+    for (std::size_t i = 0; i < threads.size(); ++i) {
+        threads[i].join();
+    }
+    threads.clear();
+
+    for (unsigned bank = 0; bank < memory.bankCount(); ++bank) {
+        threads.push_back(std::thread([&memory, bank]() {
+            memory.commitBank(bank);
+        }));
+    }
+    for (std::size_t i = 0; i < threads.size(); ++i) {
+        threads[i].join();
+    }
+    memory.clearWriteBuffers();
+
+    ULongWord result;
+    for (int core = 0; core < coreCount; ++core) {
+        for (int i = 0; i < 1000; ++i) {
+            if (16 * i + 4 * core + 3 >= 4 * 1024 - 2 &&
+                16 * i + 4 * core <= 4 * 1024 + 1) {
+                continue;
+            }
+            memory.read(16 * i + 4 * core, 4, result);
+            TS_ASSERT_EQUALS(result, static_cast<ULongWord>(i * 10 + core));
+        }
+    }
+    memory.read(4 * 1024 - 2, 4, result);
+    TS_ASSERT_EQUALS(result, 0x44444444u);
+
+    // committed writes are not committed again
+    storage->write(0, 1, 0xff);
+    storage->advanceClock();
+    memory.advanceClock();
+    TS_ASSERT_EQUALS(memory.read(0), 0xff);
+
+    // advancing the clock commits all the banks at once
+    SharedMemory first(large, SharedMemory::FIRST_CORE_WINS, 4);
+    SharedMemory::MemoryPtr second = first.addCore();
+    first.write(4 * 1024 - 2, 4, 0x11111111);
+    second->write(4 * 1024 - 2, 4, 0x22222222);
+    second->write(12 * 1024, 4, 0x33333333);
+    first.advanceClock();
+    first.read(4 * 1024 - 2, 4, result);
+    TS_ASSERT_EQUALS(result, 0x11111111u);
+    first.read(12 * 1024, 4, result);
+    TS_ASSERT_EQUALS(result, 0x33333333u);
+}
+
+/**
+ * Tests that the clock edge reaches an access tracking proxy wrapped by
+ * the shared memory.
+ */
+void
+SharedMemoryTest::testAccessTracking() {
+
+    SimulatorFrontend frontend;
+    MemoryProxy* proxy =
+        new MemoryProxy(frontend, new IdealSRAM(0, 4095, 8, false));
+    SharedMemory memory((SharedMemory::MemoryPtr(proxy)));
+    SharedMemory::MemoryPtr core1 = memory.addCore();
+
+    memory.write(0, 4, 1);
+    core1->write(8, 2, 2);
+    ULongWord result;
+    memory.read(16, 4, result);
+    memory.advanceClock();
+
+    TS_ASSERT_EQUALS(proxy->writeAccessCount(), 6u);
+    TS_ASSERT_EQUALS(proxy->readAccessCount(), 4u);
+
+    // the accesses of the previous cycle are forgotten
+    memory.advanceClock();
+    TS_ASSERT_EQUALS(proxy->writeAccessCount(), 0u);
+    TS_ASSERT_EQUALS(proxy->readAccessCount(), 0u);
+}
+
+#endif
@@ -44,6 +44,8 @@ using std::endl;
 #include <vector>
 using std::vector;
 
+#include <algorithm>
+
 #include <TestSuite.h>
 
 #include "PluginTools.hh"
@@ -78,6 +80,7 @@ public:
     void testContextId();
     void testClockedOperation();
     void testExtend();
+    void testVectorOperations();
 
 private:
     OperationBehavior* loadBehavior( 
@@ -554,4 +557,102 @@ LanguageTest::testExtend() {
     deleteBehavior("extend", "Z_EXTEND", zero_extend);
 }
 
+/**
+ * Tests the lane-wise vector operation macros against the element
+ * accessors of SimValue.
+ */
+void
+LanguageTest::testVectorOperations() {
+
+    OperationContext context;
+    const char* opNames[] = {
+        "VADD32", "VSUB8", "VMUL16", "VMUL32", "VFADD", "VXOR", "VMAX32"};
+    const int opCount = sizeof(opNames) / sizeof(opNames[0]);
+
+    // 512 bits uses whole host vectors, 288 bits leaves a tail of lanes
+    const int widths[] = {512, 288};
+    for (int w = 0; w < 2; ++w) {
+        const int width = widths[w];
+        SimValue input1(width);
+        SimValue input2(width);
+        for (int i = 0; i < width / 32; ++i) {
+            input1.setWordElement(i, 0x9e3779b9u * (i + 1));
+            input2.setWordElement(i, 0x7f4a7c15u * (i + 3) + 0xffff);
+        }
+        // floats in the even lanes, the odd ones can be NaNs
+        for (int i = 0; i < width / 32; i += 2) {
+            input1.setFloatElement(i, 1.5f * i);
+            input2.setFloatElement(i, 0.25f * i - 3.0f);
+        }
+        for (int op = 0; op < opCount; ++op) {
+            SimValue result(width);
+            vector<SimValue*> arguments;
+            arguments.push_back(&input1);
+            arguments.push_back(&input2);
+            arguments.push_back(&result);
+
+            OperationBehavior* behavior = loadBehavior("vector", opNames[op]);
+            simulateTrigger(behavior, arguments, context);
+            deleteBehavior("vector", opNames[op], behavior);
+
+            const string name = opNames[op];
+            for (int i = 0; i < width / 32; ++i) {
+                if (name == "VADD32") {
+                    TS_ASSERT_EQUALS(
+                        result.wordElement(i),
+                        input1.wordElement(i) + input2.wordElement(i));
+                } else if (name == "VMUL32") {
+                    TS_ASSERT_EQUALS(
+                        result.wordElement(i),
+                        input1.wordElement(i) * input2.wordElement(i));
+                } else if (name == "VFADD" && i % 2 == 0) {
+                    TS_ASSERT_EQUALS(
+                        result.floatElement(i),
+                        input1.floatElement(i) + input2.floatElement(i));
+                } else if (name == "VMAX32") {
+                    TS_ASSERT_EQUALS(
+                        result.sIntWordElement(i),
+                        std::max(
+                            input1.sIntWordElement(i),
+                            input2.sIntWordElement(i)));
+                }
+            }
+            for (int i = 0; i < width / 16; ++i) {
+                if (name == "VMUL16") {
+                    TS_ASSERT_EQUALS(
+                        result.halfWordElement(i),
+                        HalfWord(
+                            unsigned(input1.halfWordElement(i)) *
+                            unsigned(input2.halfWordElement(i))));
+                }
+            }
+            for (int i = 0; i < width / 8; ++i) {
+                if (name == "VSUB8") {
+                    TS_ASSERT_EQUALS(
+                        result.byteElement(i),
+                        Byte(input1.byteElement(i) - input2.byteElement(i)));
+                } else if (name == "VXOR" && i < width / 64 * 8) {
+                    // only whole 64-bit lanes are computed
+                    TS_ASSERT_EQUALS(
+                        result.byteElement(i),
+                        input1.byteElement(i) ^ input2.byteElement(i));
+                }
+            }
+        }
+
+        SimValue scalar(32);
+        scalar = 0xdeadbeefu;
+        SimValue result(width);
+        vector<SimValue*> arguments;
+        arguments.push_back(&scalar);
+        arguments.push_back(&result);
+        OperationBehavior* bcast = loadBehavior("vector", "VBCAST32");
+        simulateTrigger(bcast, arguments, context);
+        deleteBehavior("vector", "VBCAST32", bcast);
+        for (int i = 0; i < width / 32; ++i) {
+            TS_ASSERT_EQUALS(result.wordElement(i), 0xdeadbeefu);
+        }
+    }
+}
+
 #endif
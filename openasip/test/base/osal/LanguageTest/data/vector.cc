@@ -0,0 +1,84 @@
+/*
+    Copyright (c) 2002-2026 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file vector.cc
+ *
+ * Test: vector operations that use the lane-wise vector macros.
+ *
+ * The lane counts follow from the width of the output operand.
+ *
+ * @note rating: red
+ */
+
+#include "OSAL.hh"
+
+OPERATION(VADD32)
+TRIGGER
+    VECTOR_ADD(UIntWord, 3, 1, 2);
+END_TRIGGER;
+END_OPERATION(VADD32)
+
+OPERATION(VSUB8)
+TRIGGER
+    VECTOR_SUB(Byte, 3, 1, 2);
+END_TRIGGER;
+END_OPERATION(VSUB8)
+
+OPERATION(VMUL16)
+TRIGGER
+    VECTOR_MUL(HalfWord, 3, 1, 2);
+END_TRIGGER;
+END_OPERATION(VMUL16)
+
+OPERATION(VMUL32)
+TRIGGER
+    VECTOR_MUL(UIntWord, 3, 1, 2);
+END_TRIGGER;
+END_OPERATION(VMUL32)
+
+OPERATION(VFADD)
+TRIGGER
+    VECTOR_ADD(FloatWord, 3, 1, 2);
+END_TRIGGER;
+END_OPERATION(VFADD)
+
+OPERATION(VXOR)
+TRIGGER
+    VECTOR_XOR(ULongWord, 3, 1, 2);
+END_TRIGGER;
+END_OPERATION(VXOR)
+
+OPERATION(VBCAST32)
+TRIGGER
+    VECTOR_BCAST(UIntWord, 2, UINT(1));
+END_TRIGGER;
+END_OPERATION(VBCAST32)
+
+OPERATION(VMAX32)
+TRIGGER
+    VECTOR_LANEWISE2(
+        SIntWord, 3, 1, 2, [](SIntWord a, SIntWord b) {
+            return a > b ? a : b; });
+END_TRIGGER;
+END_OPERATION(VMAX32)
@@ -53,6 +53,7 @@ public:
     void testExecuteInstruction32Negative();
     void testExecuteInstruction64Positive();
     void testExecuteInstruction64Negative();
+    void testResolvedOperations();
 
 private:
     const char* machine_file_path = "data/machine.adf";
@@ -384,4 +385,80 @@ InstructionExecutorTest::testExecuteInstruction64Negative() {
     }
 }
 
+void
+InstructionExecutorTest::testResolvedOperations() {
+    char* error = nullptr;
+    const uint32_t expected[3] = {12820, 1275068416, 76};
+
+    for (int op = 0; op < 3; ++op) {
+        RISCVOperationHandle* handle = nullptr;
+        int status = resolveOperation(opNames[op], &handle, &error);
+        TS_ASSERT_EQUALS(status, 0);
+        TS_ASSERT_DIFFERS(handle, nullptr);
+        TS_ASSERT_EQUALS(operationOutputCount(handle), 1u);
+
+        uint32_t result32 = 0;
+        status = executeOperation32(
+            handle, inputs32, inputCount, &result32, &error);
+        TS_ASSERT_EQUALS(status, 0);
+        TS_ASSERT_EQUALS(result32, expected[op]);
+
+        uint64_t result64 = 0;
+        status = executeOperation64(
+            handle, inputs64, inputCount, &result64, &error);
+        TS_ASSERT_EQUALS(status, 0);
+        TS_ASSERT_EQUALS(result64, expected[op]);
+
+        // the same inputs twice give the same result twice
+        const uint64_t batchInputs[6] = {
+            inputs64[0], inputs64[1], inputs64[2],
+            inputs64[0], inputs64[1], inputs64[2]};
+        uint64_t batchResults[2] = {0, 0};
+        status = executeOperationBatch64(
+            handle, batchInputs, inputCount, 2, batchResults, &error);
+        TS_ASSERT_EQUALS(status, 0);
+        TS_ASSERT_EQUALS(batchResults[0], expected[op]);
+        TS_ASSERT_EQUALS(batchResults[1], expected[op]);
+
+        const uint32_t batchInputs32[6] = {
+            inputs32[0], inputs32[1], inputs32[2],
+            inputs32[0], inputs32[1], inputs32[2]};
+        uint32_t batchResults32[2] = {0, 0};
+        status = executeOperationBatch32(
+            handle, batchInputs32, inputCount, 2, batchResults32, &error);
+        TS_ASSERT_EQUALS(status, 0);
+        TS_ASSERT_EQUALS(batchResults32[0], expected[op]);
+        TS_ASSERT_EQUALS(batchResults32[1], expected[op]);
+        TS_ASSERT_EQUALS(error, nullptr);
+
+        status = executeOperation32(handle, inputs32, 0, &result32, &error);
+        TS_ASSERT_EQUALS(status, -1);
+        TS_ASSERT_DIFFERS(error, nullptr);
+        if (error) {
+            free(error);
+            error = nullptr;
+        }
+
+        releaseOperation(handle);
+    }
+
+    RISCVOperationHandle* handle = nullptr;
+    int status = resolveOperation("unknown instruction", &handle, &error);
+    TS_ASSERT_EQUALS(status, -1);
+    TS_ASSERT_EQUALS(handle, nullptr);
+    TS_ASSERT_DIFFERS(error, nullptr);
+    if (error) {
+        free(error);
+        error = nullptr;
+    }
+
+    uint32_t result = 0;
+    status = executeOperation32(nullptr, inputs32, 3, &result, &error);
+    TS_ASSERT_EQUALS(status, -1);
+    TS_ASSERT_DIFFERS(error, nullptr);
+    if (error) {
+        free(error);
+    }
+}
+
 #endif /* INSTRUCTION_EXECUTOR_TEST_HH */
@@ -0,0 +1,158 @@
+/*
+    Copyright (c) 2002-2026 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file VectorBehaviorBenchMarkTest.hh
+ *
+ * A benchmark for vector-heavy operation behavior kernels computed with
+ * the SimValue element accessors compared to the lane-wise OSAL vector
+ * helpers.
+ *
+ * @note rating: red
+ */
+
+#ifndef VECTOR_BEHAVIOR_BENCHMARK_TEST_HH
+#define VECTOR_BEHAVIOR_BENCHMARK_TEST_HH
+
+#include <TestSuite.h>
+
+#include <chrono>
+#include <string>
+
+#include "Application.hh"
+#include "SimValue.hh"
+#include "OSALVector.hh"
+
+class VectorBehaviorBenchMarkTest : public CxxTest::TestSuite {
+public:
+    void testKernels();
+private:
+    void elementKernels(
+        const SimValue& a, const SimValue& b, SimValue& c, SimValue& d);
+    void lanewiseKernels(
+        const SimValue& a, const SimValue& b, SimValue& c, SimValue& d);
+};
+
+//#define BENCHMARKING_ENABLED
+
+#define KERNEL_ROUNDS 1000000
+
+/// Width of the vectors, that of the widest vector machines.
+#define VECTOR_WIDTH 512
+
+/**
+ * Computes the kernels one lane at a time through the element accessors,
+ * as the vector operation behaviors do with the SUBWORD macros.
+ *
+ * The kernels are a 32-bit integer add, an 8-bit subtract, a 16-bit
+ * multiply, a floating point multiply-add and a 64-bit xor.
+ */
+void
+VectorBehaviorBenchMarkTest::elementKernels(
+    const SimValue& a, const SimValue& b, SimValue& c, SimValue& d) {
+
+    for (int i = 0; i < VECTOR_WIDTH / 32; ++i) {
+        c.setWordElement(i, a.wordElement(i) + b.wordElement(i));
+    }
+    for (int i = 0; i < VECTOR_WIDTH / 8; ++i) {
+        d.setByteElement(i, a.byteElement(i) - c.byteElement(i));
+    }
+    for (int i = 0; i < VECTOR_WIDTH / 16; ++i) {
+        c.setHalfWordElement(
+            i, unsigned(d.halfWordElement(i)) * unsigned(b.halfWordElement(i)));
+    }
+    for (int i = 0; i < VECTOR_WIDTH / 32; ++i) {
+        d.setFloatElement(i, a.floatElement(i) * b.floatElement(i));
+    }
+    for (int i = 0; i < VECTOR_WIDTH / 32; ++i) {
+        d.setFloatElement(i, d.floatElement(i) + a.floatElement(i));
+    }
+    for (int i = 0; i < VECTOR_WIDTH / 32; ++i) {
+        c.setWordElement(i, c.wordElement(i) ^ d.wordElement(i));
+    }
+}
+
+/**
+ * Computes the same kernels with the lane-wise vector helpers.
+ */
+void
+VectorBehaviorBenchMarkTest::lanewiseKernels(
+    const SimValue& a, const SimValue& b, SimValue& c, SimValue& d) {
+
+    OSALVector::add<UIntWord>(a, b, c);
+    OSALVector::sub<Byte>(a, c, d);
+    OSALVector::mul<HalfWord>(d, b, c);
+    OSALVector::mul<FloatWord>(a, b, d);
+    OSALVector::add<FloatWord>(d, a, d);
+    OSALVector::bitXor<ULongWord>(c, d, c);
+}
+
+/**
+ * Checks that both kernel versions compute the same results and, when
+ * benchmarking is enabled, logs their average times.
+ */
+void
+VectorBehaviorBenchMarkTest::testKernels() {
+
+    SimValue a(VECTOR_WIDTH);
+    SimValue b(VECTOR_WIDTH);
+    for (int i = 0; i < VECTOR_WIDTH / 32; ++i) {
+        a.setFloatElement(i, 0.5f * i + 1.0f);
+        b.setFloatElement(i, 3.0f - 0.125f * i);
+    }
+    SimValue elementC(VECTOR_WIDTH);
+    SimValue elementD(VECTOR_WIDTH);
+    SimValue lanewiseC(VECTOR_WIDTH);
+    SimValue lanewiseD(VECTOR_WIDTH);
+
+    elementKernels(a, b, elementC, elementD);
+    lanewiseKernels(a, b, lanewiseC, lanewiseD);
+    for (int i = 0; i < VECTOR_WIDTH / 8; ++i) {
+        TS_ASSERT_EQUALS(elementC.byteElement(i), lanewiseC.byteElement(i));
+        TS_ASSERT_EQUALS(elementD.byteElement(i), lanewiseD.byteElement(i));
+    }
+
+#ifdef BENCHMARKING_ENABLED
+    auto timer = std::chrono::steady_clock::now();
+    for (int i = 0; i < KERNEL_ROUNDS; ++i) {
+        elementKernels(a, b, elementC, elementD);
+    }
+    double elementTime = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - timer).count();
+
+    timer = std::chrono::steady_clock::now();
+    for (int i = 0; i < KERNEL_ROUNDS; ++i) {
+        lanewiseKernels(a, b, lanewiseC, lanewiseD);
+    }
+    double lanewiseTime = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - timer).count();
+
+    Application::logStream()
+        << VECTOR_WIDTH << "-bit vector kernels: element accessors "
+        << elementTime / KERNEL_ROUNDS * 1e9 << " ns, lane-wise "
+        << lanewiseTime / KERNEL_ROUNDS * 1e9 << " ns (average of "
+        << KERNEL_ROUNDS << ")" << std::endl;
+#endif
+}
+
+#endif
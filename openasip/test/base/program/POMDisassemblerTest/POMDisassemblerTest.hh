@@ -0,0 +1,170 @@
+/*
+    Copyright (c) 2002-2026 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file POMDisassemblerTest.hh
+ *
+ * A test suite for POMDisassembler.
+ *
+ * @note rating: red
+ */
+
+#ifndef TTA_POM_DISASSEMBLER_TEST_HH
+#define TTA_POM_DISASSEMBLER_TEST_HH
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <TestSuite.h>
+
+#include "BinaryReader.hh"
+#include "BinaryStream.hh"
+#include "TPEFProgramFactory.hh"
+#include "POMDisassembler.hh"
+#include "Program.hh"
+#include "Procedure.hh"
+#include "UniversalMachine.hh"
+#include "FileSystem.hh"
+
+using namespace TTAProgram;
+using namespace TPEF;
+
+class POMDisassemblerTest : public CxxTest::TestSuite {
+public:
+    void setUp();
+    void tearDown();
+
+    void testStreamedProcedures();
+    void testBufferedFileOutput();
+
+private:
+    std::string procedureDisassembly(const Program& program);
+
+    static const std::string LINKED_A_OUT;
+    static const std::string OUTPUT_FILE;
+};
+
+const std::string POMDisassemblerTest::LINKED_A_OUT =
+    "data/linked_binary.aout";
+const std::string POMDisassemblerTest::OUTPUT_FILE = "data/output.S";
+
+/**
+ * Called before each test.
+ */
+void
+POMDisassemblerTest::setUp() {
+}
+
+/**
+ * Called after each test.
+ */
+void
+POMDisassemblerTest::tearDown() {
+    FileSystem::removeFileOrDirectory(OUTPUT_FILE);
+}
+
+/**
+ * Returns the disassembly of the procedures of a program one procedure
+ * at a time, the way tcedisasm used to print it.
+ */
+std::string
+POMDisassemblerTest::procedureDisassembly(const Program& program) {
+    POMDisassembler disassembler(program);
+    std::string disassembly;
+    for (int i = 0; i < program.procedureCount(); i++) {
+        disassembly +=
+            disassembler.disassembleProcedure(program.procedureAtIndex(i));
+    }
+    return disassembly;
+}
+
+/**
+ * Tests that the procedures written to a stream in chunks by threads
+ * equal the disassembly of the procedures one by one.
+ */
+void
+POMDisassemblerTest::testStreamedProcedures() {
+    BinaryStream aOutFile(LINKED_A_OUT);
+    Binary* binary = BinaryReader::readBinary(aOutFile);
+    TPEFProgramFactory factory(*binary, &UniversalMachine::instance());
+    Program* program = factory.build();
+    TS_ASSERT(program->procedureCount() > 1);
+
+    const std::string expected = procedureDisassembly(*program);
+    POMDisassembler disassembler(*program);
+    TS_ASSERT_EQUALS(disassembler.disassembleProcedures(), expected);
+
+    // chunks of one procedure split the program to more chunks than
+    // there are threads
+    const unsigned int threadCounts[] = {1, 2, 3, 8};
+    for (unsigned int i = 0; i < 4; i++) {
+        std::ostringstream defaultChunks;
+        disassembler.disassembleProcedures(defaultChunks, threadCounts[i]);
+        TS_ASSERT_EQUALS(defaultChunks.str(), expected);
+
+        std::ostringstream singleProcedureChunks;
+        disassembler.disassembleProcedures(
+            singleProcedureChunks, threadCounts[i], 1);
+        TS_ASSERT_EQUALS(singleProcedureChunks.str(), expected);
+    }
+
+    delete program;
+    delete binary;
+}
+
+/**
+ * Tests that the disassembly written to a file through a large stream
+ * buffer, as tcedisasm does, is byte-identical to the unbuffered one.
+ */
+void
+POMDisassemblerTest::testBufferedFileOutput() {
+    BinaryStream aOutFile(LINKED_A_OUT);
+    Binary* binary = BinaryReader::readBinary(aOutFile);
+    TPEFProgramFactory factory(*binary, &UniversalMachine::instance());
+    Program* program = factory.build();
+
+    const std::string expected = procedureDisassembly(*program);
+    {
+        std::vector<char> fileBuffer(1 << 20);
+        std::fstream file;
+        file.rdbuf()->pubsetbuf(&fileBuffer[0], fileBuffer.size());
+        file.open(
+            OUTPUT_FILE.c_str(), std::fstream::trunc | std::fstream::out);
+        TS_ASSERT(file.is_open());
+
+        POMDisassembler disassembler(*program);
+        disassembler.disassembleProcedures(file, 4, 1);
+    }
+
+    std::ifstream written(OUTPUT_FILE.c_str(), std::ios::binary);
+    std::ostringstream contents;
+    contents << written.rdbuf();
+    TS_ASSERT_EQUALS(contents.str().size(), expected.size());
+    TS_ASSERT(contents.str() == expected);
+
+    delete program;
+    delete binary;
+}
+
+#endif
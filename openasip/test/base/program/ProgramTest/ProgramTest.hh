@@ -46,6 +46,8 @@ using std::endl;
 #include "AddressSpace.hh"
 #include "Machine.hh"
 #include "GlobalScope.hh"
+#include "InstructionReference.hh"
+#include "InstructionReferenceManager.hh"
 
 using namespace TTAMachine;
 using namespace TTAProgram;
@@ -57,6 +59,7 @@ public:
     void testBasicFunctions();
     void testProcedureHandling();
     void testInstructionHandling();
+    void testReferenceMoving();
 };
 
 
@@ -296,4 +299,49 @@ ProgramTest::testInstructionHandling() {
     TS_ASSERT_EQUALS(&prog1.nextInstruction(*ins3), ins7);
 }
 
+/**
+ * Tests moving instruction references from a separate reference manager
+ * into the one of the program.
+ */
+void
+ProgramTest::testReferenceMoving() {
+
+    Machine dummy_mach;
+    AddressSpace as1("AS1", 32, 0, 99, dummy_mach);
+    Program prog1(as1);
+    UIntWord addr1 = 0;
+    Procedure* proc1 = new Procedure("proc1", as1, addr1);
+    prog1.addProcedure(proc1);
+    Instruction* ins1 = new Instruction;
+    Instruction* ins2 = new Instruction;
+    proc1->add(ins1);
+    proc1->add(ins2);
+
+    InstructionReferenceManager& progIrm = prog1.instructionReferenceManager();
+    InstructionReferenceManager irm;
+    InstructionReference* ref1 =
+        new InstructionReference(irm.createReference(*ins1));
+    InstructionReference ref2 = irm.createReference(*ins2);
+    InstructionReference ref3 = progIrm.createReference(*ins2);
+
+    irm.moveReferencesTo(progIrm);
+
+    TS_ASSERT(!irm.hasReference(*ins1));
+    TS_ASSERT(!irm.hasReference(*ins2));
+    TS_ASSERT(progIrm.hasReference(*ins1));
+    TS_ASSERT_EQUALS(progIrm.referenceCount(*ins1), 1u);
+    TS_ASSERT_EQUALS(progIrm.referenceCount(*ins2), 2u);
+    TS_ASSERT_EQUALS(&ref1->instruction(), ins1);
+    TS_ASSERT_EQUALS(&ref2.instruction(), ins2);
+
+    // the moved references are maintained by the new manager
+    Instruction* ins3 = new Instruction;
+    proc1->add(ins3);
+    progIrm.replace(*ins2, *ins3);
+    TS_ASSERT_EQUALS(&ref2.instruction(), ins3);
+    TS_ASSERT_EQUALS(&ref3.instruction(), ins3);
+    delete ref1;
+    TS_ASSERT(!progIrm.hasReference(*ins1));
+}
+
 #endif
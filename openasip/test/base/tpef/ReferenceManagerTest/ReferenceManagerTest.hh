@@ -85,6 +85,8 @@ public:
     void testInformDeletedSafePointer();
     void testMultipleReferenceRegistrationsForSameKey();
     void testCleanUp();
+    void testReferenceContexts();
+    void testReferencesOutsideContext();
 
 private:
     /// Null safepointable.
@@ -232,8 +234,10 @@ ReferenceManagerTest::testPointerRequestWithReferences() {
     
     // create dummy (fake) object references and request 
     // SafePointers for them
-    SafePointable* fake = reinterpret_cast<SafePointable*>(0x420);
-    SafePointable* fake2 = reinterpret_cast<SafePointable*>(0x421);
+    DummySafePointable fakeObject;
+    SafePointable* fake = &fakeObject;
+    DummySafePointable fake2Object;
+    SafePointable* fake2 = &fake2Object;
     SafePointable* fake3 = fake;
  
     SafePointer* a = CREATE_SAFEPOINTER(fake);
@@ -280,7 +284,8 @@ ReferenceManagerTest::testReferenceManagingUsingSIKeys() {
     }
 
     // make sure that initially there's no entry in reference map
-    SafePointable* fake = (SafePointable*)0x666;
+    DummySafePointable fakeObject;
+    SafePointable* fake = &fakeObject;
 
     TS_ASSERT_EQUALS(SafePointer::RMapAt(fake), 
 		     reinterpret_cast<SafePointerList*>(NULL));
@@ -311,7 +316,8 @@ inline void
 ReferenceManagerTest::testReferenceManagingWithPreReferences() {
 
     SectionIndexKey key(211, 21);
-    SafePointable* fake = reinterpret_cast<SafePointable*>(0x7777);
+    DummySafePointable fakeObject;
+    SafePointable* fake = &fakeObject;
 
     const unsigned int SAFEPOINTER_COUNT = 5;    
     SafePointer* sp[SAFEPOINTER_COUNT] = {
@@ -347,7 +353,8 @@ ReferenceManagerTest::testReferenceManagingWithPreReferences() {
 inline void 
 ReferenceManagerTest::testReferenceManagingWithAllKeyTypes() {
 
-    SafePointable* fake = reinterpret_cast<SafePointable*>(0x0700f001);
+    DummySafePointable fakeObject;
+    SafePointable* fake = &fakeObject;
     SectionIndexKey SIKey(53132, 122321);
     SectionOffsetKey SOKey(2231, 3421);
     SectionKey SKey(9465);
@@ -396,7 +403,8 @@ ReferenceManagerTest::testReferenceManagingWithAllKeyTypes() {
 inline void 
 ReferenceManagerTest::testReferenceManagingWhenReferencesRegistered() {
 
-    SafePointable* fake = reinterpret_cast<SafePointable*>(0x07cef001);
+    DummySafePointable fakeObject;
+    SafePointable* fake = &fakeObject;
     SectionIndexKey SIKey(53632, 12321221);
     SectionOffsetKey SOKey(2231, 3521);
     SectionKey SKey(9465);
@@ -427,7 +435,8 @@ ReferenceManagerTest::testReferenceManagingWhenReferencesRegistered() {
 inline void 
 ReferenceManagerTest::testObjectKeyLookupWhenKeysAreFound() {
 
-    SafePointable* fake = reinterpret_cast<SafePointable*>(0x07cef001);
+    DummySafePointable fakeObject;
+    SafePointable* fake = &fakeObject;
     SectionIndexKey SIKey(53632, 12321221);
     SectionOffsetKey SOKey(231, 321);
     SectionKey SKey(9435);
@@ -456,7 +465,8 @@ ReferenceManagerTest::testObjectKeyLookupWhenKeysAreFound() {
 inline void 
 ReferenceManagerTest::testObjectKeyLookupWhenKeysAreNotFound() {
 
-    SafePointable* fake = reinterpret_cast<SafePointable*>(0x07cef001);
+    DummySafePointable fakeObject;
+    SafePointable* fake = &fakeObject;
     SectionIndexKey SIKey(53632, 12321221);
     SectionOffsetKey SOKey(2231, 321);
     SectionKey SKey(9385);
@@ -487,8 +497,10 @@ ReferenceManagerTest::testObjectKeyLookupWhenKeysAreNotFound() {
 inline
 void 
 ReferenceManagerTest::testIsReferencedMethod() {
-    SafePointable* fake1 = reinterpret_cast<SafePointable*>(0x0712f341);
-    SafePointable* fake2 = reinterpret_cast<SafePointable*>(0x0712f342);
+    DummySafePointable fake1Object;
+    SafePointable* fake1 = &fake1Object;
+    DummySafePointable fake2Object;
+    SafePointable* fake2 = &fake2Object;
 
     SafePointer* test = CREATE_SAFEPOINTER(fake1);
     
@@ -508,7 +520,8 @@ ReferenceManagerTest::testIsReferencedMethod() {
 inline void 
 ReferenceManagerTest::testCleanupKeyTables() {
 
-    SafePointable* fake = reinterpret_cast<SafePointable*>(0x0712f341);
+    DummySafePointable fakeObject;
+    SafePointable* fake = &fakeObject;
     SectionIndexKey SIKey(58532, 342111);
     SectionOffsetKey SOKey(2431, 34331);
     SectionKey SKey(9165);
@@ -748,7 +761,8 @@ inline void
 ReferenceManagerTest::testCleanUp() {
 
     // make sure there's some garbage in all the maps
-    SafePointable* fake = reinterpret_cast<SafePointable*>(0x0712f341);
+    DummySafePointable fakeObject;
+    SafePointable* fake = &fakeObject;
     SectionIndexKey SIKey(58532, 342111);
     SectionOffsetKey SOKey(22231, 3331);
     SectionKey SKey(9465);
@@ -781,4 +795,93 @@ ReferenceManagerTest::testCleanUp() {
 }
 
 
+/**
+ * Test that references of different contexts are kept apart and that
+ * freeing a context frees only its references.
+ */
+inline void
+ReferenceManagerTest::testReferenceContexts() {
+
+    SectionIndexKey SIKey(0x12, 0x34);
+    DummySafePointable object;
+    SafePointer* defaultPointer = CREATE_SAFEPOINTER(SIKey);
+
+    ReferenceContext* context = new ReferenceContext();
+    SafePointer* contextPointer = NULL;
+    {
+        ActiveReferenceContext active(context);
+
+        TS_ASSERT_EQUALS(&ReferenceContext::current(), context);
+        TS_ASSERT_EQUALS(static_cast<int>(SafePointer::SIMap()->size()), 0);
+
+        contextPointer = CREATE_SAFEPOINTER(SIKey);
+        SafePointer::addObjectReference(SIKey, &object);
+        TS_ASSERT_EQUALS(contextPointer->pointer(), &object);
+        TS_ASSERT(SafePointer::isReferenced(&object));
+        TS_ASSERT_THROWS_NOTHING(SafePointer::resolve());
+    }
+
+    // the key of the default context is still unresolved, the object is
+    // referenced in its own context
+    TS_ASSERT_DIFFERS(&ReferenceContext::current(), context);
+    TS_ASSERT_EQUALS(defaultPointer->pointer(), nullSafePointable);
+    TS_ASSERT(SafePointer::isReferenced(&object));
+    TS_ASSERT_EQUALS(
+        static_cast<int>(SafePointer::SIMapAt(SIKey)->length()), 1);
+
+    // pointers outliving their context are detached from it
+    delete context;
+    context = NULL;
+    TS_ASSERT_THROWS_NOTHING(delete contextPointer);
+    contextPointer = NULL;
+
+    SafePointer::addObjectReference(SIKey, &object);
+    TS_ASSERT_EQUALS(defaultPointer->pointer(), &object);
+
+    delete defaultPointer;
+    defaultPointer = NULL;
+}
+
+/**
+ * Test that pointers to an object are updated when the object is deleted,
+ * whichever context is active while the pointers are created and the
+ * object is deleted.
+ */
+inline void
+ReferenceManagerTest::testReferencesOutsideContext() {
+
+    SectionIndexKey SIKey(0x21, 0x43);
+    DummySafePointable* object = new DummySafePointable();
+    ReferenceContext* context = new ReferenceContext();
+    SafePointer* contextPointer = NULL;
+    {
+        ActiveReferenceContext active(context);
+        contextPointer = CREATE_SAFEPOINTER(SIKey);
+        SafePointer::addObjectReference(SIKey, object);
+    }
+
+    // the pointer is kept in the context of the object
+    SafePointer* defaultPointer = CREATE_SAFEPOINTER(object);
+    TS_ASSERT_EQUALS(defaultPointer->pointer(), object);
+    TS_ASSERT(SafePointer::RMapAt(object) == NULL);
+    {
+        ActiveReferenceContext active(context);
+        TS_ASSERT_EQUALS(
+            static_cast<int>(SafePointer::RMapAt(object)->length()), 2);
+    }
+
+    // the object is deleted while the default context is active
+    delete object;
+    object = NULL;
+    TS_ASSERT_EQUALS(defaultPointer->pointer(), nullSafePointable);
+    TS_ASSERT_EQUALS(contextPointer->pointer(), nullSafePointable);
+
+    delete defaultPointer;
+    defaultPointer = NULL;
+    delete contextPointer;
+    contextPointer = NULL;
+    delete context;
+    context = NULL;
+}
+
 #endif
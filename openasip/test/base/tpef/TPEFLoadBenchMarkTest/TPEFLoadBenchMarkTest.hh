@@ -0,0 +1,113 @@
+/*
+    Copyright (c) 2002-2026 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file TPEFLoadBenchMarkTest.hh
+ *
+ * A benchmark for loading and freeing a large TPEF binary repeatedly.
+ *
+ * @note rating: red
+ */
+
+#ifndef TPEF_LOAD_BENCHMARK_TEST_HH
+#define TPEF_LOAD_BENCHMARK_TEST_HH
+
+#include <TestSuite.h>
+
+#include <chrono>
+#include <string>
+
+#include "Application.hh"
+#include "Binary.hh"
+#include "BinaryReader.hh"
+#include "BinaryStream.hh"
+#include "SafePointer.hh"
+
+class TPEFLoadBenchMarkTest : public CxxTest::TestSuite {
+public:
+    void testLoadAndFree();
+private:
+    void benchmark(const std::string& tpefFile);
+};
+
+//#define BENCHMARKING_ENABLED
+
+#define LOAD_ROUNDS 20
+
+/**
+ * Loads and frees the given binary repeatedly and logs the times of the
+ * first and the last rounds.
+ *
+ * Each binary keeps its references in a context of its own, so the
+ * bookkeeping of the default context must not grow and the later rounds
+ * must not get slower.
+ *
+ * @param tpefFile The binary to load.
+ */
+void
+TPEFLoadBenchMarkTest::benchmark(const std::string& tpefFile) {
+
+    using TPEF::ReferenceManager::SafePointer;
+
+    const size_t defaultReferences = SafePointer::RMap()->size();
+    const size_t defaultSectionOffsets = SafePointer::SOMap()->size();
+
+    double firstTime = 0;
+    double lastTime = 0;
+    double totalTime = 0;
+    for (int i = 0; i < LOAD_ROUNDS; ++i) {
+        auto timer = std::chrono::steady_clock::now();
+        TPEF::BinaryStream stream(tpefFile);
+        TPEF::Binary* binary = TPEF::BinaryReader::readBinary(stream);
+        delete binary;
+        double time = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - timer).count();
+
+        if (i == 0) {
+            firstTime = time;
+        }
+        lastTime = time;
+        totalTime += time;
+    }
+
+    TS_ASSERT_EQUALS(SafePointer::RMap()->size(), defaultReferences);
+    TS_ASSERT_EQUALS(SafePointer::SOMap()->size(), defaultSectionOffsets);
+
+    Application::logStream()
+        << tpefFile << ": load and free first round "
+        << firstTime * 1000 << " ms, last round " << lastTime * 1000
+        << " ms, average " << totalTime / LOAD_ROUNDS * 1000 << " ms ("
+        << LOAD_ROUNDS << " rounds)" << std::endl;
+}
+
+/**
+ * Runs the binary loading benchmark.
+ */
+void
+TPEFLoadBenchMarkTest::testLoadAndFree() {
+#ifdef BENCHMARKING_ENABLED
+    benchmark("../TPEFReaderTest/data/tremor.tpef");
+#endif
+}
+
+#endif
@@ -0,0 +1,158 @@
+/*
+    Copyright (c) 2002-2026 Tampere University.
+
+    This file is part of TTA-Based Codesign Environment (TCE).
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file ReversibleTest.hh
+ *
+ * A test suite for Reversible and its record arena.
+ */
+
+#ifndef TTA_REVERSIBLE_TEST_HH
+#define TTA_REVERSIBLE_TEST_HH
+
+#include <TestSuite.h>
+#include "Reversible.hh"
+#include "ReversibleArena.hh"
+
+/**
+ * Implements the tests needed to verify correct operation of Reversible.
+ */
+class ReversibleTest : public CxxTest::TestSuite {
+public:
+    void testUndo();
+    void testUndoStack();
+    void testArena();
+};
+
+/**
+ * Appends a value to a log, or fails in case the value is negative.
+ */
+class LogValue : public Reversible {
+public:
+    LogValue(std::vector<int>& log, int value, int children = 0) :
+        log_(log), value_(value), children_(children) {}
+
+    virtual bool operator()() {
+        if (value_ < 0) {
+            return false;
+        }
+        for (int i = 0; i < children_; ++i) {
+            runPreChild(new LogValue(log_, value_ * 10 + i));
+        }
+        runPostChild(new LogValue(log_, -1));
+        log_.push_back(value_);
+        return true;
+    }
+
+protected:
+    virtual void undoOnlyMe() {
+        log_.pop_back();
+    }
+
+private:
+    std::vector<int>& log_;
+    int value_;
+    int children_;
+};
+
+/**
+ * Tests running and undoing nested reversibles.
+ */
+void
+ReversibleTest::testUndo() {
+
+    std::vector<int> log;
+    LogValue* root = new LogValue(log, 1, 3);
+    TS_ASSERT((*root)());
+    TS_ASSERT_EQUALS(log.size(), 4u);
+    TS_ASSERT_EQUALS(log.back(), 1);
+    TS_ASSERT_EQUALS(log.front(), 10);
+
+    root->undo();
+    TS_ASSERT(log.empty());
+    delete root;
+    TS_ASSERT_EQUALS(ReversibleArena::instance().liveRecords(), 0u);
+}
+
+/**
+ * Tests that the undo stack linked through the records is last in,
+ * first out.
+ */
+void
+ReversibleTest::testUndoStack() {
+
+    std::vector<int> log;
+    Reversible::UndoStack stack;
+    TS_ASSERT(stack.empty());
+    Reversible* records[3];
+    for (int i = 0; i < 3; ++i) {
+        records[i] = new LogValue(log, i);
+        stack.push(records[i]);
+        TS_ASSERT_EQUALS(stack.top(), records[i]);
+    }
+    TS_ASSERT_EQUALS(stack.size(), 3u);
+    for (int i = 2; i >= 0; --i) {
+        TS_ASSERT_EQUALS(stack.top(), records[i]);
+        stack.pop();
+        delete records[i];
+    }
+    TS_ASSERT(stack.empty());
+    TS_ASSERT_EQUALS(stack.size(), 0u);
+    TS_ASSERT_EQUALS(ReversibleArena::instance().liveRecords(), 0u);
+}
+
+/**
+ * Tests that the records are recycled and released in bulk.
+ */
+void
+ReversibleTest::testArena() {
+
+    ReversibleArena& arena = ReversibleArena::instance();
+    std::vector<int> log;
+    std::vector<Reversible*> records;
+    for (int i = 0; i < 10000; ++i) {
+        records.push_back(new LogValue(log, i));
+    }
+    TS_ASSERT_EQUALS(arena.liveRecords(), 10000u);
+    TS_ASSERT(arena.chunkCount() > 1);
+    TS_ASSERT(!Reversible::releaseMemory());
+
+    // freed records are reused before taking new memory
+    const std::size_t chunks = arena.chunkCount();
+    delete records.back();
+    records.back() = new LogValue(log, 0);
+    TS_ASSERT_EQUALS(arena.chunkCount(), chunks);
+
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        delete records[i];
+    }
+    TS_ASSERT_EQUALS(arena.liveRecords(), 0u);
+    TS_ASSERT(Reversible::releaseMemory());
+    TS_ASSERT_EQUALS(arena.chunkCount(), 1u);
+
+    Reversible* record = new LogValue(log, 1);
+    TS_ASSERT(record != NULL);
+    delete record;
+}
+
+#endif
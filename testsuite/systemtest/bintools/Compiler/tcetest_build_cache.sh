@@ -0,0 +1,62 @@
+#!/bin/sh
+### TCE TESTCASE 
+### title: Reuse of the cached operation headers and extracted libraries
+### xstdout: miss ok\nhit ok\nno cache ok\nfailed extraction ok\n
+
+mach=data/minimal_with_stdout.adf
+src=data/hello.c
+cache=$(mktemp -d tmpXXXXXX)
+baseline=$(mktemp tmpXXXXXX)
+prog=$(mktemp tmpXXXXXX)
+
+# A compilation with an empty cache fills it.
+tcecc $src -llwpr -O0 -a $mach --plugin-cache-dir=$cache -o $baseline \
+    || exit 1
+if ls $cache/tceops-*.h > /dev/null 2>&1 && \
+   ls -d $cache/libs-* > /dev/null 2>&1; then
+    echo "miss ok"
+fi
+
+# A second compilation uses the cached libraries instead of extracting
+# them again and produces the same program.
+for dir in $cache/libs-*; do
+    if [ -d $dir ]; then
+        touch $dir/marker
+    fi
+done
+tcecc $src -llwpr -O0 -a $mach --plugin-cache-dir=$cache -o $prog || exit 1
+if ls $cache/libs-*/marker > /dev/null 2>&1 && diff $baseline $prog; then
+    echo "hit ok"
+fi
+
+# Without the build cache no headers or libraries are stored and the
+# program is the same.
+nocache=$(mktemp -d tmpXXXXXX)
+tcecc $src -llwpr -O0 -a $mach --plugin-cache-dir=$nocache --no-build-cache \
+    -o $prog || exit 1
+if ! ls $nocache/tceops-*.h $nocache/libs-* > /dev/null 2>&1 && \
+   diff $baseline $prog; then
+    echo "no cache ok"
+fi
+
+# A library that cannot be extracted fails the compilation and leaves no
+# partially extracted directory in the cache.
+failcache=$(mktemp -d tmpXXXXXX)
+bogus=$(mktemp tmpXXXXXX)
+mv $bogus $bogus.a
+bogus=$bogus.a
+echo "not an archive" > $bogus
+if ! tcecc $src $bogus -O0 -a $mach --plugin-cache-dir=$failcache \
+    -o $prog > /dev/null 2>&1; then
+    found=0
+    for dir in $failcache/libs-*; do
+        if [ -d $dir ]; then
+            found=1
+        fi
+    done
+    if [ $found = 0 ]; then
+        echo "failed extraction ok"
+    fi
+fi
+
+rm -rf $cache $nocache $failcache $baseline $prog $bogus
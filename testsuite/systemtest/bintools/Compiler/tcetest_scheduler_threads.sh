@@ -0,0 +1,22 @@
+#!/bin/sh
+### TCE TESTCASE 
+### title: Scheduling on multiple threads produces the same program
+### xstdout:
+
+mach=data/minimal_with_stdout.adf
+src=data/hello.c
+baseline=$(mktemp tmpXXXXXX)
+
+tcecc $src -llwpr -O3 -a $mach -o $baseline
+
+for threads in 2 4 0
+do
+    prog=$(mktemp tmpXXXXXX)
+    tcecc $src -llwpr -O3 -a $mach --scheduler-threads=$threads -o $prog
+    diff $baseline $prog
+    rm $prog
+done
+
+rm $baseline
+# Just for the newline
+echo
@@ -0,0 +1,75 @@
+#!/bin/bash
+### TCE TESTCASE
+### title: Tests generating several program image formats at once
+
+
+DATA=./data
+SRC=$DATA/dmem_endianess.c
+ADF=$DATA/le_mach.adf
+TPEF=dmem_endianess.tpef
+IMG=dmem_endianess.img
+PROGE_OUT="proge-out"
+TOP="top"
+TCECC=../../../../openasip/src/bintools/Compiler/tcecc
+GENERATEBITS=../../../../openasip/src/bintools/PIG/generatebits
+
+function eexit {
+    echo $1
+    exit 1
+}
+
+leavedirty=false
+OPTIND=1
+while getopts "d" OPTION
+do
+    case $OPTION in
+        d)
+            leavedirty=true
+            ;;
+        ?)
+            exit 1
+            ;;
+    esac
+done
+shift "$((OPTIND-1))"
+
+clear_test_data() {
+    rm -rf $PROGE_OUT
+    rm -f $TPEF
+    rm -f *.img *.ref
+}
+
+clear_test_data
+
+set -eu
+$TCECC -O0 -llwpr -a $ADF -o $TPEF $SRC || echo "Error from tcecc."
+
+# reference images, one format at a time
+for format in ascii hex bin2n; do
+    $GENERATEBITS -e $TOP -x ${PROGE_OUT} -w 4 -p $TPEF -f $format $ADF \
+        || echo "Error from PIG"
+    mv $IMG dmem_endianess_$format.ref
+done
+
+$GENERATEBITS -e $TOP -x ${PROGE_OUT} -w 4 -p $TPEF -f ascii,hex,bin2n \
+    $ADF || echo "Error from PIG"
+
+# a repeated format is generated once to the single format file name
+$GENERATEBITS -e $TOP -x ${PROGE_OUT} -w 4 -p $TPEF -f ascii,ascii $ADF \
+    || echo "Error from PIG"
+
+set +e
+
+for format in ascii hex bin2n; do
+    diff dmem_endianess_$format.ref dmem_endianess_$format.img \
+        >& /dev/null || eexit "Mismatch for $format image"
+done
+
+diff dmem_endianess_ascii.ref $IMG >& /dev/null \
+    || eexit "Mismatch for repeated ascii image"
+
+if [ "${leavedirty}" != "true" ]; then
+    clear_test_data
+fi
+
+exit 0